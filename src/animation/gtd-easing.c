@@ -472,3 +472,117 @@ gtd_easing_for_mode (GtdEaseMode mode,
 
   return _gtd_animation_modes[mode].func (t, d);
 }
+
+
+/*
+ * Table-driven easing
+ *
+ * Every easing function is a function of t / d alone, so it can be sampled
+ * once over [0, 1] and linearly interpolated afterwards, instead of running
+ * pow() and sin() for each animated property on every frame.
+ */
+
+#define EASING_TABLE_SIZE 2048
+
+static gfloat *easing_tables[GTD_EASE_LAST] = { NULL, };
+
+static const gfloat *
+ensure_easing_table (GtdEaseMode mode)
+{
+  if (g_once_init_enter (&easing_tables[mode]))
+    {
+      GtdEaseFunc func = _gtd_animation_modes[mode].func;
+      gfloat *table;
+      guint i;
+
+      table = g_new (gfloat, EASING_TABLE_SIZE + 1);
+
+      /* Sampling with d = EASING_TABLE_SIZE keeps the t == 0 and t == d
+       * special cases of the easing functions exact.
+       */
+      for (i = 0; i <= EASING_TABLE_SIZE; i++)
+        table[i] = func (i, EASING_TABLE_SIZE);
+
+      g_once_init_leave (&easing_tables[mode], table);
+    }
+
+  return easing_tables[mode];
+}
+
+/**
+ * gtd_easing_for_mode_table:
+ * @mode: a #GtdEaseMode
+ * @t: elapsed time
+ * @d: total duration
+ *
+ * Same as gtd_easing_for_mode(), but looks the value up in a table of
+ * samples of the easing function, built the first time @mode is used.
+ * The result is exact at the boundaries, and is within
+ * gtd_easing_get_table_error() of the analytic value elsewhere. That
+ * error is below 1e-3 for all modes, except for the circular ones,
+ * whose infinite slope at their ends keeps it below 1e-2 only.
+ *
+ * Returns: the eased value
+ */
+gdouble
+gtd_easing_for_mode_table (GtdEaseMode mode,
+                           gdouble     t,
+                           gdouble     d)
+{
+  const gfloat *table;
+  gdouble position;
+  gdouble fraction;
+  guint index;
+
+  g_assert (_gtd_animation_modes[mode].mode == mode);
+  g_assert (_gtd_animation_modes[mode].func != NULL);
+
+  table = ensure_easing_table (mode);
+
+  if (G_UNLIKELY (d <= 0.0))
+    return table[EASING_TABLE_SIZE];
+
+  position = CLAMP (t / d, 0.0, 1.0) * EASING_TABLE_SIZE;
+  index = MIN ((guint) position, EASING_TABLE_SIZE - 1);
+  fraction = position - index;
+
+  return table[index] + (table[index + 1] - table[index]) * fraction;
+}
+
+/**
+ * gtd_easing_get_table_error:
+ * @mode: a #GtdEaseMode
+ *
+ * Measures the largest difference between gtd_easing_for_mode() and
+ * gtd_easing_for_mode_table() for @mode, probing each table interval
+ * at several points. This is meant for tests and benchmarks; it is
+ * much more expensive than evaluating the easing function itself.
+ *
+ * Returns: the maximum absolute error of the table-driven easing
+ */
+gdouble
+gtd_easing_get_table_error (GtdEaseMode mode)
+{
+  const guint n_probes = EASING_TABLE_SIZE * 16;
+  gdouble max_error = 0.0;
+  guint i;
+
+  g_assert (_gtd_animation_modes[mode].mode == mode);
+  g_assert (_gtd_animation_modes[mode].func != NULL);
+
+  /* Probe in between the samples too, where interpolation is worst */
+  for (i = 0; i <= n_probes; i++)
+    {
+      gdouble analytic;
+      gdouble table;
+      gdouble t;
+
+      t = (gdouble) i / n_probes;
+      analytic = gtd_easing_for_mode (mode, t, 1.0);
+      table = gtd_easing_for_mode_table (mode, t, 1.0);
+
+      max_error = MAX (max_error, fabs (analytic - table));
+    }
+
+  return max_error;
+}
@@ -45,6 +45,12 @@ gdouble             gtd_easing_for_mode                          (GtdEaseMode
                                                                   gdouble            t,
                                                                   gdouble            d);
 
+gdouble             gtd_easing_for_mode_table                    (GtdEaseMode        mode,
+                                                                  gdouble            t,
+                                                                  gdouble            d);
+
+gdouble             gtd_easing_get_table_error                   (GtdEaseMode        mode);
+
 gdouble              gtd_ease_linear                             (gdouble            t,
                                                                   gdouble            d);
 
@@ -41,6 +41,7 @@
  */
 
 #include "gtd-interval.h"
+#include "gtd-interval-private.h"
 
 #include "gtd-animation-utils.h"
 #include "gtd-easing.h"
@@ -1159,6 +1160,53 @@ gtd_interval_compute (GtdInterval *self,
   return NULL;
 }
 
+/*< private >
+ * gtd_interval_compute_double:
+ * @interval: a #GtdInterval
+ * @factor: the progress factor, between 0 and 1
+ * @out_value: (out): return location for the computed value
+ *
+ * Computes the value of a #gdouble or #gfloat interval without boxing
+ * the result in a #GValue. This is only possible when neither a subclass
+ * nor a registered progress function changes how the value is computed;
+ * callers must fall back to gtd_interval_compute_value() otherwise.
+ *
+ * Return value: %TRUE if @out_value was set
+ */
+gboolean
+gtd_interval_compute_double (GtdInterval *self,
+                             gdouble      factor,
+                             gdouble     *out_value)
+{
+  GtdIntervalPrivate *priv = gtd_interval_get_instance_private (self);
+  gdouble initial, final;
+
+  if (priv->value_type != G_TYPE_DOUBLE && priv->value_type != G_TYPE_FLOAT)
+    return FALSE;
+
+  if (GTD_INTERVAL_GET_CLASS (self)->compute_value != gtd_interval_real_compute_value ||
+      gtd_has_progress_function (priv->value_type) ||
+      !gtd_interval_is_valid (self))
+    {
+      return FALSE;
+    }
+
+  if (priv->value_type == G_TYPE_DOUBLE)
+    {
+      initial = g_value_get_double (&priv->values[INITIAL]);
+      final = g_value_get_double (&priv->values[FINAL]);
+    }
+  else
+    {
+      initial = g_value_get_float (&priv->values[INITIAL]);
+      final = g_value_get_float (&priv->values[FINAL]);
+    }
+
+  *out_value = (factor * (final - initial)) + initial;
+
+  return TRUE;
+}
+
 /**
  * gtd_interval_is_valid:
  * @interval: a #GtdInterval
@@ -287,9 +287,9 @@ gtd_keyframe_transition_compute_value (GtdTransition *transition,
   real_interval = cur_frame->interval;
 
   /* normalize the progress and apply the easing mode */
-  real_progress = gtd_easing_for_mode (cur_frame->mode,
-                                       (p - cur_frame->start),
-                                       (cur_frame->end - cur_frame->start));
+  real_progress = gtd_easing_for_mode_table (cur_frame->mode,
+                                             (p - cur_frame->start),
+                                             (cur_frame->end - cur_frame->start));
 
 #ifdef GTD_ENABLE_DEBUG
   if (GTD_HAS_DEBUG (ANIMATION))
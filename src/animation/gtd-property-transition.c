@@ -35,6 +35,7 @@
 #include "gtd-animatable.h"
 #include "gtd-debug.h"
 #include "gtd-interval.h"
+#include "gtd-interval-private.h"
 #include "gtd-transition.h"
 
 typedef struct
@@ -42,6 +43,9 @@ typedef struct
   gchar              *property_name;
 
   GParamSpec         *pspec;
+
+  /* Reused across frames by #gdouble and #gfloat properties */
+  GValue              value;
 } GtdPropertyTransitionPrivate;
 
 enum
@@ -87,6 +91,35 @@ gtd_property_transition_ensure_interval (GtdPropertyTransition *self,
     }
 }
 
+static gboolean
+gtd_property_transition_compute_value_unboxed (GtdPropertyTransition *self,
+                                               GtdAnimatable         *animatable,
+                                               GtdInterval           *interval,
+                                               gdouble                progress)
+{
+  GtdPropertyTransitionPrivate *priv = gtd_property_transition_get_instance_private (self);
+  gdouble value;
+
+  if (!G_IS_VALUE (&priv->value))
+    return FALSE;
+
+  /* Animatables that interpolate on their own need the whole interval */
+  if (GTD_ANIMATABLE_GET_IFACE (animatable)->interpolate_value != NULL)
+    return FALSE;
+
+  if (!gtd_interval_compute_double (interval, progress, &value))
+    return FALSE;
+
+  if (G_VALUE_HOLDS_DOUBLE (&priv->value))
+    g_value_set_double (&priv->value, value);
+  else
+    g_value_set_float (&priv->value, value);
+
+  gtd_animatable_set_final_state (animatable, priv->property_name, &priv->value);
+
+  return TRUE;
+}
+
 static void
 gtd_property_transition_attached (GtdTransition *transition,
                                   GtdAnimatable *animatable)
@@ -104,6 +137,15 @@ gtd_property_transition_attached (GtdTransition *transition,
   if (priv->pspec == NULL)
     return;
 
+  if (G_IS_VALUE (&priv->value))
+    g_value_unset (&priv->value);
+
+  if (G_PARAM_SPEC_VALUE_TYPE (priv->pspec) == G_TYPE_DOUBLE ||
+      G_PARAM_SPEC_VALUE_TYPE (priv->pspec) == G_TYPE_FLOAT)
+    {
+      g_value_init (&priv->value, G_PARAM_SPEC_VALUE_TYPE (priv->pspec));
+    }
+
   interval = gtd_transition_get_interval (transition);
   if (interval == NULL)
     return;
@@ -119,6 +161,9 @@ gtd_property_transition_detached (GtdTransition *transition,
   GtdPropertyTransitionPrivate *priv = gtd_property_transition_get_instance_private (self);
 
   priv->pspec = NULL;
+
+  if (G_IS_VALUE (&priv->value))
+    g_value_unset (&priv->value);
 }
 
 static void
@@ -139,6 +184,9 @@ gtd_property_transition_compute_value (GtdTransition *transition,
 
   gtd_property_transition_ensure_interval (self, animatable, interval);
 
+  if (gtd_property_transition_compute_value_unboxed (self, animatable, interval, progress))
+    return;
+
   p_type = G_PARAM_SPEC_VALUE_TYPE (priv->pspec);
   i_type = gtd_interval_get_value_type (interval);
 
@@ -232,6 +280,9 @@ gtd_property_transition_finalize (GObject *gobject)
 
   g_free (priv->property_name);
 
+  if (G_IS_VALUE (&priv->value))
+    g_value_unset (&priv->value);
+
   G_OBJECT_CLASS (gtd_property_transition_parent_class)->finalize (gobject);
 }
 
@@ -26,6 +26,21 @@
 
 G_BEGIN_DECLS
 
+/* Advancing all timelines must fit in one frame at 60Hz */
+#define GTD_TIMELINE_FRAME_BUDGET_US 16000
+
+typedef struct
+{
+  guint               n_timelines;
+  guint               n_frames;
+  gint64              last_frame_us;
+  gint64              max_frame_us;
+  gint64              total_frame_us;
+} GtdTimelineFrameStats;
+
 void gtd_timeline_cancel_delay (GtdTimeline *self);
 
+void gtd_timeline_get_frame_stats (GdkFrameClock         *frame_clock,
+                                   GtdTimelineFrameStats *out_stats);
+
 G_END_DECLS
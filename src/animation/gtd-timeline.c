@@ -180,9 +180,31 @@ enum
 
 static guint timeline_signals[LAST_SIGNAL] = { 0, };
 
+/*
+ * All the playing timelines of a frame clock are advanced by a single
+ * master clock, in one pass per frame.
+ */
+typedef struct
+{
+  GdkFrameClock *frame_clock;
+  gulong after_paint_id;
+
+  /* The playing timelines, in the order they started */
+  GPtrArray *timelines;
+
+  /* Scratch space for a frame */
+  GPtrArray *ticking;
+  GHashTable *widgets;
+
+  GtdTimelineFrameStats stats;
+} MasterClock;
+
+static GQuark master_clock_quark = 0;
+
 static void update_frame_clock (GtdTimeline *self);
 static void maybe_add_timeline (GtdTimeline *self);
 static void maybe_remove_timeline (GtdTimeline *self);
+static void master_clock_free (MasterClock *master_clock);
 
 G_DEFINE_TYPE_WITH_PRIVATE (GtdTimeline, gtd_timeline, G_TYPE_OBJECT)
 
@@ -443,29 +465,116 @@ tick_timeline (GtdTimeline *self,
     }
 }
 
+static MasterClock*
+master_clock_get (GdkFrameClock *frame_clock)
+{
+  MasterClock *master_clock;
+
+  master_clock = g_object_get_qdata (G_OBJECT (frame_clock), master_clock_quark);
+
+  if (!master_clock)
+    {
+      master_clock = g_new0 (MasterClock, 1);
+      master_clock->frame_clock = frame_clock;
+      master_clock->timelines = g_ptr_array_new ();
+      master_clock->ticking = g_ptr_array_new_with_free_func (g_object_unref);
+      master_clock->widgets = g_hash_table_new (NULL, NULL);
+
+      g_object_set_qdata_full (G_OBJECT (frame_clock),
+                               master_clock_quark,
+                               master_clock,
+                               (GDestroyNotify) master_clock_free);
+    }
+
+  return master_clock;
+}
+
+static void
+master_clock_free (MasterClock *master_clock)
+{
+  g_clear_pointer (&master_clock->timelines, g_ptr_array_unref);
+  g_clear_pointer (&master_clock->ticking, g_ptr_array_unref);
+  g_clear_pointer (&master_clock->widgets, g_hash_table_destroy);
+  g_free (master_clock);
+}
+
 static void
 on_frame_clock_after_paint_cb (GdkFrameClock *frame_clock,
-                               GtdTimeline   *self)
+                               MasterClock   *master_clock)
 {
-  GtdTimelinePrivate *priv = gtd_timeline_get_instance_private (self);
+  gboolean needs_layout;
+  gint64 frame_time;
+  gint64 start;
+  gint64 cost;
+  guint i;
+
+  start = g_get_monotonic_time ();
+  frame_time = gdk_frame_clock_get_frame_time (frame_clock) / 1000;
+  needs_layout = FALSE;
+
+  /*
+   * Timelines may be started, stopped or destroyed by the handlers of the
+   * ones being ticked, so tick a referenced copy of the playing timelines.
+   */
+  for (i = 0; i < master_clock->timelines->len; i++)
+    g_ptr_array_add (master_clock->ticking, g_object_ref (g_ptr_array_index (master_clock->timelines, i)));
 
-  tick_timeline (self, gdk_frame_clock_get_frame_time (frame_clock) / 1000);
+  for (i = 0; i < master_clock->ticking->len; i++)
+    tick_timeline (g_ptr_array_index (master_clock->ticking, i), frame_time);
 
-  if (priv->widget)
-    gtk_widget_queue_allocate (GTK_WIDGET (priv->widget));
-  else
-    gdk_frame_clock_request_phase (priv->frame_clock, GDK_FRAME_CLOCK_PHASE_LAYOUT);
+  /* Queue each animated widget only once, and request a single layout phase */
+  for (i = 0; i < master_clock->ticking->len; i++)
+    {
+      GtdTimelinePrivate *priv = gtd_timeline_get_instance_private (g_ptr_array_index (master_clock->ticking, i));
+
+      if (!priv->widget)
+        needs_layout = TRUE;
+      else if (g_hash_table_add (master_clock->widgets, priv->widget))
+        gtk_widget_queue_allocate (GTK_WIDGET (priv->widget));
+    }
+
+  if (needs_layout)
+    gdk_frame_clock_request_phase (frame_clock, GDK_FRAME_CLOCK_PHASE_LAYOUT);
+
+  cost = g_get_monotonic_time () - start;
+
+  master_clock->stats.n_timelines = master_clock->ticking->len;
+  master_clock->stats.n_frames++;
+  master_clock->stats.last_frame_us = cost;
+  master_clock->stats.max_frame_us = MAX (master_clock->stats.max_frame_us, cost);
+  master_clock->stats.total_frame_us += cost;
+
+  if (cost > GTD_TIMELINE_FRAME_BUDGET_US)
+    {
+      g_debug ("Advancing %u timelines took %.2lfms, over the frame budget",
+               master_clock->ticking->len,
+               cost / 1000.0);
+    }
+
+  g_hash_table_remove_all (master_clock->widgets);
+  g_ptr_array_set_size (master_clock->ticking, 0);
 }
 
 static void
 maybe_add_timeline (GtdTimeline *self)
 {
   GtdTimelinePrivate *priv = gtd_timeline_get_instance_private (self);
+  MasterClock *master_clock;
 
   if (!priv->frame_clock)
     return;
 
-  g_signal_connect (priv->frame_clock, "after-paint", G_CALLBACK (on_frame_clock_after_paint_cb), self);
+  master_clock = master_clock_get (priv->frame_clock);
+
+  if (master_clock->timelines->len == 0)
+    {
+      master_clock->after_paint_id = g_signal_connect (priv->frame_clock,
+                                                       "after-paint",
+                                                       G_CALLBACK (on_frame_clock_after_paint_cb),
+                                                       master_clock);
+    }
+
+  g_ptr_array_add (master_clock->timelines, self);
 
   if (priv->widget)
     gtk_widget_queue_allocate (GTK_WIDGET (priv->widget));
@@ -477,11 +586,19 @@ static void
 maybe_remove_timeline (GtdTimeline *self)
 {
   GtdTimelinePrivate *priv = gtd_timeline_get_instance_private (self);
+  MasterClock *master_clock;
 
   if (!priv->frame_clock)
     return;
 
-  g_signal_handlers_disconnect_by_func (priv->frame_clock, on_frame_clock_after_paint_cb, self);
+  master_clock = g_object_get_qdata (G_OBJECT (priv->frame_clock), master_clock_quark);
+
+  if (!master_clock || !g_ptr_array_remove (master_clock->timelines, self))
+    return;
+
+  /* Don't keep the frame clock busy without animations */
+  if (master_clock->timelines->len == 0)
+    g_clear_signal_handler (&master_clock->after_paint_id, priv->frame_clock);
 }
 
 static void
@@ -720,6 +837,8 @@ gtd_timeline_class_init (GtdTimelineClass *klass)
 {
   GObjectClass *object_class = G_OBJECT_CLASS (klass);
 
+  master_clock_quark = g_quark_from_static_string ("GtdTimeline::master-clock");
+
   /**
    * GtdTimeline::widget:
    *
@@ -1660,7 +1779,7 @@ gtd_timeline_progress_func (GtdTimeline *self,
 {
   GtdTimelinePrivate *priv = gtd_timeline_get_instance_private (self);
 
-  return gtd_easing_for_mode (priv->progress_mode, elapsed, duration);
+  return gtd_easing_for_mode_table (priv->progress_mode, elapsed, duration);
 }
 
 /**
@@ -1841,3 +1960,28 @@ gtd_timeline_get_widget (GtdTimeline *self)
 
   return priv->widget;
 }
+
+/**
+ * gtd_timeline_get_frame_stats:
+ * @frame_clock: a #GdkFrameClock
+ * @out_stats: (out): return location for the stats
+ *
+ * Retrieves how long advancing the timelines driven by @frame_clock
+ * took, which is the time spent on animations at each frame.
+ */
+void
+gtd_timeline_get_frame_stats (GdkFrameClock         *frame_clock,
+                              GtdTimelineFrameStats *out_stats)
+{
+  MasterClock *master_clock;
+
+  g_return_if_fail (GDK_IS_FRAME_CLOCK (frame_clock));
+  g_return_if_fail (out_stats != NULL);
+
+  master_clock = g_object_get_qdata (G_OBJECT (frame_clock), master_clock_quark);
+
+  if (master_clock)
+    *out_stats = master_clock->stats;
+  else
+    *out_stats = (GtdTimelineFrameStats) { 0, };
+}
@@ -22,6 +22,7 @@
 #include "gtd-debug.h"
 
 #include <gio/gio.h>
+#include <glib/gi18n.h>
 
 struct _GtdClock
 {
@@ -31,6 +32,11 @@ struct _GtdClock
 
   GDateTime          *current;
 
+  /* Labels of the days relative to today, reset when the day changes */
+  guint32             today;
+  gint                today_year;
+  GHashTable         *date_labels;
+
   GDBusProxy         *logind;
   GCancellable       *cancellable;
 };
@@ -49,10 +55,79 @@ enum
 
 static guint signals[N_SIGNALS] = { 0, };
 
+typedef struct
+{
+  const gchar        *relative_label;
+  const gchar        *due_date_label;
+} DateLabels;
+
 /*
  * Auxiliary methods
  */
 
+static guint32
+get_julian_day (GDateTime *dt,
+                gint      *out_year)
+{
+  GDate date;
+  gint month;
+  gint year;
+  gint day;
+
+  /* Only uses the offset already in @dt, no time zone lookups */
+  g_date_time_get_ymd (dt, &year, &month, &day);
+
+  g_date_clear (&date, 1);
+  g_date_set_dmy (&date, day, month, year);
+
+  if (out_year)
+    *out_year = year;
+
+  return g_date_get_julian (&date);
+}
+
+static void
+update_today (GtdClock *self)
+{
+  self->today = get_julian_day (self->current, &self->today_year);
+
+  g_hash_table_remove_all (self->date_labels);
+}
+
+static DateLabels*
+get_date_labels (GtdClock  *self,
+                 GDateTime *dt,
+                 gint      *out_days,
+                 gint      *out_year)
+{
+  DateLabels *labels;
+  guint32 day;
+
+  day = get_julian_day (dt, out_year);
+
+  if (out_days)
+    *out_days = (gint) day - (gint) self->today;
+
+  labels = g_hash_table_lookup (self->date_labels, GUINT_TO_POINTER (day));
+
+  if (!labels)
+    {
+      labels = g_new0 (DateLabels, 1);
+      g_hash_table_insert (self->date_labels, GUINT_TO_POINTER (day), labels);
+    }
+
+  return labels;
+}
+
+static const gchar*
+format_date (GDateTime   *dt,
+             const gchar *format)
+{
+  g_autofree gchar *str = g_date_time_format (dt, format);
+
+  return g_intern_string (str);
+}
+
 static void
 update_current_date (GtdClock *self)
 {
@@ -70,8 +145,15 @@ update_current_date (GtdClock *self)
   hour_changed = day_changed || g_date_time_get_hour (now) != g_date_time_get_hour (self->current);
   minute_changed = hour_changed || g_date_time_get_minute (now) != g_date_time_get_minute (self->current);
 
+  g_clear_pointer (&self->current, g_date_time_unref);
+  self->current = g_date_time_ref (now);
+
+  /* Handlers of ::day-changed already see the labels of the new day */
   if (day_changed)
-    g_signal_emit (self, signals[DAY_CHANGED], 0);
+    {
+      update_today (self);
+      g_signal_emit (self, signals[DAY_CHANGED], 0);
+    }
 
   if (hour_changed)
     g_signal_emit (self, signals[HOUR_CHANGED], 0);
@@ -81,9 +163,6 @@ update_current_date (GtdClock *self)
 
   GTD_TRACE_MSG ("Ticking clock");
 
-  g_clear_pointer (&self->current, g_date_time_unref);
-  self->current = g_date_time_ref (now);
-
   GTD_EXIT;
 }
 
@@ -195,6 +274,7 @@ gtd_clock_finalize (GObject *object)
     }
 
   g_clear_pointer (&self->current, g_date_time_unref);
+  g_clear_pointer (&self->date_labels, g_hash_table_destroy);
 
   g_clear_object (&self->cancellable);
   g_clear_object (&self->logind);
@@ -271,6 +351,9 @@ gtd_clock_init (GtdClock *self)
 
   self->current = g_date_time_new_now_local ();
   self->cancellable = g_cancellable_new ();
+  self->date_labels = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, g_free);
+
+  update_today (self);
 
   g_dbus_proxy_new_for_bus (G_BUS_TYPE_SYSTEM,
                             G_DBUS_PROXY_FLAGS_NONE,
@@ -290,3 +373,138 @@ gtd_clock_new (void)
 {
   return g_object_new (GTD_TYPE_CLOCK, NULL);
 }
+
+/**
+ * gtd_clock_get_days_from_today:
+ * @self: a #GtdClock
+ * @dt: a #GDateTime
+ *
+ * Retrieves the number of days between today and @dt. It is
+ * negative when @dt is in the past.
+ *
+ * Returns: the number of days from today to @dt
+ */
+gint
+gtd_clock_get_days_from_today (GtdClock  *self,
+                               GDateTime *dt)
+{
+  g_return_val_if_fail (GTD_IS_CLOCK (self), 0);
+  g_return_val_if_fail (dt != NULL, 0);
+
+  return (gint) get_julian_day (dt, NULL) - (gint) self->today;
+}
+
+/**
+ * gtd_clock_get_relative_date_label:
+ * @self: a #GtdClock
+ * @dt: a #GDateTime
+ *
+ * Retrieves a label for the day of @dt relative to today, such
+ * as "Yesterday", "Tomorrow", the name of the weekday or month,
+ * or the year. Panels use it to group tasks by date.
+ *
+ * Labels are formatted once per day, and the returned string is
+ * interned.
+ *
+ * Returns: (transfer none): the label for @dt
+ */
+const gchar*
+gtd_clock_get_relative_date_label (GtdClock  *self,
+                                   GDateTime *dt)
+{
+  DateLabels *labels;
+  gint days_diff;
+  gint year;
+
+  g_return_val_if_fail (GTD_IS_CLOCK (self), NULL);
+  g_return_val_if_fail (dt != NULL, NULL);
+
+  labels = get_date_labels (self, dt, &days_diff, &year);
+
+  if (labels->relative_label)
+    return labels->relative_label;
+
+  if (days_diff < -1)
+    {
+      g_autofree gchar *str = NULL;
+
+      /* Translators: This message will never be used with '1 day ago'
+       * but the singular form is required because some languages do not
+       * have plurals, some languages reuse the singular form for numbers
+       * like 21, 31, 41, etc.
+       */
+      str = g_strdup_printf (g_dngettext (NULL, "%d day ago", "%d days ago", -days_diff), -days_diff);
+      labels->relative_label = g_intern_string (str);
+    }
+  else if (days_diff == -1)
+    {
+      labels->relative_label = _("Yesterday");
+    }
+  else if (days_diff == 0)
+    {
+      labels->relative_label = _("Today");
+    }
+  else if (days_diff == 1)
+    {
+      labels->relative_label = _("Tomorrow");
+    }
+  else if (days_diff > 1 && days_diff < 7)
+    {
+      labels->relative_label = format_date (dt, "%A"); // Weekday name
+    }
+  else if (days_diff >= 7 && year == self->today_year)
+    {
+      labels->relative_label = format_date (dt, "%OB"); // Full month name
+    }
+  else
+    {
+      g_autofree gchar *str = g_strdup_printf ("%d", year);
+
+      labels->relative_label = g_intern_string (str);
+    }
+
+  return labels->relative_label;
+}
+
+/**
+ * gtd_clock_get_due_date_label:
+ * @self: a #GtdClock
+ * @dt: a #GDateTime
+ *
+ * Retrieves a short label for @dt as a due date: "Yesterday",
+ * "Today" and "Tomorrow", the name of the weekday in the next
+ * week, or the date otherwise.
+ *
+ * Labels are formatted once per day, and the returned string is
+ * interned.
+ *
+ * Returns: (transfer none): the label for @dt
+ */
+const gchar*
+gtd_clock_get_due_date_label (GtdClock  *self,
+                              GDateTime *dt)
+{
+  DateLabels *labels;
+  gint days_diff;
+
+  g_return_val_if_fail (GTD_IS_CLOCK (self), NULL);
+  g_return_val_if_fail (dt != NULL, NULL);
+
+  labels = get_date_labels (self, dt, &days_diff, NULL);
+
+  if (labels->due_date_label)
+    return labels->due_date_label;
+
+  if (days_diff == -1)
+    labels->due_date_label = _("Yesterday");
+  else if (days_diff == 0)
+    labels->due_date_label = _("Today");
+  else if (days_diff == 1)
+    labels->due_date_label = _("Tomorrow");
+  else if (days_diff > 1 && days_diff < 7)
+    labels->due_date_label = format_date (dt, "%A");
+  else
+    labels->due_date_label = format_date (dt, "%x");
+
+  return labels->due_date_label;
+}
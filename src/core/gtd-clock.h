@@ -30,4 +30,13 @@ G_DECLARE_FINAL_TYPE (GtdClock, gtd_clock, GTD, CLOCK, GtdObject)
 
 GtdClock*            gtd_clock_new                               (void);
 
+gint                 gtd_clock_get_days_from_today               (GtdClock           *self,
+                                                                  GDateTime          *dt);
+
+const gchar*         gtd_clock_get_relative_date_label           (GtdClock           *self,
+                                                                  GDateTime          *dt);
+
+const gchar*         gtd_clock_get_due_date_label                (GtdClock           *self,
+                                                                  GDateTime          *dt);
+
 G_END_DECLS
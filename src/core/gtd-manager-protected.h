@@ -22,8 +22,35 @@
 
 G_BEGIN_DECLS
 
+typedef enum
+{
+  GTD_STARTUP_MODE_COLD,
+  GTD_STARTUP_MODE_SNAPSHOT,
+} GtdStartupMode;
+
+/*
+ * All times are in microseconds. The first data and reconciled times are
+ * counted since the manager was created, and are 0 until reached.
+ */
+typedef struct
+{
+  GtdStartupMode      mode;
+  gint64              snapshot_load_us;
+  gint64              first_data_us;
+  gint64              reconciled_us;
+} GtdStartupStats;
+
 void                 gtd_manager_load_plugins                    (GtdManager         *manager);
 
 GtdPluginManager*    gtd_manager_get_plugin_manager              (GtdManager         *manager);
 
+gboolean             gtd_manager_load_snapshot                   (GtdManager         *self,
+                                                                  const gchar        *path,
+                                                                  GError            **error);
+
+void                 gtd_manager_save_snapshot                   (GtdManager         *self);
+
+void                 gtd_manager_get_startup_stats               (GtdManager         *self,
+                                                                  GtdStartupStats    *out_stats);
+
 G_END_DECLS
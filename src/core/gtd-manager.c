@@ -18,6 +18,7 @@
 
 #define G_LOG_DOMAIN "GtdManager"
 
+#include "models/gtd-due-date-index-private.h"
 #include "models/gtd-list-store.h"
 #include "models/gtd-task-model-private.h"
 #include "gtd-clock.h"
@@ -28,8 +29,10 @@
 #include "gtd-panel.h"
 #include "gtd-plugin-manager.h"
 #include "gtd-provider.h"
+#include "gtd-snapshot-private.h"
 #include "gtd-task.h"
 #include "gtd-task-list.h"
+#include "gtd-task-list-private.h"
 #include "gtd-utils.h"
 #include "gtd-workspace.h"
 
@@ -61,15 +64,29 @@ struct _GtdManager
   GListModel         *lists_model;
   GListModel         *providers_model;
   GListModel         *tasks_model;
+  GListModel         *unarchived_lists_model;
   GListModel         *unarchived_tasks_model;
 
   GList              *providers;
   GtdProvider        *default_provider;
   GtdClock           *clock;
+  GtdDueDateIndex    *due_date_index;
 
   GCancellable       *cancellable;
+
+  /* Startup snapshot */
+  gchar              *snapshot_path;
+  GHashTable         *placeholder_providers;
+  guint               save_snapshot_timeout_id;
+  guint               drop_placeholders_timeout_id;
+  guint               drop_placeholders_idle_id;
+  gint64              init_time;
+  GtdStartupStats     startup_stats;
 };
 
+#define SAVE_SNAPSHOT_TIMEOUT      10 /* seconds */
+#define DROP_PLACEHOLDERS_TIMEOUT  30 /* seconds */
+
 G_DEFINE_TYPE (GtdManager, gtd_manager, GTD_TYPE_OBJECT)
 
 /* Singleton instance */
@@ -98,6 +115,20 @@ enum
 
 static guint signals[NUM_SIGNALS] = { 0, };
 
+static gint          compare_lists_cb                            (GtdTaskList        *list_a,
+                                                                  GtdTaskList        *list_b,
+                                                                  gpointer            user_data);
+
+static void          on_list_removed_cb                          (GtdProvider        *provider,
+                                                                  GtdTaskList        *list,
+                                                                  GtdManager         *self);
+
+static void          on_provider_loading_changed_cb              (GtdProvider        *provider,
+                                                                  GParamSpec         *pspec,
+                                                                  GtdManager         *self);
+
+static gboolean      save_snapshot_timeout_cb                    (gpointer            user_data);
+
 
 /*
  * Auxiliary methods
@@ -115,6 +146,120 @@ check_provider_is_default (GtdManager  *self,
     gtd_manager_set_default_provider (self, provider);
 }
 
+static gboolean
+is_settled (GtdManager *self)
+{
+  GList *l;
+
+  if (g_hash_table_size (self->placeholder_providers) > 0)
+    return FALSE;
+
+  if (gtd_object_get_loading (GTD_OBJECT (self)))
+    return FALSE;
+
+  for (l = self->providers; l; l = l->next)
+    {
+      if (gtd_object_get_loading (l->data))
+        return FALSE;
+    }
+
+  return TRUE;
+}
+
+static void
+schedule_snapshot_save (GtdManager *self)
+{
+  if (!self->snapshot_path || self->save_snapshot_timeout_id > 0)
+    return;
+
+  self->save_snapshot_timeout_id = g_timeout_add_seconds (SAVE_SNAPSHOT_TIMEOUT,
+                                                          save_snapshot_timeout_cb,
+                                                          self);
+}
+
+static gboolean
+replace_placeholder_list (GtdManager  *self,
+                          GtdProvider *provider,
+                          GtdTaskList *list)
+{
+  g_autoptr (GtdTaskList) placeholder = NULL;
+  GtdSnapshotProvider *placeholder_provider;
+  gpointer additions[1] = { list };
+  GtdTaskList *placeholder_list;
+  guint position;
+
+  GTD_ENTRY;
+
+  if (GTD_IS_SNAPSHOT_PROVIDER (provider))
+    GTD_RETURN (FALSE);
+
+  placeholder_provider = g_hash_table_lookup (self->placeholder_providers, gtd_provider_get_id (provider));
+
+  if (!placeholder_provider)
+    GTD_RETURN (FALSE);
+
+  placeholder_list = _gtd_snapshot_provider_lookup_list (placeholder_provider, gtd_object_get_uid (GTD_OBJECT (list)));
+
+  if (!placeholder_list)
+    GTD_RETURN (FALSE);
+
+  placeholder = g_object_ref (placeholder_list);
+
+  /* Swap the lists at the same position, so views only see one change */
+  position = gtd_list_store_get_item_position (GTD_LIST_STORE (self->lists_model), placeholder);
+  gtd_list_store_splice (GTD_LIST_STORE (self->lists_model), position, 1, additions, 1);
+  gtd_list_store_sort_changed (GTD_LIST_STORE (self->lists_model),
+                               list,
+                               (GCompareDataFunc) compare_lists_cb,
+                               self);
+
+  g_signal_handlers_disconnect_by_data (placeholder, self);
+  _gtd_snapshot_provider_remove_list (placeholder_provider, placeholder);
+
+  g_signal_emit (self, signals[LIST_REMOVED], 0, placeholder);
+
+  GTD_RETURN (TRUE);
+}
+
+static void
+drop_placeholder_provider (GtdManager  *self,
+                           const gchar *provider_id)
+{
+  g_autoptr (GtdSnapshotProvider) placeholder_provider = NULL;
+  g_autofree gchar *id = NULL;
+  g_autoptr (GList) lists = NULL;
+  GList *l;
+
+  GTD_ENTRY;
+
+  if (!g_hash_table_steal_extended (self->placeholder_providers,
+                                    provider_id,
+                                    (gpointer *) &id,
+                                    (gpointer *) &placeholder_provider))
+    {
+      GTD_RETURN ();
+    }
+
+  /* Whatever wasn't replaced by now doesn't exist anymore */
+  lists = gtd_provider_get_task_lists (GTD_PROVIDER (placeholder_provider));
+
+  for (l = lists; l; l = l->next)
+    on_list_removed_cb (GTD_PROVIDER (placeholder_provider), l->data, self);
+
+  if (g_hash_table_size (self->placeholder_providers) == 0)
+    {
+      self->startup_stats.reconciled_us = g_get_monotonic_time () - self->init_time;
+
+      g_clear_handle_id (&self->drop_placeholders_timeout_id, g_source_remove);
+
+      g_debug ("Snapshot reconciled after %.1lfms", self->startup_stats.reconciled_us / 1000.0);
+
+      schedule_snapshot_save (self);
+    }
+
+  GTD_EXIT;
+}
+
 
 /*
  * Callbacks
@@ -124,13 +269,7 @@ static gboolean
 filter_archived_lists_func (gpointer item,
                             gpointer user_data)
 {
-  GtdTaskList *list;
-  GtdTask *task;
-
-  task = (GtdTask*) item;
-  list = gtd_task_get_list (task);
-
-  return !gtd_task_list_get_archived (list);
+  return !gtd_task_list_get_archived (item);
 }
 
 static gboolean
@@ -165,6 +304,27 @@ on_task_list_modified_cb (GtdTaskList *list,
 {
   GTD_ENTRY;
   g_signal_emit (self, signals[LIST_CHANGED], 0, list);
+  schedule_snapshot_save (self);
+  GTD_EXIT;
+}
+
+static void
+on_list_archived_changed_cb (GtdTaskList *list,
+                             GParamSpec  *pspec,
+                             GtdManager  *self)
+{
+  GtkFilter *filter;
+
+  GTD_ENTRY;
+
+  /*
+   * Archiving is filtered at the list level, so this only adds or removes
+   * the tasks of this list from the unarchived tasks model.
+   */
+  filter = gtk_filter_list_model_get_filter (GTK_FILTER_LIST_MODEL (self->unarchived_lists_model));
+  gtk_filter_changed (filter,
+                      gtd_task_list_get_archived (list) ? GTK_FILTER_CHANGE_MORE_STRICT : GTK_FILTER_CHANGE_LESS_STRICT);
+
   GTD_EXIT;
 }
 
@@ -175,10 +335,16 @@ on_list_added_cb (GtdProvider *provider,
 {
   GTD_ENTRY;
 
-  gtd_list_store_insert_sorted (GTD_LIST_STORE (self->lists_model),
-                                list,
-                                (GCompareDataFunc) compare_lists_cb,
-                                self);
+  /* The list may have been created before the day changed */
+  _gtd_task_list_update_day (list);
+
+  if (!replace_placeholder_list (self, provider, list))
+    {
+      gtd_list_store_insert_sorted (GTD_LIST_STORE (self->lists_model),
+                                    list,
+                                    (GCompareDataFunc) compare_lists_cb,
+                                    self);
+    }
 
   g_signal_connect (list,
                     "task-added",
@@ -195,8 +361,15 @@ on_list_added_cb (GtdProvider *provider,
                     G_CALLBACK (on_task_list_modified_cb),
                     self);
 
+  g_signal_connect (list,
+                    "notify::archived",
+                    G_CALLBACK (on_list_archived_changed_cb),
+                    self);
+
   g_signal_emit (self, signals[LIST_ADDED], 0, list);
 
+  schedule_snapshot_save (self);
+
   GTD_EXIT;
 }
 
@@ -205,19 +378,18 @@ on_list_changed_cb (GtdProvider *provider,
                     GtdTaskList *list,
                     GtdManager  *self)
 {
-  GtkFilter *filter;
-
   GTD_ENTRY;
 
-  gtd_list_store_sort (GTD_LIST_STORE (self->lists_model),
-                       (GCompareDataFunc) compare_lists_cb,
-                       self);
-
-  filter = gtk_filter_list_model_get_filter (GTK_FILTER_LIST_MODEL (self->unarchived_tasks_model));
-  gtk_filter_changed (filter, GTK_FILTER_CHANGE_DIFFERENT);
+  /* Only a rename can move the list, and nothing else is touched */
+  gtd_list_store_sort_changed (GTD_LIST_STORE (self->lists_model),
+                               list,
+                               (GCompareDataFunc) compare_lists_cb,
+                               self);
 
   g_signal_emit (self, signals[LIST_CHANGED], 0, list);
 
+  schedule_snapshot_save (self);
+
   GTD_EXIT;
 }
 
@@ -237,8 +409,162 @@ on_list_removed_cb (GtdProvider *provider,
                                         on_task_list_modified_cb,
                                         self);
 
+  g_signal_handlers_disconnect_by_func (list,
+                                        on_list_archived_changed_cb,
+                                        self);
+
   g_signal_emit (self, signals[LIST_REMOVED], 0, list);
 
+  schedule_snapshot_save (self);
+
+  GTD_EXIT;
+}
+
+static gboolean
+drop_placeholders_idle_cb (gpointer user_data)
+{
+  GtdManager *self;
+  GList *l;
+
+  self = GTD_MANAGER (user_data);
+  self->drop_placeholders_idle_id = 0;
+
+  for (l = self->providers; l; l = l->next)
+    {
+      GtdProvider *provider = l->data;
+
+      /* It may have started loading again meanwhile */
+      if (gtd_object_get_loading (GTD_OBJECT (provider)) ||
+          !g_hash_table_contains (self->placeholder_providers, gtd_provider_get_id (provider)))
+        {
+          continue;
+        }
+
+      GTD_TRACE_MSG ("Provider %s finished loading", gtd_provider_get_id (provider));
+
+      g_signal_handlers_disconnect_by_func (provider, on_provider_loading_changed_cb, self);
+      drop_placeholder_provider (self, gtd_provider_get_id (provider));
+    }
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+on_provider_loading_changed_cb (GtdProvider *provider,
+                                GParamSpec  *pspec,
+                                GtdManager  *self)
+{
+  if (gtd_object_get_loading (GTD_OBJECT (provider)))
+    return;
+
+  /*
+   * Providers stop loading right before adding their last list, so wait
+   * until that list had the chance to replace its placeholder in place.
+   */
+  if (self->drop_placeholders_idle_id == 0)
+    self->drop_placeholders_idle_id = g_idle_add (drop_placeholders_idle_cb, self);
+}
+
+static void
+on_tasks_model_items_changed_cb (GListModel *model,
+                                 guint       position,
+                                 guint       removed,
+                                 guint       added,
+                                 GtdManager *self)
+{
+  if (g_list_model_get_n_items (model) == 0)
+    return;
+
+  self->startup_stats.first_data_us = g_get_monotonic_time () - self->init_time;
+
+  g_debug ("First tasks available after %.1lfms", self->startup_stats.first_data_us / 1000.0);
+
+  g_signal_handlers_disconnect_by_func (model, on_tasks_model_items_changed_cb, self);
+}
+
+static gboolean
+drop_placeholders_timeout_cb (gpointer user_data)
+{
+  g_autoptr (GPtrArray) ids = NULL;
+  GtdManager *self;
+  guint i;
+
+  self = GTD_MANAGER (user_data);
+  self->drop_placeholders_timeout_id = 0;
+
+  g_debug ("Providers didn't finish loading in time, dropping the snapshot");
+
+  ids = g_hash_table_get_keys_as_ptr_array (self->placeholder_providers);
+
+  for (i = 0; i < ids->len; i++)
+    drop_placeholder_provider (self, g_ptr_array_index (ids, i));
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+on_snapshot_saved_cb (GObject      *source_object,
+                      GAsyncResult *result,
+                      gpointer      user_data)
+{
+  g_autoptr (GError) error = NULL;
+
+  g_file_replace_contents_finish (G_FILE (source_object), result, NULL, &error);
+
+  if (error && !g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+    g_warning ("Error saving snapshot: %s", error->message);
+}
+
+static gboolean
+save_snapshot_timeout_cb (gpointer user_data)
+{
+  g_autofree gchar *dirname = NULL;
+  g_autoptr (GBytes) bytes = NULL;
+  g_autoptr (GFile) file = NULL;
+  GtdManager *self;
+
+  GTD_ENTRY;
+
+  self = GTD_MANAGER (user_data);
+
+  /* Never replace a good snapshot with a partially loaded one */
+  if (!is_settled (self))
+    GTD_RETURN (G_SOURCE_CONTINUE);
+
+  self->save_snapshot_timeout_id = 0;
+
+  bytes = _gtd_snapshot_serialize (self->lists_model);
+  dirname = g_path_get_dirname (self->snapshot_path);
+  g_mkdir_with_parents (dirname, 0700);
+
+  file = g_file_new_for_path (self->snapshot_path);
+  g_file_replace_contents_bytes_async (file,
+                                       bytes,
+                                       NULL,
+                                       FALSE,
+                                       G_FILE_CREATE_REPLACE_DESTINATION,
+                                       self->cancellable,
+                                       on_snapshot_saved_cb,
+                                       NULL);
+
+  GTD_RETURN (G_SOURCE_REMOVE);
+}
+
+static void
+on_clock_day_changed_cb (GtdClock   *clock,
+                         GtdManager *self)
+{
+  guint i;
+
+  GTD_ENTRY;
+
+  for (i = 0; i < g_list_model_get_n_items (self->lists_model); i++)
+    {
+      g_autoptr (GtdTaskList) list = g_list_model_get_item (self->lists_model, i);
+
+      _gtd_task_list_update_day (list);
+    }
+
   GTD_EXIT;
 }
 
@@ -253,11 +579,18 @@ gtd_manager_finalize (GObject *object)
   GtdManager *self = (GtdManager *)object;
 
   g_cancellable_cancel (self->cancellable);
+  g_clear_handle_id (&self->save_snapshot_timeout_id, g_source_remove);
+  g_clear_handle_id (&self->drop_placeholders_timeout_id, g_source_remove);
+  g_clear_handle_id (&self->drop_placeholders_idle_id, g_source_remove);
+  g_clear_pointer (&self->placeholder_providers, g_hash_table_destroy);
+  g_clear_pointer (&self->snapshot_path, g_free);
   g_clear_object (&self->cancellable);
   g_clear_object (&self->plugin_manager);
   g_clear_object (&self->settings);
+  g_clear_object (&self->due_date_index);
   g_clear_object (&self->clock);
   g_clear_object (&self->unarchived_tasks_model);
+  g_clear_object (&self->unarchived_lists_model);
   g_clear_object (&self->lists_model);
   g_clear_object (&self->inbox_model);
 
@@ -508,6 +841,8 @@ gtd_manager_init (GtdManager *self)
   GtkCustomFilter *archived_lists_filter;
   GtkCustomFilter *inbox_filter;
 
+  self->init_time = g_get_monotonic_time ();
+
   inbox_filter = gtk_custom_filter_new (filter_inbox_cb, self, NULL);
   archived_lists_filter = gtk_custom_filter_new (filter_archived_lists_func, self, NULL);
 
@@ -519,9 +854,15 @@ gtd_manager_init (GtdManager *self)
   self->inbox_model = (GListModel*) gtk_filter_list_model_new (self->lists_model,
                                                                GTK_FILTER (inbox_filter));
   self->tasks_model = (GListModel*) _gtd_task_model_new (self);
-  self->unarchived_tasks_model = (GListModel*) gtk_filter_list_model_new (self->tasks_model,
+  self->unarchived_lists_model = (GListModel*) gtk_filter_list_model_new (self->lists_model,
                                                                           GTK_FILTER (archived_lists_filter));
+  self->unarchived_tasks_model = (GListModel*) gtk_flatten_list_model_new (self->unarchived_lists_model);
+  self->due_date_index = _gtd_due_date_index_new (self);
   self->providers_model = (GListModel*) gtd_list_store_new (GTD_TYPE_PROVIDER);
+  self->placeholder_providers = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_object_unref);
+
+  g_signal_connect (self->clock, "day-changed", G_CALLBACK (on_clock_day_changed_cb), self);
+  g_signal_connect (self->unarchived_tasks_model, "items-changed", G_CALLBACK (on_tasks_model_items_changed_cb), self);
 }
 
 /**
@@ -601,6 +942,15 @@ gtd_manager_add_provider (GtdManager  *self,
   /* If we just added the default provider, update the property */
   check_provider_is_default (self, provider);
 
+  /* The snapshot of this provider is dropped once it finishes loading */
+  if (g_hash_table_contains (self->placeholder_providers, gtd_provider_get_id (provider)))
+    {
+      if (gtd_object_get_loading (GTD_OBJECT (provider)))
+        g_signal_connect (provider, "notify::loading", G_CALLBACK (on_provider_loading_changed_cb), self);
+      else
+        drop_placeholder_provider (self, gtd_provider_get_id (provider));
+    }
+
   g_signal_emit (self, signals[PROVIDER_ADDED], 0, provider);
 
   GTD_EXIT;
@@ -637,6 +987,7 @@ gtd_manager_remove_provider (GtdManager  *self,
   g_signal_handlers_disconnect_by_func (provider, on_list_added_cb, self);
   g_signal_handlers_disconnect_by_func (provider, on_list_changed_cb, self);
   g_signal_handlers_disconnect_by_func (provider, on_list_removed_cb, self);
+  g_signal_handlers_disconnect_by_func (provider, on_provider_loading_changed_cb, self);
 
   g_signal_emit (self, signals[PROVIDER_REMOVED], 0, provider);
 
@@ -914,6 +1265,25 @@ gtd_manager_get_providers_model (GtdManager *self)
   return self->providers_model;
 }
 
+/**
+ * gtd_manager_get_due_date_index:
+ * @self: a #GtdManager
+ *
+ * Retrieves the #GtdDueDateIndex of @self, which keeps the tasks
+ * of unarchived lists sorted by their due dates. Panels that show
+ * tasks due in a given range of days should use this index instead
+ * of filtering gtd_manager_get_tasks_model().
+ *
+ * Returns: (transfer none): a #GtdDueDateIndex
+ */
+GtdDueDateIndex*
+gtd_manager_get_due_date_index (GtdManager *self)
+{
+  g_return_val_if_fail (GTD_IS_MANAGER (self), NULL);
+
+  return self->due_date_index;
+}
+
 void
 gtd_manager_load_plugins (GtdManager *self)
 {
@@ -931,3 +1301,129 @@ gtd_manager_get_plugin_manager (GtdManager *self)
 
   return self->plugin_manager;
 }
+
+/**
+ * gtd_manager_load_snapshot:
+ * @self: a #GtdManager
+ * @path: the path of the snapshot
+ * @error: return location for a #GError
+ *
+ * Loads the task lists saved at @path into read-only placeholders,
+ * so that they can be shown while providers load. As providers add
+ * their lists, the placeholders are replaced in place; when a provider
+ * finishes loading, the placeholders it didn't replace are removed.
+ *
+ * @path is also where the snapshot is saved, once all providers are
+ * loaded, and by gtd_manager_save_snapshot(). It must be called before
+ * any provider is added.
+ *
+ * Returns: %TRUE if the snapshot was loaded, %FALSE otherwise
+ */
+gboolean
+gtd_manager_load_snapshot (GtdManager   *self,
+                           const gchar  *path,
+                           GError      **error)
+{
+  g_autoptr (GPtrArray) providers = NULL;
+  gint64 start;
+  guint i;
+
+  g_return_val_if_fail (GTD_IS_MANAGER (self), FALSE);
+  g_return_val_if_fail (path != NULL, FALSE);
+  g_return_val_if_fail (self->providers == NULL, FALSE);
+
+  GTD_ENTRY;
+
+  g_free (self->snapshot_path);
+  self->snapshot_path = g_strdup (path);
+
+  start = g_get_monotonic_time ();
+  providers = _gtd_snapshot_load (path, error);
+
+  if (!providers)
+    GTD_RETURN (FALSE);
+
+  for (i = 0; i < providers->len; i++)
+    {
+      g_autoptr (GList) lists = NULL;
+      GtdProvider *provider;
+      GList *l;
+
+      provider = g_ptr_array_index (providers, i);
+
+      g_hash_table_insert (self->placeholder_providers,
+                           g_strdup (gtd_provider_get_id (provider)),
+                           g_object_ref (provider));
+
+      lists = gtd_provider_get_task_lists (provider);
+
+      for (l = lists; l; l = l->next)
+        on_list_added_cb (provider, l->data, self);
+    }
+
+  self->startup_stats.mode = GTD_STARTUP_MODE_SNAPSHOT;
+  self->startup_stats.snapshot_load_us = g_get_monotonic_time () - start;
+
+  if (providers->len > 0)
+    {
+      self->drop_placeholders_timeout_id = g_timeout_add_seconds (DROP_PLACEHOLDERS_TIMEOUT,
+                                                                  drop_placeholders_timeout_cb,
+                                                                  self);
+    }
+  else
+    {
+      self->startup_stats.reconciled_us = g_get_monotonic_time () - self->init_time;
+    }
+
+  g_debug ("Snapshot with %u providers loaded in %.1lfms",
+           providers->len,
+           self->startup_stats.snapshot_load_us / 1000.0);
+
+  GTD_RETURN (TRUE);
+}
+
+/**
+ * gtd_manager_save_snapshot:
+ * @self: a #GtdManager
+ *
+ * Synchronously saves the snapshot to the path passed to
+ * gtd_manager_load_snapshot(). Nothing is saved while providers
+ * are still loading.
+ */
+void
+gtd_manager_save_snapshot (GtdManager *self)
+{
+  g_autoptr (GError) error = NULL;
+
+  g_return_if_fail (GTD_IS_MANAGER (self));
+
+  GTD_ENTRY;
+
+  if (!self->snapshot_path || !is_settled (self))
+    GTD_RETURN ();
+
+  g_clear_handle_id (&self->save_snapshot_timeout_id, g_source_remove);
+
+  if (!_gtd_snapshot_save (self->lists_model, self->snapshot_path, &error))
+    g_warning ("Error saving snapshot: %s", error->message);
+
+  GTD_EXIT;
+}
+
+/**
+ * gtd_manager_get_startup_stats:
+ * @self: a #GtdManager
+ * @out_stats: (out): return location for the startup stats
+ *
+ * Retrieves how @self started, and how long it took to reach
+ * each stage of the startup.
+ */
+void
+gtd_manager_get_startup_stats (GtdManager      *self,
+                               GtdStartupStats *out_stats)
+{
+  g_return_if_fail (GTD_IS_MANAGER (self));
+  g_return_if_fail (out_stats != NULL);
+
+  *out_stats = self->startup_stats;
+}
@@ -83,4 +83,6 @@ GListModel*          gtd_manager_get_inbox_model                 (GtdManager
 
 GListModel*          gtd_manager_get_providers_model             (GtdManager         *self);
 
+GtdDueDateIndex*     gtd_manager_get_due_date_index              (GtdManager         *self);
+
 G_END_DECLS
@@ -49,10 +49,180 @@ enum
 
 static guint signals[NUM_SIGNALS] = { 0, };
 
+typedef struct
+{
+  guint               n_pending;
+  GError             *error;
+} BatchData;
+
+
+/*
+ * Auxiliary methods
+ */
+
+static void
+batch_data_free (gpointer data)
+{
+  BatchData *batch_data = data;
+
+  g_clear_error (&batch_data->error);
+  g_free (batch_data);
+}
+
+static void
+complete_batch_operation (GTask  *task,
+                          GError *error)
+{
+  BatchData *data;
+
+  data = g_task_get_task_data (task);
+
+  /* Only report the first error */
+  if (error && !data->error)
+    data->error = g_error_copy (error);
+
+  if (--data->n_pending > 0)
+    return;
+
+  if (data->error)
+    g_task_return_error (task, g_steal_pointer (&data->error));
+  else
+    g_task_return_boolean (task, TRUE);
+}
+
+
+/*
+ * Callbacks
+ */
+
+static void
+on_fallback_task_updated_cb (GObject      *object,
+                             GAsyncResult *result,
+                             gpointer      user_data)
+{
+  g_autoptr (GTask) task = G_TASK (user_data);
+  g_autoptr (GError) error = NULL;
+
+  gtd_provider_update_task_finish (GTD_PROVIDER (object), result, &error);
+
+  complete_batch_operation (task, error);
+}
+
+static void
+on_fallback_task_removed_cb (GObject      *object,
+                             GAsyncResult *result,
+                             gpointer      user_data)
+{
+  g_autoptr (GTask) task = G_TASK (user_data);
+  g_autoptr (GError) error = NULL;
+
+  gtd_provider_remove_task_finish (GTD_PROVIDER (object), result, &error);
+
+  complete_batch_operation (task, error);
+}
+
+
+/*
+ * Default implementations
+ */
+
+static void
+gtd_provider_real_update_tasks (GtdProvider         *provider,
+                                GPtrArray           *tasks,
+                                GCancellable        *cancellable,
+                                GAsyncReadyCallback  callback,
+                                gpointer             user_data)
+{
+  g_autoptr (GTask) task = NULL;
+  BatchData *data;
+  guint i;
+
+  task = g_task_new (provider, cancellable, callback, user_data);
+  g_task_set_source_tag (task, gtd_provider_real_update_tasks);
+
+  if (tasks->len == 0)
+    {
+      g_task_return_boolean (task, TRUE);
+      return;
+    }
+
+  data = g_new0 (BatchData, 1);
+  data->n_pending = tasks->len;
+  g_task_set_task_data (task, data, batch_data_free);
+
+  for (i = 0; i < tasks->len; i++)
+    {
+      gtd_provider_update_task (provider,
+                                g_ptr_array_index (tasks, i),
+                                cancellable,
+                                on_fallback_task_updated_cb,
+                                g_object_ref (task));
+    }
+}
+
+static gboolean
+gtd_provider_real_update_tasks_finish (GtdProvider   *provider,
+                                       GAsyncResult  *result,
+                                       GError       **error)
+{
+  g_return_val_if_fail (g_task_is_valid (result, provider), FALSE);
+
+  return g_task_propagate_boolean (G_TASK (result), error);
+}
+
+static void
+gtd_provider_real_remove_tasks (GtdProvider         *provider,
+                                GPtrArray           *tasks,
+                                GCancellable        *cancellable,
+                                GAsyncReadyCallback  callback,
+                                gpointer             user_data)
+{
+  g_autoptr (GTask) task = NULL;
+  BatchData *data;
+  guint i;
+
+  task = g_task_new (provider, cancellable, callback, user_data);
+  g_task_set_source_tag (task, gtd_provider_real_remove_tasks);
+
+  if (tasks->len == 0)
+    {
+      g_task_return_boolean (task, TRUE);
+      return;
+    }
+
+  data = g_new0 (BatchData, 1);
+  data->n_pending = tasks->len;
+  g_task_set_task_data (task, data, batch_data_free);
+
+  for (i = 0; i < tasks->len; i++)
+    {
+      gtd_provider_remove_task (provider,
+                                g_ptr_array_index (tasks, i),
+                                cancellable,
+                                on_fallback_task_removed_cb,
+                                g_object_ref (task));
+    }
+}
+
+static gboolean
+gtd_provider_real_remove_tasks_finish (GtdProvider   *provider,
+                                       GAsyncResult  *result,
+                                       GError       **error)
+{
+  g_return_val_if_fail (g_task_is_valid (result, provider), FALSE);
+
+  return g_task_propagate_boolean (G_TASK (result), error);
+}
+
 
 static void
 gtd_provider_default_init (GtdProviderInterface *iface)
 {
+  iface->update_tasks = gtd_provider_real_update_tasks;
+  iface->update_tasks_finish = gtd_provider_real_update_tasks_finish;
+  iface->remove_tasks = gtd_provider_real_remove_tasks;
+  iface->remove_tasks_finish = gtd_provider_real_remove_tasks_finish;
+
   /**
    * GtdProvider::enabled:
    *
@@ -415,6 +585,60 @@ gtd_provider_update_task_finish (GtdProvider   *self,
   return GTD_PROVIDER_GET_IFACE (self)->update_task_finish (self, result, error);
 }
 
+/**
+ * gtd_provider_update_tasks:
+ * @provider: a #GtdProvider
+ * @tasks: (element-type GtdTask): the #GtdTasks to update
+ * @cancellable: (nullable): a #GCancellable
+ * @callback: (scope async): a callback
+ * @user_data: (closure): user data for @callback
+ *
+ * Updates all tasks in @tasks in a single operation. Providers
+ * that can save multiple tasks at once should implement this;
+ * otherwise, each task is updated with gtd_provider_update_task().
+ *
+ * All tasks in @tasks must belong to @provider.
+ */
+void
+gtd_provider_update_tasks (GtdProvider         *provider,
+                           GPtrArray           *tasks,
+                           GCancellable        *cancellable,
+                           GAsyncReadyCallback  callback,
+                           gpointer             user_data)
+{
+  g_return_if_fail (GTD_IS_PROVIDER (provider));
+  g_return_if_fail (tasks != NULL);
+  g_return_if_fail (GTD_PROVIDER_GET_IFACE (provider)->update_tasks);
+
+  GTD_PROVIDER_GET_IFACE (provider)->update_tasks (provider,
+                                                   tasks,
+                                                   cancellable,
+                                                   callback,
+                                                   user_data);
+}
+
+/**
+ * gtd_provider_update_tasks_finish:
+ * @self: a #GtdProvider
+ * @result: a #GAsyncResult
+ * @error: (direction out)(nullable): return location for a #GError
+ *
+ * Finishes updating the tasks.
+ *
+ * Returns: %TRUE if all tasks were successfully updated, %FALSE otherwise
+ */
+gboolean
+gtd_provider_update_tasks_finish (GtdProvider   *self,
+                                  GAsyncResult  *result,
+                                  GError       **error)
+{
+  g_return_val_if_fail (GTD_IS_PROVIDER (self), FALSE);
+  g_return_val_if_fail (!error || !*error, FALSE);
+  g_return_val_if_fail (GTD_PROVIDER_GET_IFACE (self)->update_tasks_finish, FALSE);
+
+  return GTD_PROVIDER_GET_IFACE (self)->update_tasks_finish (self, result, error);
+}
+
 /**
  * gtd_provider_remove_task:
  * @provider: a #GtdProvider
@@ -464,6 +688,61 @@ gtd_provider_remove_task_finish (GtdProvider   *self,
   return GTD_PROVIDER_GET_IFACE (self)->remove_task_finish (self, result, error);
 }
 
+/**
+ * gtd_provider_remove_tasks:
+ * @provider: a #GtdProvider
+ * @tasks: (element-type GtdTask): the #GtdTasks to remove
+ * @cancellable: (nullable): a #GCancellable
+ * @callback: (scope async): a callback
+ * @user_data: (closure): user data for @callback
+ *
+ * Removes all tasks in @tasks in a single operation. Providers
+ * that can remove multiple tasks at once should implement this;
+ * otherwise, each task is removed with gtd_provider_remove_task().
+ *
+ * Subtasks are not removed implicitly, and must be part of @tasks
+ * as well. All tasks in @tasks must belong to @provider.
+ */
+void
+gtd_provider_remove_tasks (GtdProvider         *provider,
+                           GPtrArray           *tasks,
+                           GCancellable        *cancellable,
+                           GAsyncReadyCallback  callback,
+                           gpointer             user_data)
+{
+  g_return_if_fail (GTD_IS_PROVIDER (provider));
+  g_return_if_fail (tasks != NULL);
+  g_return_if_fail (GTD_PROVIDER_GET_IFACE (provider)->remove_tasks);
+
+  GTD_PROVIDER_GET_IFACE (provider)->remove_tasks (provider,
+                                                   tasks,
+                                                   cancellable,
+                                                   callback,
+                                                   user_data);
+}
+
+/**
+ * gtd_provider_remove_tasks_finish:
+ * @self: a #GtdProvider
+ * @result: a #GAsyncResult
+ * @error: (direction out)(nullable): return location for a #GError
+ *
+ * Finishes removing the tasks.
+ *
+ * Returns: %TRUE if all tasks were successfully removed, %FALSE otherwise
+ */
+gboolean
+gtd_provider_remove_tasks_finish (GtdProvider   *self,
+                                  GAsyncResult  *result,
+                                  GError       **error)
+{
+  g_return_val_if_fail (GTD_IS_PROVIDER (self), FALSE);
+  g_return_val_if_fail (!error || !*error, FALSE);
+  g_return_val_if_fail (GTD_PROVIDER_GET_IFACE (self)->remove_tasks_finish, FALSE);
+
+  return GTD_PROVIDER_GET_IFACE (self)->remove_tasks_finish (self, result, error);
+}
+
 /**
  * gtd_provider_create_task_list:
  * @provider: a #GtdProvider
@@ -74,6 +74,16 @@ struct _GtdProviderInterface
                                                                   GAsyncResult       *result,
                                                                   GError            **error);
 
+  void               (*update_tasks)                             (GtdProvider        *provider,
+                                                                  GPtrArray          *tasks,
+                                                                  GCancellable       *cancellable,
+                                                                  GAsyncReadyCallback callback,
+                                                                  gpointer            user_data);
+
+  gboolean           (*update_tasks_finish)                      (GtdProvider        *self,
+                                                                  GAsyncResult       *result,
+                                                                  GError            **error);
+
   void               (*remove_task)                              (GtdProvider        *provider,
                                                                   GtdTask            *task,
                                                                   GCancellable       *cancellable,
@@ -84,6 +94,16 @@ struct _GtdProviderInterface
                                                                   GAsyncResult       *result,
                                                                   GError            **error);
 
+  void               (*remove_tasks)                             (GtdProvider        *provider,
+                                                                  GPtrArray          *tasks,
+                                                                  GCancellable       *cancellable,
+                                                                  GAsyncReadyCallback callback,
+                                                                  gpointer            user_data);
+
+  gboolean           (*remove_tasks_finish)                      (GtdProvider        *self,
+                                                                  GAsyncResult       *result,
+                                                                  GError            **error);
+
   /* Task lists */
   void               (*create_task_list)                         (GtdProvider        *provider,
                                                                   const gchar        *name,
@@ -156,6 +176,16 @@ gboolean             gtd_provider_update_task_finish             (GtdProvider
                                                                   GAsyncResult       *result,
                                                                   GError            **error);
 
+void                 gtd_provider_update_tasks                   (GtdProvider        *provider,
+                                                                  GPtrArray          *tasks,
+                                                                  GCancellable       *cancellable,
+                                                                  GAsyncReadyCallback callback,
+                                                                  gpointer            user_data);
+
+gboolean             gtd_provider_update_tasks_finish            (GtdProvider        *self,
+                                                                  GAsyncResult       *result,
+                                                                  GError            **error);
+
 void                 gtd_provider_remove_task                    (GtdProvider        *provider,
                                                                   GtdTask            *task,
                                                                   GCancellable       *cancellable,
@@ -166,6 +196,16 @@ gboolean             gtd_provider_remove_task_finish             (GtdProvider
                                                                   GAsyncResult       *result,
                                                                   GError            **error);
 
+void                 gtd_provider_remove_tasks                   (GtdProvider        *provider,
+                                                                  GPtrArray          *tasks,
+                                                                  GCancellable       *cancellable,
+                                                                  GAsyncReadyCallback callback,
+                                                                  gpointer            user_data);
+
+gboolean             gtd_provider_remove_tasks_finish            (GtdProvider        *self,
+                                                                  GAsyncResult       *result,
+                                                                  GError            **error);
+
 void                 gtd_provider_create_task_list               (GtdProvider        *provider,
                                                                   const gchar        *name,
                                                                   GCancellable       *cancellable,
@@ -0,0 +1,49 @@
+/* gtd-snapshot-private.h
+ *
+ * Copyright 2020 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "gtd-object.h"
+#include "gtd-types.h"
+
+#include <gio/gio.h>
+
+G_BEGIN_DECLS
+
+#define GTD_TYPE_SNAPSHOT_PROVIDER (gtd_snapshot_provider_get_type())
+
+G_DECLARE_FINAL_TYPE (GtdSnapshotProvider, gtd_snapshot_provider, GTD, SNAPSHOT_PROVIDER, GtdObject)
+
+GBytes*              _gtd_snapshot_serialize                     (GListModel          *lists);
+
+gboolean             _gtd_snapshot_save                          (GListModel          *lists,
+                                                                  const gchar         *path,
+                                                                  GError             **error);
+
+GPtrArray*           _gtd_snapshot_load                          (const gchar         *path,
+                                                                  GError             **error);
+
+GtdTaskList*         _gtd_snapshot_provider_lookup_list          (GtdSnapshotProvider *self,
+                                                                  const gchar         *uid);
+
+void                 _gtd_snapshot_provider_remove_list          (GtdSnapshotProvider *self,
+                                                                  GtdTaskList         *list);
+
+G_END_DECLS
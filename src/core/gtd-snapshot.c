@@ -0,0 +1,809 @@
+/* gtd-snapshot.c
+ *
+ * Copyright 2020 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "GtdSnapshot"
+
+#include "gtd-debug.h"
+#include "gtd-provider.h"
+#include "gtd-snapshot-private.h"
+#include "gtd-task.h"
+#include "gtd-task-list.h"
+
+#include <glib/gi18n.h>
+
+/*
+ * The snapshot is a single GVariant in native byte order, so that it can
+ * be mapped from disk and read in place. Tasks are stored flat, in list
+ * order, with the uid of their parent task.
+ *
+ *  - Task: uid, parent uid, title, description, complete, important,
+ *    position, due date and creation date. Dates are stored with their
+ *    UTC offset, since the panels compare their calendar fields.
+ *  - List: uid, name, color, archived and tasks
+ *  - Provider: id, name, description, type, icon, inbox uid and lists
+ */
+#define SNAPSHOT_VERSION 2
+
+#define TASK_FORMAT     "(ssssbbxm(xi)m(xi))"
+#define LIST_FORMAT     "(sssba" TASK_FORMAT ")"
+#define PROVIDER_FORMAT "(ssssmvsa" LIST_FORMAT ")"
+#define SNAPSHOT_FORMAT "(ua" PROVIDER_FORMAT ")"
+
+struct _GtdSnapshotProvider
+{
+  GtdObject           parent;
+
+  gchar              *id;
+  gchar              *name;
+  gchar              *description;
+  gchar              *provider_type;
+  GIcon              *icon;
+
+  GtdTaskList        *inbox;
+  GHashTable         *lists;
+};
+
+static void          gtd_provider_iface_init                     (GtdProviderInterface *iface);
+
+G_DEFINE_TYPE_WITH_CODE (GtdSnapshotProvider, gtd_snapshot_provider, GTD_TYPE_OBJECT,
+                         G_IMPLEMENT_INTERFACE (GTD_TYPE_PROVIDER, gtd_provider_iface_init))
+
+enum
+{
+  PROP_0,
+  PROP_DESCRIPTION,
+  PROP_ENABLED,
+  PROP_ICON,
+  PROP_ID,
+  PROP_NAME,
+  PROP_PROVIDER_TYPE,
+  N_PROPS
+};
+
+
+/*
+ * Auxiliary methods
+ */
+
+static inline const gchar*
+non_null (const gchar *str)
+{
+  return str ? str : "";
+}
+
+static const gchar*
+get_uid (gpointer object)
+{
+  return non_null (gtd_object_get_uid (GTD_OBJECT (object)));
+}
+
+static GDateTime*
+date_from_unix_and_offset (gint64 unix_time,
+                           gint32 utc_offset)
+{
+  g_autoptr (GDateTime) utc = NULL;
+  g_autoptr (GTimeZone) tz = NULL;
+
+  utc = g_date_time_new_from_unix_utc (unix_time);
+  tz = g_time_zone_new_offset (utc_offset);
+
+  return g_date_time_to_timezone (utc, tz);
+}
+
+static void
+add_task (GVariantBuilder *builder,
+          GtdTask         *task)
+{
+  g_autoptr (GDateTime) creation_date = NULL;
+  g_autoptr (GDateTime) due_date = NULL;
+  GtdTask *parent;
+
+  creation_date = gtd_task_get_creation_date (task);
+  due_date = gtd_task_get_due_date (task);
+  parent = gtd_task_get_parent (task);
+
+  g_variant_builder_add (builder,
+                         TASK_FORMAT,
+                         get_uid (task),
+                         parent ? get_uid (parent) : "",
+                         non_null (gtd_task_get_title (task)),
+                         non_null (gtd_task_get_description (task)),
+                         gtd_task_get_complete (task),
+                         gtd_task_get_important (task),
+                         gtd_task_get_position (task),
+                         due_date != NULL,
+                         due_date ? g_date_time_to_unix (due_date) : 0,
+                         due_date ? (gint32) (g_date_time_get_utc_offset (due_date) / G_TIME_SPAN_SECOND) : 0,
+                         creation_date != NULL,
+                         creation_date ? g_date_time_to_unix (creation_date) : 0,
+                         creation_date ? (gint32) (g_date_time_get_utc_offset (creation_date) / G_TIME_SPAN_SECOND) : 0);
+}
+
+static void
+add_list (GVariantBuilder *builder,
+          GtdTaskList     *list)
+{
+  g_autofree gchar *color_str = NULL;
+  g_autoptr (GdkRGBA) color = NULL;
+  GVariantBuilder tasks_builder;
+  GListModel *model;
+  guint i;
+
+  model = G_LIST_MODEL (list);
+  color = gtd_task_list_get_color (list);
+  color_str = gdk_rgba_to_string (color);
+
+  g_variant_builder_init (&tasks_builder, G_VARIANT_TYPE ("a" TASK_FORMAT));
+
+  for (i = 0; i < g_list_model_get_n_items (model); i++)
+    {
+      g_autoptr (GtdTask) task = g_list_model_get_item (model, i);
+
+      add_task (&tasks_builder, task);
+    }
+
+  g_variant_builder_add (builder,
+                         LIST_FORMAT,
+                         get_uid (list),
+                         non_null (gtd_task_list_get_name (list)),
+                         color_str,
+                         gtd_task_list_get_archived (list),
+                         &tasks_builder);
+}
+
+static void
+add_provider (GVariantBuilder *builder,
+              GtdProvider     *provider,
+              GVariantBuilder *lists_builder)
+{
+  g_autoptr (GVariant) icon = NULL;
+  GtdTaskList *inbox;
+
+  inbox = gtd_provider_get_inbox (provider);
+
+  if (gtd_provider_get_icon (provider))
+    icon = g_icon_serialize (gtd_provider_get_icon (provider));
+
+  g_variant_builder_add (builder,
+                         PROVIDER_FORMAT,
+                         non_null (gtd_provider_get_id (provider)),
+                         non_null (gtd_provider_get_name (provider)),
+                         non_null (gtd_provider_get_description (provider)),
+                         non_null (gtd_provider_get_provider_type (provider)),
+                         icon,
+                         inbox ? get_uid (inbox) : "",
+                         lists_builder);
+}
+
+static GtdTaskList*
+create_list (GtdSnapshotProvider *self,
+             GVariant            *variant)
+{
+  g_autoptr (GVariant) tasks_variant = NULL;
+  g_autoptr (GHashTable) uid_to_task = NULL;
+  g_autoptr (GPtrArray) parent_uids = NULL;
+  g_autoptr (GPtrArray) tasks = NULL;
+  const gchar *color_str;
+  const gchar *name;
+  const gchar *uid;
+  GtdTaskList *list;
+  gboolean archived;
+  GdkRGBA color;
+  gsize n_tasks;
+  gsize i;
+
+  g_variant_get (variant, "(&s&s&sb@a" TASK_FORMAT ")", &uid, &name, &color_str, &archived, &tasks_variant);
+
+  list = gtd_task_list_new (GTD_PROVIDER (self));
+  gtd_object_set_uid (GTD_OBJECT (list), uid);
+  gtd_task_list_set_name (list, name);
+  gtd_task_list_set_archived (list, archived);
+
+  if (gdk_rgba_parse (&color, color_str))
+    gtd_task_list_set_color (list, &color);
+
+  n_tasks = g_variant_n_children (tasks_variant);
+  tasks = g_ptr_array_new_full (n_tasks, g_object_unref);
+  parent_uids = g_ptr_array_sized_new (n_tasks);
+  uid_to_task = g_hash_table_new (g_str_hash, g_str_equal);
+
+  for (i = 0; i < n_tasks; i++)
+    {
+      const gchar *description;
+      const gchar *parent_uid;
+      const gchar *task_uid;
+      const gchar *title;
+      gboolean has_creation_date;
+      gboolean has_due_date;
+      gboolean important;
+      gboolean complete;
+      gint64 creation_date;
+      gint64 due_date;
+      gint32 creation_date_offset;
+      gint32 due_date_offset;
+      gint64 position;
+      GtdTask *task;
+
+      g_variant_get_child (tasks_variant,
+                           i,
+                           "(&s&s&s&sbbxm(xi)m(xi))",
+                           &task_uid,
+                           &parent_uid,
+                           &title,
+                           &description,
+                           &complete,
+                           &important,
+                           &position,
+                           &has_due_date,
+                           &due_date,
+                           &due_date_offset,
+                           &has_creation_date,
+                           &creation_date,
+                           &creation_date_offset);
+
+      task = gtd_task_new ();
+      gtd_object_set_uid (GTD_OBJECT (task), task_uid);
+      gtd_task_set_list (task, list);
+      gtd_task_set_title (task, title);
+      gtd_task_set_description (task, description);
+      gtd_task_set_complete (task, complete);
+      gtd_task_set_important (task, important);
+      gtd_task_set_position (task, position);
+
+      if (has_due_date)
+        {
+          g_autoptr (GDateTime) dt = date_from_unix_and_offset (due_date, due_date_offset);
+          gtd_task_set_due_date (task, dt);
+        }
+
+      if (has_creation_date)
+        {
+          g_autoptr (GDateTime) dt = date_from_unix_and_offset (creation_date, creation_date_offset);
+          gtd_task_set_creation_date (task, dt);
+        }
+
+      /* Placeholders are read-only, so edits are never saved */
+      gtd_object_push_loading (GTD_OBJECT (task));
+
+      g_hash_table_insert (uid_to_task, (gpointer) task_uid, task);
+      g_ptr_array_add (parent_uids, (gpointer) parent_uid);
+      g_ptr_array_add (tasks, task);
+    }
+
+  /* Rebuild the hierarchy once all tasks exist */
+  for (i = 0; i < n_tasks; i++)
+    {
+      const gchar *parent_uid;
+      GtdTask *parent;
+
+      parent_uid = g_ptr_array_index (parent_uids, i);
+
+      if (!*parent_uid)
+        continue;
+
+      parent = g_hash_table_lookup (uid_to_task, parent_uid);
+
+      if (parent)
+        gtd_task_add_subtask (parent, g_ptr_array_index (tasks, i));
+    }
+
+  gtd_task_list_add_tasks (list, tasks);
+
+  return list;
+}
+
+static GtdSnapshotProvider*
+create_provider (GVariant *variant)
+{
+  g_autoptr (GVariant) lists = NULL;
+  g_autoptr (GVariant) icon = NULL;
+  GtdSnapshotProvider *self;
+  const gchar *inbox_uid;
+  gsize i;
+
+  self = g_object_new (GTD_TYPE_SNAPSHOT_PROVIDER, NULL);
+
+  g_variant_get (variant,
+                 "(ssssmv&s@a" LIST_FORMAT ")",
+                 &self->id,
+                 &self->name,
+                 &self->description,
+                 &self->provider_type,
+                 &icon,
+                 &inbox_uid,
+                 &lists);
+
+  if (icon)
+    self->icon = g_icon_deserialize (icon);
+
+  for (i = 0; i < g_variant_n_children (lists); i++)
+    {
+      g_autoptr (GVariant) list_variant = NULL;
+      GtdTaskList *list;
+
+      list_variant = g_variant_get_child_value (lists, i);
+      list = create_list (self, list_variant);
+
+      g_hash_table_insert (self->lists, g_strdup (get_uid (list)), list);
+
+      if (*inbox_uid && g_strcmp0 (get_uid (list), inbox_uid) == 0)
+        self->inbox = list;
+    }
+
+  return self;
+}
+
+static void
+report_read_only_error (GtdProvider         *provider,
+                        GAsyncReadyCallback  callback,
+                        gpointer             user_data,
+                        gpointer             source_tag)
+{
+  g_task_report_new_error (provider,
+                           callback,
+                           user_data,
+                           source_tag,
+                           G_IO_ERROR,
+                           G_IO_ERROR_READ_ONLY,
+                           _("Tasks are still loading"));
+}
+
+
+/*
+ * GtdProvider iface
+ */
+
+static const gchar*
+gtd_snapshot_provider_get_id (GtdProvider *provider)
+{
+  return GTD_SNAPSHOT_PROVIDER (provider)->id;
+}
+
+static const gchar*
+gtd_snapshot_provider_get_name (GtdProvider *provider)
+{
+  return GTD_SNAPSHOT_PROVIDER (provider)->name;
+}
+
+static const gchar*
+gtd_snapshot_provider_get_provider_type (GtdProvider *provider)
+{
+  return GTD_SNAPSHOT_PROVIDER (provider)->provider_type;
+}
+
+static const gchar*
+gtd_snapshot_provider_get_description (GtdProvider *provider)
+{
+  return GTD_SNAPSHOT_PROVIDER (provider)->description;
+}
+
+static gboolean
+gtd_snapshot_provider_get_enabled (GtdProvider *provider)
+{
+  return TRUE;
+}
+
+static GIcon*
+gtd_snapshot_provider_get_icon (GtdProvider *provider)
+{
+  return GTD_SNAPSHOT_PROVIDER (provider)->icon;
+}
+
+static void
+gtd_snapshot_provider_create_task (GtdProvider         *provider,
+                                   GtdTaskList         *list,
+                                   const gchar         *title,
+                                   GDateTime           *due_date,
+                                   GCancellable        *cancellable,
+                                   GAsyncReadyCallback  callback,
+                                   gpointer             user_data)
+{
+  report_read_only_error (provider, callback, user_data, gtd_snapshot_provider_create_task);
+}
+
+static GtdTask*
+gtd_snapshot_provider_create_task_finish (GtdProvider   *provider,
+                                          GAsyncResult  *result,
+                                          GError       **error)
+{
+  return g_task_propagate_pointer (G_TASK (result), error);
+}
+
+static void
+gtd_snapshot_provider_update_task (GtdProvider         *provider,
+                                   GtdTask             *task,
+                                   GCancellable        *cancellable,
+                                   GAsyncReadyCallback  callback,
+                                   gpointer             user_data)
+{
+  report_read_only_error (provider, callback, user_data, gtd_snapshot_provider_update_task);
+}
+
+static void
+gtd_snapshot_provider_remove_task (GtdProvider         *provider,
+                                   GtdTask             *task,
+                                   GCancellable        *cancellable,
+                                   GAsyncReadyCallback  callback,
+                                   gpointer             user_data)
+{
+  report_read_only_error (provider, callback, user_data, gtd_snapshot_provider_remove_task);
+}
+
+static void
+gtd_snapshot_provider_create_task_list (GtdProvider         *provider,
+                                        const gchar         *name,
+                                        GCancellable        *cancellable,
+                                        GAsyncReadyCallback  callback,
+                                        gpointer             user_data)
+{
+  report_read_only_error (provider, callback, user_data, gtd_snapshot_provider_create_task_list);
+}
+
+static void
+gtd_snapshot_provider_update_task_list (GtdProvider         *provider,
+                                        GtdTaskList         *list,
+                                        GCancellable        *cancellable,
+                                        GAsyncReadyCallback  callback,
+                                        gpointer             user_data)
+{
+  report_read_only_error (provider, callback, user_data, gtd_snapshot_provider_update_task_list);
+}
+
+static void
+gtd_snapshot_provider_remove_task_list (GtdProvider         *provider,
+                                        GtdTaskList         *list,
+                                        GCancellable        *cancellable,
+                                        GAsyncReadyCallback  callback,
+                                        gpointer             user_data)
+{
+  report_read_only_error (provider, callback, user_data, gtd_snapshot_provider_remove_task_list);
+}
+
+static gboolean
+gtd_snapshot_provider_finish (GtdProvider   *provider,
+                              GAsyncResult  *result,
+                              GError       **error)
+{
+  return g_task_propagate_boolean (G_TASK (result), error);
+}
+
+static GList*
+gtd_snapshot_provider_get_task_lists (GtdProvider *provider)
+{
+  GtdSnapshotProvider *self = GTD_SNAPSHOT_PROVIDER (provider);
+
+  return g_hash_table_get_values (self->lists);
+}
+
+static GtdTaskList*
+gtd_snapshot_provider_get_inbox (GtdProvider *provider)
+{
+  return GTD_SNAPSHOT_PROVIDER (provider)->inbox;
+}
+
+static void
+gtd_provider_iface_init (GtdProviderInterface *iface)
+{
+  iface->get_id = gtd_snapshot_provider_get_id;
+  iface->get_name = gtd_snapshot_provider_get_name;
+  iface->get_provider_type = gtd_snapshot_provider_get_provider_type;
+  iface->get_description = gtd_snapshot_provider_get_description;
+  iface->get_enabled = gtd_snapshot_provider_get_enabled;
+  iface->get_icon = gtd_snapshot_provider_get_icon;
+  iface->create_task = gtd_snapshot_provider_create_task;
+  iface->create_task_finish = gtd_snapshot_provider_create_task_finish;
+  iface->update_task = gtd_snapshot_provider_update_task;
+  iface->update_task_finish = gtd_snapshot_provider_finish;
+  iface->remove_task = gtd_snapshot_provider_remove_task;
+  iface->remove_task_finish = gtd_snapshot_provider_finish;
+  iface->create_task_list = gtd_snapshot_provider_create_task_list;
+  iface->create_task_list_finish = gtd_snapshot_provider_finish;
+  iface->update_task_list = gtd_snapshot_provider_update_task_list;
+  iface->update_task_list_finish = gtd_snapshot_provider_finish;
+  iface->remove_task_list = gtd_snapshot_provider_remove_task_list;
+  iface->remove_task_list_finish = gtd_snapshot_provider_finish;
+  iface->get_task_lists = gtd_snapshot_provider_get_task_lists;
+  iface->get_inbox = gtd_snapshot_provider_get_inbox;
+}
+
+
+/*
+ * GObject overrides
+ */
+
+static void
+gtd_snapshot_provider_finalize (GObject *object)
+{
+  GtdSnapshotProvider *self = (GtdSnapshotProvider *)object;
+
+  g_clear_pointer (&self->id, g_free);
+  g_clear_pointer (&self->name, g_free);
+  g_clear_pointer (&self->description, g_free);
+  g_clear_pointer (&self->provider_type, g_free);
+  g_clear_pointer (&self->lists, g_hash_table_destroy);
+  g_clear_object (&self->icon);
+
+  G_OBJECT_CLASS (gtd_snapshot_provider_parent_class)->finalize (object);
+}
+
+static void
+gtd_snapshot_provider_get_property (GObject    *object,
+                                    guint       prop_id,
+                                    GValue     *value,
+                                    GParamSpec *pspec)
+{
+  GtdProvider *provider = GTD_PROVIDER (object);
+
+  switch (prop_id)
+    {
+    case PROP_DESCRIPTION:
+      g_value_set_string (value, gtd_snapshot_provider_get_description (provider));
+      break;
+
+    case PROP_ENABLED:
+      g_value_set_boolean (value, gtd_snapshot_provider_get_enabled (provider));
+      break;
+
+    case PROP_ICON:
+      g_value_set_object (value, gtd_snapshot_provider_get_icon (provider));
+      break;
+
+    case PROP_ID:
+      g_value_set_string (value, gtd_snapshot_provider_get_id (provider));
+      break;
+
+    case PROP_NAME:
+      g_value_set_string (value, gtd_snapshot_provider_get_name (provider));
+      break;
+
+    case PROP_PROVIDER_TYPE:
+      g_value_set_string (value, gtd_snapshot_provider_get_provider_type (provider));
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+    }
+}
+
+static void
+gtd_snapshot_provider_set_property (GObject      *object,
+                                    guint         prop_id,
+                                    const GValue *value,
+                                    GParamSpec   *pspec)
+{
+  G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+}
+
+static void
+gtd_snapshot_provider_class_init (GtdSnapshotProviderClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->finalize = gtd_snapshot_provider_finalize;
+  object_class->get_property = gtd_snapshot_provider_get_property;
+  object_class->set_property = gtd_snapshot_provider_set_property;
+
+  g_object_class_override_property (object_class, PROP_DESCRIPTION, "description");
+  g_object_class_override_property (object_class, PROP_ENABLED, "enabled");
+  g_object_class_override_property (object_class, PROP_ICON, "icon");
+  g_object_class_override_property (object_class, PROP_ID, "id");
+  g_object_class_override_property (object_class, PROP_NAME, "name");
+  g_object_class_override_property (object_class, PROP_PROVIDER_TYPE, "provider-type");
+}
+
+static void
+gtd_snapshot_provider_init (GtdSnapshotProvider *self)
+{
+  self->lists = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_object_unref);
+}
+
+/**
+ * _gtd_snapshot_serialize:
+ * @lists: (element-type GtdTaskList): the task lists to store
+ *
+ * Serializes @lists, their tasks and their providers. Lists that
+ * are themselves placeholders from a snapshot are skipped.
+ *
+ * Returns: (transfer full): the snapshot data
+ */
+GBytes*
+_gtd_snapshot_serialize (GListModel *lists)
+{
+  g_autoptr (GHashTable) provider_to_lists = NULL;
+  g_autoptr (GPtrArray) providers = NULL;
+  g_autoptr (GVariant) snapshot = NULL;
+  GVariantBuilder providers_builder;
+  guint i;
+
+  GTD_ENTRY;
+
+  providers = g_ptr_array_new ();
+  provider_to_lists = g_hash_table_new_full (g_direct_hash,
+                                             g_direct_equal,
+                                             NULL,
+                                             (GDestroyNotify) g_variant_builder_unref);
+
+  /* Group the lists by provider, keeping the order of the providers */
+  for (i = 0; i < g_list_model_get_n_items (lists); i++)
+    {
+      g_autoptr (GtdTaskList) list = g_list_model_get_item (lists, i);
+      GVariantBuilder *lists_builder;
+      GtdProvider *provider;
+
+      provider = gtd_task_list_get_provider (list);
+
+      if (GTD_IS_SNAPSHOT_PROVIDER (provider))
+        continue;
+
+      lists_builder = g_hash_table_lookup (provider_to_lists, provider);
+
+      if (!lists_builder)
+        {
+          lists_builder = g_variant_builder_new (G_VARIANT_TYPE ("a" LIST_FORMAT));
+          g_hash_table_insert (provider_to_lists, provider, lists_builder);
+          g_ptr_array_add (providers, provider);
+        }
+
+      add_list (lists_builder, list);
+    }
+
+  g_variant_builder_init (&providers_builder, G_VARIANT_TYPE ("a" PROVIDER_FORMAT));
+
+  for (i = 0; i < providers->len; i++)
+    {
+      GtdProvider *provider = g_ptr_array_index (providers, i);
+
+      add_provider (&providers_builder, provider, g_hash_table_lookup (provider_to_lists, provider));
+    }
+
+  snapshot = g_variant_ref_sink (g_variant_new (SNAPSHOT_FORMAT, SNAPSHOT_VERSION, &providers_builder));
+
+  GTD_RETURN (g_variant_get_data_as_bytes (snapshot));
+}
+
+/**
+ * _gtd_snapshot_save:
+ * @lists: (element-type GtdTaskList): the task lists to store
+ * @path: where to save the snapshot
+ * @error: return location for a #GError
+ *
+ * Serializes @lists with _gtd_snapshot_serialize(), and atomically
+ * replaces the contents of @path with it.
+ *
+ * Returns: %TRUE on success, %FALSE otherwise
+ */
+gboolean
+_gtd_snapshot_save (GListModel   *lists,
+                    const gchar  *path,
+                    GError      **error)
+{
+  g_autofree gchar *dirname = NULL;
+  g_autoptr (GBytes) bytes = NULL;
+  gconstpointer data;
+  gsize size;
+
+  bytes = _gtd_snapshot_serialize (lists);
+  data = g_bytes_get_data (bytes, &size);
+
+  dirname = g_path_get_dirname (path);
+  g_mkdir_with_parents (dirname, 0700);
+
+  return g_file_set_contents (path, data, size, error);
+}
+
+/**
+ * _gtd_snapshot_load:
+ * @path: the path of a snapshot
+ * @error: return location for a #GError
+ *
+ * Maps the snapshot at @path, and creates a read-only placeholder
+ * provider for each provider in it. The lists of the placeholders
+ * are populated with their tasks, which are marked as loading.
+ *
+ * Returns: (transfer full)(element-type GtdSnapshotProvider)(nullable): the
+ * placeholder providers, or %NULL on error
+ */
+GPtrArray*
+_gtd_snapshot_load (const gchar  *path,
+                    GError      **error)
+{
+  g_autoptr (GMappedFile) mapped_file = NULL;
+  g_autoptr (GVariant) providers = NULL;
+  g_autoptr (GVariant) snapshot = NULL;
+  g_autoptr (GBytes) bytes = NULL;
+  GPtrArray *result;
+  guint32 version;
+  gsize i;
+
+  GTD_ENTRY;
+
+  mapped_file = g_mapped_file_new (path, FALSE, error);
+
+  if (!mapped_file)
+    GTD_RETURN (NULL);
+
+  /* Untrusted data is validated lazily, as it's accessed */
+  bytes = g_mapped_file_get_bytes (mapped_file);
+  snapshot = g_variant_ref_sink (g_variant_new_from_bytes (G_VARIANT_TYPE (SNAPSHOT_FORMAT), bytes, FALSE));
+
+  g_variant_get_child (snapshot, 0, "u", &version);
+
+  if (version != SNAPSHOT_VERSION)
+    {
+      g_set_error (error,
+                   G_IO_ERROR,
+                   G_IO_ERROR_INVALID_DATA,
+                   "Unsupported snapshot version %u",
+                   version);
+      GTD_RETURN (NULL);
+    }
+
+  providers = g_variant_get_child_value (snapshot, 1);
+  result = g_ptr_array_new_with_free_func (g_object_unref);
+
+  for (i = 0; i < g_variant_n_children (providers); i++)
+    {
+      g_autoptr (GVariant) provider = g_variant_get_child_value (providers, i);
+
+      g_ptr_array_add (result, create_provider (provider));
+    }
+
+  GTD_RETURN (result);
+}
+
+/**
+ * _gtd_snapshot_provider_lookup_list:
+ * @self: a #GtdSnapshotProvider
+ * @uid: the uid of a task list
+ *
+ * Retrieves the placeholder list with @uid, if it still exists.
+ *
+ * Returns: (transfer none)(nullable): a #GtdTaskList
+ */
+GtdTaskList*
+_gtd_snapshot_provider_lookup_list (GtdSnapshotProvider *self,
+                                    const gchar         *uid)
+{
+  g_return_val_if_fail (GTD_IS_SNAPSHOT_PROVIDER (self), NULL);
+
+  if (!uid)
+    return NULL;
+
+  return g_hash_table_lookup (self->lists, uid);
+}
+
+/**
+ * _gtd_snapshot_provider_remove_list:
+ * @self: a #GtdSnapshotProvider
+ * @list: a placeholder #GtdTaskList of @self
+ *
+ * Drops @list from @self, once it was replaced by the real list.
+ */
+void
+_gtd_snapshot_provider_remove_list (GtdSnapshotProvider *self,
+                                    GtdTaskList         *list)
+{
+  g_return_if_fail (GTD_IS_SNAPSHOT_PROVIDER (self));
+
+  if (self->inbox == list)
+    self->inbox = NULL;
+
+  g_hash_table_remove (self->lists, get_uid (list));
+}
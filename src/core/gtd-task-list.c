@@ -22,6 +22,7 @@
 #include "gtd-provider.h"
 #include "gtd-task.h"
 #include "gtd-task-list.h"
+#include "gtd-task-list-private.h"
 
 #include <glib/gi18n.h>
 
@@ -39,8 +40,18 @@
  * is only valid when associated with a #GtdProvider.
  *
  * It implements #GListModel, and can be used as the model for #GtkListBox.
+ *
+ * The number of completed, overdue and due today tasks is kept up to date
+ * as tasks change, and is available as properties, e.g. #GtdTaskList:n-completed.
  */
 
+typedef enum
+{
+  TASK_COMPLETE  = 1 << 0,
+  TASK_OVERDUE   = 1 << 1,
+  TASK_DUE_TODAY = 1 << 2,
+} TaskFlags;
+
 typedef struct
 {
   GtdProvider         *provider;
@@ -51,7 +62,16 @@ typedef struct
   GSequence           *sorted_tasks;
   guint                n_tasks;
 
+  /* Counters */
+  GHashTable          *task_flags;
+  gint                 today;
+  guint                n_completed;
+  guint                n_overdue;
+  guint                n_due_today;
+
   guint                freeze_counter;
+  GPtrArray           *frozen_tasks;
+  GHashTable          *frozen_updated_tasks;
 
   gchar               *name;
   gboolean             removable;
@@ -88,6 +108,10 @@ enum
   PROP_ARCHIVED,
   PROP_COLOR,
   PROP_IS_REMOVABLE,
+  PROP_N_COMPLETED,
+  PROP_N_DUE_TODAY,
+  PROP_N_OVERDUE,
+  PROP_N_TASKS,
   PROP_NAME,
   PROP_PROVIDER,
   N_PROPS
@@ -101,6 +125,106 @@ static GParamSpec *properties[N_PROPS] = { NULL, };
  * Auxiliary functions
  */
 
+static gint
+get_julian_day (GDateTime *dt)
+{
+  GDate date;
+
+  g_date_clear (&date, 1);
+  g_date_set_dmy (&date,
+                  g_date_time_get_day_of_month (dt),
+                  g_date_time_get_month (dt),
+                  g_date_time_get_year (dt));
+
+  return g_date_get_julian (&date);
+}
+
+static gint
+get_today (void)
+{
+  g_autoptr (GDateTime) now = NULL;
+
+  now = g_date_time_new_now_local ();
+
+  return get_julian_day (now);
+}
+
+static TaskFlags
+get_task_flags (GtdTaskList *self,
+                GtdTask     *task)
+{
+  g_autoptr (GDateTime) due_date = NULL;
+  GtdTaskListPrivate *priv;
+  gint day;
+
+  priv = gtd_task_list_get_instance_private (self);
+
+  if (gtd_task_get_complete (task))
+    return TASK_COMPLETE;
+
+  due_date = gtd_task_get_due_date (task);
+
+  if (!due_date)
+    return 0;
+
+  day = get_julian_day (due_date);
+
+  if (day < priv->today)
+    return TASK_OVERDUE;
+  else if (day == priv->today)
+    return TASK_DUE_TODAY;
+  else
+    return 0;
+}
+
+static void
+count_task_flags (GtdTaskList *self,
+                  TaskFlags    flags,
+                  gint         delta)
+{
+  GtdTaskListPrivate *priv = gtd_task_list_get_instance_private (self);
+
+  if (flags & TASK_COMPLETE)
+    {
+      priv->n_completed += delta;
+      g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_N_COMPLETED]);
+    }
+
+  if (flags & TASK_OVERDUE)
+    {
+      priv->n_overdue += delta;
+      g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_N_OVERDUE]);
+    }
+
+  if (flags & TASK_DUE_TODAY)
+    {
+      priv->n_due_today += delta;
+      g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_N_DUE_TODAY]);
+    }
+}
+
+static void
+update_task_flags (GtdTaskList *self,
+                   GtdTask     *task)
+{
+  GtdTaskListPrivate *priv;
+  TaskFlags old_flags;
+  TaskFlags new_flags;
+
+  priv = gtd_task_list_get_instance_private (self);
+
+  old_flags = GPOINTER_TO_UINT (g_hash_table_lookup (priv->task_flags, task));
+  new_flags = get_task_flags (self, task);
+
+  if (old_flags == new_flags)
+    return;
+
+  g_hash_table_insert (priv->task_flags, task, GUINT_TO_POINTER (new_flags));
+
+  count_task_flags (self, old_flags, -1);
+  count_task_flags (self, new_flags, 1);
+}
+
 static void
 update_task_uid (GtdTaskList *self,
                  GtdTask     *task)
@@ -127,9 +251,10 @@ update_task_uid (GtdTaskList *self,
   g_hash_table_insert (priv->tasks, new_uid, iter);
 }
 
-static guint
-add_task (GtdTaskList *self,
-          GtdTask     *task)
+static GSequenceIter*
+insert_task (GtdTaskList *self,
+             GtdTask     *task,
+             gboolean     sorted)
 {
   GtdTaskListPrivate *priv;
   GSequenceIter *iter;
@@ -138,10 +263,11 @@ add_task (GtdTaskList *self,
   priv = gtd_task_list_get_instance_private (self);
 
   uid = g_strdup (gtd_object_get_uid (GTD_OBJECT (task)));
-  iter = g_sequence_insert_sorted (priv->sorted_tasks,
-                                   g_object_ref (task),
-                                   compare_tasks_cb,
-                                   NULL);
+
+  if (sorted)
+    iter = g_sequence_insert_sorted (priv->sorted_tasks, g_object_ref (task), compare_tasks_cb, NULL);
+  else
+    iter = g_sequence_append (priv->sorted_tasks, g_object_ref (task));
 
   g_hash_table_insert (priv->task_to_uid, task, uid);
   g_hash_table_insert (priv->tasks, uid, iter);
@@ -149,15 +275,68 @@ add_task (GtdTaskList *self,
   g_signal_connect (task, "notify", G_CALLBACK (task_changed_cb), self);
 
   priv->n_tasks++;
+  g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_N_TASKS]);
+
+  update_task_flags (self, task);
 
-  g_signal_emit (self, signals[TASK_ADDED], 0, task);
+  return iter;
+}
+
+static guint
+add_task (GtdTaskList *self,
+          GtdTask     *task,
+          GPtrArray   *added_tasks)
+{
+  GSequenceIter *iter;
+
+  iter = insert_task (self, task, TRUE);
+  g_ptr_array_add (added_tasks, task);
 
   return g_sequence_iter_get_position (iter);
 }
 
+/*
+ * ::task-added is only emitted once the tasks were announced with
+ * items-changed, so that handlers see a consistent model.
+ */
+static void
+emit_tasks_added (GtdTaskList *self,
+                  GPtrArray   *added_tasks)
+{
+  guint i;
+
+  for (i = 0; i < added_tasks->len; i++)
+    g_signal_emit (self, signals[TASK_ADDED], 0, g_ptr_array_index (added_tasks, i));
+}
+
+static void
+append_task_and_subtasks (GtdTaskList *self,
+                          GtdTask     *task,
+                          GPtrArray   *added_tasks)
+{
+  GtdTaskListPrivate *priv;
+  GtdTask *aux;
+
+  priv = gtd_task_list_get_instance_private (self);
+
+  if (g_hash_table_contains (priv->task_to_uid, task))
+    return;
+
+  insert_task (self, task, FALSE);
+  g_ptr_array_add (added_tasks, task);
+
+  for (aux = gtd_task_get_first_subtask (task);
+       aux;
+       aux = gtd_task_get_next_sibling (aux))
+    {
+      append_task_and_subtasks (self, aux, added_tasks);
+    }
+}
+
 static void
 recursively_add_subtasks (GtdTaskList *self,
-                          GtdTask     *task)
+                          GtdTask     *task,
+                          GPtrArray   *added_tasks)
 {
   GtdTask *aux;
 
@@ -165,9 +344,9 @@ recursively_add_subtasks (GtdTaskList *self,
        aux;
        aux = gtd_task_get_next_sibling (aux))
     {
-      add_task (self, aux);
+      add_task (self, aux, added_tasks);
 
-      recursively_add_subtasks (self, aux);
+      recursively_add_subtasks (self, aux, added_tasks);
     }
 }
 
@@ -194,6 +373,13 @@ remove_task (GtdTaskList *self,
   g_sequence_remove (iter);
 
   priv->n_tasks--;
+  g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_N_TASKS]);
+
+  count_task_flags (self, GPOINTER_TO_UINT (g_hash_table_lookup (priv->task_flags, task)), -1);
+  g_hash_table_remove (priv->task_flags, task);
+
+  if (priv->frozen_updated_tasks)
+    g_hash_table_remove (priv->frozen_updated_tasks, task);
 
   g_signal_emit (self, signals[TASK_REMOVED], 0, task);
 
@@ -216,23 +402,192 @@ recursively_remove_subtasks (GtdTaskList *self,
     }
 }
 
+static void
+collect_task_and_subtasks (GtdTaskList *self,
+                           GtdTask     *task,
+                           GHashTable  *collected_tasks,
+                           GPtrArray   *removed_tasks)
+{
+  GtdTaskListPrivate *priv;
+  GtdTask *aux;
+
+  priv = gtd_task_list_get_instance_private (self);
+
+  if (!g_hash_table_contains (priv->task_to_uid, task) ||
+      !g_hash_table_add (collected_tasks, task))
+    {
+      return;
+    }
+
+  g_ptr_array_add (removed_tasks, g_object_ref (task));
+
+  for (aux = gtd_task_get_first_subtask (task);
+       aux;
+       aux = gtd_task_get_next_sibling (aux))
+    {
+      collect_task_and_subtasks (self, aux, collected_tasks, removed_tasks);
+    }
+}
+
+static guint
+get_task_position (GtdTaskList *self,
+                   GtdTask     *task)
+{
+  GtdTaskListPrivate *priv;
+  GSequenceIter *iter;
+
+  priv = gtd_task_list_get_instance_private (self);
+  iter = g_hash_table_lookup (priv->tasks, g_hash_table_lookup (priv->task_to_uid, task));
+
+  return g_sequence_iter_get_position (iter);
+}
+
+static GPtrArray*
+copy_sorted_tasks (GtdTaskList *self)
+{
+  GtdTaskListPrivate *priv;
+  GSequenceIter *iter;
+  GPtrArray *tasks;
+
+  priv = gtd_task_list_get_instance_private (self);
+  tasks = g_ptr_array_sized_new (priv->n_tasks);
+
+  for (iter = g_sequence_get_begin_iter (priv->sorted_tasks);
+       !g_sequence_iter_is_end (iter);
+       iter = g_sequence_iter_next (iter))
+    {
+      g_ptr_array_add (tasks, g_sequence_get (iter));
+    }
+
+  return tasks;
+}
+
+/*
+ * Tasks added, removed or moved while the list is frozen are announced
+ * right away, at their position in the current (unsorted) sequence. Take
+ * a new snapshot so that thawing only reports what was sorted since.
+ */
+static void
+refresh_frozen_tasks (GtdTaskList *self)
+{
+  GtdTaskListPrivate *priv = gtd_task_list_get_instance_private (self);
+
+  if (!priv->frozen_tasks)
+    return;
+
+  g_clear_pointer (&priv->frozen_tasks, g_ptr_array_unref);
+  priv->frozen_tasks = copy_sorted_tasks (self);
+}
+
+/*
+ * Compares the current order of the list with @old_tasks, and emits a
+ * single items-changed for the range between the unchanged start and
+ * end of the list. The range also covers @updated_tasks, if any, so that
+ * views refresh them even when they didn't move.
+ */
+static void
+emit_changes_since (GtdTaskList *self,
+                    GPtrArray   *old_tasks,
+                    GHashTable  *updated_tasks)
+{
+  GtdTaskListPrivate *priv;
+  GSequenceIter *iter;
+  guint n_removed;
+  guint n_added;
+  guint prefix;
+  guint suffix;
+
+  priv = gtd_task_list_get_instance_private (self);
+
+  prefix = 0;
+  iter = g_sequence_get_begin_iter (priv->sorted_tasks);
+
+  while (prefix < old_tasks->len &&
+         prefix < priv->n_tasks &&
+         g_sequence_get (iter) == g_ptr_array_index (old_tasks, prefix))
+    {
+      iter = g_sequence_iter_next (iter);
+      prefix++;
+    }
+
+  suffix = 0;
+  iter = g_sequence_get_end_iter (priv->sorted_tasks);
+
+  while (prefix + suffix < old_tasks->len && prefix + suffix < priv->n_tasks)
+    {
+      iter = g_sequence_iter_prev (iter);
+
+      if (g_sequence_get (iter) != g_ptr_array_index (old_tasks, old_tasks->len - suffix - 1))
+        break;
+
+      suffix++;
+    }
+
+  n_removed = old_tasks->len - prefix - suffix;
+  n_added = priv->n_tasks - prefix - suffix;
+
+  if (updated_tasks)
+    {
+      GHashTableIter hash_iter;
+      GtdTask *task;
+
+      g_hash_table_iter_init (&hash_iter, updated_tasks);
+
+      while (g_hash_table_iter_next (&hash_iter, (gpointer*) &task, NULL))
+        {
+          guint position;
+
+          if (!g_hash_table_contains (priv->task_to_uid, task))
+            continue;
+
+          position = get_task_position (self, task);
+
+          /* Tasks outside the range are at the same position before and after */
+          if (n_removed == 0 && n_added == 0)
+            {
+              prefix = position;
+              n_removed = 1;
+              n_added = 1;
+            }
+          else if (position < prefix)
+            {
+              n_removed += prefix - position;
+              n_added += prefix - position;
+              prefix = position;
+            }
+          else if (position >= prefix + n_added)
+            {
+              n_removed += position - prefix - n_added + 1;
+              n_added = position - prefix + 1;
+            }
+        }
+    }
+
+  if (n_removed == 0 && n_added == 0)
+    return;
+
+  GTD_TRACE_MSG ("%u tasks removed and %u added at %u", n_removed, n_added, prefix);
+
+  g_list_model_items_changed (G_LIST_MODEL (self), prefix, n_removed, n_added);
+}
+
 
 /*
  * Callbacks
  */
 
 static void
-on_task_updated_cb (GObject      *object,
-                    GAsyncResult *result,
-                    gpointer      user_data)
+on_tasks_updated_cb (GObject      *object,
+                     GAsyncResult *result,
+                     gpointer      user_data)
 {
   g_autoptr (GError) error = NULL;
 
-  gtd_provider_update_task_finish (GTD_PROVIDER (object), result, &error);
+  gtd_provider_update_tasks_finish (GTD_PROVIDER (object), result, &error);
 
   if (error)
     {
-      g_warning ("Error updating task: %s", error->message);
+      g_warning ("Error updating tasks: %s", error->message);
       return;
     }
 }
@@ -268,6 +623,13 @@ task_changed_cb (GtdTask     *task,
       GTD_RETURN ();
     }
 
+  /* Counters are kept up to date even when the list is frozen */
+  if (g_strcmp0 (g_param_spec_get_name (pspec), "complete") == 0 ||
+      g_strcmp0 (g_param_spec_get_name (pspec), "due-date") == 0)
+    {
+      update_task_flags (self, task);
+    }
+
   /* Don't update when the list is frozen */
   if (priv->freeze_counter > 0)
     GTD_RETURN ();
@@ -367,9 +729,12 @@ gtd_task_list_finalize (GObject *object)
 
   g_clear_pointer (&priv->color, gdk_rgba_free);
   g_clear_pointer (&priv->name, g_free);
+  g_clear_pointer (&priv->frozen_tasks, g_ptr_array_unref);
+  g_clear_pointer (&priv->frozen_updated_tasks, g_hash_table_destroy);
   g_clear_pointer (&priv->sorted_tasks, g_sequence_free);
   g_clear_pointer (&priv->tasks, g_hash_table_destroy);
   g_clear_pointer (&priv->task_to_uid, g_hash_table_destroy);
+  g_clear_pointer (&priv->task_flags, g_hash_table_destroy);
 
   G_OBJECT_CLASS (gtd_task_list_parent_class)->finalize (object);
 }
@@ -401,6 +766,22 @@ gtd_task_list_get_property (GObject    *object,
       g_value_set_boolean (value, gtd_task_list_is_removable (self));
       break;
 
+    case PROP_N_COMPLETED:
+      g_value_set_uint (value, priv->n_completed);
+      break;
+
+    case PROP_N_DUE_TODAY:
+      g_value_set_uint (value, priv->n_due_today);
+      break;
+
+    case PROP_N_OVERDUE:
+      g_value_set_uint (value, priv->n_overdue);
+      break;
+
+    case PROP_N_TASKS:
+      g_value_set_uint (value, priv->n_tasks);
+      break;
+
     case PROP_NAME:
       g_value_set_string (value, priv->name);
       break;
@@ -493,6 +874,58 @@ gtd_task_list_class_init (GtdTaskListClass *klass)
                                                         FALSE,
                                                         G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
 
+  /**
+   * GtdTaskList::n-completed:
+   *
+   * The number of completed tasks in the list.
+   */
+  properties[PROP_N_COMPLETED] = g_param_spec_uint ("n-completed",
+                                                    "Number of completed tasks",
+                                                    "The number of completed tasks in the list",
+                                                    0,
+                                                    G_MAXUINT,
+                                                    0,
+                                                    G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * GtdTaskList::n-due-today:
+   *
+   * The number of unfinished tasks in the list that are due today.
+   */
+  properties[PROP_N_DUE_TODAY] = g_param_spec_uint ("n-due-today",
+                                                    "Number of tasks due today",
+                                                    "The number of unfinished tasks due today",
+                                                    0,
+                                                    G_MAXUINT,
+                                                    0,
+                                                    G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * GtdTaskList::n-overdue:
+   *
+   * The number of unfinished tasks in the list that are due before today.
+   */
+  properties[PROP_N_OVERDUE] = g_param_spec_uint ("n-overdue",
+                                                  "Number of overdue tasks",
+                                                  "The number of unfinished tasks due before today",
+                                                  0,
+                                                  G_MAXUINT,
+                                                  0,
+                                                  G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
+  /**
+   * GtdTaskList::n-tasks:
+   *
+   * The number of tasks in the list, including subtasks.
+   */
+  properties[PROP_N_TASKS] = g_param_spec_uint ("n-tasks",
+                                                "Number of tasks",
+                                                "The number of tasks in the list",
+                                                0,
+                                                G_MAXUINT,
+                                                0,
+                                                G_PARAM_READABLE | G_PARAM_STATIC_STRINGS | G_PARAM_EXPLICIT_NOTIFY);
+
   /**
    * GtdTaskList::name:
    *
@@ -583,6 +1016,8 @@ gtd_task_list_init (GtdTaskList *self)
   priv->task_to_uid = g_hash_table_new (g_str_hash, g_str_equal);
   priv->tasks = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, NULL);
   priv->sorted_tasks = g_sequence_new (g_object_unref);
+  priv->task_flags = g_hash_table_new (g_direct_hash, g_direct_equal);
+  priv->today = get_today ();
 }
 
 /**
@@ -758,6 +1193,7 @@ void
 gtd_task_list_add_task (GtdTaskList *self,
                         GtdTask     *task)
 {
+  g_autoptr (GPtrArray) added_tasks = NULL;
   gint64 n_added;
   guint position;
 
@@ -766,10 +1202,11 @@ gtd_task_list_add_task (GtdTaskList *self,
   g_assert (!gtd_task_list_contains (self, task));
 
   n_added = gtd_task_get_n_total_subtasks (task) + 1;
-  position = add_task (self, task);
+  added_tasks = g_ptr_array_sized_new (n_added);
+  position = add_task (self, task, added_tasks);
 
-  /* Also remove subtasks */
-  recursively_add_subtasks (self, task);
+  /* Also add subtasks */
+  recursively_add_subtasks (self, task, added_tasks);
 
   GTD_TRACE_MSG ("Adding %ld tasks at %u", n_added, position);
 
@@ -777,6 +1214,83 @@ gtd_task_list_add_task (GtdTaskList *self,
                               position,
                               0,
                               n_added);
+
+  refresh_frozen_tasks (self);
+
+  emit_tasks_added (self, added_tasks);
+}
+
+/**
+ * gtd_task_list_add_tasks:
+ * @list: a #GtdTaskList
+ * @tasks: (element-type GtdTask): the #GtdTasks to add
+ *
+ * Adds all tasks in @tasks, and their subtasks, to @list. Tasks that
+ * are already in @list are ignored.
+ *
+ * The tasks are appended unsorted, and @list is sorted only once after
+ * all of them were added, with a single items-changed emission. This is
+ * how providers load their tasks.
+ */
+void
+gtd_task_list_add_tasks (GtdTaskList *self,
+                         GPtrArray   *tasks)
+{
+  g_autoptr (GPtrArray) added_tasks = NULL;
+  g_autoptr (GPtrArray) old_tasks = NULL;
+  GtdTaskListPrivate *priv;
+  guint i;
+
+  GTD_ENTRY;
+
+  g_return_if_fail (GTD_IS_TASK_LIST (self));
+  g_return_if_fail (tasks != NULL);
+
+  priv = gtd_task_list_get_instance_private (self);
+
+  g_return_if_fail (priv->freeze_counter == 0);
+
+  /* A single task is cheaper to insert at its position */
+  if (priv->n_tasks > 0 && tasks->len == 1)
+    {
+      GtdTask *task = g_ptr_array_index (tasks, 0);
+
+      if (!gtd_task_list_contains (self, task))
+        gtd_task_list_add_task (self, task);
+
+      GTD_RETURN ();
+    }
+
+  old_tasks = copy_sorted_tasks (self);
+  added_tasks = g_ptr_array_sized_new (tasks->len);
+
+  /* Notify the counters only once */
+  g_object_freeze_notify (G_OBJECT (self));
+
+  for (i = 0; i < tasks->len; i++)
+    append_task_and_subtasks (self, g_ptr_array_index (tasks, i), added_tasks);
+
+  if (added_tasks->len > 0)
+    {
+      g_sequence_sort (priv->sorted_tasks, compare_tasks_cb, NULL);
+
+      GTD_TRACE_MSG ("Adding %u tasks in bulk", added_tasks->len);
+
+      emit_changes_since (self, old_tasks, NULL);
+
+      /*
+       * ::task-added handlers may change the hierarchy of the tasks, e.g. EDS
+       * sets up subtasks there. Freezing the list sorts it only once, after
+       * all of them ran, instead of on every notification meanwhile.
+       */
+      gtd_task_list_freeze (self);
+      emit_tasks_added (self, added_tasks);
+      gtd_task_list_thaw (self);
+    }
+
+  g_object_thaw_notify (G_OBJECT (self));
+
+  GTD_EXIT;
 }
 
 /**
@@ -784,7 +1298,8 @@ gtd_task_list_add_task (GtdTaskList *self,
  * @list: a #GtdTaskList
  * @task: a #GtdTask
  *
- * Updates @task at @list.
+ * Updates @task at @list. When @list is frozen, the update is reported
+ * by gtd_task_list_thaw(), together with all the other changes.
  */
 void
 gtd_task_list_update_task (GtdTaskList *self,
@@ -800,16 +1315,90 @@ gtd_task_list_update_task (GtdTaskList *self,
 
   g_return_if_fail (gtd_task_list_contains (self, task));
 
-  iter = g_hash_table_lookup (priv->tasks, gtd_object_get_uid (GTD_OBJECT (task)));
+  if (priv->freeze_counter > 0 && priv->frozen_tasks)
+    {
+      if (!priv->frozen_updated_tasks)
+        priv->frozen_updated_tasks = g_hash_table_new (g_direct_hash, g_direct_equal);
 
-  g_list_model_items_changed (G_LIST_MODEL (self),
-                              g_sequence_iter_get_position (iter),
-                              1,
-                              1);
+      g_hash_table_add (priv->frozen_updated_tasks, task);
+    }
+  else
+    {
+      iter = g_hash_table_lookup (priv->tasks, gtd_object_get_uid (GTD_OBJECT (task)));
+
+      g_list_model_items_changed (G_LIST_MODEL (self),
+                                  g_sequence_iter_get_position (iter),
+                                  1,
+                                  1);
+    }
 
   g_signal_emit (self, signals[TASK_UPDATED], 0, task);
 }
 
+/**
+ * gtd_task_list_freeze:
+ * @list: a #GtdTaskList
+ *
+ * Stops @list from resorting itself when its tasks change, until
+ * gtd_task_list_thaw() is called. This is useful to change the positions
+ * of many tasks at once, since @list is then sorted only once.
+ *
+ * Tasks added to or removed from @list while it is frozen are reported
+ * right away, at their position in the unsorted list.
+ */
+void
+gtd_task_list_freeze (GtdTaskList *self)
+{
+  GtdTaskListPrivate *priv;
+
+  g_return_if_fail (GTD_IS_TASK_LIST (self));
+
+  priv = gtd_task_list_get_instance_private (self);
+  priv->freeze_counter++;
+
+  g_object_freeze_notify (G_OBJECT (self));
+
+  /* Remember the current order to figure out what changed when thawing */
+  if (!priv->frozen_tasks)
+    priv->frozen_tasks = copy_sorted_tasks (self);
+}
+
+/**
+ * gtd_task_list_thaw:
+ * @list: a #GtdTaskList
+ *
+ * Reverts the effect of a previous call to gtd_task_list_freeze(). When
+ * @list is not frozen anymore, it is sorted, and a single items-changed
+ * is emitted for the range of tasks that moved or were updated with
+ * gtd_task_list_update_task().
+ */
+void
+gtd_task_list_thaw (GtdTaskList *self)
+{
+  g_autoptr (GHashTable) updated_tasks = NULL;
+  g_autoptr (GPtrArray) frozen_tasks = NULL;
+  GtdTaskListPrivate *priv;
+
+  g_return_if_fail (GTD_IS_TASK_LIST (self));
+
+  priv = gtd_task_list_get_instance_private (self);
+
+  g_return_if_fail (priv->frozen_tasks != NULL);
+  g_return_if_fail (priv->freeze_counter > 0);
+
+  g_object_thaw_notify (G_OBJECT (self));
+
+  if (--priv->freeze_counter > 0)
+    return;
+
+  frozen_tasks = g_steal_pointer (&priv->frozen_tasks);
+  updated_tasks = g_steal_pointer (&priv->frozen_updated_tasks);
+
+  g_sequence_sort (priv->sorted_tasks, compare_tasks_cb, NULL);
+
+  emit_changes_since (self, frozen_tasks, updated_tasks);
+}
+
 /**
  * gtd_task_list_remove_task:
  * @list: a #GtdTaskList
@@ -840,6 +1429,76 @@ gtd_task_list_remove_task (GtdTaskList *list,
                               position,
                               n_removed,
                               0);
+
+  refresh_frozen_tasks (list);
+}
+
+/**
+ * gtd_task_list_remove_tasks:
+ * @list: a #GtdTaskList
+ * @tasks: (element-type GtdTask): the #GtdTasks to remove
+ *
+ * Removes all tasks in @tasks, and their subtasks, from @list. Tasks
+ * that are not in @list are ignored.
+ *
+ * A single items-changed is emitted for the range spanning all the
+ * removed tasks.
+ */
+void
+gtd_task_list_remove_tasks (GtdTaskList *self,
+                            GPtrArray   *tasks)
+{
+  g_autoptr (GHashTable) collected_tasks = NULL;
+  g_autoptr (GPtrArray) removed_tasks = NULL;
+  GtdTaskListPrivate *priv;
+  guint first_position;
+  guint last_position;
+  guint i;
+
+  GTD_ENTRY;
+
+  g_return_if_fail (GTD_IS_TASK_LIST (self));
+  g_return_if_fail (tasks != NULL);
+
+  priv = gtd_task_list_get_instance_private (self);
+
+  g_return_if_fail (priv->freeze_counter == 0);
+
+  collected_tasks = g_hash_table_new (g_direct_hash, g_direct_equal);
+  removed_tasks = g_ptr_array_new_with_free_func (g_object_unref);
+
+  for (i = 0; i < tasks->len; i++)
+    collect_task_and_subtasks (self, g_ptr_array_index (tasks, i), collected_tasks, removed_tasks);
+
+  if (removed_tasks->len == 0)
+    GTD_RETURN ();
+
+  first_position = G_MAXUINT;
+  last_position = 0;
+
+  for (i = 0; i < removed_tasks->len; i++)
+    {
+      guint position = get_task_position (self, g_ptr_array_index (removed_tasks, i));
+
+      first_position = MIN (first_position, position);
+      last_position = MAX (last_position, position);
+    }
+
+  g_object_freeze_notify (G_OBJECT (self));
+
+  for (i = 0; i < removed_tasks->len; i++)
+    remove_task (self, g_ptr_array_index (removed_tasks, i));
+
+  g_object_thaw_notify (G_OBJECT (self));
+
+  GTD_TRACE_MSG ("Removing %u tasks between %u and %u", removed_tasks->len, first_position, last_position);
+
+  g_list_model_items_changed (G_LIST_MODEL (self),
+                              first_position,
+                              last_position - first_position + 1,
+                              last_position - first_position + 1 - removed_tasks->len);
+
+  GTD_EXIT;
 }
 
 /**
@@ -957,6 +1616,7 @@ gtd_task_list_move_task_to_position (GtdTaskList *self,
   GSequenceIter *block_start_iter;
   GSequenceIter *block_end_iter;
   GSequenceIter *new_position_iter;
+  g_autoptr (GPtrArray) changed_tasks = NULL;
   gboolean moving_up;
   guint64 n_subtasks;
   guint block1_start;
@@ -1027,6 +1687,9 @@ gtd_task_list_move_task_to_position (GtdTaskList *self,
 
   priv->freeze_counter++;
 
+  /* All repositioned tasks are saved in a single batch */
+  changed_tasks = g_ptr_array_new_full (block1_length + block2_length, g_object_unref);
+
   /* Update Block 1 */
   for (i = 0; i < block1_length; i++)
     {
@@ -1038,11 +1701,7 @@ gtd_task_list_move_task_to_position (GtdTaskList *self,
       gtd_task_set_position (task_at_i, block1_new_start + i);
       g_signal_handlers_unblock_by_func (task_at_i, task_changed_cb, self);
 
-      gtd_provider_update_task (priv->provider,
-                                task_at_i,
-                                NULL,
-                                on_task_updated_cb,
-                                self);
+      g_ptr_array_add (changed_tasks, g_steal_pointer (&task_at_i));
     }
 
   /* Update Block 2 */
@@ -1056,11 +1715,7 @@ gtd_task_list_move_task_to_position (GtdTaskList *self,
       gtd_task_set_position (task_at_i, block2_new_start + i);
       g_signal_handlers_unblock_by_func (task_at_i, task_changed_cb, self);
 
-      gtd_provider_update_task (priv->provider,
-                                task_at_i,
-                                NULL,
-                                on_task_updated_cb,
-                                self);
+      g_ptr_array_add (changed_tasks, g_steal_pointer (&task_at_i));
     }
 
   /*
@@ -1095,6 +1750,14 @@ gtd_task_list_move_task_to_position (GtdTaskList *self,
     }
 
   priv->freeze_counter--;
+
+  refresh_frozen_tasks (self);
+
+  gtd_provider_update_tasks (priv->provider,
+                             changed_tasks,
+                             NULL,
+                             on_tasks_updated_cb,
+                             self);
 }
 
 /**
@@ -1158,3 +1821,118 @@ gtd_task_list_is_inbox (GtdTaskList *self)
 
   return self == gtd_provider_get_inbox (priv->provider);
 }
+
+/**
+ * gtd_task_list_get_n_tasks:
+ * @self: a #GtdTaskList
+ *
+ * Retrieves the number of tasks in @self, including subtasks.
+ *
+ * Returns: the number of tasks
+ */
+guint
+gtd_task_list_get_n_tasks (GtdTaskList *self)
+{
+  GtdTaskListPrivate *priv;
+
+  g_return_val_if_fail (GTD_IS_TASK_LIST (self), 0);
+
+  priv = gtd_task_list_get_instance_private (self);
+
+  return priv->n_tasks;
+}
+
+/**
+ * gtd_task_list_get_n_completed:
+ * @self: a #GtdTaskList
+ *
+ * Retrieves the number of completed tasks in @self.
+ *
+ * Returns: the number of completed tasks
+ */
+guint
+gtd_task_list_get_n_completed (GtdTaskList *self)
+{
+  GtdTaskListPrivate *priv;
+
+  g_return_val_if_fail (GTD_IS_TASK_LIST (self), 0);
+
+  priv = gtd_task_list_get_instance_private (self);
+
+  return priv->n_completed;
+}
+
+/**
+ * gtd_task_list_get_n_overdue:
+ * @self: a #GtdTaskList
+ *
+ * Retrieves the number of unfinished tasks in @self that are due
+ * before today.
+ *
+ * Returns: the number of overdue tasks
+ */
+guint
+gtd_task_list_get_n_overdue (GtdTaskList *self)
+{
+  GtdTaskListPrivate *priv;
+
+  g_return_val_if_fail (GTD_IS_TASK_LIST (self), 0);
+
+  priv = gtd_task_list_get_instance_private (self);
+
+  return priv->n_overdue;
+}
+
+/**
+ * gtd_task_list_get_n_due_today:
+ * @self: a #GtdTaskList
+ *
+ * Retrieves the number of unfinished tasks in @self that are due today.
+ *
+ * Returns: the number of tasks due today
+ */
+guint
+gtd_task_list_get_n_due_today (GtdTaskList *self)
+{
+  GtdTaskListPrivate *priv;
+
+  g_return_val_if_fail (GTD_IS_TASK_LIST (self), 0);
+
+  priv = gtd_task_list_get_instance_private (self);
+
+  return priv->n_due_today;
+}
+
+/*
+ * _gtd_task_list_update_day:
+ * @self: a #GtdTaskList
+ *
+ * Recounts the overdue and due today tasks of @self. Must be called when
+ * the day changes.
+ */
+void
+_gtd_task_list_update_day (GtdTaskList *self)
+{
+  GtdTaskListPrivate *priv;
+  GHashTableIter iter;
+  GtdTask *task;
+  gint today;
+
+  g_return_if_fail (GTD_IS_TASK_LIST (self));
+
+  priv = gtd_task_list_get_instance_private (self);
+  today = get_today ();
+
+  if (priv->today == today)
+    return;
+
+  priv->today = today;
+
+  g_object_freeze_notify (G_OBJECT (self));
+
+  g_hash_table_iter_init (&iter, priv->task_to_uid);
+  while (g_hash_table_iter_next (&iter, (gpointer*) &task, NULL))
+    update_task_flags (self, task);
+
+  g_object_thaw_notify (G_OBJECT (self));
+}
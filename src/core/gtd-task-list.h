@@ -79,12 +79,22 @@ void                    gtd_task_list_set_provider              (GtdTaskList
 void                    gtd_task_list_add_task                  (GtdTaskList            *list,
                                                                  GtdTask                *task);
 
+void                    gtd_task_list_add_tasks                 (GtdTaskList            *list,
+                                                                 GPtrArray              *tasks);
+
 void                    gtd_task_list_update_task               (GtdTaskList            *list,
                                                                  GtdTask                *task);
 
 void                    gtd_task_list_remove_task               (GtdTaskList            *list,
                                                                  GtdTask                *task);
 
+void                    gtd_task_list_remove_tasks              (GtdTaskList            *list,
+                                                                 GPtrArray              *tasks);
+
+void                    gtd_task_list_freeze                    (GtdTaskList            *list);
+
+void                    gtd_task_list_thaw                      (GtdTaskList            *list);
+
 gboolean                gtd_task_list_contains                  (GtdTaskList            *list,
                                                                  GtdTask                *task);
 
@@ -102,6 +112,14 @@ void                    gtd_task_list_set_archived              (GtdTaskList
 
 gboolean                gtd_task_list_is_inbox                  (GtdTaskList            *self);
 
+guint                   gtd_task_list_get_n_tasks               (GtdTaskList            *self);
+
+guint                   gtd_task_list_get_n_completed           (GtdTaskList            *self);
+
+guint                   gtd_task_list_get_n_overdue             (GtdTaskList            *self);
+
+guint                   gtd_task_list_get_n_due_today           (GtdTaskList            *self);
+
 G_END_DECLS
 
 #endif /* GTD_TASK_LIST_H */
@@ -23,6 +23,7 @@
 #include "gtd-task-list.h"
 
 #include <glib/gi18n.h>
+#include <string.h>
 
 /**
  * SECTION:gtd-task
@@ -35,6 +36,20 @@
  * must be inside a #GtdTaskList.
  */
 
+/*
+ * Packed ordering data used by gtd_task_compare(). It is lazily rebuilt
+ * from the (possibly overridden) getters whenever one of the properties
+ * it mirrors changes, so comparing two tasks never allocates.
+ */
+typedef struct
+{
+  gint64           position;
+  gint64           due_date;
+  gint64           creation_date;
+  gchar           *title_key;
+  gboolean         valid;
+} GtdTaskSortKey;
+
 typedef struct
 {
   gchar           *description;
@@ -60,6 +75,8 @@ typedef struct
   gint64           position;
   gboolean         complete;
   gboolean         important;
+
+  GtdTaskSortKey   sort_key;
 } GtdTaskPrivate;
 
 G_DEFINE_TYPE_WITH_PRIVATE (GtdTask, gtd_task, GTD_TYPE_OBJECT)
@@ -89,60 +106,6 @@ enum
 
 static guint signals[N_SIGNALS] = { 0, };
 
-static gboolean
-share_same_ancestor (GtdTask *t1,
-                     GtdTask *t2)
-{
-  GtdTask *p1, *p2;
-  gint depth_difference;
-
-  depth_difference = ABS (gtd_task_get_depth (t1) - gtd_task_get_depth (t2));
-
-  /* Put the tasks at the same depth */
-  if (depth_difference != 0)
-    {
-      gint i;
-
-      for (i = 0; i < depth_difference; i++)
-        {
-          if (gtd_task_get_depth (t1) > gtd_task_get_depth (t2))
-            t1 = gtd_task_get_parent (t1);
-          else
-            t2 = gtd_task_get_parent (t2);
-        }
-    }
-
-  p1 = t1;
-  p2 = t2;
-
-  /* Walk up in the tree, if they match, we found the ancestor */
-  while (p1 && p2)
-    {
-      if (p1 == p2)
-        return TRUE;
-
-      p1 = gtd_task_get_parent (p1);
-      p2 = gtd_task_get_parent (p2);
-    }
-
-  return FALSE;
-}
-
-static GtdTask*
-get_root_task (GtdTask *self)
-{
-  GtdTaskPrivate *priv = gtd_task_get_instance_private (self);
-  GtdTask *aux = self;
-
-  while (priv->parent_task)
-    {
-      aux = priv->parent_task;
-      priv = gtd_task_get_instance_private (aux);
-    }
-
-  return aux;
-}
-
 static void
 append_subtask (GtdTask *self,
                 GtdTask *subtask)
@@ -204,76 +167,112 @@ remove_subtask (GtdTask *self,
     }
 }
 
+static inline gint64
+date_time_to_sort_key (GDateTime *dt)
+{
+  if (!dt)
+    return G_MAXINT64;
+
+  return g_date_time_to_unix (dt) * G_USEC_PER_SEC + g_date_time_get_microsecond (dt);
+}
+
+static void
+invalidate_sort_key (GtdTask *self)
+{
+  GtdTaskPrivate *priv = gtd_task_get_instance_private (self);
+
+  priv->sort_key.valid = FALSE;
+}
+
+static const GtdTaskSortKey*
+ensure_sort_key (GtdTask *self)
+{
+  GtdTaskPrivate *priv = gtd_task_get_instance_private (self);
+  g_autoptr (GDateTime) creation_date = NULL;
+  g_autoptr (GDateTime) due_date = NULL;
+  g_autofree gchar *casefolded_title = NULL;
+  GtdTaskSortKey *key = &priv->sort_key;
+
+  if (key->valid)
+    return key;
+
+  due_date = gtd_task_get_due_date (self);
+  creation_date = gtd_task_get_creation_date (self);
+  casefolded_title = g_utf8_casefold (gtd_task_get_title (self), -1);
+
+  key->position = gtd_task_get_position (self);
+  key->due_date = date_time_to_sort_key (due_date);
+  key->creation_date = date_time_to_sort_key (creation_date);
+
+  g_clear_pointer (&key->title_key, g_free);
+  key->title_key = g_utf8_collate_key (casefolded_title, -1);
+
+  key->valid = TRUE;
+
+  return key;
+}
+
+static inline gint
+compare_int64 (gint64 a,
+               gint64 b)
+{
+  return (a > b) - (a < b);
+}
+
 static gint
 compare_by_subtasks (GtdTask **t1,
                      GtdTask **t2)
 {
+  GtdTaskPrivate *priv1, *priv2;
   GtdTask *task1, *task2;
+  gint depth1, depth2;
 
   task1 = *t1;
   task2 = *t2;
+  priv1 = gtd_task_get_instance_private (task1);
+  priv2 = gtd_task_get_instance_private (task2);
+  depth1 = priv1->depth;
+  depth2 = priv2->depth;
 
-  if (!task1 && !task2)
-    return  0;
-  if (!task1)
-    return  1;
-  if (!task2)
-    return -1;
+  /* Put the tasks at the same depth */
+  while (depth1 > depth2)
+    {
+      task1 = priv1->parent_task;
+      priv1 = gtd_task_get_instance_private (task1);
+      depth1--;
+    }
 
-  if (share_same_ancestor (task1, task2))
+  while (depth2 > depth1)
     {
-      gint depth_difference;
+      task2 = priv2->parent_task;
+      priv2 = gtd_task_get_instance_private (task2);
+      depth2--;
+    }
 
-      depth_difference = ABS (gtd_task_get_depth (task1) - gtd_task_get_depth (task2));
+  /* One task is an ancestor of the other, and ancestors come first */
+  if (task1 == task2)
+    {
+      if (*t1 == *t2)
+        return 0;
 
-      if (gtd_task_is_subtask (task1, task2))
-        {
-          return -1;
-        }
-      else if (gtd_task_is_subtask (task2, task1))
-        {
-          return 1;
-        }
-      else
-        {
-          GtdTask *p1, *p2;
-          gint i;
-
-          for (i = depth_difference; i > 0; i--)
-            {
-              if (gtd_task_get_depth (task1) > gtd_task_get_depth (task2))
-                task1 = gtd_task_get_parent (task1);
-              else
-                task2 = gtd_task_get_parent (task2);
-            }
-
-          p1 = task1;
-          p2 = task2;
-
-          /* Walk up in the tree, if they match, we found the ancestor */
-          while (gtd_task_get_parent (p1) && gtd_task_get_parent (p2))
-            {
-              if (gtd_task_get_parent (p1) == gtd_task_get_parent (p2))
-                break;
-
-              p1 = gtd_task_get_parent (p1);
-              p2 = gtd_task_get_parent (p2);
-            }
-
-          *t1 = p1;
-          *t2 = p2;
-        }
+      return task1 == *t1 ? -1 : 1;
     }
-  else
+
+  /*
+   * Walk up in the tree until both tasks are siblings. If they live in
+   * different subtask trees, this ends up comparing the root tasks.
+   */
+  while (priv1->parent_task != priv2->parent_task)
     {
-      /*
-       * If either t1 or t2 have a parent, we have to compare them
-       * solely based on the root task of the subtask tree.
-       */
-      *t1 = get_root_task (task1);
-      *t2 = get_root_task (task2);
+      task1 = priv1->parent_task;
+      task2 = priv2->parent_task;
+      priv1 = gtd_task_get_instance_private (task1);
+      priv2 = gtd_task_get_instance_private (task2);
     }
 
+  *t1 = task1;
+  *t2 = task2;
+
   return 0;
 }
 
@@ -562,10 +561,41 @@ gtd_task_finalize (GObject *object)
 
   priv->list = NULL;
   g_free (priv->description);
+  g_free (priv->sort_key.title_key);
 
   G_OBJECT_CLASS (gtd_task_parent_class)->finalize (object);
 }
 
+static void
+gtd_task_dispatch_properties_changed (GObject     *object,
+                                      guint        n_pspecs,
+                                      GParamSpec **pspecs)
+{
+  guint i;
+
+  /* Drop the cached sort key before any handler gets to compare tasks */
+  for (i = 0; i < n_pspecs; i++)
+    {
+      if (pspecs[i]->owner_type != GTD_TYPE_TASK)
+        continue;
+
+      switch (pspecs[i]->param_id)
+        {
+        case PROP_CREATION_DATE:
+        case PROP_DUE_DATE:
+        case PROP_POSITION:
+        case PROP_TITLE:
+          invalidate_sort_key (GTD_TASK (object));
+          break;
+
+        default:
+          break;
+        }
+    }
+
+  G_OBJECT_CLASS (gtd_task_parent_class)->dispatch_properties_changed (object, n_pspecs, pspecs);
+}
+
 static void
 gtd_task_get_property (GObject    *object,
                        guint       prop_id,
@@ -697,6 +727,7 @@ gtd_task_class_init (GtdTaskClass *klass)
   klass->subtask_removed = real_remove_subtask;
 
   object_class->finalize = gtd_task_finalize;
+  object_class->dispatch_properties_changed = gtd_task_dispatch_properties_changed;
   object_class->get_property = gtd_task_get_property;
   object_class->set_property = gtd_task_set_property;
 
@@ -973,8 +1004,9 @@ gtd_task_set_creation_date (GtdTask   *task,
     return;
 
   GTD_TASK_CLASS (G_OBJECT_GET_CLASS (task))->set_creation_date (task, dt);
+  invalidate_sort_key (task);
 
-  g_object_notify (G_OBJECT (task), "complete");
+  g_object_notify (G_OBJECT (task), "creation-date");
 }
 
 /**
@@ -1079,6 +1111,7 @@ gtd_task_set_due_date (GtdTask   *task,
     return;
 
   GTD_TASK_CLASS (G_OBJECT_GET_CLASS (task))->set_due_date (task, dt);
+  invalidate_sort_key (task);
 
   g_object_notify (G_OBJECT (task), "due-date");
 }
@@ -1205,6 +1238,7 @@ gtd_task_set_position (GtdTask *self,
     return;
 
   GTD_TASK_CLASS (G_OBJECT_GET_CLASS (self))->set_position (self, position);
+  invalidate_sort_key (self);
 
   g_object_notify (G_OBJECT (self), "position");
 }
@@ -1252,6 +1286,7 @@ gtd_task_set_title (GtdTask     *task,
     return;
 
   GTD_TASK_CLASS (G_OBJECT_GET_CLASS (task))->set_title (task, title);
+  invalidate_sort_key (task);
 
   g_object_notify (G_OBJECT (task), "title");
 }
@@ -1269,10 +1304,8 @@ gint
 gtd_task_compare (GtdTask *t1,
                   GtdTask *t2)
 {
-  GDateTime *dt1;
-  GDateTime *dt2;
-  gchar *txt1;
-  gchar *txt2;
+  const GtdTaskSortKey *key1;
+  const GtdTaskSortKey *key2;
   gint retval;
 
   if (!t1 && !t2)
@@ -1282,13 +1315,16 @@ gtd_task_compare (GtdTask *t1,
   if (!t2)
     return -1;
 
+  key1 = ensure_sort_key (t1);
+  key2 = ensure_sort_key (t2);
+
   /*
    * The custom position overrides any comparison we can make. To keep compatibility,
    * for now, we only compare by position if both tasks have a custom position set.
    */
-  if (gtd_task_get_position (t1) != -1 && gtd_task_get_position (t2) != -1)
+  if (key1->position != -1 && key2->position != -1)
     {
-      retval = gtd_task_get_position (t1) - gtd_task_get_position (t2);
+      retval = compare_int64 (key1->position, key2->position);
 
       if (retval != 0)
         return retval;
@@ -1300,58 +1336,24 @@ gtd_task_compare (GtdTask *t1,
   if (retval != 0)
     return retval;
 
-  /* Compare by due date */
-  dt1 = gtd_task_get_due_date (t1);
-  dt2 = gtd_task_get_due_date (t2);
-
-  if (!dt1 && !dt2)
-    retval =  0;
-  else if (!dt1)
-    retval =  1;
-  else if (!dt2)
-    retval = -1;
-  else
-    retval = g_date_time_compare (dt1, dt2);
+  /* The hierarchy may have replaced the tasks by their ancestors */
+  key1 = ensure_sort_key (t1);
+  key2 = ensure_sort_key (t2);
 
-  if (dt1)
-    g_date_time_unref (dt1);
-  if (dt2)
-    g_date_time_unref (dt2);
+  /* Compare by due date; tasks without a due date go last */
+  retval = compare_int64 (key1->due_date, key2->due_date);
 
   if (retval != 0)
     return retval;
 
   /* Compare by creation date */
-  dt1 = gtd_task_get_creation_date (t1);
-  dt2 = gtd_task_get_creation_date (t2);
-
-  if (!dt1 && !dt2)
-    retval =  0;
-  else if (!dt1)
-    retval =  1;
-  else if (!dt2)
-    retval = -1;
-  else
-    retval = g_date_time_compare (dt1, dt2);
-
-  g_clear_pointer (&dt1, g_date_time_unref);
-  g_clear_pointer (&dt2, g_date_time_unref);
+  retval = compare_int64 (key1->creation_date, key2->creation_date);
 
   if (retval != 0)
     return retval;
 
   /* If they're equal up to now, compare by title */
-  txt1 = txt2 = NULL;
-
-  txt1 = g_utf8_casefold (gtd_task_get_title (t1), -1);
-  txt2 = g_utf8_casefold (gtd_task_get_title (t2), -1);
-
-  retval = g_strcmp0 (txt1, txt2);
-
-  g_free (txt1);
-  g_free (txt2);
-
-  return retval;
+  return strcmp (key1->title_key, key2->title_key);
 }
 
 /**
@@ -25,6 +25,8 @@
 
 #include "gtd-activatable.h"
 #include "gtd-bin-layout.h"
+#include "gtd-clock.h"
+#include "gtd-due-date-index.h"
 #include "gtd-easing.h"
 #include "gtd-keyframe-transition.h"
 #include "gtd-list-model-filter.h"
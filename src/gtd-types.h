@@ -27,6 +27,7 @@ typedef struct _GtdActivatable          GtdActivatable;
 typedef struct _GtdAnimatable           GtdAnimatable;
 typedef struct _GtdApplication          GtdApplication;
 typedef struct _GtdClock                GtdClock;
+typedef struct _GtdDueDateIndex         GtdDueDateIndex;
 typedef struct _GtdDoneButton           GtdDoneButton;
 typedef struct _GtdInterval             GtdInterval;
 typedef struct _GtdInitialSetupWindow   GtdInitialSetupWindow;
@@ -245,6 +245,8 @@ gtd_application_activate (GApplication *application)
 static void
 gtd_application_startup (GApplication *application)
 {
+  g_autofree gchar *snapshot_path = NULL;
+  g_autoptr (GError) error = NULL;
   GtdApplication *self;
 
   GTD_ENTRY;
@@ -262,6 +264,15 @@ gtd_application_startup (GApplication *application)
   /* CSS provider */
   gtd_theme_manager_add_resources (self->theme_manager, "resource:///org/gnome/todo");
 
+  /* Show the tasks of the last run while the providers load */
+  snapshot_path = g_build_filename (g_get_user_cache_dir (), "gnome-todo", "snapshot.gvariant", NULL);
+
+  if (!gtd_manager_load_snapshot (gtd_manager_get_default (), snapshot_path, &error) &&
+      !g_error_matches (error, G_FILE_ERROR, G_FILE_ERROR_NOENT))
+    {
+      g_warning ("Error loading snapshot: %s", error->message);
+    }
+
   /* window */
   gtk_window_set_default_icon_name (APPLICATION_ID);
   self->window = GTK_WINDOW (gtd_window_new (self));
@@ -277,6 +288,18 @@ gtd_application_startup (GApplication *application)
   GTD_EXIT;
 }
 
+static void
+gtd_application_shutdown (GApplication *application)
+{
+  GTD_ENTRY;
+
+  gtd_manager_save_snapshot (gtd_manager_get_default ());
+
+  G_APPLICATION_CLASS (gtd_application_parent_class)->shutdown (application);
+
+  GTD_EXIT;
+}
+
 static gint
 gtd_application_command_line (GApplication            *app,
                               GApplicationCommandLine *command_line)
@@ -328,6 +351,7 @@ gtd_application_class_init (GtdApplicationClass *klass)
 
   application_class->activate = gtd_application_activate;
   application_class->startup = gtd_application_startup;
+  application_class->shutdown = gtd_application_shutdown;
   application_class->command_line = gtd_application_command_line;
   application_class->local_command_line = gtd_application_local_command_line;
   application_class->handle_local_options = gtd_application_handle_local_options;
@@ -25,6 +25,7 @@
 #include "gtd-task-list-view.h"
 #include "gtd-manager.h"
 #include "gtd-markdown-renderer.h"
+#include "gtd-max-size-layout.h"
 #include "gtd-new-task-row.h"
 #include "gtd-notification.h"
 #include "gtd-provider.h"
@@ -65,20 +66,33 @@
  * gtd_task_list_view_set_default_date (view, now);
  * ]|
  *
+ * By default, a row widget is created for every task of the model. Views
+ * that may show a large number of tasks should enable the virtualized mode
+ * with gtd_task_list_view_set_virtualized(), which only creates rows for the
+ * visible tasks, and recycles them while scrolling.
+ *
  */
 
 typedef struct
 {
   GtkListBox            *listbox;
+  GtkBox                *listbox_box;
   GtkListBoxRow         *new_task_row;
   GtkWidget             *scrolled_window;
   GtkStack              *stack;
 
+  /* virtualized mode */
+  GtkListView           *listview;
+  GtkWidget             *listview_box;
+  GtkBox                *listview_new_task_box;
+  GtkWidget             *listview_scrolled_window;
+
   /* internal */
   gboolean               can_toggle;
   gboolean               show_due_date;
   gboolean               show_list_name;
   gboolean               handle_subtasks;
+  gboolean               virtualized;
   GListModel            *model;
   GDateTime             *default_date;
 
@@ -90,7 +104,7 @@ typedef struct
   GtdMarkdownRenderer   *renderer;
 
   /* DnD */
-  GtkListBoxRow         *highlighted_row;
+  GtdTaskRow            *highlighted_row;
   guint                  scroll_timeout_id;
   gboolean               scroll_up;
 
@@ -139,9 +153,13 @@ typedef struct
 #define COLOR_TEMPLATE               "tasklistview {background-color: %s;}"
 #define DND_SCROLL_OFFSET            24 //px
 #define LUMINANCE(c)                 (0.299 * c->red + 0.587 * c->green + 0.114 * c->blue)
+#define MAX_ROW_WIDTH                700 //px
 #define TASK_REMOVED_NOTIFICATION_ID "task-removed-id"
 
 
+static GtkWidget*    create_row_for_task_cb                      (gpointer            item,
+                                                                  gpointer            user_data);
+
 static void          on_clear_completed_tasks_activated_cb       (GSimpleAction      *simple,
                                                                   GVariant           *parameter,
                                                                   gpointer            user_data);
@@ -157,6 +175,8 @@ static void          on_task_row_exited_cb                       (GtdTaskListVie
 
 static gboolean      scroll_to_bottom_cb                         (gpointer            data);
 
+static void          unset_previously_highlighted_row            (GtdTaskListView    *self);
+
 
 G_DEFINE_TYPE_WITH_PRIVATE (GtdTaskListView, gtd_task_list_view, GTK_TYPE_BOX)
 
@@ -177,6 +197,7 @@ enum {
   PROP_SHOW_LIST_NAME,
   PROP_SHOW_DUE_DATE,
   PROP_SHOW_NEW_TASK_ROW,
+  PROP_VIRTUALIZED,
   LAST_PROP
 };
 
@@ -194,6 +215,176 @@ task_row_from_row (GtkListBoxRow *row)
   return GTD_TASK_ROW (gtk_list_box_row_get_child (row));
 }
 
+static inline GtdTaskRow*
+task_row_from_list_item (GtkListItem *list_item)
+{
+  return g_object_get_data (G_OBJECT (list_item), "task-row");
+}
+
+static inline GtkWidget*
+get_list_widget (GtdTaskListView *self)
+{
+  GtdTaskListViewPrivate *priv = gtd_task_list_view_get_instance_private (self);
+
+  return priv->virtualized ? GTK_WIDGET (priv->listview) : GTK_WIDGET (priv->listbox);
+}
+
+static inline GtkWidget*
+get_scrolled_window (GtdTaskListView *self)
+{
+  GtdTaskListViewPrivate *priv = gtd_task_list_view_get_instance_private (self);
+
+  return priv->virtualized ? priv->listview_scrolled_window : priv->scrolled_window;
+}
+
+static void
+setup_task_row (GtdTaskListView *self,
+                GtdTaskRow      *row)
+{
+  GtdTaskListViewPrivate *priv = gtd_task_list_view_get_instance_private (self);
+
+  g_object_bind_property (self,
+                          "handle-subtasks",
+                          row,
+                          "handle-subtasks",
+                          G_BINDING_DEFAULT | G_BINDING_SYNC_CREATE);
+
+  gtd_task_row_set_list_name_visible (row, priv->show_list_name);
+  gtd_task_row_set_due_date_visible (row, priv->show_due_date);
+
+  g_signal_connect_swapped (row, "enter", G_CALLBACK (on_task_row_entered_cb), self);
+  g_signal_connect_swapped (row, "exit", G_CALLBACK (on_task_row_exited_cb), self);
+
+  g_signal_connect (row, "remove-task", G_CALLBACK (on_remove_task_row_cb), self);
+}
+
+static GtkWidget*
+create_header (GtdTaskListView *self,
+               GtdTask         *task,
+               GtdTask         *previous_task)
+{
+  GtdTaskListViewPrivate *priv = gtd_task_list_view_get_instance_private (self);
+  GtkWidget *real_header;
+  GtkWidget *header;
+
+  header = priv->header_func (task, previous_task, priv->header_user_data);
+
+  if (!header)
+    return NULL;
+
+  real_header = gtd_widget_new ();
+  gtk_widget_insert_before (header, real_header, NULL);
+
+  return real_header;
+}
+
+/*
+ * GtkListView has no notion of headers, so in virtualized mode they are
+ * placed above the task row, inside the list item. @position is passed
+ * explicitly since the list item may not know about model changes yet.
+ */
+static void
+update_list_item_header (GtdTaskListView *self,
+                         GtkListItem     *list_item,
+                         guint            position)
+{
+  GtdTaskListViewPrivate *priv;
+  g_autoptr (GtdTask) previous_task = NULL;
+  GtkWidget *header;
+  GtkWidget *child;
+  GtkWidget *box;
+  GtdTaskRow *row;
+  GtdTask *task;
+
+  priv = gtd_task_list_view_get_instance_private (self);
+  row = task_row_from_list_item (list_item);
+  box = gtk_widget_get_parent (GTK_WIDGET (row));
+
+  /* Remove the current header, if any */
+  child = gtk_widget_get_first_child (box);
+  if (child != GTK_WIDGET (row))
+    gtk_box_remove (GTK_BOX (box), child);
+
+  task = gtd_task_row_get_task (row);
+
+  if (!priv->header_func || !task)
+    return;
+
+  if (position > 0)
+    previous_task = g_list_model_get_item (priv->model, position - 1);
+
+  header = create_header (self, task, previous_task);
+
+  if (header)
+    gtk_box_prepend (GTK_BOX (box), header);
+}
+
+static void
+update_bound_headers (GtdTaskListView *self)
+{
+  GtdTaskListViewPrivate *priv = gtd_task_list_view_get_instance_private (self);
+  GHashTableIter iter;
+  GtdTaskRow *row;
+
+  g_hash_table_iter_init (&iter, priv->task_to_row);
+  while (g_hash_table_iter_next (&iter, NULL, (gpointer*) &row))
+    {
+      GtkListItem *list_item = g_object_get_data (G_OBJECT (row), "list-item");
+
+      update_list_item_header (self, list_item, gtk_list_item_get_position (list_item));
+    }
+}
+
+static void
+bind_model (GtdTaskListView *self)
+{
+  GtdTaskListViewPrivate *priv = gtd_task_list_view_get_instance_private (self);
+
+  if (priv->virtualized)
+    {
+      g_autoptr (GtkNoSelection) selection_model = NULL;
+
+      gtk_list_box_bind_model (priv->listbox, NULL, NULL, NULL, NULL);
+      g_hash_table_remove_all (priv->task_to_row);
+
+      if (priv->model)
+        selection_model = gtk_no_selection_new (priv->model);
+
+      gtk_list_view_set_model (priv->listview, GTK_SELECTION_MODEL (selection_model));
+    }
+  else
+    {
+      gtk_list_view_set_model (priv->listview, NULL);
+      g_hash_table_remove_all (priv->task_to_row);
+
+      gtk_list_box_bind_model (priv->listbox,
+                               priv->model,
+                               priv->model ? create_row_for_task_cb : NULL,
+                               self,
+                               NULL);
+    }
+}
+
+static void
+move_new_task_row (GtdTaskListView *self)
+{
+  GtdTaskListViewPrivate *priv;
+  GtkWidget *new_task_row;
+  GtkBox *new_parent;
+
+  priv = gtd_task_list_view_get_instance_private (self);
+  new_task_row = GTK_WIDGET (priv->new_task_row);
+  new_parent = priv->virtualized ? priv->listview_new_task_box : priv->listbox_box;
+
+  if (gtk_widget_get_parent (new_task_row) == GTK_WIDGET (new_parent))
+    return;
+
+  g_object_ref (new_task_row);
+  gtk_box_remove (GTK_BOX (gtk_widget_get_parent (new_task_row)), new_task_row);
+  gtk_box_append (new_parent, new_task_row);
+  g_object_unref (new_task_row);
+}
+
 static void
 set_active_row (GtdTaskListView *self,
                 GtdTaskRow      *row)
@@ -215,6 +406,16 @@ set_active_row (GtdTaskListView *self,
     }
 }
 
+static void
+toggle_active_row (GtdTaskListView *self,
+                   GtdTaskRow      *row)
+{
+  if (gtd_task_row_get_active (row))
+    set_active_row (self, NULL);
+  else
+    set_active_row (self, row);
+}
+
 static gboolean
 iterate_subtasks (GtdTaskListView    *self,
                   GtdTask            *task,
@@ -236,6 +437,52 @@ iterate_subtasks (GtdTaskListView    *self,
   return TRUE;
 }
 
+static void
+collect_task_and_subtasks (GtdTask   *task,
+                           GPtrArray *tasks)
+{
+  GtdTask *aux;
+
+  g_ptr_array_add (tasks, g_object_ref (task));
+
+  for (aux = gtd_task_get_first_subtask (task);
+       aux;
+       aux = gtd_task_get_next_sibling (aux))
+    {
+      collect_task_and_subtasks (aux, tasks);
+    }
+}
+
+static GHashTable*
+group_tasks_by_list (GPtrArray *tasks)
+{
+  GHashTable *list_to_tasks;
+  guint i;
+
+  list_to_tasks = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, (GDestroyNotify) g_ptr_array_unref);
+
+  for (i = 0; i < tasks->len; i++)
+    {
+      GPtrArray *list_tasks;
+      GtdTaskList *list;
+      GtdTask *task;
+
+      task = g_ptr_array_index (tasks, i);
+      list = gtd_task_get_list (task);
+      list_tasks = g_hash_table_lookup (list_to_tasks, list);
+
+      if (!list_tasks)
+        {
+          list_tasks = g_ptr_array_new ();
+          g_hash_table_insert (list_to_tasks, list, list_tasks);
+        }
+
+      g_ptr_array_add (list_tasks, task);
+    }
+
+  return list_to_tasks;
+}
+
 static void
 update_font_color (GtdTaskListView *self)
 {
@@ -294,20 +541,7 @@ create_row_for_task_cb (gpointer item,
   priv = gtd_task_list_view_get_instance_private (self);
 
   row = gtd_task_row_new (item, priv->renderer);
-
-  g_object_bind_property (self,
-                          "handle-subtasks",
-                          row,
-                          "handle-subtasks",
-                          G_BINDING_DEFAULT | G_BINDING_SYNC_CREATE);
-
-  gtd_task_row_set_list_name_visible (GTD_TASK_ROW (row), priv->show_list_name);
-  gtd_task_row_set_due_date_visible (GTD_TASK_ROW (row), priv->show_due_date);
-
-  g_signal_connect_swapped (row, "enter", G_CALLBACK (on_task_row_entered_cb), self);
-  g_signal_connect_swapped (row, "exit", G_CALLBACK (on_task_row_exited_cb), self);
-
-  g_signal_connect (row, "remove-task", G_CALLBACK (on_remove_task_row_cb), self);
+  setup_task_row (self, GTD_TASK_ROW (row));
 
   listbox_row = gtk_list_box_row_new ();
   gtk_list_box_row_set_child (GTK_LIST_BOX_ROW (listbox_row), row);
@@ -319,6 +553,132 @@ create_row_for_task_cb (gpointer item,
   return listbox_row;
 }
 
+static void
+on_list_item_setup_cb (GtkSignalListItemFactory *factory,
+                       GtkListItem              *list_item,
+                       GtdTaskListView          *self)
+{
+  GtdTaskListViewPrivate *priv;
+  GtkLayoutManager *layout;
+  GtkWidget *cell;
+  GtkWidget *box;
+  GtkWidget *row;
+
+  priv = gtd_task_list_view_get_instance_private (self);
+
+  row = gtd_task_row_new (NULL, priv->renderer);
+  setup_task_row (self, GTD_TASK_ROW (row));
+
+  /* The header, when there's one, is prepended to this box */
+  box = gtk_box_new (GTK_ORIENTATION_VERTICAL, 0);
+  gtk_widget_set_margin_start (box, 18);
+  gtk_widget_set_margin_end (box, 18);
+  gtk_box_append (GTK_BOX (box), row);
+
+  /* Same width constraints of the list box */
+  layout = gtd_max_size_layout_new ();
+  gtd_max_size_layout_set_max_width (GTD_MAX_SIZE_LAYOUT (layout), MAX_ROW_WIDTH);
+
+  cell = gtd_widget_new ();
+  gtk_widget_set_hexpand (cell, TRUE);
+  gtk_widget_set_halign (cell, GTK_ALIGN_CENTER);
+  gtk_widget_set_layout_manager (cell, layout);
+  gtk_widget_insert_before (box, cell, NULL);
+
+  g_object_set_data (G_OBJECT (box), "task-row", row);
+  g_object_set_data (G_OBJECT (row), "list-item", list_item);
+  g_object_set_data (G_OBJECT (list_item), "task-row", row);
+
+  gtk_list_item_set_child (list_item, cell);
+}
+
+static void
+on_list_item_bind_cb (GtkSignalListItemFactory *factory,
+                      GtkListItem              *list_item,
+                      GtdTaskListView          *self)
+{
+  GtdTaskListViewPrivate *priv;
+  GtdTaskRow *row;
+  GtdTask *task;
+
+  priv = gtd_task_list_view_get_instance_private (self);
+  row = task_row_from_list_item (list_item);
+  task = gtk_list_item_get_item (list_item);
+
+  gtd_task_row_set_task (row, task);
+  gtd_task_row_set_list_name_visible (row, priv->show_list_name);
+  gtd_task_row_set_due_date_visible (row, priv->show_due_date);
+
+  /* Recycled rows may have been hidden by a drag operation */
+  gtk_widget_show (GTK_WIDGET (row));
+
+  update_list_item_header (self, list_item, gtk_list_item_get_position (list_item));
+
+  g_hash_table_insert (priv->task_to_row, task, row);
+}
+
+static void
+on_list_item_unbind_cb (GtkSignalListItemFactory *factory,
+                        GtkListItem              *list_item,
+                        GtdTaskListView          *self)
+{
+  GtdTaskListViewPrivate *priv;
+  GtdTaskRow *row;
+  GtdTask *task;
+
+  priv = gtd_task_list_view_get_instance_private (self);
+  row = task_row_from_list_item (list_item);
+  task = gtd_task_row_get_task (row);
+
+  /* Closing the row saves any pending change before it's recycled */
+  if (priv->active_row == row)
+    set_active_row (self, NULL);
+
+  if (priv->highlighted_row == row)
+    unset_previously_highlighted_row (self);
+
+  if (g_hash_table_lookup (priv->task_to_row, task) == row)
+    g_hash_table_remove (priv->task_to_row, task);
+
+  gtd_task_row_set_task (row, NULL);
+}
+
+static void
+on_model_items_changed_cb (GtdTaskListView *self,
+                           guint            position,
+                           guint            removed,
+                           guint            added,
+                           GListModel      *model)
+{
+  GtdTaskListViewPrivate *priv;
+  g_autoptr (GtdTask) next_task = NULL;
+  GtkListItem *list_item;
+  GtdTaskRow *row;
+
+  priv = gtd_task_list_view_get_instance_private (self);
+
+  if (!priv->virtualized || !priv->header_func)
+    return;
+
+  /*
+   * The header of the task right after the changed range depends on the
+   * task before it, which may have changed. Rows of new tasks are handled
+   * when they're bound.
+   */
+  next_task = g_list_model_get_item (model, position + added);
+
+  if (!next_task)
+    return;
+
+  row = g_hash_table_lookup (priv->task_to_row, next_task);
+
+  if (!row)
+    return;
+
+  list_item = g_object_get_data (G_OBJECT (row), "list-item");
+  update_list_item_header (self, list_item, position + added);
+}
+
 static gboolean
 scroll_to_bottom_cb (gpointer data)
 {
@@ -347,7 +707,7 @@ scroll_to_bottom_cb (gpointer data)
       gboolean ignored;
 
       gtk_widget_grab_focus (GTK_WIDGET (priv->new_task_row));
-      g_signal_emit_by_name (priv->scrolled_window, "scroll-child", GTK_SCROLL_END, FALSE, &ignored);
+      g_signal_emit_by_name (get_scrolled_window (data), "scroll-child", GTK_SCROLL_END, FALSE, &ignored);
     }
 
   return G_SOURCE_REMOVE;
@@ -378,31 +738,154 @@ remove_task_cb (GtdTaskListView *self,
   return TRUE;
 }
 
+static void
+on_tasks_removed_cb (GObject      *source,
+                     GAsyncResult *result,
+                     gpointer      user_data)
+{
+  g_autoptr (GError) error = NULL;
+
+  gtd_provider_remove_tasks_finish (GTD_PROVIDER (source), result, &error);
+
+  if (error)
+    g_warning ("Error removing tasks: %s", error->message);
+}
+
+static void
+on_clear_completed_tasks_action_cb (GtdNotification *notification,
+                                    gpointer         user_data)
+{
+  g_autoptr (GHashTable) provider_to_tasks = NULL;
+  g_autoptr (GPtrArray) tasks = NULL;
+  GHashTableIter iter;
+  GPtrArray *provider_tasks;
+  GtdProvider *provider;
+  guint i;
+
+  tasks = user_data;
+
+  /*
+   * Detach all tasks before collecting the subtasks, so that completed
+   * subtasks of completed tasks are not collected twice.
+   */
+  for (i = 0; i < tasks->len; i++)
+    {
+      GtdTask *task = g_ptr_array_index (tasks, i);
+
+      if (gtd_task_get_parent (task))
+        gtd_task_remove_subtask (gtd_task_get_parent (task), task);
+    }
+
+  provider_to_tasks = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, (GDestroyNotify) g_ptr_array_unref);
+
+  for (i = 0; i < tasks->len; i++)
+    {
+      GtdTask *task = g_ptr_array_index (tasks, i);
+
+      provider = gtd_task_get_provider (task);
+      provider_tasks = g_hash_table_lookup (provider_to_tasks, provider);
+
+      if (!provider_tasks)
+        {
+          provider_tasks = g_ptr_array_new_with_free_func (g_object_unref);
+          g_hash_table_insert (provider_to_tasks, provider, provider_tasks);
+        }
+
+      collect_task_and_subtasks (task, provider_tasks);
+    }
+
+  /* Each provider removes all of its tasks at once */
+  g_hash_table_iter_init (&iter, provider_to_tasks);
+  while (g_hash_table_iter_next (&iter, (gpointer *) &provider, (gpointer *) &provider_tasks))
+    gtd_provider_remove_tasks (provider, provider_tasks, NULL, on_tasks_removed_cb, NULL);
+}
+
+static void
+on_undo_clear_completed_tasks_action_cb (GtdNotification *notification,
+                                         gpointer         user_data)
+{
+  g_autoptr (GHashTable) list_to_tasks = NULL;
+  g_autoptr (GPtrArray) tasks = NULL;
+  GHashTableIter iter;
+  GPtrArray *list_tasks;
+  GtdTaskList *list;
+
+  tasks = user_data;
+  list_to_tasks = group_tasks_by_list (tasks);
+
+  /* Put the tasks, and their subtasks, back in their lists */
+  g_hash_table_iter_init (&iter, list_to_tasks);
+  while (g_hash_table_iter_next (&iter, (gpointer *) &list, (gpointer *) &list_tasks))
+    gtd_task_list_add_tasks (list, list_tasks);
+}
+
 static void
 on_clear_completed_tasks_activated_cb (GSimpleAction *simple,
                                        GVariant      *parameter,
                                        gpointer       user_data)
 {
+  g_autoptr (GHashTable) list_to_tasks = NULL;
+  g_autoptr (GPtrArray) tasks = NULL;
+  g_autofree gchar *text = NULL;
+  GtdNotification *notification;
   GtdTaskListView *self;
+  GHashTableIter iter;
+  GPtrArray *list_tasks;
+  GtdTaskList *list;
   GListModel *model;
+  GtdWindow *window;
   guint i;
 
   self = GTD_TASK_LIST_VIEW (user_data);
   model = self->priv->model;
 
+  tasks = g_ptr_array_new_with_free_func (g_object_unref);
+
   for (i = 0; i < g_list_model_get_n_items (model); i++)
     {
       g_autoptr (GtdTask) task = g_list_model_get_item (model, i);
 
-      if (!gtd_task_get_complete (task))
-        continue;
+      if (gtd_task_get_complete (task))
+        g_ptr_array_add (tasks, g_steal_pointer (&task));
+    }
 
-      if (gtd_task_get_parent (task))
-        gtd_task_remove_subtask (gtd_task_get_parent (task), task);
+  if (tasks->len == 0)
+    return;
 
-      /* Remove the subtasks recursively */
-      iterate_subtasks (self, task, remove_task_cb);
-    }
+  GTD_TRACE_MSG ("Clearing %u completed tasks", tasks->len);
+
+  /* Remove the tasks, and their subtasks, with a single items-changed per list */
+  list_to_tasks = group_tasks_by_list (tasks);
+
+  g_hash_table_iter_init (&iter, list_to_tasks);
+  while (g_hash_table_iter_next (&iter, (gpointer *) &list, (gpointer *) &list_tasks))
+    gtd_task_list_remove_tasks (list, list_tasks);
+
+  set_active_row (self, NULL);
+
+  /* The tasks are only removed from the providers when the notification is dismissed */
+  text = g_strdup_printf (g_dngettext (NULL,
+                                       "%u completed task removed",
+                                       "%u completed tasks removed",
+                                       tasks->len),
+                          tasks->len);
+
+  notification = gtd_notification_new (text, 5000.0);
+
+  gtd_notification_set_primary_action (notification,
+                                       (GtdNotificationActionFunc) on_clear_completed_tasks_action_cb,
+                                       tasks);
+
+  gtd_notification_set_secondary_action (notification,
+                                         _("Undo"),
+                                         (GtdNotificationActionFunc) on_undo_clear_completed_tasks_action_cb,
+                                         tasks);
+
+  window = GTD_WINDOW (gtk_widget_get_root (GTK_WIDGET (self)));
+  gtd_window_notify (window, notification);
+
+  /* Only one of the actions runs, and it takes ownership of the array */
+  g_steal_pointer (&tasks);
 }
 
 static void
@@ -552,17 +1035,30 @@ on_listbox_row_activated_cb (GtkListBox      *listbox,
                              GtkListBoxRow   *row,
                              GtdTaskListView *self)
 {
+  GTD_ENTRY;
+
+  toggle_active_row (self, task_row_from_row (row));
+
+  GTD_EXIT;
+}
+
+static void
+on_listview_activate_cb (GtkListView     *listview,
+                         guint            position,
+                         GtdTaskListView *self)
+{
+  GtdTaskListViewPrivate *priv;
+  g_autoptr (GtdTask) task = NULL;
   GtdTaskRow *task_row;
 
   GTD_ENTRY;
 
-  task_row = task_row_from_row (row);
+  priv = gtd_task_list_view_get_instance_private (self);
+  task = g_list_model_get_item (priv->model, position);
+  task_row = g_hash_table_lookup (priv->task_to_row, task);
 
-  /* Toggle the row */
-  if (gtd_task_row_get_active (task_row))
-    set_active_row (self, NULL);
-  else
-    set_active_row (self, task_row);
+  if (task_row)
+    toggle_active_row (self, task_row);
 
   GTD_EXIT;
 }
@@ -577,7 +1073,6 @@ internal_header_func (GtkListBoxRow   *row,
                       GtkListBoxRow   *before,
                       GtdTaskListView *view)
 {
-  GtkWidget *header;
   GtdTask *row_task;
   GtdTask *before_task;
 
@@ -592,17 +1087,7 @@ internal_header_func (GtkListBoxRow   *row,
   if (before)
       before_task = gtd_task_row_get_task (task_row_from_row (before));
 
-  header = view->priv->header_func (row_task, before_task, view->priv->header_user_data);
-
-  if (header)
-    {
-      GtkWidget *real_header = gtd_widget_new ();
-      gtk_widget_insert_before (header, real_header, NULL);
-
-      header = real_header;
-    }
-
-  gtk_list_box_row_set_header (row, header);
+  gtk_list_box_row_set_header (row, create_header (view, row_task, before_task));
 }
 
 
@@ -610,22 +1095,9 @@ internal_header_func (GtkListBoxRow   *row,
  * Drag n' Drop functions
  */
 
-static gboolean
-row_is_subtask_of (GtdTaskRow *row_a,
-                   GtdTaskRow *row_b)
-{
-  GtdTask *task_a;
-  GtdTask *task_b;
-
-  task_a = gtd_task_row_get_task (row_a);
-  task_b = gtd_task_row_get_task (row_b);
-
-  return gtd_task_is_subtask (task_a, task_b);
-}
-
 static GtkListBoxRow*
-get_drop_row_at_y (GtdTaskListView *self,
-                   gdouble          y)
+get_listbox_drop_row_at_y (GtdTaskListView *self,
+                           gdouble          y)
 {
   GtdTaskListViewPrivate *priv;
   GtkListBoxRow *hovered_row;
@@ -684,13 +1156,120 @@ get_drop_row_at_y (GtdTaskListView *self,
   return drop_row ? drop_row : NULL;
 }
 
+static GtdTaskRow*
+get_listview_task_row_at_y (GtdTaskListView *self,
+                            gdouble          y)
+{
+  GtdTaskListViewPrivate *priv;
+  GtkWidget *widget;
+
+  priv = gtd_task_list_view_get_instance_private (self);
+
+  /* Rows are centered, so pick at the middle to not hit the margins */
+  widget = gtk_widget_pick (GTK_WIDGET (priv->listview),
+                            gtk_widget_get_width (GTK_WIDGET (priv->listview)) / 2.0,
+                            y,
+                            GTK_PICK_INSENSITIVE);
+
+  for (; widget && widget != GTK_WIDGET (priv->listview); widget = gtk_widget_get_parent (widget))
+    {
+      GtdTaskRow *row = g_object_get_data (G_OBJECT (widget), "task-row");
+
+      if (row)
+        return row;
+    }
+
+  return NULL;
+}
+
+/*
+ * Same as get_listbox_drop_row_at_y(), but only rows of visible tasks
+ * exist, so the previous task row may not be available.
+ */
+static GtdTaskRow*
+get_listview_drop_row_at_y (GtdTaskListView *self,
+                            gdouble          y)
+{
+  GtdTaskListViewPrivate *priv;
+  GtkListItem *list_item;
+  GtdTaskRow *hovered_row;
+  gboolean hovered_visible;
+  gdouble row_y, row_height;
+  guint position;
+  guint i;
+
+  priv = gtd_task_list_view_get_instance_private (self);
+
+  hovered_row = get_listview_task_row_at_y (self, y);
+
+  if (!hovered_row)
+    return NULL;
+
+  list_item = g_object_get_data (G_OBJECT (hovered_row), "list-item");
+  position = gtk_list_item_get_position (list_item);
+  hovered_visible = gtk_widget_get_visible (GTK_WIDGET (hovered_row));
+
+  if (position == 0)
+    return hovered_visible ? hovered_row : NULL;
+
+  row_height = gtk_widget_get_allocated_height (GTK_WIDGET (hovered_row));
+  gtk_widget_translate_coordinates (GTK_WIDGET (priv->listview),
+                                    GTK_WIDGET (hovered_row),
+                                    0,
+                                    y,
+                                    NULL,
+                                    &row_y);
+
+  if (hovered_visible && row_y >= row_height / 2)
+    return hovered_row;
+
+  /* Search for a valid task row */
+  for (i = position; i > 0; i--)
+    {
+      g_autoptr (GtdTask) task = NULL;
+      GtdTaskRow *aux;
+
+      task = g_list_model_get_item (priv->model, i - 1);
+      aux = g_hash_table_lookup (priv->task_to_row, task);
+
+      /* Not bound, i.e. out of the visible area */
+      if (!aux)
+        break;
+
+      /* Skip hidden rows */
+      if (!gtk_widget_get_visible (GTK_WIDGET (aux)))
+        continue;
+
+      return aux;
+    }
+
+  return hovered_visible ? hovered_row : NULL;
+}
+
+static GtdTaskRow*
+get_drop_row_at_y (GtdTaskListView *self,
+                   gdouble          y)
+{
+  GtdTaskListViewPrivate *priv;
+  GtkListBoxRow *drop_row;
+
+  priv = gtd_task_list_view_get_instance_private (self);
+
+  if (priv->virtualized)
+    return get_listview_drop_row_at_y (self, y);
+
+  drop_row = get_listbox_drop_row_at_y (self, y);
+
+  return drop_row ? task_row_from_row (drop_row) : NULL;
+}
+
 static void
 unset_previously_highlighted_row (GtdTaskListView *self)
 {
   GtdTaskListViewPrivate *priv = gtd_task_list_view_get_instance_private (self);
   if (priv->highlighted_row)
     {
-      gtd_task_row_unset_drag_offset (task_row_from_row (priv->highlighted_row));
+      gtd_task_row_unset_drag_offset (priv->highlighted_row);
       priv->highlighted_row = NULL;
     }
 }
@@ -703,7 +1282,7 @@ scroll_to_dnd (gpointer user_data)
   gint value;
 
   priv = gtd_task_list_view_get_instance_private (user_data);
-  vadjustment = gtk_scrolled_window_get_vadjustment (GTK_SCROLLED_WINDOW (priv->scrolled_window));
+  vadjustment = gtk_scrolled_window_get_vadjustment (GTK_SCROLLED_WINDOW (get_scrolled_window (user_data)));
   value = gtk_adjustment_get_value (vadjustment) + (priv->scroll_up ? -6 : 6);
 
   gtk_adjustment_set_value (vadjustment,
@@ -731,9 +1310,9 @@ check_dnd_scroll (GtdTaskListView *self,
       return;
     }
 
-  height = gtk_widget_get_allocated_height (priv->scrolled_window);
-  gtk_widget_translate_coordinates (GTK_WIDGET (priv->listbox),
-                                    priv->scrolled_window,
+  height = gtk_widget_get_allocated_height (get_scrolled_window (self));
+  gtk_widget_translate_coordinates (get_list_widget (self),
+                                    get_scrolled_window (self),
                                     0, y,
                                     NULL, &current_y);
 
@@ -774,8 +1353,7 @@ on_drop_target_drag_motion_cb (GtkDropTarget   *drop_target,
                                GtdTaskListView *self)
 {
   GtdTaskListViewPrivate *priv;
-  GtkListBoxRow *highlighted_row;
-  GtdTaskRow *highlighted_task_row;
+  GtdTaskRow *highlighted_row;
   GtdTaskRow *source_task_row;
   const GValue *value;
   GdkDrop *drop;
@@ -798,13 +1376,17 @@ on_drop_target_drag_motion_cb (GtkDropTarget   *drop_target,
   value = gtk_drop_target_get_value (drop_target);
   task = g_value_get_object (value);
 
+  /* In virtualized mode, the source row may have been recycled already */
   source_task_row = g_hash_table_lookup (priv->task_to_row, task);
 
   /* Update the x value according to the current offset */
-  if (gtk_widget_get_direction (GTK_WIDGET (self)) == GTK_TEXT_DIR_RTL)
-    x += gtd_task_row_get_x_offset (source_task_row);
-  else
-    x -= gtd_task_row_get_x_offset (source_task_row);
+  if (source_task_row)
+    {
+      if (gtk_widget_get_direction (GTK_WIDGET (self)) == GTK_TEXT_DIR_RTL)
+        x += gtd_task_row_get_x_offset (source_task_row);
+      else
+        x -= gtd_task_row_get_x_offset (source_task_row);
+    }
 
   unset_previously_highlighted_row (self);
 
@@ -812,20 +1394,18 @@ on_drop_target_drag_motion_cb (GtkDropTarget   *drop_target,
   if (!highlighted_row)
     GTD_GOTO (success);
 
-  highlighted_task_row = task_row_from_row (highlighted_row);
-
   /* Forbid dropping a row over a subtask row */
-  if (row_is_subtask_of (source_task_row, highlighted_task_row))
+  if (gtd_task_is_subtask (task, gtd_task_row_get_task (highlighted_row)))
     GTD_GOTO (fail);
 
-  gtk_widget_translate_coordinates (GTK_WIDGET (priv->listbox),
-                                    GTK_WIDGET (highlighted_task_row),
+  gtk_widget_translate_coordinates (get_list_widget (self),
+                                    GTK_WIDGET (highlighted_row),
                                     x,
                                     0,
                                     &x_offset,
                                     NULL);
 
-  gtd_task_row_set_drag_offset (highlighted_task_row, source_task_row, x_offset);
+  gtd_task_row_set_drag_offset (highlighted_row, source_task_row, x_offset);
   priv->highlighted_row = highlighted_row;
 
 success:
@@ -844,7 +1424,6 @@ on_drop_target_drag_drop_cb (GtkDropTarget   *drop_target,
                              GtdTaskListView *self)
 {
   GtdTaskListViewPrivate *priv;
-  GtkListBoxRow *drop_row;
   GtdProvider *provider;
   GtdTaskRow *hovered_row;
   GtkWidget *row;
@@ -877,10 +1456,18 @@ on_drop_target_drag_drop_cb (GtkDropTarget   *drop_target,
    * to show it again.
    */
   row = g_hash_table_lookup (priv->task_to_row, source_task);
-  gtk_widget_show (row);
+  if (row)
+    gtk_widget_show (row);
+
+  hovered_row = get_drop_row_at_y (self, y);
+
+  if (!hovered_row)
+    {
+      check_dnd_scroll (self, TRUE, -1);
+      gdk_drop_finish (drop, 0);
+      GTD_RETURN (FALSE);
+    }
 
-  drop_row = get_drop_row_at_y (self, y);
-  hovered_row = task_row_from_row (drop_row);
   hovered_task = gtd_task_row_get_task (hovered_row);
   new_parent_task = gtd_task_row_get_dnd_drop_task (hovered_row);
 
@@ -931,6 +1518,20 @@ on_drop_target_drag_drop_cb (GtkDropTarget   *drop_target,
   GTD_RETURN (TRUE);
 }
 
+static GtkEventController*
+create_drop_target (GtdTaskListView *self)
+{
+  GtkDropTarget *target;
+
+  target = gtk_drop_target_new (GTD_TYPE_TASK, GDK_ACTION_MOVE);
+  gtk_drop_target_set_preload (target, TRUE);
+  g_signal_connect (target, "drop", G_CALLBACK (on_drop_target_drag_drop_cb), self);
+  g_signal_connect (target, "leave", G_CALLBACK (on_drop_target_drag_leave_cb), self);
+  g_signal_connect (target, "motion", G_CALLBACK (on_drop_target_drag_motion_cb), self);
+
+  return GTK_EVENT_CONTROLLER (target);
+}
+
 
 /*
  * GObject overrides
@@ -980,6 +1581,10 @@ gtd_task_list_view_get_property (GObject    *object,
       g_value_set_boolean (value, gtk_widget_get_visible (GTK_WIDGET (self->priv->new_task_row)));
       break;
 
+    case PROP_VIRTUALIZED:
+      g_value_set_boolean (value, self->priv->virtualized);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
     }
@@ -1015,6 +1620,10 @@ gtd_task_list_view_set_property (GObject      *object,
       gtd_task_list_view_set_show_new_task_row (self, g_value_get_boolean (value));
       break;
 
+    case PROP_VIRTUALIZED:
+      gtd_task_list_view_set_virtualized (self, g_value_get_boolean (value));
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
     }
@@ -1156,16 +1765,37 @@ gtd_task_list_view_class_init (GtdTaskListViewClass *klass)
                               TRUE,
                               G_PARAM_READWRITE));
 
+  /**
+   * GtdTaskListView::virtualized:
+   *
+   * Whether only the visible tasks have rows, which are recycled
+   * while scrolling.
+   */
+  g_object_class_install_property (
+        object_class,
+        PROP_VIRTUALIZED,
+        g_param_spec_boolean ("virtualized",
+                              "Whether the list is virtualized",
+                              "Whether only rows of visible tasks are created",
+                              FALSE,
+                              G_PARAM_READWRITE));
+
   gtk_widget_class_set_template_from_resource (widget_class, "/org/gnome/todo/ui/gtd-task-list-view.ui");
 
   gtk_widget_class_bind_template_child_private (widget_class, GtdTaskListView, due_date_sizegroup);
   gtk_widget_class_bind_template_child_private (widget_class, GtdTaskListView, listbox);
+  gtk_widget_class_bind_template_child_private (widget_class, GtdTaskListView, listbox_box);
+  gtk_widget_class_bind_template_child_private (widget_class, GtdTaskListView, listview);
+  gtk_widget_class_bind_template_child_private (widget_class, GtdTaskListView, listview_box);
+  gtk_widget_class_bind_template_child_private (widget_class, GtdTaskListView, listview_new_task_box);
+  gtk_widget_class_bind_template_child_private (widget_class, GtdTaskListView, listview_scrolled_window);
   gtk_widget_class_bind_template_child_private (widget_class, GtdTaskListView, new_task_row);
   gtk_widget_class_bind_template_child_private (widget_class, GtdTaskListView, tasklist_name_sizegroup);
   gtk_widget_class_bind_template_child_private (widget_class, GtdTaskListView, scrolled_window);
   gtk_widget_class_bind_template_child_private (widget_class, GtdTaskListView, stack);
 
   gtk_widget_class_bind_template_callback (widget_class, on_listbox_row_activated_cb);
+  gtk_widget_class_bind_template_callback (widget_class, on_listview_activate_cb);
   gtk_widget_class_bind_template_callback (widget_class, on_new_task_row_entered_cb);
   gtk_widget_class_bind_template_callback (widget_class, on_new_task_row_exited_cb);
   gtk_widget_class_bind_template_callback (widget_class, on_task_row_entered_cb);
@@ -1178,7 +1808,7 @@ static void
 gtd_task_list_view_init (GtdTaskListView *self)
 {
   GtdTaskListViewPrivate *priv;
-  GtkDropTarget *target;
+  g_autoptr (GtkListItemFactory) factory = NULL;
 
   priv = gtd_task_list_view_get_instance_private (self);
 
@@ -1194,13 +1824,14 @@ gtd_task_list_view_init (GtdTaskListView *self)
 
   gtk_widget_init_template (GTK_WIDGET (self));
 
-  target = gtk_drop_target_new (GTD_TYPE_TASK, GDK_ACTION_MOVE);
-  gtk_drop_target_set_preload (target, TRUE);
-  g_signal_connect (target, "drop", G_CALLBACK (on_drop_target_drag_drop_cb), self);
-  g_signal_connect (target, "leave", G_CALLBACK (on_drop_target_drag_leave_cb), self);
-  g_signal_connect (target, "motion", G_CALLBACK (on_drop_target_drag_motion_cb), self);
+  gtk_widget_add_controller (GTK_WIDGET (priv->listbox), create_drop_target (self));
+  gtk_widget_add_controller (GTK_WIDGET (priv->listview), create_drop_target (self));
 
-  gtk_widget_add_controller (GTK_WIDGET (priv->listbox), GTK_EVENT_CONTROLLER (target));
+  factory = gtk_signal_list_item_factory_new ();
+  g_signal_connect (factory, "setup", G_CALLBACK (on_list_item_setup_cb), self);
+  g_signal_connect (factory, "bind", G_CALLBACK (on_list_item_bind_cb), self);
+  g_signal_connect (factory, "unbind", G_CALLBACK (on_list_item_unbind_cb), self);
+  gtk_list_view_set_factory (priv->listview, factory);
 
   priv->renderer = gtd_markdown_renderer_new ();
 }
@@ -1270,10 +1901,10 @@ gtd_task_list_view_get_model (GtdTaskListView *view)
 /**
  * gtd_task_list_view_set_model:
  * @view: a #GtdTaskListView
- * @model: a #GListModel
+ * @model: (nullable): a #GListModel
  *
  * Sets the internal #GListModel of @view. The model must have
- * its element GType as @GtdTask.
+ * its element GType as @GtdTask. Passing %NULL unsets the model.
  */
 void
 gtd_task_list_view_set_model (GtdTaskListView *view,
@@ -1286,18 +1917,31 @@ gtd_task_list_view_set_model (GtdTaskListView *view,
   GtdTaskList *list;
 
   g_return_if_fail (GTD_IS_TASK_LIST_VIEW (view));
-  g_return_if_fail (G_IS_LIST_MODEL (model));
+  g_return_if_fail (!model || G_IS_LIST_MODEL (model));
 
   priv = gtd_task_list_view_get_instance_private (view);
 
-  if (!g_set_object (&priv->model, model))
+  if (priv->model == model)
     return;
 
-  gtk_list_box_bind_model (priv->listbox,
-                           model,
-                           create_row_for_task_cb,
-                           view,
-                           NULL);
+  if (priv->model)
+    g_signal_handlers_disconnect_by_func (priv->model, on_model_items_changed_cb, view);
+
+  g_set_object (&priv->model, model);
+
+  if (model)
+    {
+      g_signal_connect_object (model,
+                               "items-changed",
+                               G_CALLBACK (on_model_items_changed_cb),
+                               view,
+                               G_CONNECT_SWAPPED | G_CONNECT_AFTER);
+    }
+
+  bind_model (view);
+
+  if (!model)
+    return;
 
   schedule_scroll_to_bottom (view);
 
@@ -1356,6 +2000,20 @@ gtd_task_list_view_set_show_list_name (GtdTaskListView *view,
 
       view->priv->show_list_name = show_list_name;
 
+      /* Only bound rows exist, the others are updated when bound */
+      if (view->priv->virtualized)
+        {
+          GHashTableIter iter;
+          GtdTaskRow *row;
+
+          g_hash_table_iter_init (&iter, view->priv->task_to_row);
+          while (g_hash_table_iter_next (&iter, NULL, (gpointer*) &row))
+            gtd_task_row_set_list_name_visible (row, show_list_name);
+
+          g_object_notify (G_OBJECT (view), "show-list-name");
+          return;
+        }
+
       for (child = gtk_widget_get_first_child (GTK_WIDGET (view->priv->listbox));
            child;
            child = gtk_widget_get_next_sibling (child))
@@ -1412,6 +2070,20 @@ gtd_task_list_view_set_show_due_date (GtdTaskListView *self,
 
   priv->show_due_date = show_due_date;
 
+  /* Only bound rows exist, the others are updated when bound */
+  if (priv->virtualized)
+    {
+      GHashTableIter iter;
+      GtdTaskRow *row;
+
+      g_hash_table_iter_init (&iter, priv->task_to_row);
+      while (g_hash_table_iter_next (&iter, NULL, (gpointer*) &row))
+        gtd_task_row_set_due_date_visible (row, show_due_date);
+
+      g_object_notify (G_OBJECT (self), "show-due-date");
+      return;
+    }
+
   for (child = gtk_widget_get_first_child (GTK_WIDGET (priv->listbox));
        child;
        child = gtk_widget_get_next_sibling (child))
@@ -1469,6 +2141,9 @@ gtd_task_list_view_set_header_func (GtdTaskListView           *view,
                                     NULL,
                                     NULL);
     }
+
+  if (priv->virtualized)
+    update_bound_headers (view);
 }
 
 /**
@@ -1664,3 +2339,63 @@ gtd_task_list_view_set_task_list_selector_behavior (GtdTaskListView
       break;
     }
 }
+
+/**
+ * gtd_task_list_view_get_virtualized:
+ * @self: a #GtdTaskListView
+ *
+ * Retrieves whether @self is virtualized.
+ *
+ * Returns: %TRUE if @self is virtualized, %FALSE otherwise
+ */
+gboolean
+gtd_task_list_view_get_virtualized (GtdTaskListView *self)
+{
+  GtdTaskListViewPrivate *priv;
+
+  g_return_val_if_fail (GTD_IS_TASK_LIST_VIEW (self), FALSE);
+
+  priv = gtd_task_list_view_get_instance_private (self);
+
+  return priv->virtualized;
+}
+
+/**
+ * gtd_task_list_view_set_virtualized:
+ * @self: a #GtdTaskListView
+ * @virtualized: %TRUE to virtualize @self
+ *
+ * If %TRUE, @self only creates rows for the tasks that are visible, and
+ * reuses them for other tasks while scrolling, so that showing large
+ * lists takes the same time and memory as small ones. Otherwise, a row
+ * is created for every task of the model.
+ *
+ * Editing a task closes it when its row is scrolled out of view.
+ */
+void
+gtd_task_list_view_set_virtualized (GtdTaskListView *self,
+                                    gboolean         virtualized)
+{
+  GtdTaskListViewPrivate *priv;
+
+  g_return_if_fail (GTD_IS_TASK_LIST_VIEW (self));
+
+  priv = gtd_task_list_view_get_instance_private (self);
+
+  if (priv->virtualized == virtualized)
+    return;
+
+  set_active_row (self, NULL);
+  unset_previously_highlighted_row (self);
+  check_dnd_scroll (self, TRUE, -1);
+
+  priv->virtualized = virtualized;
+
+  gtk_widget_set_visible (priv->scrolled_window, !virtualized);
+  gtk_widget_set_visible (priv->listview_box, virtualized);
+
+  move_new_task_row (self);
+  bind_model (self);
+
+  g_object_notify (G_OBJECT (self), "virtualized");
+}
@@ -96,6 +96,11 @@ GtdTaskListSelectorBehavior gtd_task_list_view_get_task_list_selector_behavior (
 void                        gtd_task_list_view_set_task_list_selector_behavior (GtdTaskListView             *self,
                                                                                 GtdTaskListSelectorBehavior  behavior);
 
+gboolean                  gtd_task_list_view_get_virtualized    (GtdTaskListView        *self);
+
+void                      gtd_task_list_view_set_virtualized    (GtdTaskListView        *self,
+                                                                 gboolean                virtualized);
+
 G_END_DECLS
 
 #endif /* GTD_TASK_LIST_VIEW_H */
@@ -18,6 +18,7 @@
 
 #define G_LOG_DOMAIN "GtdTaskRow"
 
+#include "gtd-clock.h"
 #include "gtd-debug.h"
 #include "gtd-edit-pane.h"
 #include "gtd-manager.h"
@@ -112,7 +113,6 @@ date_to_label_binding_cb (GBinding     *binding,
                           GValue       *to_value,
                           gpointer      user_data)
 {
-  g_autofree gchar *new_label = NULL;
   GDateTime *dt;
 
   g_return_val_if_fail (GTD_IS_TASK_ROW (user_data), FALSE);
@@ -121,45 +121,15 @@ date_to_label_binding_cb (GBinding     *binding,
 
   if (dt)
     {
-      g_autoptr (GDateTime) today = g_date_time_new_now_local ();
+      GtdClock *clock = gtd_manager_get_clock (gtd_manager_get_default ());
 
-      if (g_date_time_get_year (dt) == g_date_time_get_year (today) &&
-          g_date_time_get_month (dt) == g_date_time_get_month (today))
-        {
-          if (g_date_time_get_day_of_month (dt) == g_date_time_get_day_of_month (today))
-            {
-              new_label = g_strdup (_("Today"));
-            }
-          else if (g_date_time_get_day_of_month (dt) == g_date_time_get_day_of_month (today) + 1)
-            {
-              new_label = g_strdup (_("Tomorrow"));
-            }
-          else if (g_date_time_get_day_of_month (dt) == g_date_time_get_day_of_month (today) - 1)
-            {
-              new_label = g_strdup (_("Yesterday"));
-            }
-          else if (g_date_time_get_day_of_year (dt) > g_date_time_get_day_of_month (today) &&
-                   g_date_time_get_day_of_year (dt) < g_date_time_get_day_of_month (today) + 7)
-            {
-              new_label = g_date_time_format (dt, "%A");
-            }
-          else
-            {
-              new_label = g_date_time_format (dt, "%x");
-            }
-        }
-      else
-        {
-          new_label = g_date_time_format (dt, "%x");
-        }
+      g_value_set_static_string (to_value, gtd_clock_get_due_date_label (clock, dt));
     }
   else
     {
-      new_label = g_strdup ("");
+      g_value_set_static_string (to_value, "");
     }
 
-  g_value_set_string (to_value, new_label);
-
   return TRUE;
 }
 
@@ -845,7 +815,9 @@ gtd_task_row_set_handle_subtasks (GtdTaskRow *self,
 
   gtk_widget_set_visible (self->dnd_box, handle_subtasks);
   gtk_widget_set_visible (self->dnd_icon, handle_subtasks);
-  on_depth_changed_cb (self, NULL, self->task);
+
+  if (self->task)
+    on_depth_changed_cb (self, NULL, self->task);
 
   g_object_notify (G_OBJECT (self), "handle-subtasks");
 }
@@ -0,0 +1,32 @@
+/* gtd-due-date-index-private.h
+ *
+ * Copyright 2020 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "gtd-due-date-index.h"
+
+G_BEGIN_DECLS
+
+GtdDueDateIndex*     _gtd_due_date_index_new                     (GtdManager         *manager);
+
+void                 _gtd_due_date_index_set_today               (GtdDueDateIndex    *self,
+                                                                  GDateTime          *today);
+
+G_END_DECLS
@@ -0,0 +1,854 @@
+/* gtd-due-date-index.c
+ *
+ * Copyright 2020 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "GtdDueDateIndex"
+
+#include "gtd-clock.h"
+#include "gtd-debug.h"
+#include "gtd-due-date-index.h"
+#include "gtd-due-date-index-private.h"
+#include "gtd-manager.h"
+#include "gtd-task.h"
+#include "gtd-task-list.h"
+
+/**
+ * SECTION:gtd-due-date-index
+ * @short_description: tasks indexed by their due day
+ * @title:GtdDueDateIndex
+ * @stability:Unstable
+ * @see_also:#GtdManager
+ *
+ * #GtdDueDateIndex keeps every task of the unarchived task lists sorted
+ * by due day, and then by gtd_task_compare(). It is updated incrementally
+ * from the task lists' signals, and exposes #GListModels for ranges of days
+ * relative to today with gtd_due_date_index_get_model().
+ *
+ * Range models are contiguous slices of the index, so querying them, and
+ * moving them when the day changes, only costs as much as the number of
+ * tasks inside the range.
+ */
+
+/* Tasks without a due date are sorted after every other task */
+#define UNDATED_DAY G_MAXINT
+
+typedef enum
+{
+  ALL_TASKS,
+  INCOMPLETE_TASKS,
+  N_SEQUENCES
+} SequenceId;
+
+typedef struct
+{
+  GtdTask            *task;
+  GSequenceIter      *iters[N_SEQUENCES];
+  gint                day;
+} IndexEntry;
+
+#define GTD_TYPE_DUE_DATE_RANGE_MODEL (gtd_due_date_range_model_get_type())
+
+G_DECLARE_FINAL_TYPE (GtdDueDateRangeModel, gtd_due_date_range_model, GTD, DUE_DATE_RANGE_MODEL, GObject)
+
+struct _GtdDueDateRangeModel
+{
+  GObject             parent;
+
+  GtdDueDateIndex    *index;
+  GtdDueDateRange     range;
+  SequenceId          sequence_id;
+
+  gint64              start_day;
+  gint64              end_day;
+  guint               n_items;
+};
+
+struct _GtdDueDateIndex
+{
+  GObject             parent;
+
+  GtdManager         *manager;
+
+  GHashTable         *entries;
+  GHashTable         *lists;
+  GSequence          *sequences[N_SEQUENCES];
+
+  GtdDueDateRangeModel *models[GTD_DUE_DATE_RANGE_LAST][N_SEQUENCES];
+
+  gint                today;
+};
+
+static void          g_list_model_iface_init                     (GListModelInterface *iface);
+
+G_DEFINE_TYPE_WITH_CODE (GtdDueDateRangeModel, gtd_due_date_range_model, G_TYPE_OBJECT,
+                         G_IMPLEMENT_INTERFACE (G_TYPE_LIST_MODEL, g_list_model_iface_init))
+
+G_DEFINE_TYPE (GtdDueDateIndex, gtd_due_date_index, G_TYPE_OBJECT)
+
+static void          on_task_notify_cb                           (GtdTask            *task,
+                                                                  GParamSpec         *pspec,
+                                                                  GtdDueDateIndex    *self);
+
+
+/*
+ * Auxiliary methods
+ */
+
+static gint
+get_julian_day (GDateTime *dt)
+{
+  GDate date;
+
+  g_date_clear (&date, 1);
+  g_date_set_dmy (&date,
+                  g_date_time_get_day_of_month (dt),
+                  g_date_time_get_month (dt),
+                  g_date_time_get_year (dt));
+
+  return g_date_get_julian (&date);
+}
+
+static gint
+get_task_day (GtdTask *task)
+{
+  g_autoptr (GDateTime) due_date = NULL;
+
+  due_date = gtd_task_get_due_date (task);
+
+  return due_date ? get_julian_day (due_date) : UNDATED_DAY;
+}
+
+static gint
+get_today (void)
+{
+  g_autoptr (GDateTime) now = NULL;
+
+  now = g_date_time_new_now_local ();
+
+  return get_julian_day (now);
+}
+
+static gint
+compare_entries_cb (gconstpointer a,
+                    gconstpointer b,
+                    gpointer      user_data)
+{
+  const IndexEntry *entry_a = a;
+  const IndexEntry *entry_b = b;
+
+  if (entry_a->day != entry_b->day)
+    return entry_a->day < entry_b->day ? -1 : 1;
+
+  return gtd_task_compare (entry_a->task, entry_b->task);
+}
+
+static GSequenceIter*
+find_first_iter_at_day (GSequence *sequence,
+                        gint64     day)
+{
+  GSequenceIter *begin;
+  GSequenceIter *end;
+
+  begin = g_sequence_get_begin_iter (sequence);
+  end = g_sequence_get_end_iter (sequence);
+
+  while (begin != end)
+    {
+      GSequenceIter *middle;
+      IndexEntry *entry;
+
+      middle = g_sequence_range_get_midpoint (begin, end);
+      entry = g_sequence_get (middle);
+
+      if (entry->day < day)
+        begin = g_sequence_iter_next (middle);
+      else
+        end = middle;
+    }
+
+  return begin;
+}
+
+static guint
+get_position_of_day (GSequence *sequence,
+                     gint64     day)
+{
+  if (day <= G_MININT)
+    return 0;
+
+  if (day > UNDATED_DAY)
+    return g_sequence_get_length (sequence);
+
+  return g_sequence_iter_get_position (find_first_iter_at_day (sequence, day));
+}
+
+static gboolean
+is_entry_in_order (GSequenceIter *iter)
+{
+  GSequenceIter *previous;
+  GSequenceIter *next;
+  IndexEntry *entry;
+
+  entry = g_sequence_get (iter);
+  next = g_sequence_iter_next (iter);
+
+  if (!g_sequence_iter_is_end (next) && compare_entries_cb (entry, g_sequence_get (next), NULL) > 0)
+    return FALSE;
+
+  if (g_sequence_iter_is_begin (iter))
+    return TRUE;
+
+  previous = g_sequence_iter_prev (iter);
+
+  return compare_entries_cb (g_sequence_get (previous), entry, NULL) <= 0;
+}
+
+static void
+update_model_bounds (GtdDueDateRangeModel *model,
+                     gint                  today)
+{
+  switch (model->range)
+    {
+    case GTD_DUE_DATE_RANGE_OVERDUE:
+      model->start_day = G_MININT64;
+      model->end_day = today;
+      break;
+
+    case GTD_DUE_DATE_RANGE_TODAY:
+      model->start_day = today;
+      model->end_day = (gint64) today + 1;
+      break;
+
+    case GTD_DUE_DATE_RANGE_NEXT_WEEK:
+      model->start_day = today;
+      model->end_day = (gint64) today + 7;
+      break;
+
+    case GTD_DUE_DATE_RANGE_SCHEDULED:
+      model->start_day = G_MININT64;
+      model->end_day = UNDATED_DAY;
+      break;
+
+    case GTD_DUE_DATE_RANGE_ALL:
+      model->start_day = G_MININT64;
+      model->end_day = G_MAXINT64;
+      break;
+
+    case GTD_DUE_DATE_RANGE_LAST:
+    default:
+      g_assert_not_reached ();
+    }
+}
+
+static guint
+count_model_items (GtdDueDateIndex      *self,
+                   GtdDueDateRangeModel *model)
+{
+  GSequence *sequence = self->sequences[model->sequence_id];
+
+  return get_position_of_day (sequence, model->end_day) - get_position_of_day (sequence, model->start_day);
+}
+
+static void
+emit_items_changed (GtdDueDateIndex *self,
+                    SequenceId       sequence_id,
+                    gint             day,
+                    guint            position,
+                    gboolean         added)
+{
+  guint i;
+
+  for (i = 0; i < GTD_DUE_DATE_RANGE_LAST; i++)
+    {
+      GtdDueDateRangeModel *model;
+      guint start;
+
+      model = self->models[i][sequence_id];
+
+      if (!model || day < model->start_day || day >= model->end_day)
+        continue;
+
+      start = get_position_of_day (self->sequences[sequence_id], model->start_day);
+
+      if (added)
+        {
+          model->n_items++;
+          g_list_model_items_changed (G_LIST_MODEL (model), position - start, 0, 1);
+        }
+      else
+        {
+          model->n_items--;
+          g_list_model_items_changed (G_LIST_MODEL (model), position - start, 1, 0);
+        }
+    }
+}
+
+static void
+insert_entry (GtdDueDateIndex *self,
+              IndexEntry      *entry,
+              SequenceId       sequence_id)
+{
+  GSequenceIter *iter;
+
+  g_assert (entry->iters[sequence_id] == NULL);
+
+  iter = g_sequence_insert_sorted (self->sequences[sequence_id], entry, compare_entries_cb, NULL);
+  entry->iters[sequence_id] = iter;
+
+  emit_items_changed (self, sequence_id, entry->day, g_sequence_iter_get_position (iter), TRUE);
+}
+
+static void
+remove_entry (GtdDueDateIndex *self,
+              IndexEntry      *entry,
+              SequenceId       sequence_id,
+              gint             day)
+{
+  guint position;
+
+  g_assert (entry->iters[sequence_id] != NULL);
+
+  position = g_sequence_iter_get_position (entry->iters[sequence_id]);
+
+  g_sequence_remove (entry->iters[sequence_id]);
+  entry->iters[sequence_id] = NULL;
+
+  emit_items_changed (self, sequence_id, day, position, FALSE);
+}
+
+static void
+update_entry (GtdDueDateIndex *self,
+              IndexEntry      *entry,
+              SequenceId       sequence_id,
+              gboolean         should_contain,
+              gint             old_day)
+{
+  GSequenceIter *iter = entry->iters[sequence_id];
+
+  /* Most notifications don't affect the order at all */
+  if (iter && should_contain && entry->day == old_day && is_entry_in_order (iter))
+    return;
+
+  if (iter)
+    remove_entry (self, entry, sequence_id, old_day);
+
+  if (should_contain)
+    insert_entry (self, entry, sequence_id);
+}
+
+static gboolean
+affects_sort_key (GParamSpec *pspec)
+{
+  return g_strcmp0 (pspec->name, "creation-date") == 0 ||
+         g_strcmp0 (pspec->name, "due-date") == 0 ||
+         g_strcmp0 (pspec->name, "position") == 0 ||
+         g_strcmp0 (pspec->name, "title") == 0;
+}
+
+static void
+collect_subtask_entries (GtdDueDateIndex *self,
+                         GtdTask         *task,
+                         GPtrArray       *entries)
+{
+  GtdTask *subtask;
+
+  for (subtask = gtd_task_get_first_subtask (task); subtask; subtask = gtd_task_get_next_sibling (subtask))
+    {
+      IndexEntry *entry = g_hash_table_lookup (self->entries, subtask);
+
+      if (entry)
+        g_ptr_array_add (entries, entry);
+
+      collect_subtask_entries (self, subtask, entries);
+    }
+}
+
+/*
+ * Subtasks are sorted relative to their ancestors, so when the sort key
+ * of a task changes, its whole subtree may have to move. All entries of
+ * the subtree are out of place at once, which is why they're removed
+ * before any of them is inserted back.
+ */
+static void
+update_subtree (GtdDueDateIndex *self,
+                IndexEntry      *entry,
+                gint             old_day)
+{
+  g_autoptr (GPtrArray) entries = NULL;
+  guint i, j;
+
+  entries = g_ptr_array_new ();
+  g_ptr_array_add (entries, entry);
+  collect_subtask_entries (self, entry->task, entries);
+
+  for (i = 0; i < N_SEQUENCES; i++)
+    {
+      for (j = 0; j < entries->len; j++)
+        {
+          IndexEntry *subtree_entry = g_ptr_array_index (entries, j);
+
+          if (subtree_entry->iters[i])
+            remove_entry (self, subtree_entry, i, subtree_entry == entry ? old_day : subtree_entry->day);
+        }
+
+      for (j = 0; j < entries->len; j++)
+        {
+          IndexEntry *subtree_entry = g_ptr_array_index (entries, j);
+
+          if (i == ALL_TASKS || !gtd_task_get_complete (subtree_entry->task))
+            insert_entry (self, subtree_entry, i);
+        }
+    }
+}
+
+static void
+add_task (GtdDueDateIndex *self,
+          GtdTask         *task)
+{
+  IndexEntry *entry;
+
+  if (g_hash_table_contains (self->entries, task))
+    return;
+
+  entry = g_new0 (IndexEntry, 1);
+  entry->task = g_object_ref (task);
+  entry->day = get_task_day (task);
+
+  g_hash_table_insert (self->entries, task, entry);
+
+  insert_entry (self, entry, ALL_TASKS);
+
+  if (!gtd_task_get_complete (task))
+    insert_entry (self, entry, INCOMPLETE_TASKS);
+
+  g_signal_connect (task, "notify", G_CALLBACK (on_task_notify_cb), self);
+}
+
+static void
+remove_task (GtdDueDateIndex *self,
+             GtdTask         *task)
+{
+  IndexEntry *entry;
+  guint i;
+
+  entry = g_hash_table_lookup (self->entries, task);
+
+  if (!entry)
+    return;
+
+  g_signal_handlers_disconnect_by_func (task, on_task_notify_cb, self);
+
+  for (i = 0; i < N_SEQUENCES; i++)
+    {
+      if (entry->iters[i])
+        remove_entry (self, entry, i, entry->day);
+    }
+
+  g_hash_table_remove (self->entries, task);
+}
+
+static void
+add_tasks_from_list (GtdDueDateIndex *self,
+                     GtdTaskList     *list)
+{
+  guint n_items;
+  guint i;
+
+  n_items = g_list_model_get_n_items (G_LIST_MODEL (list));
+
+  for (i = 0; i < n_items; i++)
+    {
+      g_autoptr (GtdTask) task = g_list_model_get_item (G_LIST_MODEL (list), i);
+
+      add_task (self, task);
+    }
+}
+
+static void
+remove_tasks_from_list (GtdDueDateIndex *self,
+                        GtdTaskList     *list)
+{
+  guint n_items;
+  guint i;
+
+  n_items = g_list_model_get_n_items (G_LIST_MODEL (list));
+
+  for (i = 0; i < n_items; i++)
+    {
+      g_autoptr (GtdTask) task = g_list_model_get_item (G_LIST_MODEL (list), i);
+
+      remove_task (self, task);
+    }
+}
+
+static void
+index_entry_free (IndexEntry *entry)
+{
+  g_clear_object (&entry->task);
+  g_free (entry);
+}
+
+static void
+set_today (GtdDueDateIndex *self,
+           gint             today)
+{
+  guint i, j;
+
+  self->today = today;
+
+  for (i = 0; i < GTD_DUE_DATE_RANGE_LAST; i++)
+    {
+      for (j = 0; j < N_SEQUENCES; j++)
+        {
+          GtdDueDateRangeModel *model;
+          guint old_n_items;
+
+          model = self->models[i][j];
+
+          if (!model)
+            continue;
+
+          old_n_items = model->n_items;
+
+          update_model_bounds (model, self->today);
+          model->n_items = count_model_items (self, model);
+
+          if (old_n_items > 0 || model->n_items > 0)
+            g_list_model_items_changed (G_LIST_MODEL (model), 0, old_n_items, model->n_items);
+        }
+    }
+}
+
+
+/*
+ * Callbacks
+ */
+
+static void
+on_task_notify_cb (GtdTask         *task,
+                   GParamSpec      *pspec,
+                   GtdDueDateIndex *self)
+{
+  IndexEntry *entry;
+  gint old_day;
+
+  entry = g_hash_table_lookup (self->entries, task);
+  g_assert (entry != NULL);
+
+  old_day = entry->day;
+  entry->day = get_task_day (task);
+
+  if (affects_sort_key (pspec) && gtd_task_get_n_direct_subtasks (task) > 0)
+    {
+      update_subtree (self, entry, old_day);
+      return;
+    }
+
+  update_entry (self, entry, ALL_TASKS, TRUE, old_day);
+  update_entry (self, entry, INCOMPLETE_TASKS, !gtd_task_get_complete (task), old_day);
+}
+
+static void
+on_task_added_cb (GtdTaskList     *list,
+                  GtdTask         *task,
+                  GtdDueDateIndex *self)
+{
+  if (gtd_task_list_get_archived (list))
+    return;
+
+  add_task (self, task);
+}
+
+static void
+on_task_removed_cb (GtdTaskList     *list,
+                    GtdTask         *task,
+                    GtdDueDateIndex *self)
+{
+  remove_task (self, task);
+}
+
+static void
+on_list_archived_changed_cb (GtdTaskList     *list,
+                             GParamSpec      *pspec,
+                             GtdDueDateIndex *self)
+{
+  GTD_ENTRY;
+
+  if (gtd_task_list_get_archived (list))
+    remove_tasks_from_list (self, list);
+  else
+    add_tasks_from_list (self, list);
+
+  GTD_EXIT;
+}
+
+static void
+on_manager_list_added_cb (GtdManager      *manager,
+                          GtdTaskList     *list,
+                          GtdDueDateIndex *self)
+{
+  GTD_ENTRY;
+
+  if (!g_hash_table_add (self->lists, g_object_ref (list)))
+    GTD_RETURN ();
+
+  g_signal_connect (list, "task-added", G_CALLBACK (on_task_added_cb), self);
+  g_signal_connect (list, "task-removed", G_CALLBACK (on_task_removed_cb), self);
+  g_signal_connect (list, "notify::archived", G_CALLBACK (on_list_archived_changed_cb), self);
+
+  if (!gtd_task_list_get_archived (list))
+    add_tasks_from_list (self, list);
+
+  GTD_EXIT;
+}
+
+static void
+on_manager_list_removed_cb (GtdManager      *manager,
+                            GtdTaskList     *list,
+                            GtdDueDateIndex *self)
+{
+  GTD_ENTRY;
+
+  if (!g_hash_table_contains (self->lists, list))
+    GTD_RETURN ();
+
+  g_signal_handlers_disconnect_by_data (list, self);
+  remove_tasks_from_list (self, list);
+
+  g_hash_table_remove (self->lists, list);
+
+  GTD_EXIT;
+}
+
+static void
+on_clock_day_changed_cb (GtdClock        *clock,
+                         GtdDueDateIndex *self)
+{
+  GTD_ENTRY;
+
+  set_today (self, get_today ());
+
+  GTD_EXIT;
+}
+
+
+/*
+ * GListModel iface
+ */
+
+static GType
+gtd_due_date_range_model_get_item_type (GListModel *model)
+{
+  return GTD_TYPE_TASK;
+}
+
+static guint
+gtd_due_date_range_model_get_n_items (GListModel *model)
+{
+  GtdDueDateRangeModel *self = (GtdDueDateRangeModel*) model;
+
+  return self->n_items;
+}
+
+static gpointer
+gtd_due_date_range_model_get_item (GListModel *model,
+                                   guint       position)
+{
+  GtdDueDateRangeModel *self;
+  GSequenceIter *iter;
+  GSequence *sequence;
+  IndexEntry *entry;
+  guint start;
+
+  self = (GtdDueDateRangeModel*) model;
+
+  if (!self->index || position >= self->n_items)
+    return NULL;
+
+  sequence = self->index->sequences[self->sequence_id];
+  start = get_position_of_day (sequence, self->start_day);
+  iter = g_sequence_get_iter_at_pos (sequence, start + position);
+  entry = g_sequence_get (iter);
+
+  return g_object_ref (entry->task);
+}
+
+static void
+g_list_model_iface_init (GListModelInterface *iface)
+{
+  iface->get_item_type = gtd_due_date_range_model_get_item_type;
+  iface->get_n_items = gtd_due_date_range_model_get_n_items;
+  iface->get_item = gtd_due_date_range_model_get_item;
+}
+
+
+/*
+ * GObject overrides
+ */
+
+static void
+gtd_due_date_range_model_class_init (GtdDueDateRangeModelClass *klass)
+{
+}
+
+static void
+gtd_due_date_range_model_init (GtdDueDateRangeModel *self)
+{
+}
+
+static void
+gtd_due_date_index_finalize (GObject *object)
+{
+  GtdDueDateIndex *self = (GtdDueDateIndex *)object;
+  GHashTableIter iter;
+  gpointer list;
+  guint i, j;
+
+  g_signal_handlers_disconnect_by_data (self->manager, self);
+  g_signal_handlers_disconnect_by_data (gtd_manager_get_clock (self->manager), self);
+
+  g_hash_table_iter_init (&iter, self->lists);
+  while (g_hash_table_iter_next (&iter, &list, NULL))
+    g_signal_handlers_disconnect_by_data (list, self);
+
+  g_hash_table_iter_init (&iter, self->entries);
+  while (g_hash_table_iter_next (&iter, &list, NULL))
+    g_signal_handlers_disconnect_by_func (list, on_task_notify_cb, self);
+
+  for (i = 0; i < GTD_DUE_DATE_RANGE_LAST; i++)
+    {
+      for (j = 0; j < N_SEQUENCES; j++)
+        {
+          if (!self->models[i][j])
+            continue;
+
+          self->models[i][j]->index = NULL;
+          g_clear_object (&self->models[i][j]);
+        }
+    }
+
+  for (i = 0; i < N_SEQUENCES; i++)
+    g_clear_pointer (&self->sequences[i], g_sequence_free);
+
+  g_clear_pointer (&self->entries, g_hash_table_destroy);
+  g_clear_pointer (&self->lists, g_hash_table_destroy);
+
+  G_OBJECT_CLASS (gtd_due_date_index_parent_class)->finalize (object);
+}
+
+static void
+gtd_due_date_index_class_init (GtdDueDateIndexClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->finalize = gtd_due_date_index_finalize;
+}
+
+static void
+gtd_due_date_index_init (GtdDueDateIndex *self)
+{
+  guint i;
+
+  self->entries = g_hash_table_new_full (g_direct_hash, g_direct_equal, NULL, (GDestroyNotify) index_entry_free);
+  self->lists = g_hash_table_new_full (g_direct_hash, g_direct_equal, g_object_unref, NULL);
+  self->today = get_today ();
+
+  for (i = 0; i < N_SEQUENCES; i++)
+    self->sequences[i] = g_sequence_new (NULL);
+}
+
+GtdDueDateIndex*
+_gtd_due_date_index_new (GtdManager *manager)
+{
+  GtdDueDateIndex *self;
+
+  self = g_object_new (GTD_TYPE_DUE_DATE_INDEX, NULL);
+  self->manager = manager;
+
+  g_signal_connect (manager, "list-added", G_CALLBACK (on_manager_list_added_cb), self);
+  g_signal_connect (manager, "list-removed", G_CALLBACK (on_manager_list_removed_cb), self);
+
+  g_signal_connect (gtd_manager_get_clock (manager),
+                    "day-changed",
+                    G_CALLBACK (on_clock_day_changed_cb),
+                    self);
+
+  return self;
+}
+
+/*
+ * _gtd_due_date_index_set_today:
+ * @self: a #GtdDueDateIndex
+ * @today: the day to consider as today
+ *
+ * Moves the boundaries of every range as if the day changed to @today.
+ * This is only meant for tests and benchmarks that can't wait for the
+ * clock to actually roll over.
+ */
+void
+_gtd_due_date_index_set_today (GtdDueDateIndex *self,
+                               GDateTime       *today)
+{
+  g_return_if_fail (GTD_IS_DUE_DATE_INDEX (self));
+  g_return_if_fail (today != NULL);
+
+  set_today (self, get_julian_day (today));
+}
+
+/**
+ * gtd_due_date_index_get_model:
+ * @self: a #GtdDueDateIndex
+ * @range: a #GtdDueDateRange
+ * @include_completed: whether completed tasks are part of the model
+ *
+ * Retrieves a #GListModel with the tasks that are due in @range. Tasks
+ * are sorted by their due day, and then by gtd_task_compare(). The model
+ * is kept up to date as tasks change, and when the day changes.
+ *
+ * Returns: (transfer none): a #GListModel of #GtdTask
+ */
+GListModel*
+gtd_due_date_index_get_model (GtdDueDateIndex *self,
+                              GtdDueDateRange  range,
+                              gboolean         include_completed)
+{
+  GtdDueDateRangeModel *model;
+  SequenceId sequence_id;
+
+  g_return_val_if_fail (GTD_IS_DUE_DATE_INDEX (self), NULL);
+  g_return_val_if_fail (range < GTD_DUE_DATE_RANGE_LAST, NULL);
+
+  sequence_id = include_completed ? ALL_TASKS : INCOMPLETE_TASKS;
+  model = self->models[range][sequence_id];
+
+  if (!model)
+    {
+      model = g_object_new (GTD_TYPE_DUE_DATE_RANGE_MODEL, NULL);
+      model->index = self;
+      model->range = range;
+      model->sequence_id = sequence_id;
+
+      update_model_bounds (model, self->today);
+      model->n_items = count_model_items (self, model);
+
+      self->models[range][sequence_id] = model;
+    }
+
+  return G_LIST_MODEL (model);
+}
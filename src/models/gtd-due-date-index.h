@@ -0,0 +1,58 @@
+/* gtd-due-date-index.h
+ *
+ * Copyright 2020 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <gio/gio.h>
+
+#include "gtd-types.h"
+
+G_BEGIN_DECLS
+
+/**
+ * GtdDueDateRange:
+ * @GTD_DUE_DATE_RANGE_OVERDUE: tasks due before today
+ * @GTD_DUE_DATE_RANGE_TODAY: tasks due today
+ * @GTD_DUE_DATE_RANGE_NEXT_WEEK: tasks due today or in the next 6 days
+ * @GTD_DUE_DATE_RANGE_SCHEDULED: all tasks with a due date
+ * @GTD_DUE_DATE_RANGE_ALL: all tasks, with undated tasks at the end
+ *
+ * The ranges of days that can be queried from a #GtdDueDateIndex. Ranges
+ * are relative to the current day, and are updated when the day changes.
+ */
+typedef enum
+{
+  GTD_DUE_DATE_RANGE_OVERDUE,
+  GTD_DUE_DATE_RANGE_TODAY,
+  GTD_DUE_DATE_RANGE_NEXT_WEEK,
+  GTD_DUE_DATE_RANGE_SCHEDULED,
+  GTD_DUE_DATE_RANGE_ALL,
+  GTD_DUE_DATE_RANGE_LAST,
+} GtdDueDateRange;
+
+#define GTD_TYPE_DUE_DATE_INDEX (gtd_due_date_index_get_type())
+
+G_DECLARE_FINAL_TYPE (GtdDueDateIndex, gtd_due_date_index, GTD, DUE_DATE_INDEX, GObject)
+
+GListModel*          gtd_due_date_index_get_model                (GtdDueDateIndex    *self,
+                                                                  GtdDueDateRange     range,
+                                                                  gboolean            include_completed);
+
+G_END_DECLS
@@ -26,6 +26,11 @@ typedef struct
 {
   GSequenceIter      *child_iter;
   GSequenceIter      *filter_iter;
+
+  /* Owned reference to the child item, and its ::notify handler if watched */
+  GObject            *instance;
+  GtdListModelFilter *self;
+  gulong              notify_id;
 } GtdListModelFilterItem;
 
 typedef struct
@@ -42,6 +47,9 @@ typedef struct
   GSequence          *child_seq;
   GSequence          *filter_seq;
 
+  /* Child instance → GtdListModelFilterItem, for gtd_list_model_filter_refilter_item() */
+  GHashTable         *items;
+
   /*
    * Typical set of callback/closure/free function pointers and data.
    * Called for child items to determine visibility state.
@@ -61,6 +69,9 @@ typedef struct
    * that have changed.
    */
   gboolean            supress_items_changed : 1;
+
+  /* If set, items are re-filtered individually when they emit ::notify */
+  gboolean            watch_items : 1;
 } GtdListModelFilterPrivate;
 
 struct _GtdListModelFilter
@@ -79,18 +90,24 @@ enum
 {
   PROP_0,
   PROP_CHILD_MODEL,
+  PROP_WATCH_ITEMS,
   N_PROPS
 };
 
 static GParamSpec *properties [N_PROPS];
 static guint signal_id;
 
+static void          refilter_item                               (GtdListModelFilter     *self,
+                                                                  GtdListModelFilterItem *item);
+
 static void
 gtd_list_model_filter_item_free (gpointer data)
 {
   GtdListModelFilterItem *item = data;
 
   g_clear_pointer (&item->filter_iter, g_sequence_remove);
+  g_clear_signal_handler (&item->notify_id, item->instance);
+  g_clear_object (&item->instance);
   item->child_iter = NULL;
   g_slice_free (GtdListModelFilterItem, item);
 }
@@ -165,6 +182,91 @@ emit_items_changed (GtdListModelFilter *self,
   g_list_model_items_changed (G_LIST_MODEL (self), position, n_removed, n_added);
 }
 
+static gint
+compare_filter_items (gconstpointer a,
+                      gconstpointer b,
+                      gpointer      user_data)
+{
+  const GtdListModelFilterItem *item_a = a;
+  const GtdListModelFilterItem *item_b = b;
+
+  return g_sequence_iter_compare (item_a->child_iter, item_b->child_iter);
+}
+
+static void
+on_item_notify_cb (GObject                *instance,
+                   GParamSpec             *pspec,
+                   GtdListModelFilterItem *item)
+{
+  refilter_item (item->self, item);
+}
+
+static void
+watch_item (GtdListModelFilter     *self,
+            GtdListModelFilterItem *item)
+{
+  if (item->notify_id > 0)
+    return;
+
+  item->notify_id = g_signal_connect (item->instance,
+                                      "notify",
+                                      G_CALLBACK (on_item_notify_cb),
+                                      item);
+}
+
+static void
+untrack_item (GtdListModelFilter     *self,
+              GtdListModelFilterItem *item)
+{
+  GtdListModelFilterPrivate *priv = gtd_list_model_filter_get_instance_private (self);
+
+  if (g_hash_table_lookup (priv->items, item->instance) == item)
+    g_hash_table_remove (priv->items, item->instance);
+}
+
+/*
+ * Re-runs the filter function on a single child item, and moves it into or
+ * out of the filter sequence if its visibility changed. Since the filter
+ * sequence is ordered by child position, this is a binary search rather
+ * than a walk over the child sequence.
+ */
+static void
+refilter_item (GtdListModelFilter     *self,
+               GtdListModelFilterItem *item)
+{
+  GtdListModelFilterPrivate *priv = gtd_list_model_filter_get_instance_private (self);
+  gboolean was_visible;
+  gboolean visible;
+  guint position;
+
+  g_assert (item->child_iter != NULL);
+
+  was_visible = item->filter_iter != NULL;
+  visible = priv->filter_func (item->instance, priv->filter_func_data);
+
+  if (visible == was_visible)
+    return;
+
+  if (visible)
+    {
+      item->filter_iter = g_sequence_insert_sorted (priv->filter_seq, item, compare_filter_items, NULL);
+      position = g_sequence_iter_get_position (item->filter_iter);
+
+      GTD_TRACE_MSG ("Item at %u is now visible", position);
+
+      emit_items_changed (self, position, 0, 1);
+    }
+  else
+    {
+      position = g_sequence_iter_get_position (item->filter_iter);
+      g_clear_pointer (&item->filter_iter, g_sequence_remove);
+
+      GTD_TRACE_MSG ("Item at %u is now hidden", position);
+
+      emit_items_changed (self, position, 1, 0);
+    }
+}
+
 static void
 child_model_items_changed (GtdListModelFilter *self,
                            guint               position,
@@ -200,6 +302,7 @@ child_model_items_changed (GtdListModelFilter *self,
       /* Small shortcut when all items are removed */
       if (n_removed == (guint)g_sequence_get_length (priv->child_seq))
         {
+          g_hash_table_remove_all (priv->items);
           g_sequence_remove_range (g_sequence_get_begin_iter (priv->child_seq),
                                    g_sequence_get_end_iter (priv->child_seq));
           g_assert (g_sequence_is_empty (priv->child_seq));
@@ -232,6 +335,8 @@ child_model_items_changed (GtdListModelFilter *self,
               count++;
             }
 
+          untrack_item (self, item);
+
           /* Fetch the next while the iter is still valid */
           iter = g_sequence_iter_next (iter);
 
@@ -266,10 +371,17 @@ add_new_items:
           item = g_slice_new0 (GtdListModelFilterItem);
           item->filter_iter = NULL;
           item->child_iter = g_sequence_insert_before (iter, item);
+          item->self = self;
 
           instance = g_list_model_get_item (child_model, i - 1);
           g_assert (G_IS_OBJECT (instance));
 
+          item->instance = g_object_ref (instance);
+          g_hash_table_insert (priv->items, instance, item);
+
+          if (priv->watch_items)
+            watch_item (self, item);
+
           /* Check if this item is visible */
           if (priv->filter_func (instance, priv->filter_func_data))
             {
@@ -301,6 +413,7 @@ gtd_list_model_filter_finalize (GObject *object)
   GtdListModelFilter *self = (GtdListModelFilter *)object;
   GtdListModelFilterPrivate *priv = gtd_list_model_filter_get_instance_private (self);
 
+  g_clear_pointer (&priv->items, g_hash_table_destroy);
   g_clear_pointer (&priv->child_seq, g_sequence_free);
   g_clear_pointer (&priv->filter_seq, g_sequence_free);
 
@@ -329,6 +442,29 @@ gtd_list_model_filter_get_property (GObject    *object,
       g_value_set_object (value, gtd_list_model_filter_get_child_model (self));
       break;
 
+    case PROP_WATCH_ITEMS:
+      g_value_set_boolean (value, gtd_list_model_filter_get_watch_items (self));
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+    }
+}
+
+static void
+gtd_list_model_filter_set_property (GObject      *object,
+                                    guint         prop_id,
+                                    const GValue *value,
+                                    GParamSpec   *pspec)
+{
+  GtdListModelFilter *self = GTD_LIST_MODEL_FILTER (object);
+
+  switch (prop_id)
+    {
+    case PROP_WATCH_ITEMS:
+      gtd_list_model_filter_set_watch_items (self, g_value_get_boolean (value));
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
     }
@@ -341,6 +477,7 @@ gtd_list_model_filter_class_init (GtdListModelFilterClass *klass)
 
   object_class->finalize = gtd_list_model_filter_finalize;
   object_class->get_property = gtd_list_model_filter_get_property;
+  object_class->set_property = gtd_list_model_filter_set_property;
 
   properties [PROP_CHILD_MODEL] =
     g_param_spec_object ("child-model",
@@ -349,6 +486,13 @@ gtd_list_model_filter_class_init (GtdListModelFilterClass *klass)
                          G_TYPE_LIST_MODEL,
                          (G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
+  properties [PROP_WATCH_ITEMS] =
+    g_param_spec_boolean ("watch-items",
+                          "Watch Items",
+                          "Whether items are re-filtered when their properties change.",
+                          FALSE,
+                          (G_PARAM_READWRITE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS));
+
   g_object_class_install_properties (object_class, N_PROPS, properties);
 
   signal_id = g_signal_lookup ("items-changed", GTD_TYPE_LIST_MODEL_FILTER);
@@ -362,6 +506,7 @@ gtd_list_model_filter_init (GtdListModelFilter *self)
   priv->filter_func = gtd_list_model_filter_default_filter_func;
   priv->child_seq = g_sequence_new (gtd_list_model_filter_item_free);
   priv->filter_seq = g_sequence_new (NULL);
+  priv->items = g_hash_table_new (g_direct_hash, g_direct_equal);
   priv->last_position = -1;
 }
 
@@ -500,6 +645,8 @@ gtd_list_model_filter_invalidate (GtdListModelFilter *self)
    * If we have a child store, we want to rebuild our list of items
    * from scratch, so just remove everything.
    */
+  g_hash_table_remove_all (priv->items);
+
   if (!g_sequence_is_empty (priv->child_seq))
     g_sequence_remove_range (g_sequence_get_begin_iter (priv->child_seq),
                              g_sequence_get_end_iter (priv->child_seq));
@@ -567,3 +714,124 @@ gtd_list_model_filter_set_filter_func (GtdListModelFilter     *self,
 
   gtd_list_model_filter_invalidate (self);
 }
+
+/**
+ * gtd_list_model_filter_refilter_item:
+ * @self: a #GtdListModelFilter
+ * @item: an item of the child model
+ *
+ * Re-runs the filter function on @item only, and emits a single
+ * items-changed if its visibility changed. Use this instead of
+ * gtd_list_model_filter_invalidate() when you know which item
+ * changed.
+ *
+ * If @item is not in the child model, nothing happens.
+ */
+void
+gtd_list_model_filter_refilter_item (GtdListModelFilter *self,
+                                     gpointer            item)
+{
+  GtdListModelFilterPrivate *priv = gtd_list_model_filter_get_instance_private (self);
+  GtdListModelFilterItem *filter_item;
+
+  g_return_if_fail (GTD_IS_LIST_MODEL_FILTER (self));
+  g_return_if_fail (G_IS_OBJECT (item));
+
+  filter_item = g_hash_table_lookup (priv->items, item);
+
+  if (filter_item)
+    refilter_item (self, filter_item);
+}
+
+/**
+ * gtd_list_model_filter_refilter_range:
+ * @self: a #GtdListModelFilter
+ * @position: the position of the first item in the child model
+ * @n_items: the number of items to re-filter
+ *
+ * Re-runs the filter function on @n_items items of the child
+ * model, starting at @position. Only the items whose visibility
+ * changed are added or removed.
+ */
+void
+gtd_list_model_filter_refilter_range (GtdListModelFilter *self,
+                                      guint               position,
+                                      guint               n_items)
+{
+  GtdListModelFilterPrivate *priv = gtd_list_model_filter_get_instance_private (self);
+  GSequenceIter *iter;
+  guint i;
+
+  GTD_ENTRY;
+
+  g_return_if_fail (GTD_IS_LIST_MODEL_FILTER (self));
+  g_return_if_fail (position + n_items <= (guint)g_sequence_get_length (priv->child_seq));
+
+  iter = g_sequence_get_iter_at_pos (priv->child_seq, position);
+
+  for (i = 0; i < n_items; i++)
+    {
+      refilter_item (self, g_sequence_get (iter));
+      iter = g_sequence_iter_next (iter);
+    }
+
+  GTD_EXIT;
+}
+
+/**
+ * gtd_list_model_filter_get_watch_items:
+ * @self: a #GtdListModelFilter
+ *
+ * Retrieves whether @self re-filters items when they change.
+ *
+ * Returns: %TRUE if items are watched, %FALSE otherwise
+ */
+gboolean
+gtd_list_model_filter_get_watch_items (GtdListModelFilter *self)
+{
+  GtdListModelFilterPrivate *priv = gtd_list_model_filter_get_instance_private (self);
+
+  g_return_val_if_fail (GTD_IS_LIST_MODEL_FILTER (self), FALSE);
+
+  return priv->watch_items;
+}
+
+/**
+ * gtd_list_model_filter_set_watch_items:
+ * @self: a #GtdListModelFilter
+ * @watch_items: whether to watch items
+ *
+ * When @watch_items is %TRUE, @self connects to #GObject::notify on
+ * every child item, and re-filters that item alone whenever one of
+ * its properties changes.
+ */
+void
+gtd_list_model_filter_set_watch_items (GtdListModelFilter *self,
+                                       gboolean            watch_items)
+{
+  GtdListModelFilterPrivate *priv = gtd_list_model_filter_get_instance_private (self);
+  GSequenceIter *iter;
+
+  g_return_if_fail (GTD_IS_LIST_MODEL_FILTER (self));
+
+  watch_items = !!watch_items;
+
+  if (priv->watch_items == watch_items)
+    return;
+
+  priv->watch_items = watch_items;
+
+  for (iter = g_sequence_get_begin_iter (priv->child_seq);
+       !g_sequence_iter_is_end (iter);
+       iter = g_sequence_iter_next (iter))
+    {
+      GtdListModelFilterItem *item = g_sequence_get (iter);
+
+      if (watch_items)
+        watch_item (self, item);
+      else
+        g_clear_signal_handler (&item->notify_id, item->instance);
+    }
+
+  g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_WATCH_ITEMS]);
+}
@@ -36,6 +36,18 @@ GListModel*          gtd_list_model_filter_get_child_model       (GtdListModelFi
 
 void                 gtd_list_model_filter_invalidate            (GtdListModelFilter *self);
 
+void                 gtd_list_model_filter_refilter_item         (GtdListModelFilter *self,
+                                                                  gpointer            item);
+
+void                 gtd_list_model_filter_refilter_range        (GtdListModelFilter *self,
+                                                                  guint               position,
+                                                                  guint               n_items);
+
+gboolean             gtd_list_model_filter_get_watch_items       (GtdListModelFilter *self);
+
+void                 gtd_list_model_filter_set_watch_items       (GtdListModelFilter *self,
+                                                                  gboolean            watch_items);
+
 void                 gtd_list_model_filter_set_filter_func       (GtdListModelFilter     *self,
                                                                   GtdListModelFilterFunc  filter_func,
                                                                   gpointer                filter_func_data,
@@ -359,6 +359,54 @@ gtd_list_store_sort (GtdListStore     *store,
   gtd_list_store_items_changed (store, 0, n_items, n_items);
 }
 
+/**
+ * gtd_list_store_sort_changed:
+ * @store: a #GtdListStore
+ * @item: (type GObject): an item in @store
+ * @compare_func: (scope call): pairwise comparison function for sorting
+ * @user_data: (closure): user data for @compare_func
+ *
+ * Moves @item to its sorted position after it changed in a way that may
+ * affect the sort order. The rest of @store must already be sorted.
+ *
+ * Unlike gtd_list_store_sort(), only @item is removed and re-added, and
+ * nothing is emitted when it's already in place.
+ *
+ * Returns: the position of @item
+ */
+guint
+gtd_list_store_sort_changed (GtdListStore     *store,
+                             gpointer          item,
+                             GCompareDataFunc  compare_func,
+                             gpointer          user_data)
+{
+  g_autoptr (GObject) item_ref = NULL;
+  GSequenceIter *next;
+  GSequenceIter *it;
+
+  g_return_val_if_fail (GTD_IS_LIST_STORE (store), 0);
+  g_return_val_if_fail (compare_func != NULL, 0);
+
+  it = g_hash_table_lookup (store->item_to_iter, item);
+
+  g_return_val_if_fail (it != NULL, 0);
+
+  next = g_sequence_iter_next (it);
+
+  if ((g_sequence_iter_is_begin (it) || compare_func (g_sequence_get (g_sequence_iter_prev (it)), item, user_data) <= 0) &&
+      (g_sequence_iter_is_end (next) || compare_func (item, g_sequence_get (next), user_data) <= 0))
+    {
+      return g_sequence_iter_get_position (it);
+    }
+
+  /* Keep the item alive while it's out of the store */
+  item_ref = g_object_ref (item);
+
+  gtd_list_store_remove (store, item);
+
+  return gtd_list_store_insert_sorted (store, item, compare_func, user_data);
+}
+
 /**
  * gtd_list_store_append:
  * @store: a #GtdListStore
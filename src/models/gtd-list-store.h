@@ -43,6 +43,11 @@ void                 gtd_list_store_sort                         (GtdListStore
                                                                   GCompareDataFunc    compare_func,
                                                                   gpointer            user_data);
 
+guint                gtd_list_store_sort_changed                 (GtdListStore       *store,
+                                                                  gpointer            item,
+                                                                  GCompareDataFunc    compare_func,
+                                                                  gpointer            user_data);
+
 void                 gtd_list_store_append                       (GtdListStore       *store,
                                                                   gpointer            item);
 
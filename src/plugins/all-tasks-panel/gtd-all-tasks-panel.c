@@ -43,8 +43,7 @@ struct _GtdAllTasksPanel
   guint               number_of_tasks;
   GtdTaskListView    *view;
 
-  GtkFilterListModel *filter_model;
-  GtkSortListModel   *sort_model;
+  GListModel         *model;
 };
 
 static void          gtd_panel_iface_init                        (GtdPanelInterface  *iface);
@@ -70,89 +69,22 @@ enum
  */
 
 
-static void
-get_date_offset (GDateTime *dt,
-                 gint      *days_diff,
-                 gint      *years_diff)
-{
-  g_autoptr (GDateTime) now = NULL;
-  GDate now_date, dt_date;
-
-  g_date_clear (&dt_date, 1);
-  g_date_set_dmy (&dt_date,
-                  g_date_time_get_day_of_month (dt),
-                  g_date_time_get_month (dt),
-                  g_date_time_get_year (dt));
-
-  now = g_date_time_new_now_local ();
-
-  g_date_clear (&now_date, 1);
-  g_date_set_dmy (&now_date,
-                  g_date_time_get_day_of_month (now),
-                  g_date_time_get_month (now),
-                  g_date_time_get_year (now));
-
-
-  if (days_diff)
-    *days_diff = g_date_days_between (&now_date, &dt_date);
-
-  if (years_diff)
-    *years_diff = g_date_time_get_year (dt) - g_date_time_get_year (now);
-}
-
-static gchar*
+static const gchar*
 get_string_for_date (GDateTime *dt,
                      gint      *span)
 {
-  gchar *str;
-  gint days_diff;
-  gint years_diff;
+  GtdClock *clock;
 
+  /* This case should never happen */
   if (!dt)
-    return g_strdup (_("No date set"));
-
-  days_diff = years_diff = 0;
+    return _("No date set");
 
-  get_date_offset (dt, &days_diff, &years_diff);
-
-  if (days_diff < -1)
-    {
-      /* Translators: This message will never be used with '1 day ago'
-       * but the singular form is required because some languages do not
-       * have plurals, some languages reuse the singular form for numbers
-       * like 21, 31, 41, etc.
-       */
-      str = g_strdup_printf (g_dngettext (NULL, "%d day ago", "%d days ago", -days_diff), -days_diff);
-    }
-  else if (days_diff == -1)
-    {
-      str = g_strdup (_("Yesterday"));
-    }
-  else if (days_diff == 0)
-    {
-      str = g_strdup (_("Today"));
-    }
-  else if (days_diff == 1)
-    {
-      str = g_strdup (_("Tomorrow"));
-    }
-  else if (days_diff > 1 && days_diff < 7)
-    {
-      str = g_date_time_format (dt, "%A"); // Weekday name
-    }
-  else if (days_diff >= 7 && years_diff == 0)
-    {
-      str = g_date_time_format (dt, "%OB"); // Full month name
-    }
-  else
-    {
-      str = g_strdup_printf ("%d", g_date_time_get_year (dt));
-    }
+  clock = gtd_manager_get_clock (gtd_manager_get_default ());
 
   if (span)
-    *span = days_diff;
+    *span = gtd_clock_get_days_from_today (clock, dt);
 
-  return str;
+  return gtd_clock_get_relative_date_label (clock, dt);
 }
 
 static GtkWidget*
@@ -212,7 +144,7 @@ header_func (GtdTask          *task,
              GtdAllTasksPanel *self)
 {
   g_autoptr (GDateTime) dt = NULL;
-  g_autofree gchar *text = NULL;
+  const gchar *text = NULL;
   gint span;
 
   dt = gtd_task_get_due_date (task);
@@ -236,59 +168,6 @@ header_func (GtdTask          *task,
   return text ? create_label (text, span, !previous_task) : NULL;
 }
 
-static gint
-sort_func (gconstpointer a,
-           gconstpointer b,
-           gpointer      user_data)
-{
-  g_autoptr (GDateTime) dt1 = NULL;
-  g_autoptr (GDateTime) dt2 = NULL;
-  GtdTask *task1;
-  GtdTask *task2;
-  GDate dates[2];
-  gint result;
-
-  task1 = (GtdTask*) a;
-  task2 = (GtdTask*) b;
-
-  dt1 = gtd_task_get_due_date (task1);
-  dt2 = gtd_task_get_due_date (task2);
-
-  if (!dt1 && !dt2)
-    return gtd_task_compare (task1, task2);
-  else if (!dt1)
-    return 1;
-  else if (!dt2)
-    return -1;
-
-  g_date_clear (dates, 2);
-
-  g_date_set_dmy (&dates[0],
-                  g_date_time_get_day_of_month (dt1),
-                  g_date_time_get_month (dt1),
-                  g_date_time_get_year (dt1));
-
-  g_date_set_dmy (&dates[1],
-                  g_date_time_get_day_of_month (dt2),
-                  g_date_time_get_month (dt2),
-                  g_date_time_get_year (dt2));
-
-  result = g_date_days_between (&dates[1], &dates[0]);
-
-  if (result != 0)
-    return result;
-
-  return gtd_task_compare (task1, task2);
-}
-
-static gboolean
-filter_func (gpointer  item,
-             gpointer  user_data)
-{
-  GtdTask *task = (GtdTask*) item;
-  return !gtd_task_get_complete (task);
-}
-
 static void
 on_model_items_changed_cb (GListModel       *model,
                            guint             position,
@@ -310,13 +189,9 @@ on_clock_day_changed_cb (GtdClock         *clock,
                          GtdAllTasksPanel *self)
 {
   g_autoptr (GDateTime) now = NULL;
-  GtkFilter *filter;
 
   now = g_date_time_new_now_local ();
   gtd_task_list_view_set_default_date (self->view, now);
-
-  filter = gtk_filter_list_model_get_filter (self->filter_model);
-  gtk_filter_changed (filter, GTK_FILTER_CHANGE_DIFFERENT);
 }
 
 /*
@@ -390,8 +265,6 @@ gtd_all_tasks_panel_finalize (GObject *object)
   GtdAllTasksPanel *self = (GtdAllTasksPanel *)object;
 
   g_clear_object (&self->icon);
-  g_clear_object (&self->filter_model);
-  g_clear_object (&self->sort_model);
 
   G_OBJECT_CLASS (gtd_all_tasks_panel_parent_class)->finalize (object);
 }
@@ -465,22 +338,17 @@ static void
 gtd_all_tasks_panel_init (GtdAllTasksPanel *self)
 {
   GtdManager *manager = gtd_manager_get_default ();
-  GtkCustomFilter *filter;
-  GtkCustomSorter *sorter;
 
   self->icon = g_themed_icon_new ("view-tasks-all-symbolic");
 
-  filter = gtk_custom_filter_new (filter_func, self, NULL);
-  self->filter_model = gtk_filter_list_model_new (gtd_manager_get_tasks_model (manager),
-                                                  GTK_FILTER (filter));
-
-  sorter = gtk_custom_sorter_new (sort_func, self, NULL);
-  self->sort_model = gtk_sort_list_model_new (G_LIST_MODEL (self->filter_model),
-                                              GTK_SORTER (sorter));
+  self->model = gtd_due_date_index_get_model (gtd_manager_get_due_date_index (manager),
+                                              GTD_DUE_DATE_RANGE_ALL,
+                                              FALSE);
 
   /* The main view */
   self->view = GTD_TASK_LIST_VIEW (gtd_task_list_view_new ());
-  gtd_task_list_view_set_model (GTD_TASK_LIST_VIEW (self->view), G_LIST_MODEL (self->sort_model));
+  gtd_task_list_view_set_virtualized (GTD_TASK_LIST_VIEW (self->view), TRUE);
+  gtd_task_list_view_set_model (GTD_TASK_LIST_VIEW (self->view), self->model);
   gtd_task_list_view_set_handle_subtasks (GTD_TASK_LIST_VIEW (self->view), FALSE);
   gtd_task_list_view_set_show_list_name (GTD_TASK_LIST_VIEW (self->view), TRUE);
   gtd_task_list_view_set_show_due_date (GTD_TASK_LIST_VIEW (self->view), FALSE);
@@ -493,7 +361,7 @@ gtd_all_tasks_panel_init (GtdAllTasksPanel *self)
                                       (GtdTaskListViewHeaderFunc) header_func,
                                       self);
 
-  g_signal_connect_object (self->sort_model,
+  g_signal_connect_object (self->model,
                            "items-changed",
                            G_CALLBACK (on_model_items_changed_cb),
                            self,
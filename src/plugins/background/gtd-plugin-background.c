@@ -279,24 +279,31 @@ get_tasks_for_today (guint *n_events)
 
   for (i = 0; i < g_list_model_get_n_items (lists); i++)
     {
-      g_autoptr (GListModel) list = NULL;
+      g_autoptr (GtdTaskList) list = NULL;
+      guint n_due_today;
       guint j;
 
       list = g_list_model_get_item (lists, i);
+      n_due_today = gtd_task_list_get_n_due_today (list);
 
-      for (j = 0; j < g_list_model_get_n_items (list); j++)
+      /* The list keeps count of the tasks due today, skip it if there's none */
+      if (n_due_today == 0)
+        continue;
+
+      n_tasks += n_due_today;
+
+      for (j = 0; j < g_list_model_get_n_items (G_LIST_MODEL (list)); j++)
         {
-          GDateTime *due_date;
-          GtdTask *task;
+          g_autoptr (GDateTime) due_date = NULL;
+          g_autoptr (GtdTask) task = NULL;
 
-          task = g_list_model_get_item (list, j);
+          task = g_list_model_get_item (G_LIST_MODEL (list), j);
 
           due_date = gtd_task_get_due_date (task);
 
           if (!due_date || !is_today (now, due_date) || gtd_task_get_complete (task))
             continue;
 
-          n_tasks += 1;
           result = g_list_prepend (result, task);
         }
     }
@@ -0,0 +1,837 @@
+/* gtd-eds-writer.c
+ *
+ * Copyright 2020 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "GtdEdsWriter"
+
+#include "gtd-debug.h"
+#include "gtd-eds-autoptr.h"
+#include "gtd-eds-writer.h"
+
+/*
+ * #GtdEdsWriter serializes the writes to a calendar. Writes are queued,
+ * and a single worker thread sends them in batches, so bulk actions don't
+ * flood the thread pool with blocking calls to the same client.
+ *
+ * While a batch is being written, new writes wait in the queue. Repeated
+ * modifications of the same object are collapsed into the last one, and
+ * removing an object drops its pending modification.
+ */
+
+#define MAX_BATCH_SIZE 100
+
+typedef enum
+{
+  OPERATION_CREATE,
+  OPERATION_MODIFY,
+  OPERATION_REMOVE,
+} OperationType;
+
+typedef struct
+{
+  OperationType       type;
+  gchar              *uid;
+  gchar              *rid;
+  ICalComponent      *icalcomp;
+
+  /* The GTasks waiting for this operation */
+  GPtrArray          *tasks;
+  gint64              queued_time;
+
+  /* Set by the worker thread */
+  gchar              *new_uid;
+  GError             *error;
+} Operation;
+
+struct _GtdEdsWriter
+{
+  GObject             parent;
+
+  const GtdEdsWriterBackend *backend;
+  gpointer            backend_data;
+  GDestroyNotify      backend_data_destroy;
+
+  GQueue              pending;
+
+  /* The last pending operation of each object, for collapsing */
+  GHashTable         *pending_by_uid;
+
+  guint               flush_idle_id;
+  gboolean            writing;
+
+  GtdEdsWriterStats   stats;
+};
+
+static void          start_batch                                 (GtdEdsWriter       *self);
+
+G_DEFINE_TYPE (GtdEdsWriter, gtd_eds_writer, G_TYPE_OBJECT)
+
+enum
+{
+  PROP_0,
+  PROP_QUEUE_DEPTH,
+  N_PROPS
+};
+
+static GParamSpec *properties [N_PROPS];
+
+
+/*
+ * ECalClient backend
+ */
+
+static gboolean
+client_create_objects (gpointer       backend,
+                       GSList        *icalcomps,
+                       GSList       **out_uids,
+                       GCancellable  *cancellable,
+                       GError       **error)
+{
+  return e_cal_client_create_objects_sync (backend,
+                                           icalcomps,
+                                           E_CAL_OPERATION_FLAG_NONE,
+                                           out_uids,
+                                           cancellable,
+                                           error);
+}
+
+static gboolean
+client_modify_objects (gpointer       backend,
+                       GSList        *icalcomps,
+                       GCancellable  *cancellable,
+                       GError       **error)
+{
+  return e_cal_client_modify_objects_sync (backend,
+                                           icalcomps,
+                                           E_CAL_OBJ_MOD_THIS,
+                                           E_CAL_OPERATION_FLAG_NONE,
+                                           cancellable,
+                                           error);
+}
+
+static gboolean
+client_remove_objects (gpointer       backend,
+                       GSList        *ids,
+                       GCancellable  *cancellable,
+                       GError       **error)
+{
+  return e_cal_client_remove_objects_sync (backend,
+                                           ids,
+                                           E_CAL_OBJ_MOD_THIS,
+                                           E_CAL_OPERATION_FLAG_NONE,
+                                           cancellable,
+                                           error);
+}
+
+static const GtdEdsWriterBackend client_backend = {
+  .create_objects = client_create_objects,
+  .modify_objects = client_modify_objects,
+  .remove_objects = client_remove_objects,
+};
+
+
+/*
+ * Auxiliary methods
+ */
+
+static Operation*
+operation_new (OperationType  type,
+               const gchar   *uid,
+               GTask         *task)
+{
+  Operation *operation;
+
+  operation = g_new0 (Operation, 1);
+  operation->type = type;
+  operation->uid = g_strdup (uid);
+  operation->tasks = g_ptr_array_new_with_free_func (g_object_unref);
+  operation->queued_time = g_get_monotonic_time ();
+
+  g_ptr_array_add (operation->tasks, g_object_ref (task));
+
+  return operation;
+}
+
+static void
+operation_free (Operation *operation)
+{
+  g_clear_pointer (&operation->uid, g_free);
+  g_clear_pointer (&operation->rid, g_free);
+  g_clear_pointer (&operation->icalcomp, g_object_unref);
+  g_clear_pointer (&operation->tasks, g_ptr_array_unref);
+  g_clear_pointer (&operation->new_uid, g_free);
+  g_clear_error (&operation->error);
+  g_free (operation);
+}
+
+static gboolean
+operation_is_cancelled (Operation *operation)
+{
+  guint i;
+
+  for (i = 0; i < operation->tasks->len; i++)
+    {
+      if (!g_cancellable_is_cancelled (g_task_get_cancellable (g_ptr_array_index (operation->tasks, i))))
+        return FALSE;
+    }
+
+  return TRUE;
+}
+
+static void
+complete_operation (GtdEdsWriter *self,
+                    Operation    *operation)
+{
+  gint64 latency;
+  guint i;
+
+  for (i = 0; i < operation->tasks->len; i++)
+    {
+      GTask *task = g_ptr_array_index (operation->tasks, i);
+
+      if (operation->error)
+        g_task_return_error (task, g_error_copy (operation->error));
+      else if (operation->type == OPERATION_CREATE)
+        g_task_return_pointer (task, g_strdup (operation->new_uid), g_free);
+      else
+        g_task_return_boolean (task, TRUE);
+    }
+
+  latency = g_get_monotonic_time () - operation->queued_time;
+
+  self->stats.total_latency_us += latency;
+  self->stats.max_latency_us = MAX (self->stats.max_latency_us, latency);
+}
+
+static gboolean
+on_flush_idle_cb (gpointer user_data)
+{
+  GtdEdsWriter *self = GTD_EDS_WRITER (user_data);
+
+  self->flush_idle_id = 0;
+
+  start_batch (self);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+enqueue_operation (GtdEdsWriter *self,
+                   Operation    *operation)
+{
+  g_queue_push_tail (&self->pending, operation);
+
+  if (operation->uid && operation->type != OPERATION_CREATE)
+    g_hash_table_replace (self->pending_by_uid, operation->uid, operation);
+
+  self->stats.max_queue_depth = MAX (self->stats.max_queue_depth, self->pending.length);
+
+  /* Writes issued in the same main loop iteration go in the same batch */
+  if (!self->writing && self->flush_idle_id == 0)
+    self->flush_idle_id = g_idle_add (on_flush_idle_cb, self);
+
+  g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_QUEUE_DEPTH]);
+}
+
+static GTask*
+create_task (GtdEdsWriter        *self,
+             GCancellable        *cancellable,
+             GAsyncReadyCallback  callback,
+             gpointer             user_data,
+             gpointer             source_tag)
+{
+  GTask *task;
+
+  task = g_task_new (self, cancellable, callback, user_data);
+  g_task_set_source_tag (task, source_tag);
+
+  self->stats.n_requests++;
+
+  return task;
+}
+
+static void
+write_operations (GtdEdsWriter  *self,
+                  OperationType  type,
+                  GSList        *operations,
+                  GCancellable  *cancellable)
+{
+  g_autoptr (GError) error = NULL;
+  g_autoptr (GSList) icalcomps = NULL;
+  GSList *remove_ids = NULL;
+  GSList *new_uids = NULL;
+  gboolean success;
+  GSList *l;
+  GSList *u;
+
+  for (l = operations; l; l = l->next)
+    {
+      Operation *operation = l->data;
+
+      if (type == OPERATION_REMOVE)
+        remove_ids = g_slist_prepend (remove_ids, e_cal_component_id_new (operation->uid, operation->rid));
+      else
+        icalcomps = g_slist_prepend (icalcomps, operation->icalcomp);
+    }
+
+  remove_ids = g_slist_reverse (remove_ids);
+  icalcomps = g_slist_reverse (icalcomps);
+
+  switch (type)
+    {
+    case OPERATION_CREATE:
+      success = self->backend->create_objects (self->backend_data, icalcomps, &new_uids, cancellable, &error);
+      break;
+
+    case OPERATION_MODIFY:
+      success = self->backend->modify_objects (self->backend_data, icalcomps, cancellable, &error);
+      break;
+
+    case OPERATION_REMOVE:
+      success = self->backend->remove_objects (self->backend_data, remove_ids, cancellable, &error);
+      break;
+
+    default:
+      g_assert_not_reached ();
+    }
+
+  g_slist_free_full (remove_ids, e_cal_component_id_free);
+
+  for (l = operations, u = new_uids; success && type == OPERATION_CREATE && l; l = l->next, u = u ? u->next : NULL)
+    ((Operation*) l->data)->new_uid = g_strdup (u ? u->data : NULL);
+
+  g_slist_free_full (new_uids, g_free);
+
+  if (success)
+    return;
+
+  /*
+   * A single bad object fails the whole call, so write the operations of a
+   * failed batch one by one to only fail the ones that are actually bad.
+   */
+  if (operations->next && !g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+    {
+      GTD_TRACE_MSG ("Batch of %u operations failed, retrying them one by one", g_slist_length (operations));
+
+      for (l = operations; l; l = l->next)
+        {
+          GSList single = { l->data, NULL };
+
+          write_operations (self, type, &single, cancellable);
+        }
+
+      return;
+    }
+
+  for (l = operations; l; l = l->next)
+    ((Operation*) l->data)->error = g_error_copy (error);
+}
+
+
+/*
+ * Callbacks
+ */
+
+static void
+write_batch_in_thread_cb (GTask        *task,
+                         gpointer      source_object,
+                         gpointer      task_data,
+                         GCancellable *cancellable)
+{
+  g_autoptr (GSList) created = NULL;
+  g_autoptr (GSList) modified = NULL;
+  g_autoptr (GSList) removed = NULL;
+  GtdEdsWriter *self;
+  GPtrArray *operations;
+  guint i;
+
+  GTD_ENTRY;
+
+  self = GTD_EDS_WRITER (source_object);
+  operations = task_data;
+
+  /* Group the operations by type, keeping their order */
+  for (i = operations->len; i > 0; i--)
+    {
+      Operation *operation = g_ptr_array_index (operations, i - 1);
+
+      switch (operation->type)
+        {
+        case OPERATION_CREATE:
+          created = g_slist_prepend (created, operation);
+          break;
+
+        case OPERATION_MODIFY:
+          modified = g_slist_prepend (modified, operation);
+          break;
+
+        case OPERATION_REMOVE:
+          removed = g_slist_prepend (removed, operation);
+          break;
+        }
+    }
+
+  if (created)
+    write_operations (self, OPERATION_CREATE, created, cancellable);
+
+  if (modified)
+    write_operations (self, OPERATION_MODIFY, modified, cancellable);
+
+  if (removed)
+    write_operations (self, OPERATION_REMOVE, removed, cancellable);
+
+  g_task_return_boolean (task, TRUE);
+
+  GTD_EXIT;
+}
+
+static void
+on_batch_written_cb (GObject      *source_object,
+                     GAsyncResult *result,
+                     gpointer      user_data)
+{
+  GtdEdsWriter *self;
+  GPtrArray *operations;
+  guint i;
+
+  GTD_ENTRY;
+
+  self = GTD_EDS_WRITER (source_object);
+  operations = g_task_get_task_data (G_TASK (result));
+
+  for (i = 0; i < operations->len; i++)
+    complete_operation (self, g_ptr_array_index (operations, i));
+
+  self->writing = FALSE;
+
+  GTD_TRACE_MSG ("Wrote %u operations, %u queued", operations->len, self->pending.length);
+
+  /* Whatever was queued meanwhile is the next batch */
+  if (self->pending.length > 0)
+    start_batch (self);
+
+  GTD_EXIT;
+}
+
+static void
+start_batch (GtdEdsWriter *self)
+{
+  g_autoptr (GHashTable) batch_uids = NULL;
+  g_autoptr (GPtrArray) operations = NULL;
+  g_autoptr (GTask) task = NULL;
+  Operation *operation;
+
+  GTD_ENTRY;
+
+  g_clear_handle_id (&self->flush_idle_id, g_source_remove);
+
+  if (self->writing)
+    GTD_RETURN ();
+
+  operations = g_ptr_array_new_with_free_func ((GDestroyNotify) operation_free);
+  batch_uids = g_hash_table_new (g_str_hash, g_str_equal);
+
+  while (operations->len < MAX_BATCH_SIZE && (operation = g_queue_peek_head (&self->pending)))
+    {
+      /* Operations on the same object must be written in order */
+      if (operation->uid && g_hash_table_contains (batch_uids, operation->uid))
+        break;
+
+      g_queue_pop_head (&self->pending);
+
+      if (operation->uid)
+        {
+          if (g_hash_table_lookup (self->pending_by_uid, operation->uid) == operation)
+            g_hash_table_remove (self->pending_by_uid, operation->uid);
+
+          g_hash_table_add (batch_uids, operation->uid);
+        }
+
+      if (operation_is_cancelled (operation))
+        {
+          complete_operation (self, operation);
+          operation_free (operation);
+          continue;
+        }
+
+      g_ptr_array_add (operations, operation);
+    }
+
+  g_object_notify_by_pspec (G_OBJECT (self), properties[PROP_QUEUE_DEPTH]);
+
+  if (operations->len == 0)
+    GTD_RETURN ();
+
+  GTD_TRACE_MSG ("Writing %u operations, %u still queued", operations->len, self->pending.length);
+
+  self->writing = TRUE;
+  self->stats.n_batches++;
+
+  task = g_task_new (self, NULL, on_batch_written_cb, NULL);
+  g_task_set_source_tag (task, start_batch);
+  g_task_set_task_data (task, g_steal_pointer (&operations), (GDestroyNotify) g_ptr_array_unref);
+  g_task_run_in_thread (task, write_batch_in_thread_cb);
+
+  GTD_EXIT;
+}
+
+
+/*
+ * GObject overrides
+ */
+
+static void
+gtd_eds_writer_finalize (GObject *object)
+{
+  GtdEdsWriter *self = (GtdEdsWriter *)object;
+
+  g_clear_handle_id (&self->flush_idle_id, g_source_remove);
+
+  /* Pending operations keep the writer alive, so the queue is empty here */
+  g_queue_clear_full (&self->pending, (GDestroyNotify) operation_free);
+  g_clear_pointer (&self->pending_by_uid, g_hash_table_destroy);
+
+  if (self->backend_data_destroy)
+    g_clear_pointer (&self->backend_data, self->backend_data_destroy);
+
+  G_OBJECT_CLASS (gtd_eds_writer_parent_class)->finalize (object);
+}
+
+static void
+gtd_eds_writer_get_property (GObject    *object,
+                             guint       prop_id,
+                             GValue     *value,
+                             GParamSpec *pspec)
+{
+  GtdEdsWriter *self = GTD_EDS_WRITER (object);
+
+  switch (prop_id)
+    {
+    case PROP_QUEUE_DEPTH:
+      g_value_set_uint (value, self->pending.length);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+    }
+}
+
+static void
+gtd_eds_writer_class_init (GtdEdsWriterClass *klass)
+{
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->finalize = gtd_eds_writer_finalize;
+  object_class->get_property = gtd_eds_writer_get_property;
+
+  /**
+   * GtdEdsWriter::queue-depth:
+   *
+   * The number of operations waiting to be written.
+   */
+  properties[PROP_QUEUE_DEPTH] = g_param_spec_uint ("queue-depth",
+                                                    "Queue depth",
+                                                    "The number of operations waiting to be written",
+                                                    0,
+                                                    G_MAXUINT,
+                                                    0,
+                                                    G_PARAM_READABLE | G_PARAM_EXPLICIT_NOTIFY | G_PARAM_STATIC_STRINGS);
+
+  g_object_class_install_properties (object_class, N_PROPS, properties);
+}
+
+static void
+gtd_eds_writer_init (GtdEdsWriter *self)
+{
+  g_queue_init (&self->pending);
+  self->pending_by_uid = g_hash_table_new (g_str_hash, g_str_equal);
+}
+
+/**
+ * gtd_eds_writer_new:
+ * @client: an #ECalClient
+ *
+ * Creates a new #GtdEdsWriter that writes to @client.
+ *
+ * Returns: (transfer full): a #GtdEdsWriter
+ */
+GtdEdsWriter*
+gtd_eds_writer_new (ECalClient *client)
+{
+  g_return_val_if_fail (E_IS_CAL_CLIENT (client), NULL);
+
+  return gtd_eds_writer_new_for_backend (&client_backend, g_object_ref (client), g_object_unref);
+}
+
+/**
+ * gtd_eds_writer_new_for_backend:
+ * @backend: the operations to write with
+ * @backend_data: the data passed to the operations of @backend
+ * @backend_data_destroy: (nullable): function to free @backend_data
+ *
+ * Creates a new #GtdEdsWriter that writes with @backend. The operations
+ * of @backend are called in a worker thread, one batch at a time.
+ *
+ * Returns: (transfer full): a #GtdEdsWriter
+ */
+GtdEdsWriter*
+gtd_eds_writer_new_for_backend (const GtdEdsWriterBackend *backend,
+                                gpointer                   backend_data,
+                                GDestroyNotify             backend_data_destroy)
+{
+  GtdEdsWriter *self;
+
+  g_return_val_if_fail (backend != NULL, NULL);
+
+  self = g_object_new (GTD_TYPE_EDS_WRITER, NULL);
+  self->backend = backend;
+  self->backend_data = backend_data;
+  self->backend_data_destroy = backend_data_destroy;
+
+  return self;
+}
+
+/**
+ * gtd_eds_writer_create:
+ * @self: a #GtdEdsWriter
+ * @icalcomp: the component to create
+ * @cancellable: (nullable): a #GCancellable
+ * @callback: (scope async): callback to call when the component is created
+ * @user_data: user data for @callback
+ *
+ * Queues the creation of a copy of @icalcomp.
+ */
+void
+gtd_eds_writer_create (GtdEdsWriter        *self,
+                       ICalComponent       *icalcomp,
+                       GCancellable        *cancellable,
+                       GAsyncReadyCallback  callback,
+                       gpointer             user_data)
+{
+  g_autoptr (GTask) task = NULL;
+  Operation *operation;
+
+  g_return_if_fail (GTD_IS_EDS_WRITER (self));
+  g_return_if_fail (I_CAL_IS_COMPONENT (icalcomp));
+
+  task = create_task (self, cancellable, callback, user_data, gtd_eds_writer_create);
+
+  operation = operation_new (OPERATION_CREATE, i_cal_component_get_uid (icalcomp), task);
+  operation->icalcomp = i_cal_component_clone (icalcomp);
+
+  enqueue_operation (self, operation);
+}
+
+/**
+ * gtd_eds_writer_create_finish:
+ * @self: a #GtdEdsWriter
+ * @result: a #GAsyncResult
+ * @error: return location for a #GError
+ *
+ * Finishes an operation started with gtd_eds_writer_create().
+ *
+ * Returns: (transfer full)(nullable): the uid of the created component,
+ * if the calendar assigned a new one
+ */
+gchar*
+gtd_eds_writer_create_finish (GtdEdsWriter  *self,
+                              GAsyncResult  *result,
+                              GError       **error)
+{
+  g_return_val_if_fail (GTD_IS_EDS_WRITER (self), NULL);
+  g_return_val_if_fail (g_task_is_valid (result, self), NULL);
+
+  return g_task_propagate_pointer (G_TASK (result), error);
+}
+
+/**
+ * gtd_eds_writer_modify:
+ * @self: a #GtdEdsWriter
+ * @icalcomp: the modified component
+ * @cancellable: (nullable): a #GCancellable
+ * @callback: (scope async): callback to call when the component is written
+ * @user_data: user data for @callback
+ *
+ * Queues the modification of the component with the uid of @icalcomp. If
+ * the component already has a pending modification, @icalcomp replaces
+ * it, and both operations finish when it is written.
+ */
+void
+gtd_eds_writer_modify (GtdEdsWriter        *self,
+                       ICalComponent       *icalcomp,
+                       GCancellable        *cancellable,
+                       GAsyncReadyCallback  callback,
+                       gpointer             user_data)
+{
+  g_autoptr (GTask) task = NULL;
+  Operation *operation;
+  const gchar *uid;
+
+  g_return_if_fail (GTD_IS_EDS_WRITER (self));
+  g_return_if_fail (I_CAL_IS_COMPONENT (icalcomp));
+
+  task = create_task (self, cancellable, callback, user_data, gtd_eds_writer_modify);
+  uid = i_cal_component_get_uid (icalcomp);
+  operation = uid ? g_hash_table_lookup (self->pending_by_uid, uid) : NULL;
+
+  if (operation && operation->type == OPERATION_MODIFY)
+    {
+      GTD_TRACE_MSG ("Collapsing modifications of '%s'", uid);
+
+      g_clear_pointer (&operation->icalcomp, g_object_unref);
+      operation->icalcomp = i_cal_component_clone (icalcomp);
+      g_ptr_array_add (operation->tasks, g_object_ref (task));
+
+      self->stats.n_coalesced++;
+      return;
+    }
+
+  operation = operation_new (OPERATION_MODIFY, uid, task);
+  operation->icalcomp = i_cal_component_clone (icalcomp);
+
+  enqueue_operation (self, operation);
+}
+
+/**
+ * gtd_eds_writer_modify_finish:
+ * @self: a #GtdEdsWriter
+ * @result: a #GAsyncResult
+ * @error: return location for a #GError
+ *
+ * Finishes an operation started with gtd_eds_writer_modify().
+ *
+ * Returns: %TRUE if the component was written, %FALSE otherwise
+ */
+gboolean
+gtd_eds_writer_modify_finish (GtdEdsWriter  *self,
+                              GAsyncResult  *result,
+                              GError       **error)
+{
+  g_return_val_if_fail (GTD_IS_EDS_WRITER (self), FALSE);
+  g_return_val_if_fail (g_task_is_valid (result, self), FALSE);
+
+  return g_task_propagate_boolean (G_TASK (result), error);
+}
+
+/**
+ * gtd_eds_writer_remove:
+ * @self: a #GtdEdsWriter
+ * @uid: the uid of the component to remove
+ * @rid: (nullable): the recurrence id of the component
+ * @cancellable: (nullable): a #GCancellable
+ * @callback: (scope async): callback to call when the component is removed
+ * @user_data: user data for @callback
+ *
+ * Queues the removal of the component with @uid. A pending modification
+ * of the component is not written anymore, and finishes when the
+ * component is removed.
+ */
+void
+gtd_eds_writer_remove (GtdEdsWriter        *self,
+                       const gchar         *uid,
+                       const gchar         *rid,
+                       GCancellable        *cancellable,
+                       GAsyncReadyCallback  callback,
+                       gpointer             user_data)
+{
+  g_autoptr (GTask) task = NULL;
+  Operation *operation;
+
+  g_return_if_fail (GTD_IS_EDS_WRITER (self));
+  g_return_if_fail (uid != NULL);
+
+  task = create_task (self, cancellable, callback, user_data, gtd_eds_writer_remove);
+  operation = g_hash_table_lookup (self->pending_by_uid, uid);
+
+  if (operation)
+    {
+      GTD_TRACE_MSG ("Collapsing removal of '%s'", uid);
+
+      operation->type = OPERATION_REMOVE;
+      g_clear_pointer (&operation->icalcomp, g_object_unref);
+      g_clear_pointer (&operation->rid, g_free);
+      operation->rid = g_strdup (rid);
+      g_ptr_array_add (operation->tasks, g_object_ref (task));
+
+      self->stats.n_coalesced++;
+      return;
+    }
+
+  operation = operation_new (OPERATION_REMOVE, uid, task);
+  operation->rid = g_strdup (rid);
+
+  enqueue_operation (self, operation);
+}
+
+/**
+ * gtd_eds_writer_remove_finish:
+ * @self: a #GtdEdsWriter
+ * @result: a #GAsyncResult
+ * @error: return location for a #GError
+ *
+ * Finishes an operation started with gtd_eds_writer_remove().
+ *
+ * Returns: %TRUE if the component was removed, %FALSE otherwise
+ */
+gboolean
+gtd_eds_writer_remove_finish (GtdEdsWriter  *self,
+                              GAsyncResult  *result,
+                              GError       **error)
+{
+  g_return_val_if_fail (GTD_IS_EDS_WRITER (self), FALSE);
+  g_return_val_if_fail (g_task_is_valid (result, self), FALSE);
+
+  return g_task_propagate_boolean (G_TASK (result), error);
+}
+
+/**
+ * gtd_eds_writer_get_queue_depth:
+ * @self: a #GtdEdsWriter
+ *
+ * Retrieves the number of operations waiting to be written, not
+ * counting the ones being written.
+ *
+ * Returns: the number of queued operations
+ */
+guint
+gtd_eds_writer_get_queue_depth (GtdEdsWriter *self)
+{
+  g_return_val_if_fail (GTD_IS_EDS_WRITER (self), 0);
+
+  return self->pending.length;
+}
+
+/**
+ * gtd_eds_writer_get_stats:
+ * @self: a #GtdEdsWriter
+ * @out_stats: (out): return location for the statistics
+ *
+ * Retrieves the statistics of @self. The latency of an operation is the
+ * time between it being queued and written.
+ */
+void
+gtd_eds_writer_get_stats (GtdEdsWriter      *self,
+                          GtdEdsWriterStats *out_stats)
+{
+  g_return_if_fail (GTD_IS_EDS_WRITER (self));
+  g_return_if_fail (out_stats != NULL);
+
+  *out_stats = self->stats;
+  out_stats->queue_depth = self->pending.length;
+}
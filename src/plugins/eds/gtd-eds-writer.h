@@ -0,0 +1,109 @@
+/* gtd-eds-writer.h
+ *
+ * Copyright 2020 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "gtd-eds.h"
+
+#include <gio/gio.h>
+
+G_BEGIN_DECLS
+
+/*
+ * The operations the writer issues, in a worker thread. By default they
+ * call the ECalClient, but tests can provide a stand-in calendar.
+ */
+typedef struct
+{
+  gboolean           (*create_objects)                           (gpointer            backend,
+                                                                  GSList             *icalcomps,
+                                                                  GSList            **out_uids,
+                                                                  GCancellable       *cancellable,
+                                                                  GError            **error);
+
+  gboolean           (*modify_objects)                           (gpointer            backend,
+                                                                  GSList             *icalcomps,
+                                                                  GCancellable       *cancellable,
+                                                                  GError            **error);
+
+  gboolean           (*remove_objects)                           (gpointer            backend,
+                                                                  GSList             *ids,
+                                                                  GCancellable       *cancellable,
+                                                                  GError            **error);
+} GtdEdsWriterBackend;
+
+typedef struct
+{
+  guint               n_requests;
+  guint               n_coalesced;
+  guint               n_batches;
+  guint               queue_depth;
+  guint               max_queue_depth;
+  gint64              total_latency_us;
+  gint64              max_latency_us;
+} GtdEdsWriterStats;
+
+#define GTD_TYPE_EDS_WRITER (gtd_eds_writer_get_type())
+
+G_DECLARE_FINAL_TYPE (GtdEdsWriter, gtd_eds_writer, GTD, EDS_WRITER, GObject)
+
+GtdEdsWriter*        gtd_eds_writer_new                          (ECalClient                *client);
+
+GtdEdsWriter*        gtd_eds_writer_new_for_backend              (const GtdEdsWriterBackend *backend,
+                                                                  gpointer                   backend_data,
+                                                                  GDestroyNotify             backend_data_destroy);
+
+void                 gtd_eds_writer_create                       (GtdEdsWriter        *self,
+                                                                  ICalComponent       *icalcomp,
+                                                                  GCancellable        *cancellable,
+                                                                  GAsyncReadyCallback  callback,
+                                                                  gpointer             user_data);
+
+gchar*               gtd_eds_writer_create_finish                (GtdEdsWriter        *self,
+                                                                  GAsyncResult        *result,
+                                                                  GError             **error);
+
+void                 gtd_eds_writer_modify                       (GtdEdsWriter        *self,
+                                                                  ICalComponent       *icalcomp,
+                                                                  GCancellable        *cancellable,
+                                                                  GAsyncReadyCallback  callback,
+                                                                  gpointer             user_data);
+
+gboolean             gtd_eds_writer_modify_finish                (GtdEdsWriter        *self,
+                                                                  GAsyncResult        *result,
+                                                                  GError             **error);
+
+void                 gtd_eds_writer_remove                       (GtdEdsWriter        *self,
+                                                                  const gchar         *uid,
+                                                                  const gchar         *rid,
+                                                                  GCancellable        *cancellable,
+                                                                  GAsyncReadyCallback  callback,
+                                                                  gpointer             user_data);
+
+gboolean             gtd_eds_writer_remove_finish                (GtdEdsWriter        *self,
+                                                                  GAsyncResult        *result,
+                                                                  GError             **error);
+
+guint                gtd_eds_writer_get_queue_depth              (GtdEdsWriter        *self);
+
+void                 gtd_eds_writer_get_stats                    (GtdEdsWriter        *self,
+                                                                  GtdEdsWriterStats   *out_stats);
+
+G_END_DECLS
@@ -20,12 +20,15 @@
 
 #include "gtd-debug.h"
 #include "gtd-eds-autoptr.h"
+#include "gtd-eds-writer.h"
 #include "gtd-provider-eds.h"
 #include "gtd-task-eds.h"
 #include "gtd-task-list-eds.h"
 
 #include <glib/gi18n.h>
 
+#define DEFAULT_MAX_PARALLEL_LOADS 4
+
 /**
  * #GtdProviderEds is the base class of #GtdProviderLocal
  * and #GtdProviderGoa. It provides the common functionality
@@ -40,15 +43,43 @@
 typedef struct
 {
   GtdTaskList        *list;
-  GDateTime          *due_date;
   gchar              *title;
   ESource            *source;
 
   /* Update Task */
   ECalComponent      *component;
   GtdTask            *task;
+
+  /* Update Tasks */
+  GPtrArray          *tasks;
+  gboolean           *failed;
+  guint               n_pending;
+  GError             *error;
 } AsyncData;
 
+/* One modification of an update of several tasks */
+typedef struct
+{
+  GTask              *task;
+  guint               index;
+} TaskOperation;
+
+/*
+ * The load of a source, from being queued until its list is added. The
+ * timestamps are used to report which sources are slow to load.
+ */
+typedef struct
+{
+  GtdProviderEds     *provider;
+  ESource            *source;
+  GCancellable       *cancellable;
+  gboolean            priority;
+
+  gint64              queued_time;
+  gint64              connect_time;
+  gint64              client_time;
+} SourceLoad;
+
 typedef struct
 {
   GHashTable           *task_lists;
@@ -57,12 +88,24 @@ typedef struct
 
   GCancellable         *cancellable;
 
-  gint                  lazy_load_id;
+  /*
+   * Sources are connected to a few at a time, with the inbox and the
+   * default list first. Only these keep the manager loading; the other
+   * lists are added as they finish loading.
+   */
+  GQueue                pending_loads;
+  GHashTable           *running_loads;
+  guint                 max_parallel_loads;
+  gint64                first_load_time;
 } GtdProviderEdsPrivate;
 
 
 static void          gtd_provider_iface_init                     (GtdProviderInterface *iface);
 
+static void          on_client_connected_cb                      (GObject            *source_object,
+                                                                  GAsyncResult       *result,
+                                                                  gpointer            user_data);
+
 
 G_DEFINE_TYPE_WITH_CODE (GtdProviderEds, gtd_provider_eds, GTD_TYPE_OBJECT,
                          G_ADD_PRIVATE (GtdProviderEds)
@@ -79,6 +122,7 @@ enum
   PROP_NAME,
   PROP_PROVIDER_TYPE,
   PROP_REGISTRY,
+  PROP_MAX_PARALLEL_LOADS,
   N_PROPS
 };
 
@@ -92,15 +136,61 @@ async_data_free (gpointer data)
 {
   AsyncData *async_data = data;
 
-  g_clear_pointer (&async_data->due_date, g_date_time_unref);
   g_clear_pointer (&async_data->title, g_free);
   g_clear_object (&async_data->source);
   g_clear_object (&async_data->list);
   g_clear_object (&async_data->task);
   g_clear_object (&async_data->component);
+  g_clear_pointer (&async_data->tasks, g_ptr_array_unref);
+  g_clear_pointer (&async_data->failed, g_free);
+  g_clear_error (&async_data->error);
   g_free (async_data);
 }
 
+static ECalComponent*
+create_component (const gchar *title,
+                  GDateTime   *due_date)
+{
+  ECalComponentText *new_summary;
+  ECalComponent *component;
+
+  component = e_cal_component_new ();
+  e_cal_component_set_new_vtype (component, E_CAL_COMPONENT_TODO);
+
+  new_summary = e_cal_component_text_new (title, NULL);
+  e_cal_component_set_summary (component, new_summary);
+
+  if (due_date)
+    {
+      ECalComponentDateTime *comp_dt;
+      ICalTime *idt;
+
+      idt = i_cal_time_new_null_time ();
+      i_cal_time_set_date (idt,
+                           g_date_time_get_year (due_date),
+                           g_date_time_get_month (due_date),
+                           g_date_time_get_day_of_month (due_date));
+      i_cal_time_set_time (idt,
+                           g_date_time_get_hour (due_date),
+                           g_date_time_get_minute (due_date),
+                           g_date_time_get_seconds (due_date));
+      i_cal_time_set_is_date (idt,
+                              i_cal_time_get_hour (idt) == 0 &&
+                              i_cal_time_get_minute (idt) == 0 &&
+                              i_cal_time_get_second (idt) == 0);
+
+      comp_dt = e_cal_component_datetime_new_take (idt, g_strdup ("UTC"));
+      e_cal_component_set_due (component, comp_dt);
+      e_cal_component_commit_sequence (component);
+
+      e_cal_component_datetime_free (comp_dt);
+    }
+
+  e_cal_component_text_free (new_summary);
+
+  return component;
+}
+
 static void
 set_default_list (GtdProviderEds *self,
                   GtdTaskList    *list)
@@ -119,6 +209,152 @@ set_default_list (GtdProviderEds *self,
     gtd_manager_set_default_provider (manager, GTD_PROVIDER (self));
 }
 
+static void
+source_load_free (SourceLoad *load)
+{
+  /* Whatever is still connecting or loading won't find the load anymore */
+  g_cancellable_cancel (load->cancellable);
+
+  g_clear_object (&load->cancellable);
+  g_clear_object (&load->source);
+  g_free (load);
+}
+
+static gboolean
+is_priority_source (GtdProviderEds *self,
+                    ESource        *source)
+{
+  g_autoptr (ESource) default_source = NULL;
+  GtdProviderEdsPrivate *priv;
+
+  priv = gtd_provider_eds_get_instance_private (self);
+
+  if (g_str_equal (e_source_get_uid (source), GTD_PROVIDER_EDS_INBOX_ID))
+    return TRUE;
+
+  default_source = e_source_registry_ref_default_task_list (priv->source_registry);
+
+  return default_source && e_source_equal (source, default_source);
+}
+
+static void
+queue_source (GtdProviderEds *self,
+              ESource        *source)
+{
+  GtdProviderEdsPrivate *priv;
+  SourceLoad *load;
+  GList *l;
+
+  priv = gtd_provider_eds_get_instance_private (self);
+
+  /* Don't load the source if it's not a tasklist */
+  if (!e_source_has_extension (source, E_SOURCE_EXTENSION_TASK_LIST) ||
+      !GTD_PROVIDER_EDS_CLASS (G_OBJECT_GET_CLASS (self))->should_load_source (self, source))
+    {
+      GTD_TRACE_MSG ("Ignoring source %s (%s)",
+                     e_source_get_display_name (source),
+                     e_source_get_uid (source));
+      return;
+    }
+
+  load = g_new0 (SourceLoad, 1);
+  load->provider = self;
+  load->source = g_object_ref (source);
+  load->cancellable = g_cancellable_new ();
+  load->priority = is_priority_source (self, source);
+  load->queued_time = g_get_monotonic_time ();
+
+  /*
+   * The pop_loading() is actually emited by GtdTaskListEds, before the
+   * provider's ::list-added is emitted.
+   */
+  gtd_object_push_loading (GTD_OBJECT (self));
+
+  if (load->priority)
+    gtd_object_push_loading (GTD_OBJECT (gtd_manager_get_default ()));
+
+  if (priv->first_load_time == 0)
+    priv->first_load_time = load->queued_time;
+
+  /* Priority sources go before all the others */
+  for (l = priv->pending_loads.head; l; l = l->next)
+    {
+      if (load->priority && !((SourceLoad*) l->data)->priority)
+        break;
+    }
+
+  if (l)
+    g_queue_insert_before (&priv->pending_loads, l, load);
+  else
+    g_queue_push_tail (&priv->pending_loads, load);
+}
+
+static void
+load_next_sources (GtdProviderEds *self)
+{
+  GtdProviderEdsPrivate *priv;
+  SourceLoad *load;
+
+  priv = gtd_provider_eds_get_instance_private (self);
+
+  while (g_hash_table_size (priv->running_loads) < priv->max_parallel_loads &&
+         (load = g_queue_pop_head (&priv->pending_loads)))
+    {
+      GTD_TRACE_MSG ("Connecting to source %s (%s)%s",
+                     e_source_get_display_name (load->source),
+                     e_source_get_uid (load->source),
+                     load->priority ? ", with priority" : "");
+
+      load->connect_time = g_get_monotonic_time ();
+
+      g_hash_table_insert (priv->running_loads, (gpointer) e_source_get_uid (load->source), load);
+
+      e_cal_client_connect (load->source,
+                            E_CAL_CLIENT_SOURCE_TYPE_TASKS,
+                            15, /* seconds to wait */
+                            load->cancellable,
+                            on_client_connected_cb,
+                            load);
+    }
+}
+
+static void
+finish_source_load (GtdProviderEds *self,
+                    SourceLoad     *load,
+                    gboolean        success)
+{
+  GtdProviderEdsPrivate *priv;
+  gint64 now;
+
+  priv = gtd_provider_eds_get_instance_private (self);
+  now = g_get_monotonic_time ();
+
+  g_debug ("Task list '%s' %s in %.1lfms (queued for %.1lfms, connected in %.1lfms, loaded in %.1lfms)",
+           e_source_get_display_name (load->source),
+           success ? "loaded" : "failed to load",
+           (now - load->queued_time) / 1000.0,
+           (load->connect_time - load->queued_time) / 1000.0,
+           load->client_time > 0 ? (load->client_time - load->connect_time) / 1000.0 : 0.0,
+           load->client_time > 0 ? (now - load->client_time) / 1000.0 : 0.0);
+
+  /* On success, the list already popped the provider's loading */
+  if (!success)
+    gtd_object_pop_loading (GTD_OBJECT (self));
+
+  if (load->priority)
+    gtd_object_pop_loading (GTD_OBJECT (gtd_manager_get_default ()));
+
+  g_hash_table_remove (priv->running_loads, e_source_get_uid (load->source));
+
+  load_next_sources (self);
+
+  if (g_hash_table_size (priv->running_loads) == 0 && priv->pending_loads.length == 0)
+    {
+      g_debug ("All task lists loaded in %.1lfms", (now - priv->first_load_time) / 1000.0);
+      priv->first_load_time = 0;
+    }
+}
+
 static void
 ensure_offline_sync (GtdProviderEds *self,
                      ESource        *source)
@@ -142,19 +378,26 @@ on_task_list_eds_loaded_cb (GObject      *source_object,
                             GAsyncResult *result,
                             gpointer      user_data)
 {
+  g_autoptr (GtdTaskListEds) list = NULL;
   g_autoptr (GError) error = NULL;
   GtdProviderEdsPrivate *priv;
   GtdProviderEds *self;
-  GtdTaskListEds *list;
+  SourceLoad *load;
   ESource *source;
 
-  self = GTD_PROVIDER_EDS (user_data);
-  priv = gtd_provider_eds_get_instance_private (self);
+  load = user_data;
   list = gtd_task_list_eds_new_finish (result, &error);
 
+  if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+    return;
+
+  self = load->provider;
+  priv = gtd_provider_eds_get_instance_private (self);
+
   if (error)
     {
       g_warning ("Error creating task list: %s", error->message);
+      finish_source_load (self, load, FALSE);
       return;
     }
 
@@ -175,79 +418,122 @@ on_client_connected_cb (GObject      *source_object,
   GtdProviderEdsPrivate *priv;
   GtdProviderEds *self;
   ECalClient *client;
-  ESource *source;
+  SourceLoad *load;
 
-  self = GTD_PROVIDER_EDS (user_data);
-  priv = gtd_provider_eds_get_instance_private (self);
-  source = e_client_get_source (E_CLIENT (source_object));
+  load = user_data;
   client = E_CAL_CLIENT (e_cal_client_connect_finish (result, &error));
 
+  /* The provider is gone */
+  if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+    return;
+
+  self = load->provider;
+  priv = gtd_provider_eds_get_instance_private (self);
+
   if (error)
     {
-      g_warning ("Failed to connect to task list '%s': %s", e_source_get_uid (source), error->message);
+      g_warning ("Failed to connect to task list '%s': %s", e_source_get_uid (load->source), error->message);
 
       gtd_manager_emit_error_message (gtd_manager_get_default (),
                                       _("Failed to connect to task list"),
                                       error->message,
                                       NULL,
                                       NULL);
-      gtd_object_pop_loading (GTD_OBJECT (self));
+      finish_source_load (self, load, FALSE);
       return;
     }
 
-  ensure_offline_sync (self, source);
+  load->client_time = g_get_monotonic_time ();
+
+  ensure_offline_sync (self, load->source);
 
   /* creates a new task list */
   gtd_task_list_eds_new (GTD_PROVIDER (self),
-                         source,
+                         load->source,
                          client,
                          on_task_list_eds_loaded_cb,
-                         priv->cancellable,
-                         self);
+                         load->cancellable,
+                         load);
+
+  g_object_unref (client);
+}
+
+static void
+on_list_added_cb (GtdProviderEds *self,
+                  GtdTaskList    *list)
+{
+  GtdProviderEdsPrivate *priv;
+  SourceLoad *load;
+  ESource *source;
+
+  priv = gtd_provider_eds_get_instance_private (self);
+  source = gtd_task_list_eds_get_source (GTD_TASK_LIST_EDS (list));
+  load = g_hash_table_lookup (priv->running_loads, e_source_get_uid (source));
+
+  if (load)
+    finish_source_load (self, load, TRUE);
 }
 
 static void
 on_source_added_cb (GtdProviderEds *provider,
                     ESource        *source)
 {
-  /* Don't load the source if it's not a tasklist */
-  if (!e_source_has_extension (source, E_SOURCE_EXTENSION_TASK_LIST) ||
-      !GTD_PROVIDER_EDS_CLASS (G_OBJECT_GET_CLASS (provider))->should_load_source (provider, source))
-    {
-      GTD_TRACE_MSG ("Ignoring source %s (%s)",
-                     e_source_get_display_name (source),
-                     e_source_get_uid (source));
-      return;
-    }
-
-  /*
-   * The pop_loading() is actually emited by GtdTaskListEds, after the
-   * ECalClientView sends the :complete signal.
-   */
-  gtd_object_push_loading (GTD_OBJECT (provider));
-  gtd_object_push_loading (GTD_OBJECT (gtd_manager_get_default ()));
-
-  e_cal_client_connect (source,
-                        E_CAL_CLIENT_SOURCE_TYPE_TASKS,
-                        15, /* seconds to wait */
-                        NULL,
-                        on_client_connected_cb,
-                        provider);
+  queue_source (provider, source);
+  load_next_sources (provider);
 }
 
 static void
 on_source_removed_cb (GtdProviderEds *provider,
                       ESource        *source)
 {
+  g_autoptr (GtdTaskList) list = NULL;
   GtdProviderEdsPrivate *priv;
-  GtdTaskList *list;
+  SourceLoad *load;
+  gboolean announced;
+  GList *l;
 
   GTD_ENTRY;
 
   priv = gtd_provider_eds_get_instance_private (provider);
+
+  /* Sources that weren't connected to yet are simply not loaded anymore */
+  for (l = priv->pending_loads.head; l; l = l->next)
+    {
+      load = l->data;
+
+      if (!e_source_equal (load->source, source))
+        continue;
+
+      gtd_object_pop_loading (GTD_OBJECT (provider));
+
+      if (load->priority)
+        gtd_object_pop_loading (GTD_OBJECT (gtd_manager_get_default ()));
+
+      g_queue_delete_link (&priv->pending_loads, l);
+      source_load_free (load);
+
+      GTD_RETURN ();
+    }
+
+  /*
+   * Sources still connecting or loading are cancelled, and their list, if
+   * already created, was never announced with ::list-added.
+   */
+  load = g_hash_table_lookup (priv->running_loads, e_source_get_uid (source));
+  announced = load == NULL;
+
+  if (load)
+    finish_source_load (provider, load, FALSE);
+
   list = g_object_get_data (G_OBJECT (source), "task-list");
 
-  if (!g_hash_table_remove (priv->task_lists, gtd_object_get_uid (GTD_OBJECT (list))))
+  if (!list)
+    GTD_RETURN ();
+
+  /* Keep the list alive until ::list-removed is emitted */
+  g_object_ref (list);
+
+  if (!g_hash_table_remove (priv->task_lists, gtd_object_get_uid (GTD_OBJECT (list))) || !announced)
     GTD_RETURN ();
 
   /*
@@ -283,75 +569,31 @@ on_source_refreshed_cb (GObject      *source_object,
 }
 
 static void
-create_task_in_thread_cb (GTask        *task,
-                          gpointer      source_object,
-                          gpointer      task_data,
-                          GCancellable *cancellable)
+on_task_created_cb (GObject      *source_object,
+                    GAsyncResult *result,
+                    gpointer      user_data)
 {
-  g_autoptr (ECalComponent) component = NULL;
+  g_autoptr (GTask) task = G_TASK (user_data);
   g_autoptr (GError) error = NULL;
   g_autofree gchar *new_uid = NULL;
-  ECalComponentText *new_summary;
   GtdTaskListEds *tasklist;
-  ECalClient *client;
   AsyncData *data;
   GtdTask *new_task;
 
   GTD_ENTRY;
 
-  data = task_data;
-  tasklist = GTD_TASK_LIST_EDS (data->list);
-  client = gtd_task_list_eds_get_client (tasklist);
-
-  /* Create the new task */
-  component = e_cal_component_new ();
-  e_cal_component_set_new_vtype (component, E_CAL_COMPONENT_TODO);
-
-  new_summary = e_cal_component_text_new (data->title, NULL);
-  e_cal_component_set_summary (component, new_summary);
-
-  if (data->due_date)
-    {
-      ECalComponentDateTime *comp_dt;
-      ICalTime *idt;
-
-      idt = i_cal_time_new_null_time ();
-      i_cal_time_set_date (idt,
-                           g_date_time_get_year (data->due_date),
-                           g_date_time_get_month (data->due_date),
-                           g_date_time_get_day_of_month (data->due_date));
-      i_cal_time_set_time (idt,
-                           g_date_time_get_hour (data->due_date),
-                           g_date_time_get_minute (data->due_date),
-                           g_date_time_get_seconds (data->due_date));
-      i_cal_time_set_is_date (idt,
-                              i_cal_time_get_hour (idt) == 0 &&
-                              i_cal_time_get_minute (idt) == 0 &&
-                              i_cal_time_get_second (idt) == 0);
-
-      comp_dt = e_cal_component_datetime_new_take (idt, g_strdup ("UTC"));
-      e_cal_component_set_due (component, comp_dt);
-      e_cal_component_commit_sequence (component);
-
-      e_cal_component_datetime_free (comp_dt);
-    }
-
-  e_cal_client_create_object_sync (client,
-                                   e_cal_component_get_icalcomponent (component),
-                                   E_CAL_OPERATION_FLAG_NONE,
-                                   &new_uid,
-                                   cancellable,
-                                   &error);
-
-  e_cal_component_text_free (new_summary);
+  new_uid = gtd_eds_writer_create_finish (GTD_EDS_WRITER (source_object), result, &error);
 
   if (error)
     {
       g_task_return_error (task, g_steal_pointer (&error));
-      return;
+      GTD_RETURN ();
     }
 
-  new_task = gtd_task_eds_new (component);
+  data = g_task_get_task_data (task);
+  tasklist = GTD_TASK_LIST_EDS (data->list);
+
+  new_task = gtd_task_eds_new (data->component);
   gtd_task_set_position (new_task, g_list_model_get_n_items (G_LIST_MODEL (tasklist)));
 
   /*
@@ -364,37 +606,22 @@ create_task_in_thread_cb (GTask        *task,
   /* Effectively apply the updated component */
   gtd_task_eds_apply (GTD_TASK_EDS (new_task));
 
-  g_task_return_pointer (task, g_object_ref (new_task), g_object_unref);
+  g_task_return_pointer (task, new_task, g_object_unref);
 
   GTD_EXIT;
 }
 
 static void
-update_task_in_thread_cb (GTask        *task,
-                          gpointer      source_object,
-                          gpointer      task_data,
-                          GCancellable *cancellable)
+on_task_modified_cb (GObject      *source_object,
+                     GAsyncResult *result,
+                     gpointer      user_data)
 {
+  g_autoptr (GTask) task = G_TASK (user_data);
   g_autoptr (GError) error = NULL;
-  GtdTaskListEds *tasklist;
-  ECalClient *client;
-  AsyncData *data;
 
   GTD_ENTRY;
 
-  data = task_data;
-  tasklist = GTD_TASK_LIST_EDS (gtd_task_get_list (data->task));
-  client = gtd_task_list_eds_get_client (tasklist);
-
-  e_cal_client_modify_object_sync (client,
-                                   e_cal_component_get_icalcomponent (data->component),
-                                   E_CAL_OBJ_MOD_THIS,
-                                   E_CAL_OPERATION_FLAG_NONE,
-                                   cancellable,
-                                   &error);
-
-
-  if (error)
+  if (!gtd_eds_writer_modify_finish (GTD_EDS_WRITER (source_object), result, &error))
     {
       g_task_return_error (task, g_steal_pointer (&error));
       GTD_RETURN ();
@@ -406,34 +633,50 @@ update_task_in_thread_cb (GTask        *task,
 }
 
 static void
-remove_task_in_thread_cb (GTask        *task,
-                          gpointer      source_object,
-                          gpointer      task_data,
-                          GCancellable *cancellable)
+on_tasks_modified_cb (GObject      *source_object,
+                      GAsyncResult *result,
+                      gpointer      user_data)
 {
-  g_autoptr (ECalComponentId) id = NULL;
+  g_autofree TaskOperation *operation = user_data;
+  g_autoptr (GTask) task = operation->task;
   g_autoptr (GError) error = NULL;
-  GtdTaskListEds *tasklist;
-  ECalClient *client;
   AsyncData *data;
 
   GTD_ENTRY;
 
-  data = task_data;
-  tasklist = GTD_TASK_LIST_EDS (gtd_task_get_list (data->task));
-  client = gtd_task_list_eds_get_client (tasklist);
-  id = e_cal_component_get_id (data->component);
+  data = g_task_get_task_data (task);
 
-  e_cal_client_remove_object_sync (client,
-                                   e_cal_component_id_get_uid (id),
-                                   e_cal_component_id_get_rid (id),
-                                   E_CAL_OBJ_MOD_THIS,
-                                   E_CAL_OPERATION_FLAG_NONE,
-                                   cancellable,
-                                   &error);
+  /* Remember which tasks failed, keep the first error, and finish when all the tasks are written */
+  if (!gtd_eds_writer_modify_finish (GTD_EDS_WRITER (source_object), result, &error))
+    {
+      data->failed[operation->index] = TRUE;
 
+      if (!data->error)
+        data->error = g_steal_pointer (&error);
+    }
 
-  if (error)
+  if (--data->n_pending > 0)
+    GTD_RETURN ();
+
+  if (data->error)
+    g_task_return_error (task, g_steal_pointer (&data->error));
+  else
+    g_task_return_boolean (task, TRUE);
+
+  GTD_EXIT;
+}
+
+static void
+on_task_removed_cb (GObject      *source_object,
+                    GAsyncResult *result,
+                    gpointer      user_data)
+{
+  g_autoptr (GTask) task = G_TASK (user_data);
+  g_autoptr (GError) error = NULL;
+
+  GTD_ENTRY;
+
+  if (!gtd_eds_writer_remove_finish (GTD_EDS_WRITER (source_object), result, &error))
     {
       g_task_return_error (task, g_steal_pointer (&error));
       GTD_RETURN ();
@@ -444,6 +687,34 @@ remove_task_in_thread_cb (GTask        *task,
   GTD_EXIT;
 }
 
+static void
+on_tasks_removed_cb (GObject      *source_object,
+                     GAsyncResult *result,
+                     gpointer      user_data)
+{
+  g_autoptr (GTask) task = G_TASK (user_data);
+  g_autoptr (GError) error = NULL;
+  AsyncData *data;
+
+  GTD_ENTRY;
+
+  data = g_task_get_task_data (task);
+
+  /* Keep the first error, and finish when all the tasks are removed */
+  if (!gtd_eds_writer_remove_finish (GTD_EDS_WRITER (source_object), result, &error) && !data->error)
+    data->error = g_steal_pointer (&error);
+
+  if (--data->n_pending > 0)
+    GTD_RETURN ();
+
+  if (data->error)
+    g_task_return_error (task, g_steal_pointer (&data->error));
+  else
+    g_task_return_boolean (task, TRUE);
+
+  GTD_EXIT;
+}
+
 static void
 create_or_update_task_list_in_thread_cb (GTask        *task,
                                          gpointer      source_object,
@@ -624,15 +895,19 @@ gtd_provider_eds_create_task (GtdProvider         *provider,
 
   data = g_new0 (AsyncData, 1);
   data->list = g_object_ref (list);
-  data->title = g_strdup (title);
-  data->due_date = due_date ? g_date_time_ref (due_date) : NULL;
+  data->component = create_component (title, due_date);
 
   gtd_object_push_loading (GTD_OBJECT (self));
 
   task = g_task_new (self, cancellable, callback, user_data);
   g_task_set_source_tag (task, gtd_provider_eds_create_task);
   g_task_set_task_data (task, data, async_data_free);
-  g_task_run_in_thread (task, create_task_in_thread_cb);
+
+  gtd_eds_writer_create (gtd_task_list_eds_get_writer (GTD_TASK_LIST_EDS (list)),
+                         e_cal_component_get_icalcomponent (data->component),
+                         cancellable,
+                         on_task_created_cb,
+                         g_object_ref (task));
 
   GTD_EXIT;
 }
@@ -676,6 +951,7 @@ gtd_provider_eds_update_task (GtdProvider         *provider,
 {
   g_autoptr (GTask) gtask = NULL;
   ECalComponent *component;
+  GtdTaskList *list;
   AsyncData *data;
 
   GTD_ENTRY;
@@ -684,6 +960,7 @@ gtd_provider_eds_update_task (GtdProvider         *provider,
   g_return_if_fail (GTD_IS_TASK_LIST_EDS (gtd_task_get_list (task)));
 
   component = gtd_task_eds_get_component (GTD_TASK_EDS (task));
+  list = gtd_task_get_list (task);
 
   e_cal_component_commit_sequence (component);
 
@@ -693,12 +970,17 @@ gtd_provider_eds_update_task (GtdProvider         *provider,
 
   data = g_new0 (AsyncData, 1);
   data->task = g_object_ref (task);
-  data->component = e_cal_component_clone (component);
 
   gtask = g_task_new (provider, cancellable, callback, user_data);
   g_task_set_source_tag (gtask, gtd_provider_eds_update_task);
   g_task_set_task_data (gtask, data, async_data_free);
-  g_task_run_in_thread (gtask, update_task_in_thread_cb);
+
+  /* The writer copies the component, and collapses repeated updates */
+  gtd_eds_writer_modify (gtd_task_list_eds_get_writer (GTD_TASK_LIST_EDS (list)),
+                         e_cal_component_get_icalcomponent (component),
+                         cancellable,
+                         on_task_modified_cb,
+                         g_object_ref (gtask));
 
   GTD_EXIT;
 }
@@ -733,6 +1015,113 @@ gtd_provider_eds_update_task_finish (GtdProvider   *provider,
   GTD_RETURN (TRUE);
 }
 
+static void
+gtd_provider_eds_update_tasks (GtdProvider         *provider,
+                               GPtrArray           *tasks,
+                               GCancellable        *cancellable,
+                               GAsyncReadyCallback  callback,
+                               gpointer             user_data)
+{
+  g_autoptr (GTask) gtask = NULL;
+  AsyncData *data;
+  guint i;
+
+  GTD_ENTRY;
+
+  data = g_new0 (AsyncData, 1);
+  data->tasks = g_ptr_array_new_full (tasks->len, g_object_unref);
+  data->failed = g_new0 (gboolean, tasks->len);
+  data->n_pending = tasks->len;
+
+  gtd_object_push_loading (GTD_OBJECT (provider));
+
+  gtask = g_task_new (provider, cancellable, callback, user_data);
+  g_task_set_source_tag (gtask, gtd_provider_eds_update_tasks);
+  g_task_set_task_data (gtask, data, async_data_free);
+
+  if (tasks->len == 0)
+    {
+      g_task_return_boolean (gtask, TRUE);
+      GTD_RETURN ();
+    }
+
+  /*
+   * Each list has its own writer, which sends all the components queued
+   * in this loop to its client in a single request.
+   */
+  for (i = 0; i < tasks->len; i++)
+    {
+      ECalComponent *component;
+      TaskOperation *operation;
+      GtdTaskList *list;
+      GtdTask *task;
+
+      task = g_ptr_array_index (tasks, i);
+      list = gtd_task_get_list (task);
+
+      g_assert (GTD_IS_TASK_LIST_EDS (list));
+
+      component = gtd_task_eds_get_component (GTD_TASK_EDS (task));
+      e_cal_component_commit_sequence (component);
+
+      /* The task is not ready until we finish the operation */
+      gtd_object_push_loading (GTD_OBJECT (task));
+
+      g_ptr_array_add (data->tasks, g_object_ref (task));
+
+      operation = g_new0 (TaskOperation, 1);
+      operation->task = g_object_ref (gtask);
+      operation->index = i;
+
+      gtd_eds_writer_modify (gtd_task_list_eds_get_writer (GTD_TASK_LIST_EDS (list)),
+                             e_cal_component_get_icalcomponent (component),
+                             cancellable,
+                             on_tasks_modified_cb,
+                             operation);
+    }
+
+  GTD_EXIT;
+}
+
+static gboolean
+gtd_provider_eds_update_tasks_finish (GtdProvider   *provider,
+                                      GAsyncResult  *result,
+                                      GError       **error)
+{
+  GtdProviderEds *self;
+  AsyncData *data;
+  gboolean success;
+  guint i;
+
+  GTD_ENTRY;
+
+  self = GTD_PROVIDER_EDS (provider);
+  data = g_task_get_task_data (G_TASK (result));
+
+  gtd_object_pop_loading (GTD_OBJECT (self));
+
+  success = g_task_propagate_boolean (G_TASK (result), error);
+
+  /* Only the tasks that failed to be written go back to their saved state */
+  for (i = 0; i < data->tasks->len; i++)
+    {
+      GtdTask *task = g_ptr_array_index (data->tasks, i);
+
+      gtd_object_pop_loading (GTD_OBJECT (task));
+
+      if (data->failed[i])
+        {
+          gtd_task_eds_revert (GTD_TASK_EDS (task));
+          continue;
+        }
+
+      gtd_task_eds_apply (GTD_TASK_EDS (task));
+      gtd_task_list_update_task (gtd_task_get_list (task), task);
+    }
+
+  GTD_RETURN (success);
+}
+
 static void
 gtd_provider_eds_remove_task (GtdProvider         *provider,
                               GtdTask             *task,
@@ -740,8 +1129,10 @@ gtd_provider_eds_remove_task (GtdProvider         *provider,
                               GAsyncReadyCallback  callback,
                               gpointer             user_data)
 {
+  g_autoptr (ECalComponentId) id = NULL;
   g_autoptr (GTask) gtask = NULL;
   ECalComponent *component;
+  GtdTaskList *list;
   AsyncData *data;
 
   GTD_ENTRY;
@@ -750,17 +1141,24 @@ gtd_provider_eds_remove_task (GtdProvider         *provider,
   g_return_if_fail (GTD_IS_TASK_LIST_EDS (gtd_task_get_list (task)));
 
   component = gtd_task_eds_get_component (GTD_TASK_EDS (task));
+  list = gtd_task_get_list (task);
+  id = e_cal_component_get_id (component);
 
   gtd_object_push_loading (GTD_OBJECT (provider));
 
   data = g_new0 (AsyncData, 1);
   data->task = g_object_ref (task);
-  data->component = e_cal_component_clone (component);
 
   gtask = g_task_new (provider, cancellable, callback, user_data);
   g_task_set_source_tag (gtask, gtd_provider_eds_remove_task);
   g_task_set_task_data (gtask, data, async_data_free);
-  g_task_run_in_thread (gtask, remove_task_in_thread_cb);
+
+  gtd_eds_writer_remove (gtd_task_list_eds_get_writer (GTD_TASK_LIST_EDS (list)),
+                         e_cal_component_id_get_uid (id),
+                         e_cal_component_id_get_rid (id),
+                         cancellable,
+                         on_task_removed_cb,
+                         g_object_ref (gtask));
 
   GTD_EXIT;
 }
@@ -777,6 +1175,73 @@ gtd_provider_eds_remove_task_finish (GtdProvider   *provider,
   GTD_RETURN (g_task_propagate_boolean (G_TASK (result), error));
 }
 
+static void
+gtd_provider_eds_remove_tasks (GtdProvider         *provider,
+                               GPtrArray           *tasks,
+                               GCancellable        *cancellable,
+                               GAsyncReadyCallback  callback,
+                               gpointer             user_data)
+{
+  g_autoptr (GTask) gtask = NULL;
+  AsyncData *data;
+  guint i;
+
+  GTD_ENTRY;
+
+  data = g_new0 (AsyncData, 1);
+  data->n_pending = tasks->len;
+
+  gtd_object_push_loading (GTD_OBJECT (provider));
+
+  gtask = g_task_new (provider, cancellable, callback, user_data);
+  g_task_set_source_tag (gtask, gtd_provider_eds_remove_tasks);
+  g_task_set_task_data (gtask, data, async_data_free);
+
+  if (tasks->len == 0)
+    {
+      g_task_return_boolean (gtask, TRUE);
+      GTD_RETURN ();
+    }
+
+  /* Like updates, removals queued on the same writer go out in one request */
+  for (i = 0; i < tasks->len; i++)
+    {
+      g_autoptr (ECalComponentId) id = NULL;
+      ECalComponent *component;
+      GtdTaskList *list;
+      GtdTask *task;
+
+      task = g_ptr_array_index (tasks, i);
+      list = gtd_task_get_list (task);
+
+      g_assert (GTD_IS_TASK_LIST_EDS (list));
+
+      component = gtd_task_eds_get_component (GTD_TASK_EDS (task));
+      id = e_cal_component_get_id (component);
+
+      gtd_eds_writer_remove (gtd_task_list_eds_get_writer (GTD_TASK_LIST_EDS (list)),
+                             e_cal_component_id_get_uid (id),
+                             e_cal_component_id_get_rid (id),
+                             cancellable,
+                             on_tasks_removed_cb,
+                             g_object_ref (gtask));
+    }
+
+  GTD_EXIT;
+}
+
+static gboolean
+gtd_provider_eds_remove_tasks_finish (GtdProvider   *provider,
+                                      GAsyncResult  *result,
+                                      GError       **error)
+{
+  GTD_ENTRY;
+
+  gtd_object_pop_loading (GTD_OBJECT (provider));
+
+  GTD_RETURN (g_task_propagate_boolean (G_TASK (result), error));
+}
+
 static void
 gtd_provider_eds_create_task_list (GtdProvider         *provider,
                                    const gchar         *name,
@@ -960,8 +1425,12 @@ gtd_provider_iface_init (GtdProviderInterface *iface)
   iface->create_task_finish = gtd_provider_eds_create_task_finish;
   iface->update_task = gtd_provider_eds_update_task;
   iface->update_task_finish = gtd_provider_eds_update_task_finish;
+  iface->update_tasks = gtd_provider_eds_update_tasks;
+  iface->update_tasks_finish = gtd_provider_eds_update_tasks_finish;
   iface->remove_task = gtd_provider_eds_remove_task;
   iface->remove_task_finish = gtd_provider_eds_remove_task_finish;
+  iface->remove_tasks = gtd_provider_eds_remove_tasks;
+  iface->remove_tasks_finish = gtd_provider_eds_remove_tasks_finish;
   iface->create_task_list = gtd_provider_eds_create_task_list;
   iface->create_task_list_finish = gtd_provider_eds_create_task_list_finish;
   iface->update_task_list = gtd_provider_eds_update_task_list;
@@ -985,8 +1454,11 @@ gtd_provider_eds_finalize (GObject *object)
 
   g_cancellable_cancel (priv->cancellable);
 
+  g_queue_clear_full (&priv->pending_loads, (GDestroyNotify) source_load_free);
+
   g_clear_object (&priv->cancellable);
   g_clear_object (&priv->source_registry);
+  g_clear_pointer (&priv->running_loads, g_hash_table_destroy);
   g_clear_pointer (&priv->task_lists, g_hash_table_destroy);
 
   G_OBJECT_CLASS (gtd_provider_eds_parent_class)->finalize (object);
@@ -1010,14 +1482,18 @@ gtd_provider_eds_constructed (GObject *object)
       return;
     }
 
-  /* Load task list sources */
+  g_signal_connect (self, "list-added", G_CALLBACK (on_list_added_cb), NULL);
+
+  /* Load task list sources, queueing all of them so the priority ones go first */
   sources = e_source_registry_list_sources (priv->source_registry, E_SOURCE_EXTENSION_TASK_LIST);
 
   for (l = sources; l != NULL; l = l->next)
-    on_source_added_cb (self, l->data);
+    queue_source (self, l->data);
 
   g_list_free_full (sources, g_object_unref);
 
+  load_next_sources (self);
+
   /* listen to the signals, so new sources don't slip by */
   g_signal_connect_swapped (priv->source_registry,
                             "source-added",
@@ -1070,6 +1546,10 @@ gtd_provider_eds_get_property (GObject    *object,
       g_value_set_object (value, priv->source_registry);
       break;
 
+    case PROP_MAX_PARALLEL_LOADS:
+      g_value_set_uint (value, priv->max_parallel_loads);
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
     }
@@ -1091,6 +1571,12 @@ gtd_provider_eds_set_property (GObject      *object,
         g_object_notify (object, "registry");
       break;
 
+    case PROP_MAX_PARALLEL_LOADS:
+      priv->max_parallel_loads = g_value_get_uint (value);
+      load_next_sources (self);
+      g_object_notify (object, "max-parallel-loads");
+      break;
+
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
     }
@@ -1120,6 +1606,16 @@ gtd_provider_eds_class_init (GtdProviderEdsClass *klass)
                                                         "The EDS source registry object",
                                                         E_TYPE_SOURCE_REGISTRY,
                                                         G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY | G_PARAM_STATIC_STRINGS));
+
+  g_object_class_install_property (object_class,
+                                   PROP_MAX_PARALLEL_LOADS,
+                                   g_param_spec_uint ("max-parallel-loads",
+                                                      "Maximum parallel loads",
+                                                      "The maximum number of sources that are loaded at the same time",
+                                                      1,
+                                                      G_MAXUINT,
+                                                      DEFAULT_MAX_PARALLEL_LOADS,
+                                                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 static void
@@ -1129,6 +1625,10 @@ gtd_provider_eds_init (GtdProviderEds *self)
 
   priv->cancellable = g_cancellable_new ();
   priv->task_lists = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_object_unref);
+  priv->running_loads = g_hash_table_new_full (g_str_hash, g_str_equal, NULL, (GDestroyNotify) source_load_free);
+  priv->max_parallel_loads = DEFAULT_MAX_PARALLEL_LOADS;
+
+  g_queue_init (&priv->pending_loads);
 }
 
 GtdProviderEds*
@@ -1150,3 +1650,28 @@ gtd_provider_eds_get_registry (GtdProviderEds *provider)
 
   return priv->source_registry;
 }
+
+/**
+ * gtd_provider_eds_source_load_failed:
+ * @provider: a #GtdProviderEds
+ * @source: the #ESource that failed to load
+ *
+ * Called by the task list of @source when its tasks couldn't be fetched,
+ * so that the next sources are loaded.
+ */
+void
+gtd_provider_eds_source_load_failed (GtdProviderEds *provider,
+                                     ESource        *source)
+{
+  GtdProviderEdsPrivate *priv;
+  SourceLoad *load;
+
+  g_return_if_fail (GTD_IS_PROVIDER_EDS (provider));
+  g_return_if_fail (E_IS_SOURCE (source));
+
+  priv = gtd_provider_eds_get_instance_private (provider);
+  load = g_hash_table_lookup (priv->running_loads, e_source_get_uid (source));
+
+  if (load)
+    finish_source_load (provider, load, FALSE);
+}
@@ -58,4 +58,7 @@ GtdProviderEds*      gtd_provider_eds_new                        (ESourceRegistr
 
 ESourceRegistry*     gtd_provider_eds_get_registry               (GtdProviderEds     *local);
 
+void                 gtd_provider_eds_source_load_failed         (GtdProviderEds     *provider,
+                                                                  ESource            *source);
+
 G_END_DECLS
@@ -30,7 +30,18 @@ struct _GtdTaskEds
   ECalComponent      *component;
   ECalComponent      *new_component;
 
+  /*
+   * Decoded from new_component whenever it changes, since the getters are
+   * called from sorting and filtering functions all the time.
+   */
   gchar              *description;
+  gchar              *title;
+  GDateTime          *completion_date;
+  GDateTime          *creation_date;
+  GDateTime          *due_date;
+  gint64              position;
+  gboolean            complete;
+  gboolean            important;
 };
 
 G_DEFINE_TYPE (GtdTaskEds, gtd_task_eds, GTD_TYPE_TASK)
@@ -67,6 +78,83 @@ convert_icaltime (const ICalTime *date)
   return dt;
 }
 
+static void
+update_completion_date (GtdTaskEds *self)
+{
+  ICalTime *idt;
+
+  g_clear_pointer (&self->completion_date, g_date_time_unref);
+
+  idt = e_cal_component_get_completed (self->new_component);
+  self->completion_date = convert_icaltime (idt);
+
+  g_clear_object (&idt);
+}
+
+static void
+update_creation_date (GtdTaskEds *self)
+{
+  ICalTime *idt;
+
+  g_clear_pointer (&self->creation_date, g_date_time_unref);
+
+  idt = e_cal_component_get_created (self->new_component);
+  self->creation_date = convert_icaltime (idt);
+
+  g_clear_object (&idt);
+}
+
+static void
+update_due_date (GtdTaskEds *self)
+{
+  ECalComponentDateTime *comp_dt;
+
+  g_clear_pointer (&self->due_date, g_date_time_unref);
+
+  comp_dt = e_cal_component_get_due (self->new_component);
+
+  if (!comp_dt)
+    return;
+
+  self->due_date = convert_icaltime (e_cal_component_datetime_get_value (comp_dt));
+  e_cal_component_datetime_free (comp_dt);
+}
+
+static void
+update_complete (GtdTaskEds *self)
+{
+  self->complete = e_cal_component_get_status (self->new_component) == I_CAL_STATUS_COMPLETED;
+}
+
+static void
+update_important (GtdTaskEds *self)
+{
+  self->important = e_cal_component_get_priority (self->new_component) > 0;
+}
+
+static void
+update_position (GtdTaskEds *self)
+{
+  g_autofree gchar *value = NULL;
+  ICalComponent *ical_comp;
+
+  ical_comp = e_cal_component_get_icalcomponent (self->new_component);
+  value = e_cal_util_component_dup_x_property (ical_comp, ICAL_X_GNOME_TODO_POSITION);
+
+  self->position = value ? g_ascii_strtoll (value, NULL, 10) : -1;
+}
+
+static void
+update_title (GtdTaskEds *self)
+{
+  ICalComponent *ical_comp;
+
+  ical_comp = e_cal_component_get_icalcomponent (self->new_component);
+
+  g_clear_pointer (&self->title, g_free);
+  self->title = g_strdup (i_cal_component_get_summary (ical_comp));
+}
+
 static void
 set_description (GtdTaskEds  *self,
                  const gchar *description)
@@ -128,6 +216,43 @@ setup_description (GtdTaskEds *self)
 }
 
 
+static void
+replace_component (GtdTaskEds    *self,
+                   ECalComponent *component,
+                   gboolean       decode)
+{
+  GObject *object;
+
+  if (!g_set_object (&self->component, component))
+    return;
+
+  object = G_OBJECT (self);
+
+  g_clear_object (&self->new_component);
+  self->new_component = e_cal_component_clone (component);
+
+  if (decode)
+    {
+      setup_description (self);
+      update_completion_date (self);
+      update_creation_date (self);
+      update_due_date (self);
+      update_complete (self);
+      update_important (self);
+      update_position (self);
+      update_title (self);
+    }
+
+  g_object_notify (object, "complete");
+  g_object_notify (object, "creation-date");
+  g_object_notify (object, "description");
+  g_object_notify (object, "due-date");
+  g_object_notify (object, "important");
+  g_object_notify (object, "position");
+  g_object_notify (object, "title");
+  g_object_notify_by_pspec (object, properties[PROP_COMPONENT]);
+}
+
 /*
  * GtdObject overrides
  */
@@ -182,21 +307,9 @@ gtd_task_eds_set_uid (GtdObject   *object,
 static GDateTime*
 gtd_task_eds_get_completion_date (GtdTask *task)
 {
-  ICalTime *idt;
-  GtdTaskEds *self;
-  GDateTime *dt;
-
-  self = GTD_TASK_EDS (task);
-  dt = NULL;
-
-  idt = e_cal_component_get_completed (self->new_component);
-
-  if (idt)
-    dt = convert_icaltime (idt);
-
-  g_clear_object (&idt);
+  GtdTaskEds *self = GTD_TASK_EDS (task);
 
-  return dt;
+  return self->completion_date ? g_date_time_ref (self->completion_date) : NULL;
 }
 
 static void
@@ -227,6 +340,7 @@ gtd_task_eds_set_completion_date (GtdTask   *task,
   i_cal_time_convert_timezone (idt, NULL, i_cal_timezone_get_utc_timezone ());
 
   e_cal_component_set_completed (self->new_component, idt);
+  update_completion_date (self);
 
   g_object_unref (idt);
 }
@@ -234,18 +348,9 @@ gtd_task_eds_set_completion_date (GtdTask   *task,
 static gboolean
 gtd_task_eds_get_complete (GtdTask *task)
 {
-  ICalPropertyStatus status;
-  GtdTaskEds *self;
-  gboolean completed;
-
   g_return_val_if_fail (GTD_IS_TASK_EDS (task), FALSE);
 
-  self = GTD_TASK_EDS (task);
-
-  status = e_cal_component_get_status (self->new_component);
-  completed = status == I_CAL_STATUS_COMPLETED;
-
-  return completed;
+  return GTD_TASK_EDS (task)->complete;
 }
 
 static void
@@ -273,27 +378,17 @@ gtd_task_eds_set_complete (GtdTask  *task,
 
   e_cal_component_set_percent_complete (self->new_component, percent);
   e_cal_component_set_status (self->new_component, status);
+  update_complete (self);
+
   gtd_task_eds_set_completion_date (task, now);
 }
 
 static GDateTime*
 gtd_task_eds_get_creation_date (GtdTask *task)
 {
-  ICalTime *idt;
-  GtdTaskEds *self;
-  GDateTime *dt;
-
-  self = GTD_TASK_EDS (task);
-  dt = NULL;
-
-  idt = e_cal_component_get_created (self->new_component);
-
-  if (idt)
-    dt = convert_icaltime (idt);
-
-  g_clear_object (&idt);
+  GtdTaskEds *self = GTD_TASK_EDS (task);
 
-  return dt;
+  return self->creation_date ? g_date_time_ref (self->creation_date) : NULL;
 }
 
 static void
@@ -321,22 +416,13 @@ gtd_task_eds_set_description (GtdTask     *task,
 static GDateTime*
 gtd_task_eds_get_due_date (GtdTask *task)
 {
-  ECalComponentDateTime *comp_dt;
   GtdTaskEds *self;
-  GDateTime *date;
 
   g_return_val_if_fail (GTD_IS_TASK_EDS (task), NULL);
 
   self = GTD_TASK_EDS (task);
 
-  comp_dt = e_cal_component_get_due (self->new_component);
-  if (!comp_dt)
-    return NULL;
-
-  date = convert_icaltime (e_cal_component_datetime_get_value (comp_dt));
-  e_cal_component_datetime_free (comp_dt);
-
-  return date;
+  return self->due_date ? g_date_time_ref (self->due_date) : NULL;
 }
 
 static void
@@ -395,6 +481,8 @@ gtd_task_eds_set_due_date (GtdTask   *task,
         {
           e_cal_component_set_due (self->new_component, NULL);
         }
+
+      update_due_date (self);
     }
 
   g_clear_pointer (&current_dt, g_date_time_unref);
@@ -403,9 +491,7 @@ gtd_task_eds_set_due_date (GtdTask   *task,
 static gboolean
 gtd_task_eds_get_important (GtdTask *task)
 {
-  GtdTaskEds *self = GTD_TASK_EDS (task);
-
-  return e_cal_component_get_priority (self->new_component) > 0;
+  return GTD_TASK_EDS (task)->important;
 }
 
 static void
@@ -415,26 +501,13 @@ gtd_task_eds_set_important (GtdTask  *task,
   GtdTaskEds *self = GTD_TASK_EDS (task);
 
   e_cal_component_set_priority (self->new_component, important ? 3 : -1);
+  update_important (self);
 }
 
 static gint64
 gtd_task_eds_get_position (GtdTask *task)
 {
-  g_autofree gchar *value = NULL;
-  ICalComponent *ical_comp;
-  gint64 position = -1;
-  GtdTaskEds *self;
-
-  self = GTD_TASK_EDS (task);
-  ical_comp = e_cal_component_get_icalcomponent (self->new_component);
-
-  value = e_cal_util_component_dup_x_property (ical_comp, ICAL_X_GNOME_TODO_POSITION);
-  if (value)
-    {
-        position = g_ascii_strtoll (value, NULL, 10);
-    }
-
-  return position;
+  return GTD_TASK_EDS (task)->position;
 }
 
 void
@@ -451,6 +524,8 @@ gtd_task_eds_set_position (GtdTask *task,
   ical_comp = e_cal_component_get_icalcomponent (self->new_component);
 
   e_cal_util_component_set_x_property (ical_comp, ICAL_X_GNOME_TODO_POSITION, value);
+
+  self->position = position;
 }
 
 static const gchar*
@@ -462,7 +537,7 @@ gtd_task_eds_get_title (GtdTask *task)
 
   self = GTD_TASK_EDS (task);
 
-  return i_cal_component_get_summary (e_cal_component_get_icalcomponent (self->new_component));
+  return self->title;
 }
 
 static void
@@ -480,6 +555,7 @@ gtd_task_eds_set_title (GtdTask     *task,
   new_summary = e_cal_component_text_new (title, NULL);
 
   e_cal_component_set_summary (self->new_component, new_summary);
+  update_title (self);
 
   e_cal_component_text_free (new_summary);
 }
@@ -550,6 +626,11 @@ gtd_task_eds_finalize (GObject *object)
 
   g_clear_object (&self->component);
   g_clear_object (&self->new_component);
+  g_clear_pointer (&self->description, g_free);
+  g_clear_pointer (&self->title, g_free);
+  g_clear_pointer (&self->completion_date, g_date_time_unref);
+  g_clear_pointer (&self->creation_date, g_date_time_unref);
+  g_clear_pointer (&self->due_date, g_date_time_unref);
 
   G_OBJECT_CLASS (gtd_task_eds_parent_class)->finalize (object);
 }
@@ -659,29 +740,10 @@ void
 gtd_task_eds_set_component (GtdTaskEds    *self,
                             ECalComponent *component)
 {
-  GObject *object;
-
   g_return_if_fail (GTD_IS_TASK_EDS (self));
   g_return_if_fail (E_IS_CAL_COMPONENT (component));
 
-  if (!g_set_object (&self->component, component))
-    return;
-
-  object = G_OBJECT (self);
-
-  g_clear_object (&self->new_component);
-  self->new_component = e_cal_component_clone (component);
-
-  setup_description (self);
-
-  g_object_notify (object, "complete");
-  g_object_notify (object, "creation-date");
-  g_object_notify (object, "description");
-  g_object_notify (object, "due-date");
-  g_object_notify (object, "important");
-  g_object_notify (object, "position");
-  g_object_notify (object, "title");
-  g_object_notify_by_pspec (object, properties[PROP_COMPONENT]);
+  replace_component (self, component, TRUE);
 }
 
 void
@@ -691,8 +753,11 @@ gtd_task_eds_apply (GtdTaskEds *self)
 
   e_cal_component_commit_sequence (self->new_component);
 
-  /* Make new_component the actual component */
-  gtd_task_eds_set_component (self, self->new_component);
+  /*
+   * Make new_component the actual component. The decoded fields already
+   * reflect it, so there's no need to decode it again.
+   */
+  replace_component (self, self->new_component, FALSE);
 }
 
 void
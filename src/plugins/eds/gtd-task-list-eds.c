@@ -21,6 +21,7 @@
 #include "e-source-gnome-todo.h"
 #include "gtd-debug.h"
 #include "gtd-eds-autoptr.h"
+#include "gtd-eds-writer.h"
 #include "gtd-provider-eds.h"
 #include "gtd-task-eds.h"
 #include "gtd-task-list-eds.h"
@@ -35,6 +36,8 @@ struct _GtdTaskListEds
   ECalClientView     *client_view;
   ESource            *source;
 
+  GtdEdsWriter       *writer;
+
   GPtrArray           *pending_subtasks;
 
   GCancellable       *cancellable;
@@ -335,7 +338,7 @@ new_task_list_in_idle_cb (gpointer data)
                            "client", list_data->client,
                            NULL);
 
-  g_task_return_pointer (task, g_steal_pointer (&list_eds), NULL);
+  g_task_return_pointer (task, g_steal_pointer (&list_eds), g_object_unref);
 
   return G_SOURCE_REMOVE;
 }
@@ -351,12 +354,16 @@ on_client_objects_modified_for_migration_cb (GObject      *object,
 
   GTD_ENTRY;
 
+  e_cal_client_modify_objects_finish (E_CAL_CLIENT (object), result, &error);
+
+  /* The list is gone */
+  if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+    GTD_RETURN ();
+
   self = GTD_TASK_LIST_EDS (user_data);
   provider = gtd_task_list_get_provider (GTD_TASK_LIST (self));
 
-  e_cal_client_modify_objects_finish (self->client, result, &error);
-
-  if (error && !g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+  if (error)
     g_warning ("Error migrating tasks to new API version: %s", error->message);
 
   gtd_object_pop_loading (GTD_OBJECT (provider));
@@ -371,11 +378,19 @@ on_view_objects_added_cb (ECalClientView *view,
                           GtdTaskList    *self)
 {
   g_autoptr (ECalClient) client = NULL;
+  g_autoptr (GPtrArray) new_tasks = NULL;
   GSList *l;
 
   GTD_ENTRY;
 
   client = e_cal_client_view_ref_client (view);
+  new_tasks = g_ptr_array_new_with_free_func (g_object_unref);
+
+  /*
+   * Apply the whole notification at once: updated tasks are only resorted
+   * when thawing, and new tasks are added in bulk afterwards.
+   */
+  gtd_task_list_freeze (self);
 
   for (l = (GSList*) objects; l; l = l->next)
     {
@@ -406,7 +421,7 @@ on_view_objects_added_cb (ECalClientView *view,
       task = gtd_task_eds_new (component);
       gtd_task_set_list (task, self);
 
-      gtd_task_list_add_task (self, task);
+      g_ptr_array_add (new_tasks, task);
 
       GTD_TRACE_MSG ("Added task '%s' (%s) to tasklist '%s'",
                      gtd_task_get_title (task),
@@ -414,6 +429,10 @@ on_view_objects_added_cb (ECalClientView *view,
                      gtd_task_list_get_name (self));
     }
 
+  gtd_task_list_thaw (self);
+
+  gtd_task_list_add_tasks (self, new_tasks);
+
   GTD_EXIT;
 }
 
@@ -429,6 +448,8 @@ on_view_objects_modified_cb (ECalClientView *view,
 
   client = e_cal_client_view_ref_client (view);
 
+  gtd_task_list_freeze (self);
+
   for (l = (GSList*) objects; l; l = l->next)
     {
       g_autoptr (ECalComponent) component = NULL;
@@ -450,6 +471,8 @@ on_view_objects_modified_cb (ECalClientView *view,
                      gtd_task_list_get_name (self));
     }
 
+  gtd_task_list_thaw (self);
+
   GTD_EXIT;
 }
 
@@ -458,10 +481,13 @@ on_view_objects_removed_cb (ECalClientView *view,
                             const GSList   *uids,
                             GtdTaskList    *self)
 {
+  g_autoptr (GPtrArray) removed_tasks = NULL;
   GSList *l;
 
   GTD_ENTRY;
 
+  removed_tasks = g_ptr_array_new ();
+
   for (l = (GSList*) uids; l; l = l->next)
     {
       ECalComponentId *id;
@@ -473,13 +499,15 @@ on_view_objects_removed_cb (ECalClientView *view,
       if (!task)
         continue;
 
-      gtd_task_list_remove_task (self, task);
+      g_ptr_array_add (removed_tasks, task);
 
       GTD_TRACE_MSG ("Removed task '%s' from tasklist '%s'",
                      gtd_task_get_title (task),
                      gtd_task_list_get_name (self));
     }
 
+  gtd_task_list_remove_tasks (self, removed_tasks);
+
   GTD_EXIT;
 }
 
@@ -488,7 +516,6 @@ on_view_completed_cb (ECalClientView *view,
                       const GError   *error,
                       GtdTaskList    *self)
 {
-  gtd_object_pop_loading (GTD_OBJECT (gtd_manager_get_default ()));
   gtd_object_pop_loading (GTD_OBJECT (self));
 
   if (error)
@@ -500,6 +527,9 @@ on_view_completed_cb (ECalClientView *view,
                                       error->message,
                                       NULL,
                                       NULL);
+
+      gtd_provider_eds_source_load_failed (GTD_PROVIDER_EDS (gtd_task_list_get_provider (self)),
+                                           GTD_TASK_LIST_EDS (self)->source);
       return;
     }
 
@@ -511,12 +541,18 @@ on_client_view_acquired_cb (GObject      *client,
                             GAsyncResult *result,
                             gpointer      user_data)
 {
+  g_autoptr (ECalClientView) client_view = NULL;
   g_autoptr (GError) error = NULL;
   GtdTaskListEds *self;
 
-  self = GTD_TASK_LIST_EDS (user_data);
+  e_cal_client_get_view_finish (E_CAL_CLIENT (client), result, &client_view, &error);
+
+  /* The list is gone */
+  if (g_error_matches (error, G_IO_ERROR, G_IO_ERROR_CANCELLED))
+    return;
 
-  e_cal_client_get_view_finish (E_CAL_CLIENT (client), result, &self->client_view, &error);
+  self = GTD_TASK_LIST_EDS (user_data);
+  self->client_view = g_steal_pointer (&client_view);
 
   if (error)
     {
@@ -527,6 +563,9 @@ on_client_view_acquired_cb (GObject      *client,
                                       error->message,
                                       NULL,
                                       NULL);
+
+      gtd_provider_eds_source_load_failed (GTD_PROVIDER_EDS (gtd_task_list_get_provider (GTD_TASK_LIST (self))),
+                                           self->source);
       return;
     }
 
@@ -551,6 +590,12 @@ on_client_view_acquired_cb (GObject      *client,
                                       error->message,
                                       NULL,
                                       NULL);
+
+      /* The view won't complete, so don't hold the next sources back */
+      gtd_object_pop_loading (GTD_OBJECT (self));
+
+      gtd_provider_eds_source_load_failed (GTD_PROVIDER_EDS (gtd_task_list_get_provider (GTD_TASK_LIST (self))),
+                                           self->source);
     }
 }
 
@@ -604,9 +649,6 @@ save_task_list (GtdTaskListEds *list)
 {
   if (e_source_get_writable (list->source))
     {
-      if (!list->cancellable)
-        list->cancellable = g_cancellable_new ();
-
       gtd_object_push_loading (GTD_OBJECT (list));
 
       e_source_write (list->source,
@@ -731,7 +773,11 @@ gtd_task_list_eds_finalize (GObject *object)
 
   g_cancellable_cancel (self->cancellable);
 
+  if (self->client_view)
+    g_signal_handlers_disconnect_by_data (self->client_view, self);
+
   g_clear_object (&self->cancellable);
+  g_clear_object (&self->writer);
   g_clear_object (&self->client);
   g_clear_object (&self->client_view);
   g_clear_object (&self->source);
@@ -773,9 +819,16 @@ gtd_task_list_eds_set_property (GObject      *object,
   switch (prop_id)
     {
     case PROP_CLIENT:
-      if (!g_set_object (&self->client, g_value_get_object (value)) || !self->client)
+      if (!g_set_object (&self->client, g_value_get_object (value)))
+        return;
+
+      g_clear_object (&self->writer);
+
+      if (!self->client)
         return;
 
+      self->writer = gtd_eds_writer_new (self->client);
+
       e_cal_client_get_view (self->client,
                              "#t",
                              self->cancellable,
@@ -844,6 +897,7 @@ static void
 gtd_task_list_eds_init (GtdTaskListEds *self)
 {
   self->pending_subtasks = g_ptr_array_new_with_free_func ((GDestroyNotify) pending_subtask_data_free);
+  self->cancellable = g_cancellable_new ();
 }
 
 void
@@ -977,3 +1031,20 @@ gtd_task_list_eds_get_client (GtdTaskListEds *self)
 
   return self->client;
 }
+
+/**
+ * gtd_task_list_eds_get_writer:
+ * @self: a #GtdTaskListEds
+ *
+ * Retrieves the #GtdEdsWriter that queues the writes to the client
+ * of @self.
+ *
+ * Returns: (transfer none)(nullable): a #GtdEdsWriter
+ */
+GtdEdsWriter*
+gtd_task_list_eds_get_writer (GtdTaskListEds *self)
+{
+  g_return_val_if_fail (GTD_IS_TASK_LIST_EDS (self), NULL);
+
+  return self->writer;
+}
@@ -22,6 +22,7 @@
 #include "gnome-todo.h"
 
 #include "gtd-eds.h"
+#include "gtd-eds-writer.h"
 
 #include <glib-object.h>
 
@@ -48,6 +49,8 @@ void                 gtd_task_list_eds_set_source                (GtdTaskListEds
 
 ECalClient*          gtd_task_list_eds_get_client                (GtdTaskListEds     *self);
 
+GtdEdsWriter*        gtd_task_list_eds_get_writer                (GtdTaskListEds     *self);
+
 G_END_DECLS
 
 #endif /* GTD_TASK_LIST_EDS_H */
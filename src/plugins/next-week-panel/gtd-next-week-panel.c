@@ -41,9 +41,9 @@ struct _GtdNextWeekPanel
   guint               number_of_tasks;
   GtdTaskListView    *view;
 
-  GtkFilterListModel *filter_model;
-  GtkFilterListModel *incomplete_model;
-  GtkSortListModel   *sort_model;
+  GListModel         *model;
+  GListModel         *incomplete_overdue_model;
+  GListModel         *incomplete_next_week_model;
 
   GtkCssProvider     *css_provider;
 };
@@ -95,83 +95,27 @@ load_css_provider (GtdNextWeekPanel *self)
     gtk_css_provider_load_from_resource (self->css_provider, "/org/gnome/todo/theme/scheduled-panel/Adwaita.css");
 }
 
-static gboolean
-get_date_offset (GDateTime *dt,
-                 gint      *days_diff,
-                 gint      *years_diff)
-{
-  g_autoptr (GDateTime) now = NULL;
-  GDate now_date, dt_date;
-
-  g_date_clear (&dt_date, 1);
-  g_date_set_dmy (&dt_date,
-                  g_date_time_get_day_of_month (dt),
-                  g_date_time_get_month (dt),
-                  g_date_time_get_year (dt));
-
-  now = g_date_time_new_now_local ();
-
-  g_date_clear (&now_date, 1);
-  g_date_set_dmy (&now_date,
-                  g_date_time_get_day_of_month (now),
-                  g_date_time_get_month (now),
-                  g_date_time_get_year (now));
-
-
-  if (days_diff)
-    *days_diff = g_date_days_between (&now_date, &dt_date);
-
-  if (years_diff)
-    *years_diff = g_date_time_get_year (dt) - g_date_time_get_year (now);
-
-  return TRUE;
-}
-
-static gchar*
+static const gchar*
 get_string_for_date (GDateTime *dt,
                      gint      *span)
 {
-  gchar *str;
+  GtdClock *clock;
   gint days_diff;
-  gint years_diff;
 
   /* This case should never happen */
   if (!dt)
-    return g_strdup (_("No date set"));
-
-  days_diff = years_diff = 0;
+    return _("No date set");
 
-  get_date_offset (dt, &days_diff, &years_diff);
-
-  if (days_diff < 0)
-    {
-      str = g_strdup (_("Overdue"));
-    }
-  else if (days_diff == 0)
-    {
-      str = g_strdup (_("Today"));
-    }
-  else if (days_diff == 1)
-    {
-      str = g_strdup (_("Tomorrow"));
-    }
-  else if (days_diff > 1 && days_diff < 7)
-    {
-      str = g_date_time_format (dt, "%A"); // Weekday name
-    }
-  else if (days_diff >= 7 && years_diff == 0)
-    {
-      str = g_date_time_format (dt, "%OB"); // Full month name
-    }
-  else
-    {
-      str = g_strdup_printf ("%d", g_date_time_get_year (dt));
-    }
+  clock = gtd_manager_get_clock (gtd_manager_get_default ());
+  days_diff = gtd_clock_get_days_from_today (clock, dt);
 
   if (span)
     *span = days_diff;
 
-  return str;
+  if (days_diff < 0)
+    return _("Overdue");
+
+  return gtd_clock_get_relative_date_label (clock, dt);
 }
 
 static GtkWidget*
@@ -203,23 +147,13 @@ create_label (const gchar *text,
   return box;
 }
 
-static gint
-compare_by_date (GDateTime *d1,
-                 GDateTime *d2)
-{
-  if (g_date_time_get_year (d1) != g_date_time_get_year (d2))
-    return g_date_time_get_year (d1) - g_date_time_get_year (d2);
-
-  return g_date_time_get_day_of_year (d1) - g_date_time_get_day_of_year (d2);
-}
-
 static GtkWidget*
 header_func (GtdTask          *task,
              GtdTask          *previous_task,
              GtdNextWeekPanel *self)
 {
   g_autoptr (GDateTime) dt = NULL;
-  g_autofree gchar *text = NULL;
+  const gchar *text = NULL;
   gint span;
 
   dt = gtd_task_get_due_date (task);
@@ -228,11 +162,14 @@ header_func (GtdTask          *task,
     {
       g_autoptr (GDateTime) before_dt = NULL;
       gint before_diff, current_diff;
+      GtdClock *clock;
+
+      clock = gtd_manager_get_clock (gtd_manager_get_default ());
 
       before_dt = gtd_task_get_due_date (previous_task);
 
-      get_date_offset (before_dt, &before_diff, NULL);
-      get_date_offset (dt, &current_diff, NULL);
+      before_diff = gtd_clock_get_days_from_today (clock, before_dt);
+      current_diff = gtd_clock_get_days_from_today (clock, dt);
 
       if ((before_diff < 0 && current_diff >= 0) ||
           (before_diff >= 0 && current_diff >= 0 && before_diff != current_diff))
@@ -248,102 +185,6 @@ header_func (GtdTask          *task,
   return text ? create_label (text, span, !previous_task) : NULL;
 }
 
-static gint
-sort_func (gconstpointer a,
-           gconstpointer b,
-           gpointer      user_data)
-{
-  GDateTime *dt1;
-  GDateTime *dt2;
-  GtdTask *task1;
-  GtdTask *task2;
-  gint retval;
-  gchar *t1;
-  gchar *t2;
-
-  task1 = (GtdTask*) a;
-  task2 = (GtdTask*) b;
-
-  /* First, compare by ::due-date. */
-  dt1 = gtd_task_get_due_date (task1);
-  dt2 = gtd_task_get_due_date (task2);
-
-  if (!dt1 && !dt2)
-    retval = 0;
-  else if (!dt1)
-    retval = 1;
-  else if (!dt2)
-    retval = -1;
-  else
-    retval = compare_by_date (dt1, dt2);
-
-  g_clear_pointer (&dt1, g_date_time_unref);
-  g_clear_pointer (&dt2, g_date_time_unref);
-
-  if (retval != 0)
-    return retval;
-
-  /* Third, compare by ::creation-date. */
-  dt1 = gtd_task_get_creation_date (task1);
-  dt2 = gtd_task_get_creation_date (task2);
-
-  if (!dt1 && !dt2)
-    retval =  0;
-  else if (!dt1)
-    retval =  1;
-  else if (!dt2)
-    retval = -1;
-  else
-    retval = g_date_time_compare (dt1, dt2);
-
-  g_clear_pointer (&dt1, g_date_time_unref);
-  g_clear_pointer (&dt2, g_date_time_unref);
-
-  if (retval != 0)
-    return retval;
-
-  /* Finally, compare by ::title. */
-  t1 = t2 = NULL;
-
-  t1 = g_utf8_casefold (gtd_task_get_title (task1), -1);
-  t2 = g_utf8_casefold (gtd_task_get_title (task2), -1);
-
-  retval = g_strcmp0 (t1, t2);
-
-  g_free (t1);
-  g_free (t2);
-
-  return retval;
-}
-
-static gboolean
-filter_func (gpointer item,
-             gpointer user_data)
-{
-  g_autoptr (GDateTime) task_dt = NULL;
-  GtdTask *task;
-  gboolean complete;
-  gint days_offset;
-
-  task = (GtdTask*) item;
-  complete = gtd_task_get_complete (task);
-  task_dt = gtd_task_get_due_date (task);
-
-  return task_dt != NULL &&
-         get_date_offset (task_dt, &days_offset, NULL) &&
-         days_offset < 7 &&
-         ((days_offset < 0 && !complete) || days_offset >= 0);
-}
-
-static gboolean
-filter_complete_func (gpointer item,
-                      gpointer user_data)
-{
-  GtdTask *task = (GtdTask*) item;
-
-  return !gtd_task_get_complete (task);
-}
-
 static void
 on_model_items_changed_cb (GListModel       *model,
                            guint             position,
@@ -351,10 +192,15 @@ on_model_items_changed_cb (GListModel       *model,
                            guint             n_added,
                            GtdNextWeekPanel *self)
 {
-  if (self->number_of_tasks == g_list_model_get_n_items (model))
+  guint number_of_tasks;
+
+  number_of_tasks = g_list_model_get_n_items (self->incomplete_overdue_model) +
+                    g_list_model_get_n_items (self->incomplete_next_week_model);
+
+  if (self->number_of_tasks == number_of_tasks)
     return;
 
-  self->number_of_tasks = g_list_model_get_n_items (model);
+  self->number_of_tasks = number_of_tasks;
   g_object_notify (G_OBJECT (self), "subtitle");
 }
 
@@ -363,13 +209,9 @@ on_clock_day_changed_cb (GtdClock         *clock,
                          GtdNextWeekPanel *self)
 {
   g_autoptr (GDateTime) now = NULL;
-  GtkFilter *filter;
 
   now = g_date_time_new_now_local ();
   gtd_task_list_view_set_default_date (self->view, now);
-
-  filter = gtk_filter_list_model_get_filter (self->filter_model);
-  gtk_filter_changed (filter, GTK_FILTER_CHANGE_DIFFERENT);
 }
 
 /*
@@ -444,9 +286,7 @@ gtd_next_week_panel_finalize (GObject *object)
 
   g_clear_object (&self->css_provider);
   g_clear_object (&self->icon);
-  g_clear_object (&self->filter_model);
-  g_clear_object (&self->incomplete_model);
-  g_clear_object (&self->sort_model);
+  g_clear_object (&self->model);
 
   G_OBJECT_CLASS (gtd_next_week_panel_parent_class)->finalize (object);
 }
@@ -521,27 +361,25 @@ gtd_next_week_panel_init (GtdNextWeekPanel *self)
 {
   g_autoptr (GDateTime) now = g_date_time_new_now_local ();
   GtdManager *manager = gtd_manager_get_default ();
-  GtkCustomFilter *incomplete_filter;
-  GtkCustomFilter *filter;
-  GtkCustomSorter *sorter;
+  g_autoptr (GListStore) ranges = NULL;
+  GtdDueDateIndex *index;
 
   self->icon = g_themed_icon_new ("view-tasks-week-symbolic");
 
-  filter = gtk_custom_filter_new (filter_func, self, NULL);
-  self->filter_model = gtk_filter_list_model_new (gtd_manager_get_tasks_model (manager),
-                                                  GTK_FILTER (filter));
+  /* Incomplete overdue tasks, followed by all tasks due in the next 7 days */
+  index = gtd_manager_get_due_date_index (manager);
+  self->incomplete_overdue_model = gtd_due_date_index_get_model (index, GTD_DUE_DATE_RANGE_OVERDUE, FALSE);
+  self->incomplete_next_week_model = gtd_due_date_index_get_model (index, GTD_DUE_DATE_RANGE_NEXT_WEEK, FALSE);
 
-  sorter = gtk_custom_sorter_new (sort_func, self, NULL);
-  self->sort_model = gtk_sort_list_model_new (G_LIST_MODEL (self->filter_model),
-                                              GTK_SORTER (sorter));
+  ranges = g_list_store_new (G_TYPE_LIST_MODEL);
+  g_list_store_append (ranges, self->incomplete_overdue_model);
+  g_list_store_append (ranges, gtd_due_date_index_get_model (index, GTD_DUE_DATE_RANGE_NEXT_WEEK, TRUE));
 
-  incomplete_filter = gtk_custom_filter_new (filter_complete_func, self, NULL);
-  self->incomplete_model = gtk_filter_list_model_new (G_LIST_MODEL (self->sort_model),
-                                                      GTK_FILTER (incomplete_filter));
+  self->model = G_LIST_MODEL (gtk_flatten_list_model_new (G_LIST_MODEL (ranges)));
 
   /* The main view */
   self->view = GTD_TASK_LIST_VIEW (gtd_task_list_view_new ());
-  gtd_task_list_view_set_model (GTD_TASK_LIST_VIEW (self->view), G_LIST_MODEL (self->sort_model));
+  gtd_task_list_view_set_model (GTD_TASK_LIST_VIEW (self->view), self->model);
   gtd_task_list_view_set_handle_subtasks (GTD_TASK_LIST_VIEW (self->view), FALSE);
   gtd_task_list_view_set_show_list_name (GTD_TASK_LIST_VIEW (self->view), TRUE);
   gtd_task_list_view_set_show_due_date (GTD_TASK_LIST_VIEW (self->view), FALSE);
@@ -555,7 +393,13 @@ gtd_next_week_panel_init (GtdNextWeekPanel *self)
                                       (GtdTaskListViewHeaderFunc) header_func,
                                       self);
 
-  g_signal_connect_object (self->incomplete_model,
+  g_signal_connect_object (self->incomplete_overdue_model,
+                           "items-changed",
+                           G_CALLBACK (on_model_items_changed_cb),
+                           self,
+                           0);
+
+  g_signal_connect_object (self->incomplete_next_week_model,
                            "items-changed",
                            G_CALLBACK (on_model_items_changed_cb),
                            self,
@@ -34,8 +34,7 @@ struct _GtdPanelScheduled
   guint               number_of_tasks;
   GtdTaskListView    *view;
 
-  GtkFilterListModel *filter_model;
-  GtkSortListModel   *sort_model;
+  GListModel         *model;
 };
 
 static void          gtd_panel_iface_init                        (GtdPanelInterface  *iface);
@@ -60,90 +59,22 @@ enum
   N_PROPS
 };
 
-static void
-get_date_offset (GDateTime *dt,
-                 gint      *days_diff,
-                 gint      *years_diff)
-{
-  g_autoptr (GDateTime) now = NULL;
-  GDate now_date, dt_date;
-
-  g_date_clear (&dt_date, 1);
-  g_date_set_dmy (&dt_date,
-                  g_date_time_get_day_of_month (dt),
-                  g_date_time_get_month (dt),
-                  g_date_time_get_year (dt));
-
-  now = g_date_time_new_now_local ();
-
-  g_date_clear (&now_date, 1);
-  g_date_set_dmy (&now_date,
-                  g_date_time_get_day_of_month (now),
-                  g_date_time_get_month (now),
-                  g_date_time_get_year (now));
-
-
-  if (days_diff)
-    *days_diff = g_date_days_between (&now_date, &dt_date);
-
-  if (years_diff)
-    *years_diff = g_date_time_get_year (dt) - g_date_time_get_year (now);
-}
-
-static gchar*
+static const gchar*
 get_string_for_date (GDateTime *dt,
                      gint      *span)
 {
-  gchar *str;
-  gint days_diff;
-  gint years_diff;
+  GtdClock *clock;
 
   /* This case should never happen */
   if (!dt)
-    return g_strdup (_("No date set"));
-
-  days_diff = years_diff = 0;
+    return _("No date set");
 
-  get_date_offset (dt, &days_diff, &years_diff);
-
-  if (days_diff < -1)
-    {
-      /* Translators: This message will never be used with '1 day ago'
-       * but the singular form is required because some languages do not
-       * have plurals, some languages reuse the singular form for numbers
-       * like 21, 31, 41, etc.
-       */
-      str = g_strdup_printf (g_dngettext (NULL, "%d day ago", "%d days ago", -days_diff), -days_diff);
-    }
-  else if (days_diff == -1)
-    {
-      str = g_strdup (_("Yesterday"));
-    }
-  else if (days_diff == 0)
-    {
-      str = g_strdup (_("Today"));
-    }
-  else if (days_diff == 1)
-    {
-      str = g_strdup (_("Tomorrow"));
-    }
-  else if (days_diff > 1 && days_diff < 7)
-    {
-      str = g_date_time_format (dt, "%A"); // Weekday name
-    }
-  else if (days_diff >= 7 && years_diff == 0)
-    {
-      str = g_date_time_format (dt, "%OB"); // Full month name
-    }
-  else
-    {
-      str = g_strdup_printf ("%d", g_date_time_get_year (dt));
-    }
+  clock = gtd_manager_get_clock (gtd_manager_get_default ());
 
   if (span)
-    *span = days_diff;
+    *span = gtd_clock_get_days_from_today (clock, dt);
 
-  return str;
+  return gtd_clock_get_relative_date_label (clock, dt);
 }
 
 static GtkWidget*
@@ -190,7 +121,7 @@ header_func (GtdTask           *task,
              GtdPanelScheduled *panel)
 {
   g_autoptr (GDateTime) dt = NULL;
-  g_autofree gchar *text = NULL;
+  const gchar *text = NULL;
   gint span;
 
   dt = gtd_task_get_due_date (task);
@@ -214,93 +145,6 @@ header_func (GtdTask           *task,
   return text ? create_label (text, span, !previous_task) : NULL;
 }
 
-static gint
-sort_func (gconstpointer a,
-           gconstpointer b,
-           gpointer      user_data)
-{
-  GDateTime *dt1;
-  GDateTime *dt2;
-  GtdTask *task1;
-  GtdTask *task2;
-  gint retval;
-  gchar *t1;
-  gchar *t2;
-
-  task1 = (GtdTask*) a;
-  task2 = (GtdTask*) b;
-
-  /* First, compare by ::due-date. */
-  dt1 = gtd_task_get_due_date (task1);
-  dt2 = gtd_task_get_due_date (task2);
-
-  if (!dt1 && !dt2)
-    retval = 0;
-  else if (!dt1)
-    retval = 1;
-  else if (!dt2)
-    retval = -1;
-  else
-    retval = compare_by_date (dt1, dt2);
-
-  g_clear_pointer (&dt1, g_date_time_unref);
-  g_clear_pointer (&dt2, g_date_time_unref);
-
-  if (retval != 0)
-    return retval;
-
-  /* Second, compare by ::complete. */
-  retval = gtd_task_get_complete (task1) - gtd_task_get_complete (task2);
-
-  if (retval != 0)
-    return retval;
-
-  /* Third, compare by ::creation-date. */
-  dt1 = gtd_task_get_creation_date (task1);
-  dt2 = gtd_task_get_creation_date (task2);
-
-  if (!dt1 && !dt2)
-    retval =  0;
-  else if (!dt1)
-    retval =  1;
-  else if (!dt2)
-    retval = -1;
-  else
-    retval = g_date_time_compare (dt1, dt2);
-
-  g_clear_pointer (&dt1, g_date_time_unref);
-  g_clear_pointer (&dt2, g_date_time_unref);
-
-  if (retval != 0)
-    return retval;
-
-  /* Finally, compare by ::title. */
-  t1 = t2 = NULL;
-
-  t1 = g_utf8_casefold (gtd_task_get_title (task1), -1);
-  t2 = g_utf8_casefold (gtd_task_get_title (task2), -1);
-
-  retval = g_strcmp0 (t1, t2);
-
-  g_free (t1);
-  g_free (t2);
-
-  return retval;
-}
-
-static gboolean
-filter_func (gpointer  item,
-             gpointer  user_data)
-{
-  g_autoptr (GDateTime) task_dt = NULL;
-  GtdTask *task;
-
-  task = (GtdTask*) item;
-  task_dt = gtd_task_get_due_date (task);
-
-  return !gtd_task_get_complete (task) && task_dt != NULL;
-}
-
 static void
 on_model_items_changed_cb (GListModel        *model,
                            guint              position,
@@ -320,13 +164,9 @@ on_clock_day_changed_cb (GtdClock          *clock,
                          GtdPanelScheduled *self)
 {
   g_autoptr (GDateTime) now = NULL;
-  GtkFilter *filter;
 
   now = g_date_time_new_now_local ();
   gtd_task_list_view_set_default_date (self->view, now);
-
-  filter = gtk_filter_list_model_get_filter (self->filter_model);
-  gtk_filter_changed (filter, GTK_FILTER_CHANGE_DIFFERENT);
 }
 
 
@@ -395,8 +235,6 @@ gtd_panel_scheduled_finalize (GObject *object)
   GtdPanelScheduled *self = (GtdPanelScheduled *)object;
 
   g_clear_object (&self->icon);
-  g_clear_object (&self->filter_model);
-  g_clear_object (&self->sort_model);
 
   G_OBJECT_CLASS (gtd_panel_scheduled_parent_class)->finalize (object);
 }
@@ -471,22 +309,16 @@ gtd_panel_scheduled_init (GtdPanelScheduled *self)
 {
   g_autoptr (GDateTime) now = g_date_time_new_now_local ();
   GtdManager *manager = gtd_manager_get_default ();
-  GtkCustomFilter *filter;
-  GtkCustomSorter *sorter;
 
   self->icon = g_themed_icon_new ("alarm-symbolic");
 
-  filter = gtk_custom_filter_new (filter_func, self, NULL);
-  self->filter_model = gtk_filter_list_model_new (gtd_manager_get_tasks_model (manager),
-                                                  GTK_FILTER (filter));
-
-  sorter = gtk_custom_sorter_new (sort_func, self, NULL);
-  self->sort_model = gtk_sort_list_model_new (G_LIST_MODEL (self->filter_model),
-                                              GTK_SORTER (sorter));
+  self->model = gtd_due_date_index_get_model (gtd_manager_get_due_date_index (manager),
+                                              GTD_DUE_DATE_RANGE_SCHEDULED,
+                                              FALSE);
 
   /* The main view */
   self->view = GTD_TASK_LIST_VIEW (gtd_task_list_view_new ());
-  gtd_task_list_view_set_model (self->view, G_LIST_MODEL (self->sort_model));
+  gtd_task_list_view_set_model (self->view, self->model);
   gtd_task_list_view_set_handle_subtasks (self->view, FALSE);
   gtd_task_list_view_set_show_list_name (self->view, TRUE);
   gtd_task_list_view_set_show_due_date (self->view, FALSE);
@@ -500,7 +332,7 @@ gtd_panel_scheduled_init (GtdPanelScheduled *self)
                                       (GtdTaskListViewHeaderFunc) header_func,
                                       self);
 
-  g_signal_connect_object (self->sort_model,
+  g_signal_connect_object (self->model,
                            "items-changed",
                            G_CALLBACK (on_model_items_changed_cb),
                            self,
@@ -44,7 +44,7 @@ struct _GtdSidebarListRow
 };
 
 
-static void          on_list_changed_cb                          (GtdSidebarListRow  *self);
+static void          on_list_counters_changed_cb                 (GtdSidebarListRow  *self);
 
 static void          on_list_color_changed_cb                    (GtdTaskList        *list,
                                                                   GParamSpec         *pspec,
@@ -82,14 +82,9 @@ static void
 update_counter_label (GtdSidebarListRow *self)
 {
   g_autofree gchar *label = NULL;
-  GListModel *model;
-  guint counter = 0;
-  guint i;
+  guint counter;
 
-  model = G_LIST_MODEL (self->list);
-
-  for (i = 0; i < g_list_model_get_n_items (model); i++)
-    counter += !gtd_task_get_complete (g_list_model_get_item (model, i));
+  counter = gtd_task_list_get_n_tasks (self->list) - gtd_task_list_get_n_completed (self->list);
 
   label = counter > 0 ? g_strdup_printf ("%u", counter) : g_strdup ("");
 
@@ -118,9 +113,8 @@ set_list (GtdSidebarListRow *self,
                           G_BINDING_DEFAULT | G_BINDING_SYNC_CREATE);
 
   /* Always keep the counter label updated */
-  g_signal_connect_object (list, "task-added", G_CALLBACK (on_list_changed_cb), self, G_CONNECT_SWAPPED);
-  g_signal_connect_object (list, "task-updated", G_CALLBACK (on_list_changed_cb), self, G_CONNECT_SWAPPED);
-  g_signal_connect_object (list, "task-removed", G_CALLBACK (on_list_changed_cb), self, G_CONNECT_SWAPPED);
+  g_signal_connect_object (list, "notify::n-tasks", G_CALLBACK (on_list_counters_changed_cb), self, G_CONNECT_SWAPPED);
+  g_signal_connect_object (list, "notify::n-completed", G_CALLBACK (on_list_counters_changed_cb), self, G_CONNECT_SWAPPED);
 
   update_counter_label (self);
 
@@ -136,7 +130,7 @@ set_list (GtdSidebarListRow *self,
  */
 
 static void
-on_list_changed_cb (GtdSidebarListRow *self)
+on_list_counters_changed_cb (GtdSidebarListRow *self)
 {
   update_counter_label (self);
 }
@@ -216,6 +216,12 @@ update_archive_button (GtdTaskListPanel *self)
  * Callbacks
  */
 
+static void
+on_task_list_counters_changed_cb (GtdTaskListPanel *self)
+{
+  g_object_notify (G_OBJECT (self), "subtitle");
+}
+
 static void
 on_task_list_updated_cb (GObject      *source,
                          GAsyncResult *result,
@@ -418,7 +424,16 @@ gtd_task_list_panel_get_priority (GtdPanel *panel)
 static gchar*
 gtd_task_list_panel_get_subtitle (GtdPanel *panel)
 {
-  return NULL;
+  GtdTaskListPanel *self;
+  GtdTaskList *list;
+
+  self = GTD_TASK_LIST_PANEL (panel);
+  list = (GtdTaskList *) gtd_task_list_view_get_model (self->task_list_view);
+
+  if (!list)
+    return NULL;
+
+  return g_strdup_printf ("%u", gtd_task_list_get_n_tasks (list) - gtd_task_list_get_n_completed (list));
 }
 
 static void
@@ -526,7 +541,7 @@ gtd_task_list_panel_get_property (GObject    *object,
       break;
 
     case PROP_SUBTITLE:
-      g_value_take_string (value, NULL);
+      g_value_take_string (value, gtd_panel_get_subtitle (GTD_PANEL (object)));
       break;
 
     case PROP_TITLE:
@@ -622,14 +637,34 @@ void
 gtd_task_list_panel_set_task_list (GtdTaskListPanel *self,
                                    GtdTaskList      *list)
 {
+  GtdTaskList *old_list;
+
   g_return_if_fail (GTD_IS_TASK_LIST_PANEL (self));
   g_return_if_fail (GTD_IS_TASK_LIST (list));
 
+  old_list = gtd_task_list_panel_get_task_list (self);
+
+  if (old_list)
+    g_signal_handlers_disconnect_by_func (old_list, on_task_list_counters_changed_cb, self);
+
   gtd_task_list_view_set_model (self->task_list_view, G_LIST_MODEL (list));
 
+  g_signal_connect_object (list,
+                           "notify::n-tasks",
+                           G_CALLBACK (on_task_list_counters_changed_cb),
+                           self,
+                           G_CONNECT_SWAPPED);
+
+  g_signal_connect_object (list,
+                           "notify::n-completed",
+                           G_CALLBACK (on_task_list_counters_changed_cb),
+                           self,
+                           G_CONNECT_SWAPPED);
+
   update_selected_color (self);
   update_archive_button (self);
 
   g_object_notify (G_OBJECT (self), "title");
+  g_object_notify (G_OBJECT (self), "subtitle");
 }
 
@@ -34,9 +34,9 @@ struct _GtdPanelToday
   guint               number_of_tasks;
   GtdTaskListView    *view;
 
-  GtkFilterListModel *filter_model;
-  GtkFilterListModel *incomplete_model;
-  GtkSortListModel   *sort_model;
+  GListModel         *model;
+  GListModel         *incomplete_overdue_model;
+  GListModel         *incomplete_today_model;
 
   GtkCssProvider     *css_provider;
 };
@@ -185,71 +185,6 @@ header_func (GtdTask  *task,
  * Callbacks
  */
 
-static gboolean
-filter_func (gpointer  item,
-             gpointer  user_data)
-{
-  g_autoptr (GDateTime) task_dt = NULL;
-  g_autoptr (GDateTime) now = NULL;
-  GtdTask *task;
-  gboolean complete;
-
-  task = (GtdTask*) item;
-  now = g_date_time_new_now_local ();
-  task_dt = gtd_task_get_due_date (task);
-
-  complete = gtd_task_get_complete (task);
-
-  return is_today (now, task_dt) || (!complete && is_overdue (now, task_dt));
-}
-
-static gboolean
-filter_complete_func (gpointer item,
-                      gpointer user_data)
-{
-  GtdTask *task = (GtdTask*) item;
-
-  return !gtd_task_get_complete (task);
-}
-
-static gint
-sort_func (gconstpointer a,
-           gconstpointer b,
-           gpointer      user_data)
-{
-  g_autoptr (GDateTime) dt1 = NULL;
-  g_autoptr (GDateTime) dt2 = NULL;
-  GtdTask *task1;
-  GtdTask *task2;
-  GDate dates[2];
-  gint result;
-
-  task1 = (GtdTask*) a;
-  task2 = (GtdTask*) b;
-
-  dt1 = gtd_task_get_due_date (task1);
-  dt2 = gtd_task_get_due_date (task2);
-
-  g_date_clear (dates, 2);
-
-  g_date_set_dmy (&dates[0],
-                  g_date_time_get_day_of_month (dt1),
-                  g_date_time_get_month (dt1),
-                  g_date_time_get_year (dt1));
-
-  g_date_set_dmy (&dates[1],
-                  g_date_time_get_day_of_month (dt2),
-                  g_date_time_get_month (dt2),
-                  g_date_time_get_year (dt2));
-
-  result = g_date_days_between (&dates[1], &dates[0]);
-
-  if (result != 0)
-    return result;
-
-  return gtd_task_compare (task1, task2);
-}
-
 static void
 on_model_items_changed_cb (GListModel    *model,
                            guint          position,
@@ -257,10 +192,15 @@ on_model_items_changed_cb (GListModel    *model,
                            guint          n_added,
                            GtdPanelToday *self)
 {
-  if (self->number_of_tasks == g_list_model_get_n_items (model))
+  guint number_of_tasks;
+
+  number_of_tasks = g_list_model_get_n_items (self->incomplete_overdue_model) +
+                    g_list_model_get_n_items (self->incomplete_today_model);
+
+  if (self->number_of_tasks == number_of_tasks)
     return;
 
-  self->number_of_tasks = g_list_model_get_n_items (model);
+  self->number_of_tasks = number_of_tasks;
   g_object_notify (G_OBJECT (self), "subtitle");
 }
 
@@ -269,13 +209,9 @@ on_clock_day_changed_cb (GtdClock      *clock,
                          GtdPanelToday *self)
 {
   g_autoptr (GDateTime) now = NULL;
-  GtkFilter *filter;
 
   now = g_date_time_new_now_local ();
   gtd_task_list_view_set_default_date (self->view, now);
-
-  filter = gtk_filter_list_model_get_filter (self->filter_model);
-  gtk_filter_changed (filter, GTK_FILTER_CHANGE_DIFFERENT);
 }
 
 
@@ -346,9 +282,7 @@ gtd_panel_today_finalize (GObject *object)
 
   g_clear_object (&self->css_provider);
   g_clear_object (&self->icon);
-  g_clear_object (&self->filter_model);
-  g_clear_object (&self->incomplete_model);
-  g_clear_object (&self->sort_model);
+  g_clear_object (&self->model);
 
   G_OBJECT_CLASS (gtd_panel_today_parent_class)->finalize (object);
 }
@@ -421,27 +355,25 @@ gtd_panel_today_class_init (GtdPanelTodayClass *klass)
 static void
 gtd_panel_today_init (GtdPanelToday *self)
 {
+  g_autoptr (GListStore) ranges = NULL;
   g_autoptr (GDateTime) now = NULL;
+  GtdDueDateIndex *index;
   GtdManager *manager;
-  GtkCustomFilter *incomplete_filter;
-  GtkCustomFilter *filter;
-  GtkCustomSorter *sorter;
 
   manager = gtd_manager_get_default ();
 
   self->icon = g_themed_icon_new ("view-tasks-today-symbolic");
 
-  filter = gtk_custom_filter_new (filter_func, self, NULL);
-  self->filter_model = gtk_filter_list_model_new (gtd_manager_get_tasks_model (manager),
-                                                  GTK_FILTER (filter));
+  /* Incomplete overdue tasks, followed by all tasks due today */
+  index = gtd_manager_get_due_date_index (manager);
+  self->incomplete_overdue_model = gtd_due_date_index_get_model (index, GTD_DUE_DATE_RANGE_OVERDUE, FALSE);
+  self->incomplete_today_model = gtd_due_date_index_get_model (index, GTD_DUE_DATE_RANGE_TODAY, FALSE);
 
-  sorter = gtk_custom_sorter_new (sort_func, self, NULL);
-  self->sort_model = gtk_sort_list_model_new (G_LIST_MODEL (self->filter_model),
-                                              GTK_SORTER (sorter));
+  ranges = g_list_store_new (G_TYPE_LIST_MODEL);
+  g_list_store_append (ranges, self->incomplete_overdue_model);
+  g_list_store_append (ranges, gtd_due_date_index_get_model (index, GTD_DUE_DATE_RANGE_TODAY, TRUE));
 
-  incomplete_filter = gtk_custom_filter_new (filter_complete_func, self, NULL);
-  self->incomplete_model = gtk_filter_list_model_new (G_LIST_MODEL (self->sort_model),
-                                                      GTK_FILTER (incomplete_filter));
+  self->model = G_LIST_MODEL (gtk_flatten_list_model_new (G_LIST_MODEL (ranges)));
 
   /* Connect to GtdManager::list-* signals to update the title */
   manager = gtd_manager_get_default ();
@@ -449,7 +381,7 @@ gtd_panel_today_init (GtdPanelToday *self)
 
   /* The main view */
   self->view = GTD_TASK_LIST_VIEW (gtd_task_list_view_new ());
-  gtd_task_list_view_set_model (self->view, G_LIST_MODEL (self->sort_model));
+  gtd_task_list_view_set_model (self->view, self->model);
   gtd_task_list_view_set_handle_subtasks (self->view, FALSE);
   gtd_task_list_view_set_show_list_name (self->view, TRUE);
   gtd_task_list_view_set_show_due_date (self->view, FALSE);
@@ -461,7 +393,13 @@ gtd_panel_today_init (GtdPanelToday *self)
 
   gtd_task_list_view_set_header_func (self->view, header_func, self);
 
-  g_signal_connect_object (self->incomplete_model,
+  g_signal_connect_object (self->incomplete_overdue_model,
+                           "items-changed",
+                           G_CALLBACK (on_model_items_changed_cb),
+                           self,
+                           0);
+
+  g_signal_connect_object (self->incomplete_today_model,
                            "items-changed",
                            G_CALLBACK (on_model_items_changed_cb),
                            self,
@@ -32,7 +32,7 @@ struct _GtdTodayOmniAreaAddin
   GObject             parent;
 
   GIcon              *icon;
-  GtkFilterListModel *filter_model;
+  GListModel         *model;
 
   GtdOmniArea        *omni_area;
   guint               number_of_tasks;
@@ -114,22 +114,6 @@ update_omni_area_message (GtdTodayOmniAreaAddin *self)
   gtd_omni_area_push_message (self->omni_area, MESSAGE_ID, message, self->icon);
 }
 
-static gboolean
-is_today (GDateTime *today,
-          GDateTime *dt)
-{
-  if (!dt)
-    return FALSE;
-
-  if (g_date_time_get_year (dt) == g_date_time_get_year (today) &&
-      g_date_time_get_day_of_year (dt) == g_date_time_get_day_of_year (today))
-    {
-      return TRUE;
-    }
-
-  return FALSE;
-}
-
 
 /*
  * Callbacks
@@ -147,36 +131,12 @@ idle_update_omni_area_message_cb (gpointer user_data)
   return G_SOURCE_REMOVE;
 }
 
-static gboolean
-filter_func (gpointer  item,
-             gpointer  user_data)
-{
-  g_autoptr (GDateTime) task_dt = NULL;
-  g_autoptr (GDateTime) now = NULL;
-  GtdTask *task;
-
-  task = (GtdTask*) item;
-
-  if (gtd_task_get_complete (task))
-    return FALSE;
-
-  now = g_date_time_new_now_local ();
-  task_dt = gtd_task_get_due_date (task);
-
-  return is_today (now, task_dt);
-}
-
 static void
 on_clock_day_changed_cb (GtdClock              *clock,
                          GtdTodayOmniAreaAddin *self)
 {
-  GtkFilter *filter;
-
   self->had_tasks = FALSE;
   self->finished_tasks = FALSE;
-
-  filter = gtk_filter_list_model_get_filter (self->filter_model);
-  gtk_filter_changed (filter, GTK_FILTER_CHANGE_DIFFERENT);
 }
 
 static void
@@ -263,7 +223,6 @@ gtd_today_omni_area_addin_finalize (GObject *object)
 
   g_clear_handle_id (&self->idle_update_message_timeout_id, g_source_remove);
   g_clear_object (&self->icon);
-  g_clear_object (&self->filter_model);
 
   G_OBJECT_CLASS (gtd_today_omni_area_addin_parent_class)->finalize (object);
 }
@@ -279,18 +238,17 @@ gtd_today_omni_area_addin_class_init (GtdTodayOmniAreaAddinClass *klass)
 static void
 gtd_today_omni_area_addin_init (GtdTodayOmniAreaAddin *self)
 {
-  GtkCustomFilter *filter;
   GtdManager *manager;
 
   manager = gtd_manager_get_default ();
 
   self->icon = g_themed_icon_new ("view-tasks-today-symbolic");
 
-  filter = gtk_custom_filter_new (filter_func, self, NULL);
-  self->filter_model = gtk_filter_list_model_new (gtd_manager_get_tasks_model (manager),
-                                                  GTK_FILTER (filter));
+  self->model = gtd_due_date_index_get_model (gtd_manager_get_due_date_index (manager),
+                                              GTD_DUE_DATE_RANGE_TODAY,
+                                              FALSE);
 
-  g_signal_connect_object (self->filter_model,
+  g_signal_connect_object (self->model,
                            "items-changed",
                            G_CALLBACK (on_model_items_changed_cb),
                            self,
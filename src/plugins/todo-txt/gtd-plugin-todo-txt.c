@@ -39,10 +39,10 @@ struct _GtdPluginTodoTxt
   GSettings          *settings;
 
   GtkWidget          *preferences_box;
-  GtkWidget          *preferences;
+  GtkWidget          *file_button;
+  GtkNativeDialog    *file_chooser;
 
-  /* Providers */
-  GList              *providers;
+  GtdProviderTodoTxt *provider;
 };
 
 enum
@@ -52,7 +52,7 @@ enum
   LAST_PROP
 };
 
-static void          on_source_changed_cb                        (GtkWidget          *preference_panel,
+static void          on_file_button_clicked_cb                   (GtkButton          *button,
                                                                   GtdPluginTodoTxt   *self);
 
 static void          gtd_activatable_iface_init                  (GtdActivatableInterface  *iface);
@@ -102,6 +102,8 @@ setup_source (GtdPluginTodoTxt *self)
 
   GTD_ENTRY;
 
+  g_clear_object (&self->source_file);
+
   source = g_settings_get_string (self->settings, "file");
 
   if (!source || source[0] == '\0')
@@ -133,67 +135,80 @@ setup_source (GtdPluginTodoTxt *self)
 }
 
 static void
-setup_preferences_panel (GtdPluginTodoTxt *self)
+add_provider (GtdPluginTodoTxt *self)
+{
+  GTD_ENTRY;
+
+  g_assert (self->provider == NULL);
+
+  if (!setup_source (self))
+    GTD_RETURN ();
+
+  self->provider = gtd_provider_todo_txt_new (self->source_file);
+  gtd_manager_add_provider (gtd_manager_get_default (), GTD_PROVIDER (self->provider));
+
+  GTD_EXIT;
+}
+
+static void
+remove_provider (GtdPluginTodoTxt *self)
+{
+  g_autoptr (GtdProviderTodoTxt) provider = NULL;
+
+  GTD_ENTRY;
+
+  provider = g_steal_pointer (&self->provider);
+
+  if (provider)
+    gtd_manager_remove_provider (gtd_manager_get_default (), GTD_PROVIDER (provider));
+
+  GTD_EXIT;
+}
+
+static void
+update_file_button (GtdPluginTodoTxt *self)
 {
-  GtdProviderTodoTxt *provider;
   g_autofree gchar *path = NULL;
-  GtkWidget *label;
-  GtkWidget *box;
-  gboolean set;
+  g_autofree gchar *basename = NULL;
 
-  set = setup_source (self);
-  self->providers = NULL;
+  path = g_settings_get_string (self->settings, "file");
 
-  if (set)
-    {
-      provider = gtd_provider_todo_txt_new (self->source_file);
-      self->providers = g_list_append (self->providers, provider);
-    }
+  if (path && *path)
+    basename = g_path_get_basename (path);
+
+  gtk_button_set_label (GTK_BUTTON (self->file_button), basename ? basename : _("Select a file"));
+}
+
+static void
+setup_preferences_panel (GtdPluginTodoTxt *self)
+{
+  GtkWidget *label;
+  GtkWidget *box;
 
   /* Preferences */
   box = g_object_new (GTK_TYPE_BOX,
-                      "margin", 18,
+                      "margin-top", 18,
+                      "margin-bottom", 18,
+                      "margin-start", 18,
+                      "margin-end", 18,
                       "spacing", 12,
-                      "expand", TRUE,
+                      "hexpand", TRUE,
+                      "vexpand", TRUE,
                       "orientation", GTK_ORIENTATION_VERTICAL,
                       NULL);
 
   label = gtk_label_new (_("Select a Todo.txt-formatted file:"));
-  gtk_container_add (GTK_CONTAINER (box), label);
+  gtk_box_append (GTK_BOX (box), label);
 
-  /* Filechooser */
-  self->preferences = gtk_file_chooser_button_new (_("Select a file"), GTK_FILE_CHOOSER_ACTION_OPEN);
+  /* File button; the chooser dialog itself is created on demand */
+  self->file_button = gtk_button_new ();
   gtk_widget_set_size_request (GTK_WIDGET (box), 300, 0);
   gtk_widget_set_halign (GTK_WIDGET (box), GTK_ALIGN_CENTER);
   gtk_widget_set_valign (GTK_WIDGET (box), GTK_ALIGN_CENTER);
 
-  gtk_container_add (GTK_CONTAINER (box), self->preferences);
-
-  /* If there's a file set, select it */
-  path = g_settings_get_string (self->settings, "file");
-
-  if (path && *path)
-    {
-      g_autoptr (GError) error = NULL;
-      g_autoptr (GFile) file = NULL;
+  gtk_box_append (GTK_BOX (box), self->file_button);
 
-      g_debug ("Selecting Todo.txt file %s", path);
-
-      file = g_file_new_for_path (path);
-
-      gtk_file_chooser_set_file (GTK_FILE_CHOOSER (self->preferences), file, &error);
-
-      if (error)
-        {
-          g_warning ("Error selecting Todo.txt file (%s): %s", path, error->message);
-
-          gtd_manager_emit_error_message (gtd_manager_get_default (),
-                                          _("Error opening Todo.txt file"),
-                                          error->message,
-                                          NULL,
-                                          NULL);
-        }
-    }
+  update_file_button (self);
 
   /* Big warning label reminding the user that this is experimental */
   label = gtk_label_new ("");
@@ -207,12 +222,12 @@ setup_preferences_panel (GtdPluginTodoTxt *self)
   gtk_label_set_lines (GTK_LABEL (label), 3);
   gtk_widget_set_margin_top (label, 18);
 
-  gtk_container_add (GTK_CONTAINER (box), label);
+  gtk_box_append (GTK_BOX (box), label);
 
   /* Store the box, and report it as the preferences panel itself */
-  self->preferences_box = box;
+  self->preferences_box = g_object_ref_sink (box);
 
-  g_signal_connect (self->preferences, "file-set", G_CALLBACK (on_source_changed_cb), self);
+  g_signal_connect (self->file_button, "clicked", G_CALLBACK (on_file_button_clicked_cb), self);
 }
 
 
@@ -221,51 +236,77 @@ setup_preferences_panel (GtdPluginTodoTxt *self)
  */
 
 static void
-on_source_changed_finished_cb (GtdPluginTodoTxt *self)
+on_file_chooser_response_cb (GtkNativeDialog  *dialog,
+                             gint              response,
+                             GtdPluginTodoTxt *self)
 {
-  GtdProviderTodoTxt *provider;
-  gboolean set;
+  g_autoptr (GFile) file = NULL;
 
   GTD_ENTRY;
 
-  set = setup_source (self);
+  if (response != GTK_RESPONSE_ACCEPT)
+    GTD_GOTO (out);
 
-  if (!set)
-    GTD_RETURN ();
+  file = gtk_file_chooser_get_file (GTK_FILE_CHOOSER (dialog));
+
+  if (!file)
+    GTD_GOTO (out);
 
-  provider = gtd_provider_todo_txt_new (self->source_file);
-  self->providers = g_list_append (self->providers, provider);
+  g_settings_set_string (self->settings, "file", g_file_peek_path (file));
+  update_file_button (self);
+
+  /* Replace the provider of the previous file */
+  remove_provider (self);
+  add_provider (self);
 
-  g_signal_emit_by_name (self, "provider-added", provider);
+out:
+  g_clear_object (&self->file_chooser);
 
   GTD_EXIT;
 }
 
 static void
-on_source_changed_cb (GtkWidget        *preference_panel,
-                      GtdPluginTodoTxt *self)
+on_file_button_clicked_cb (GtkButton        *button,
+                           GtdPluginTodoTxt *self)
 {
-  g_autoptr (GFile) file = NULL;
-  GtdProviderTodoTxt *provider;
+  g_autofree gchar *path = NULL;
+  GtkFileChooserNative *chooser;
+  GtkRoot *root;
 
   GTD_ENTRY;
 
-  g_clear_object (&self->source_file);
+  if (self->file_chooser)
+    GTD_RETURN ();
 
-  file = gtk_file_chooser_get_file (GTK_FILE_CHOOSER (self->preferences));
-  g_settings_set_string (self->settings, "file", g_file_peek_path (file));
+  root = gtk_widget_get_root (GTK_WIDGET (button));
+  chooser = gtk_file_chooser_native_new (_("Select a file"),
+                                         GTK_IS_WINDOW (root) ? GTK_WINDOW (root) : NULL,
+                                         GTK_FILE_CHOOSER_ACTION_OPEN,
+                                         _("_Select"),
+                                         _("_Cancel"));
 
-  if (self->providers)
+  /* If there's a file set, select it */
+  path = g_settings_get_string (self->settings, "file");
+
+  if (path && *path)
     {
-      provider = self->providers->data;
+      g_autoptr (GError) error = NULL;
+      g_autoptr (GFile) file = NULL;
+
+      g_debug ("Selecting Todo.txt file %s", path);
+
+      file = g_file_new_for_path (path);
 
-      g_list_free_full (self->providers, g_object_unref);
-      self->providers = NULL;
+      gtk_file_chooser_set_file (GTK_FILE_CHOOSER (chooser), file, &error);
 
-      g_signal_emit_by_name (self, "provider-removed", provider);
+      if (error)
+        g_warning ("Error selecting Todo.txt file (%s): %s", path, error->message);
     }
 
-  on_source_changed_finished_cb (self);
+  self->file_chooser = GTK_NATIVE_DIALOG (chooser);
+
+  g_signal_connect (chooser, "response", G_CALLBACK (on_file_chooser_response_cb), self);
+  gtk_native_dialog_show (self->file_chooser);
 
   GTD_EXIT;
 }
@@ -278,17 +319,17 @@ on_source_changed_cb (GtkWidget        *preference_panel,
 static void
 gtd_plugin_todo_txt_activate (GtdActivatable *activatable)
 {
+  GtdPluginTodoTxt *self = GTD_PLUGIN_TODO_TXT (activatable);
+
+  add_provider (self);
 }
 
 static void
 gtd_plugin_todo_txt_deactivate (GtdActivatable *activatable)
 {
-}
+  GtdPluginTodoTxt *self = GTD_PLUGIN_TODO_TXT (activatable);
 
-static GList*
-gtd_plugin_todo_txt_get_header_widgets (GtdActivatable *activatable)
-{
-  return NULL;
+  remove_provider (self);
 }
 
 static GtkWidget*
@@ -297,20 +338,6 @@ gtd_plugin_todo_txt_get_preferences_panel (GtdActivatable *activatable)
   GtdPluginTodoTxt *plugin = GTD_PLUGIN_TODO_TXT (activatable);
 
   return plugin->preferences_box;
-
-}
-
-static GList*
-gtd_plugin_todo_txt_get_panels (GtdActivatable *activatable)
-{
-  return NULL;
-}
-
-static GList*
-gtd_plugin_todo_txt_get_providers (GtdActivatable *activatable)
-{
-  GtdPluginTodoTxt *plugin = GTD_PLUGIN_TODO_TXT (activatable);
-  return plugin->providers;
 }
 
 static void
@@ -318,10 +345,7 @@ gtd_activatable_iface_init (GtdActivatableInterface *iface)
 {
   iface->activate = gtd_plugin_todo_txt_activate;
   iface->deactivate = gtd_plugin_todo_txt_deactivate;
-  iface->get_header_widgets = gtd_plugin_todo_txt_get_header_widgets;
   iface->get_preferences_panel = gtd_plugin_todo_txt_get_preferences_panel;
-  iface->get_panels = gtd_plugin_todo_txt_get_panels;
-  iface->get_providers = gtd_plugin_todo_txt_get_providers;
 }
 
 
@@ -334,8 +358,14 @@ gtd_plugin_todo_txt_finalize (GObject *object)
 {
   GtdPluginTodoTxt *self = (GtdPluginTodoTxt *) object;
 
-  g_list_free_full (self->providers, g_object_unref);
-  self->providers = NULL;
+  if (self->file_chooser)
+    gtk_native_dialog_destroy (self->file_chooser);
+
+  g_clear_object (&self->file_chooser);
+  g_clear_object (&self->provider);
+  g_clear_object (&self->preferences_box);
+  g_clear_object (&self->source_file);
+  g_clear_object (&self->settings);
 
   G_OBJECT_CLASS (gtd_plugin_todo_txt_parent_class)->finalize (object);
 }
@@ -350,7 +380,7 @@ gtd_plugin_todo_txt_get_property (GObject    *object,
   switch (prop_id)
     {
     case PROP_PREFERENCES_PANEL:
-      g_value_set_object (value, self->preferences);
+      g_value_set_object (value, self->preferences_box);
       break;
 
     default:
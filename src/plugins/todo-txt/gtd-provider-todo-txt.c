@@ -29,6 +29,9 @@
 #include <stdlib.h>
 #include <glib/gi18n.h>
 
+#define SAVE_TIMEOUT_MS 500
+#define RELOAD_TIMEOUT_MS 250
+
 
 struct _GtdProviderTodoTxt
 {
@@ -45,10 +48,57 @@ struct _GtdProviderTodoTxt
   GList              *task_lists;
   GPtrArray          *cache;
 
+  /*
+   * The last serialized contents, and the span of each task's line in
+   * it, by task uid. Tasks without a span are serialized again.
+   */
+  GBytes             *contents;
+  GHashTable         *line_spans;
+
+  guint               save_timeout_id;
+  gboolean            saving;
+  gboolean            save_pending;
+
+  guint               reload_timeout_id;
+
   guint64             task_counter;
-  gboolean            should_reload;
 };
 
+typedef struct
+{
+  gsize               offset;
+  gsize               length;
+} LineSpan;
+
+typedef struct
+{
+  gchar              *path;
+  GBytes             *contents;
+} SaveData;
+
+typedef struct
+{
+  const gchar        *data;
+  gsize               length;
+} LineKey;
+
+typedef struct
+{
+  GtdTask            *task;
+  GtdTaskList        *list;
+
+  /* The task already in the list that this line corresponds to, if any */
+  GtdTask            *existing;
+  guint               old_index;
+  gboolean            edited;
+
+  const gchar        *line;
+  gsize               length;
+  gsize               length_with_newline;
+  gboolean            terminated;
+  guint               indent;
+} ParsedLine;
+
 static void          on_file_monitor_changed_cb                  (GFileMonitor       *monitor,
                                                                   GFile              *first,
                                                                   GFile              *second,
@@ -63,7 +113,6 @@ G_DEFINE_TYPE_WITH_CODE (GtdProviderTodoTxt, gtd_provider_todo_txt, GTD_TYPE_OBJ
 enum
 {
   PROP_0,
-  PROP_DEFAULT_TASKLIST,
   PROP_DESCRIPTION,
   PROP_ENABLED,
   PROP_ICON,
@@ -76,12 +125,25 @@ enum
 
 typedef gboolean (*GtdLineParserFunc) (GtdProviderTodoTxt *self,
                                        const gchar        *line,
+                                       GHashTable         *seen_lists,
                                        GError            **error);
 
+static void          on_source_saved_cb                          (GObject            *source_object,
+                                                                  GAsyncResult       *result,
+                                                                  gpointer            user_data);
+
 /*
  * Auxiliary methods
  */
 
+static void
+save_data_free (SaveData *data)
+{
+  g_clear_pointer (&data->contents, g_bytes_unref);
+  g_clear_pointer (&data->path, g_free);
+  g_free (data);
+}
+
 static void
 print_task (GString *output,
             GtdTask *task)
@@ -160,21 +222,56 @@ rgba_to_hex (GdkRGBA *color)
 }
 
 static void
-update_source (GtdProviderTodoTxt *self)
+invalidate_task_line (GtdProviderTodoTxt *self,
+                      GtdTask            *task)
 {
-  g_autofree gchar *output_path = NULL;
+  GtdTask *subtask;
+
+  g_hash_table_remove (self->line_spans, gtd_object_get_uid (GTD_OBJECT (task)));
+
+  /* Subtasks are indented based on their parent, so they may change too */
+  for (subtask = gtd_task_get_first_subtask (task);
+       subtask;
+       subtask = gtd_task_get_next_sibling (subtask))
+    {
+      invalidate_task_line (self, subtask);
+    }
+}
+
+static void
+invalidate_task_list_lines (GtdProviderTodoTxt *self,
+                            GtdTaskList        *list)
+{
+  guint i;
+
+  for (i = 0; i < g_list_model_get_n_items (G_LIST_MODEL (list)); i++)
+    {
+      g_autoptr (GtdTask) task = g_list_model_get_item (G_LIST_MODEL (list), i);
+
+      g_hash_table_remove (self->line_spans, gtd_object_get_uid (GTD_OBJECT (task)));
+    }
+}
+
+static GBytes*
+serialize_contents (GtdProviderTodoTxt *self)
+{
+  g_autoptr (GHashTable) line_spans = NULL;
   g_autoptr (GString) contents = NULL;
   g_autoptr (GString) color_line = NULL;
   g_autoptr (GString) list_line = NULL;
-  g_autoptr (GError) error = NULL;
+  const gchar *previous_contents;
   GtdTaskList *list;
+  guint n_reused;
   guint i;
 
   GTD_ENTRY;
 
-  contents = g_string_new ("");
+  contents = g_string_sized_new (self->contents ? g_bytes_get_size (self->contents) : 0);
   color_line = g_string_new ("");
   list_line = g_string_new ("");
+  line_spans = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+  previous_contents = self->contents ? g_bytes_get_data (self->contents, NULL) : NULL;
+  n_reused = 0;
 
   /* Save the tasks first */
   for (i = 0; i < self->cache->len; i++)
@@ -183,9 +280,37 @@ update_source (GtdProviderTodoTxt *self)
 
       list = g_ptr_array_index (self->cache, i);
 
-      /* And now save each task */
+      /* And now save each task, copying unchanged lines verbatim */
       for (j = 0; j < g_list_model_get_n_items (G_LIST_MODEL (list)); j++)
-        print_task (contents, g_list_model_get_item (G_LIST_MODEL (list), j));
+        {
+          g_autoptr (GtdTask) task = NULL;
+          LineSpan *previous_span;
+          LineSpan *span;
+          const gchar *uid;
+
+          task = g_list_model_get_item (G_LIST_MODEL (list), j);
+          uid = gtd_object_get_uid (GTD_OBJECT (task));
+          previous_span = g_hash_table_lookup (self->line_spans, uid);
+
+          span = g_new0 (LineSpan, 1);
+          span->offset = contents->len;
+
+          if (previous_span)
+            {
+              g_string_append_len (contents,
+                                   previous_contents + previous_span->offset,
+                                   previous_span->length);
+              n_reused++;
+            }
+          else
+            {
+              print_task (contents, task);
+            }
+
+          span->length = contents->len - span->offset;
+
+          g_hash_table_insert (line_spans, g_strdup (uid), span);
+        }
     }
 
   /* Initialize lists & colors custom lines */
@@ -222,20 +347,119 @@ update_source (GtdProviderTodoTxt *self)
   g_string_append (contents, list_line->str);
   g_string_append (contents, color_line->str);
 
-  output_path = g_file_get_path (self->source_file);
-  g_file_set_contents (output_path, contents->str, contents->len, &error);
+  GTD_TRACE_MSG ("Serialized %u tasks, %u lines reused",
+                 g_hash_table_size (line_spans),
+                 n_reused);
 
-  if (error)
+  /* The new spans point into the new contents */
+  g_clear_pointer (&self->line_spans, g_hash_table_destroy);
+  self->line_spans = g_steal_pointer (&line_spans);
+
+  g_clear_pointer (&self->contents, g_bytes_unref);
+  self->contents = g_string_free_to_bytes (g_steal_pointer (&contents));
+
+  GTD_RETURN (g_bytes_ref (self->contents));
+}
+
+static void
+save_in_thread_cb (GTask        *task,
+                   gpointer      source_object,
+                   gpointer      task_data,
+                   GCancellable *cancellable)
+{
+  g_autoptr (GError) error = NULL;
+  SaveData *data;
+  gsize size;
+  const gchar *contents;
+
+  data = task_data;
+  contents = g_bytes_get_data (data->contents, &size);
+
+  /* g_file_set_contents() writes to a temporary file and renames it over */
+  if (!g_file_set_contents (data->path, contents, size, &error))
     {
-      g_warning ("Error saving Todo.txt file: %s", error->message);
+      g_task_return_error (task, g_steal_pointer (&error));
       return;
     }
 
-  self->should_reload = FALSE;
+  g_task_return_boolean (task, TRUE);
+}
+
+static void
+update_source (GtdProviderTodoTxt *self)
+{
+  g_autoptr (GTask) task = NULL;
+  SaveData *data;
+
+  GTD_ENTRY;
+
+  g_assert (!self->saving);
+
+  data = g_new0 (SaveData, 1);
+  data->path = g_file_get_path (self->source_file);
+  data->contents = serialize_contents (self);
+
+  self->saving = TRUE;
+  self->save_pending = FALSE;
+
+  task = g_task_new (self, NULL, on_source_saved_cb, NULL);
+  g_task_set_source_tag (task, update_source);
+  g_task_set_task_data (task, data, (GDestroyNotify) save_data_free);
+  g_task_run_in_thread (task, save_in_thread_cb);
 
   GTD_EXIT;
 }
 
+static gboolean
+save_timeout_cb (gpointer user_data)
+{
+  GtdProviderTodoTxt *self = GTD_PROVIDER_TODO_TXT (user_data);
+
+  self->save_timeout_id = 0;
+
+  /* Wait for the running write to finish, and save again after it */
+  if (self->saving)
+    self->save_pending = TRUE;
+  else
+    update_source (self);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+schedule_update_source (GtdProviderTodoTxt *self)
+{
+  if (self->save_timeout_id > 0)
+    return;
+
+  self->save_timeout_id = g_timeout_add (SAVE_TIMEOUT_MS, save_timeout_cb, self);
+}
+
+static void
+flush_update_source (GtdProviderTodoTxt *self)
+{
+  g_autoptr (GBytes) contents = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *output_path = NULL;
+
+  if (self->save_timeout_id == 0 && !self->save_pending)
+    return;
+
+  g_clear_handle_id (&self->save_timeout_id, g_source_remove);
+  self->save_pending = FALSE;
+
+  contents = serialize_contents (self);
+  output_path = g_file_get_path (self->source_file);
+
+  if (!g_file_set_contents (output_path,
+                            g_bytes_get_data (contents, NULL),
+                            g_bytes_get_size (contents),
+                            &error))
+    {
+      g_warning ("Error saving Todo.txt file: %s", error->message);
+    }
+}
+
 static void
 add_task_list (GtdProviderTodoTxt *self,
                GtdTaskList        *list)
@@ -252,6 +476,7 @@ add_task_list (GtdProviderTodoTxt *self,
 static gboolean
 parse_lists_line (GtdProviderTodoTxt *self,
                   const gchar        *line,
+                  GHashTable         *seen_lists,
                   GError            **error)
 {
   g_autoptr (GPtrArray) lists = NULL;
@@ -263,7 +488,14 @@ parse_lists_line (GtdProviderTodoTxt *self,
     return FALSE;
 
   for (i = 0; i < lists->len; i++)
-    add_task_list (self, g_ptr_array_index (lists, i));
+    {
+      GtdTaskList *list = g_ptr_array_index (lists, i);
+
+      add_task_list (self, list);
+
+      /* The list may already exist, in which case the existing one is kept */
+      g_hash_table_add (seen_lists, g_hash_table_lookup (self->lists, gtd_task_list_get_name (list)));
+    }
 
   return TRUE;
 }
@@ -271,62 +503,91 @@ parse_lists_line (GtdProviderTodoTxt *self,
 static gboolean
 parse_list_colors_line (GtdProviderTodoTxt *self,
                         const gchar        *line,
+                        GHashTable         *seen_lists,
                         GError            **error)
 {
   return gtd_todo_txt_parser_parse_task_list_color (self->lists, line, error);
 }
 
-static void
-parse_task (GtdProviderTodoTxt  *self,
-            const gchar         *line,
-            GHashTable          *list_to_tasks,
-            GError             **error)
+static GtdTaskList*
+lookup_or_create_list (GtdProviderTodoTxt *self,
+                       GString            *list_name)
 {
-  g_autofree gchar *list_name = NULL;
   GtdTaskList *list;
-  GPtrArray *tasks;
-  GtdTask *task;
 
-  task = gtd_todo_txt_parser_parse_task (GTD_PROVIDER (self), line, &list_name, error);
+  list = g_hash_table_lookup (self->lists, list_name->str);
 
-  if (!task)
-    GTD_RETURN ();
+  if (list)
+    return list;
 
   /*
    * Create the list if it doesn't exist yet; this might happen with todo.txt files
    * that are not saved from GNOME To Do.
    */
-  if (!g_hash_table_contains (self->lists, list_name))
-    {
-      GTD_TRACE_MSG ("Creating new list with name '%s'", list_name);
+  GTD_TRACE_MSG ("Creating new list with name '%s'", list_name->str);
 
-      list = g_object_new (GTD_TYPE_TASK_LIST,
-                           "provider", self,
-                           "name", list_name,
-                           "is-removable", TRUE,
-                           NULL);
+  list = g_object_new (GTD_TYPE_TASK_LIST,
+                       "provider", self,
+                       "name", list_name->str,
+                       "is-removable", TRUE,
+                       NULL);
 
-      add_task_list (self, list);
-    }
-  else
-    {
-      GTD_TRACE_MSG ("List with name '%s' already exists, reusing", list_name);
+  add_task_list (self, list);
 
-      list = g_hash_table_lookup (self->lists, list_name);
-    }
+  return list;
+}
+
+static void
+parsed_line_free (ParsedLine *line)
+{
+  g_clear_object (&line->task);
+  g_free (line);
+}
+
+static ParsedLine*
+parse_line (GtdProviderTodoTxt  *self,
+            const gchar         *line,
+            gsize                length,
+            GString             *list_name,
+            GtdTaskList        **inout_list,
+            GError             **error)
+{
+  const gchar *task_list_name;
+  ParsedLine *parsed_line;
+  GtdTaskList *list;
+  GtdTask *task;
+  gsize task_list_name_length;
+
+  task = gtd_todo_txt_parser_parse_task_span (GTD_PROVIDER (self),
+                                              line,
+                                              length,
+                                              &task_list_name,
+                                              &task_list_name_length,
+                                              error);
 
-  /* Add to the temporary GPtrArray that will be consumed below */
-  if (!g_hash_table_contains (list_to_tasks, list))
-    g_hash_table_insert (list_to_tasks, list, g_ptr_array_new ());
+  if (!task)
+    return NULL;
+
+  /* Consecutive tasks usually belong to the same list, so only look it up when it changes */
+  list = *inout_list;
 
-  tasks = g_hash_table_lookup (list_to_tasks, list);
-  g_ptr_array_add (tasks, task);
+  if (!list ||
+      list_name->len != task_list_name_length ||
+      memcmp (list_name->str, task_list_name, task_list_name_length) != 0)
+    {
+      g_string_truncate (list_name, 0);
+      g_string_append_len (list_name, task_list_name, task_list_name_length);
 
-  gtd_task_set_list (task, list);
-  gtd_task_list_add_task (list, task);
+      list = lookup_or_create_list (self, list_name);
+      *inout_list = list;
+    }
 
-  g_hash_table_insert (self->tasks, (gpointer) gtd_object_get_uid (GTD_OBJECT (task)), task);
-  self->task_counter++;
+  parsed_line = g_new0 (ParsedLine, 1);
+  parsed_line->task = task;
+  parsed_line->list = list;
+  parsed_line->indent = GPOINTER_TO_UINT (g_object_get_data (G_OBJECT (task), "indent"));
+
+  return parsed_line;
 }
 
 struct
@@ -340,104 +601,472 @@ struct
   { GTD_TODO_TXT_LINE_TYPE_LIST_COLORS, "Colors", parse_list_colors_line }
 };
 
-static GPtrArray*
-remove_empty_lines (GStrv lines)
+static gsize
+strip_line (const gchar *line,
+            gsize        length)
+{
+  while (length > 0 && g_ascii_isspace (line[length - 1]))
+    length--;
+
+  return length;
+}
+
+static void
+parse_custom_lines (GtdProviderTodoTxt *self,
+                    const gchar        *contents,
+                    gsize               length,
+                    GHashTable         *seen_lists)
+{
+  const gchar *custom_lines[G_N_ELEMENTS (custom_lines_vtable)] = { NULL, };
+  gsize custom_lines_length[G_N_ELEMENTS (custom_lines_vtable)] = { 0, };
+  const gchar *line_end;
+  guint vtable_len;
+  guint n_found;
+  guint i;
+
+  vtable_len = G_N_ELEMENTS (custom_lines_vtable);
+  line_end = contents + length;
+  n_found = 0;
+
+  /* The custom lines are the last non-empty lines of the file, so walk it backwards */
+  while (line_end > contents && n_found < vtable_len)
+    {
+      const gchar *line_start = line_end;
+      gsize line_length;
+
+      while (line_start > contents && line_start[-1] != '\n')
+        line_start--;
+
+      line_length = strip_line (line_start, line_end - line_start);
+
+      if (line_length > 0)
+        {
+          n_found++;
+          custom_lines[vtable_len - n_found] = line_start;
+          custom_lines_length[vtable_len - n_found] = line_length;
+        }
+
+      line_end = line_start > contents ? line_start - 1 : contents;
+    }
+
+  /* First parse the custom lines at the end of the Todo.txt file, if possible */
+  for (i = 0; n_found == vtable_len && i < vtable_len; i++)
+    {
+      g_autoptr (GError) line_error = NULL;
+      g_autofree gchar *line = NULL;
+      GtdTodoTxtLineType line_type;
+
+      /* Since leading whitespace doesn't matter here, remove them */
+      line = g_strndup (custom_lines[i], custom_lines_length[i]);
+      line = g_strstrip (line);
+
+      line_type = gtd_todo_txt_parser_get_line_type (line, &line_error);
+
+      if (line_error)
+        {
+          g_warning ("Error parsing custom line %u: %s", i, line_error->message);
+          continue;
+        }
+
+      if (custom_lines_vtable[i].type == line_type)
+        custom_lines_vtable[i].parse (self, line, seen_lists, &line_error);
+
+      if (line_error)
+        {
+          g_warning ("Error parsing custom line %u: %s", i, line_error->message);
+          continue;
+        }
+    }
+}
+
+static guint
+line_key_hash (gconstpointer key)
+{
+  const LineKey *line_key = key;
+  guint hash = 5381;
+  gsize i;
+
+  for (i = 0; i < line_key->length; i++)
+    hash = (hash << 5) + hash + line_key->data[i];
+
+  return hash;
+}
+
+static gboolean
+line_key_equal (gconstpointer a,
+                gconstpointer b)
+{
+  const LineKey *key_a = a;
+  const LineKey *key_b = b;
+
+  return key_a->length == key_b->length && memcmp (key_a->data, key_b->data, key_a->length) == 0;
+}
+
+static gboolean
+get_task_line (GtdProviderTodoTxt *self,
+               GtdTask            *task,
+               LineKey            *out_key)
+{
+  LineSpan *span;
+
+  if (!self->contents)
+    return FALSE;
+
+  span = g_hash_table_lookup (self->line_spans, gtd_object_get_uid (GTD_OBJECT (task)));
+
+  if (!span)
+    return FALSE;
+
+  out_key->data = (const gchar *) g_bytes_get_data (self->contents, NULL) + span->offset;
+  out_key->length = strip_line (out_key->data, span->length);
+
+  return TRUE;
+}
+
+/*
+ * Matches the parsed lines of @list to the tasks it already has. Lines
+ * that didn't change match the task they were read from. Then, changed
+ * lines that sit between the same unchanged neighbours as an unmatched
+ * task are assumed to be that task, edited.
+ */
+static void
+match_lines (GtdProviderTodoTxt *self,
+             GPtrArray          *old_tasks,
+             gboolean           *old_matched,
+             GPtrArray          *lines)
 {
-  g_autoptr (GPtrArray) valid_lines = NULL;
-  guint n_lines;
+  g_autoptr (GHashTable) line_to_tasks = NULL;
+  g_autofree LineKey *old_keys = NULL;
+  g_autofree guint *next_anchor = NULL;
+  guint cursor;
   guint i;
 
-  n_lines = g_strv_length (lines);
-  valid_lines = g_ptr_array_sized_new (n_lines);
+  line_to_tasks = g_hash_table_new_full (line_key_hash, line_key_equal, NULL, (GDestroyNotify) g_queue_free);
+  old_keys = g_new0 (LineKey, old_tasks->len);
+
+  for (i = 0; i < old_tasks->len; i++)
+    {
+      GQueue *queue;
+
+      if (!get_task_line (self, g_ptr_array_index (old_tasks, i), &old_keys[i]))
+        continue;
+
+      queue = g_hash_table_lookup (line_to_tasks, &old_keys[i]);
+
+      if (!queue)
+        {
+          queue = g_queue_new ();
+          g_hash_table_insert (line_to_tasks, &old_keys[i], queue);
+        }
+
+      g_queue_push_tail (queue, GUINT_TO_POINTER (i));
+    }
+
+  /* Unchanged lines */
+  for (i = 0; i < lines->len; i++)
+    {
+      ParsedLine *line = g_ptr_array_index (lines, i);
+      LineKey key = { line->line, line->length };
+      GQueue *queue;
+      guint old_index;
+
+      queue = g_hash_table_lookup (line_to_tasks, &key);
+
+      if (!queue || g_queue_is_empty (queue))
+        continue;
+
+      old_index = GPOINTER_TO_UINT (g_queue_pop_head (queue));
 
-  for (i = 0; i < n_lines; i++)
+      line->existing = g_ptr_array_index (old_tasks, old_index);
+      line->old_index = old_index;
+      old_matched[old_index] = TRUE;
+    }
+
+  /* The position in the old list of the next unchanged line */
+  next_anchor = g_new0 (guint, lines->len + 1);
+  next_anchor[lines->len] = old_tasks->len;
+
+  for (i = lines->len; i > 0; i--)
     {
-      gchar *line;
+      ParsedLine *line = g_ptr_array_index (lines, i - 1);
+
+      next_anchor[i - 1] = line->existing ? line->old_index : next_anchor[i];
+    }
+
+  /* Edited lines */
+  cursor = 0;
+
+  for (i = 0; i < lines->len; i++)
+    {
+      ParsedLine *line = g_ptr_array_index (lines, i);
+
+      if (line->existing)
+        {
+          cursor = line->old_index + 1;
+          continue;
+        }
 
-      /*
-       * We can only remove the trailing space here since leading
-       * whitespace determine the indentation and subtasks
-       */
-      line = g_strchomp (lines[i]);
+      while (cursor < next_anchor[i] && old_matched[cursor])
+        cursor++;
 
-      if (!line || line[0] == '\n' || line[0] == '\0')
+      if (cursor >= next_anchor[i])
         continue;
 
-      g_ptr_array_add (valid_lines, lines[i]);
+      line->existing = g_ptr_array_index (old_tasks, cursor);
+      line->old_index = cursor;
+      line->edited = TRUE;
+      old_matched[cursor] = TRUE;
+      cursor++;
     }
+}
+
+static void
+update_task_from_line (GtdTask *task,
+                       GtdTask *parsed_task)
+{
+  g_autoptr (GDateTime) completion_date = NULL;
+  g_autoptr (GDateTime) creation_date = NULL;
+  g_autoptr (GDateTime) due_date = NULL;
+
+  due_date = gtd_task_get_due_date (parsed_task);
+  creation_date = gtd_task_get_creation_date (parsed_task);
+  completion_date = gtd_task_get_completion_date (parsed_task);
+
+  gtd_task_set_title (task, gtd_task_get_title (parsed_task));
+  gtd_task_set_description (task, gtd_task_get_description (parsed_task));
+  gtd_task_set_complete (task, gtd_task_get_complete (parsed_task));
+  gtd_task_set_due_date (task, due_date);
+
+  if (creation_date)
+    gtd_task_set_creation_date (task, creation_date);
 
-  return g_steal_pointer (&valid_lines);
+  if (completion_date)
+    gtd_task_todo_txt_set_completion_date (GTD_TASK_TODO_TXT (task), completion_date);
 }
 
 static void
-resolve_subtasks (GtdProviderTodoTxt *self,
-                  GHashTable         *list_to_tasks)
+remove_task (GtdProviderTodoTxt *self,
+             GtdTaskList        *list,
+             GtdTask            *task)
 {
-  GtdTaskList *list;
-  GPtrArray *tasks;
-  GHashTableIter iter;
+  GtdTask *parent;
+
+  /* Subtasks are removed before their parents, so @task is a leaf by now */
+  parent = gtd_task_get_parent (task);
+
+  if (parent)
+    gtd_task_remove_subtask (parent, task);
+
+  g_hash_table_remove (self->line_spans, gtd_object_get_uid (GTD_OBJECT (task)));
+  g_hash_table_remove (self->tasks, gtd_object_get_uid (GTD_OBJECT (task)));
+
+  gtd_task_list_remove_task (list, task);
+}
+
+/*
+ * Applies the parsed lines of @list to it, reusing the tasks that are
+ * already there, so that only tasks that actually changed are added,
+ * removed or updated.
+ */
+static void
+reconcile_list (GtdProviderTodoTxt *self,
+                GtdTaskList        *list,
+                GPtrArray          *lines,
+                const gchar        *contents,
+                GHashTable         *line_spans)
+{
+  g_autoptr (GPtrArray) new_tasks = NULL;
+  g_autoptr (GPtrArray) old_tasks = NULL;
+  g_autoptr (GPtrArray) parents = NULL;
+  g_autofree gboolean *old_matched = NULL;
   GQueue tasks_stack;
+  guint previous_indent;
+  guint n_items;
+  guint i;
+
+  GTD_ENTRY;
+
+  GTD_TRACE_MSG ("Setting up tasklist '%s'", gtd_task_list_get_name (list));
 
+  n_items = g_list_model_get_n_items (G_LIST_MODEL (list));
+  old_tasks = g_ptr_array_new_full (n_items, g_object_unref);
+  old_matched = g_new0 (gboolean, n_items);
+
+  for (i = 0; i < n_items; i++)
+    g_ptr_array_add (old_tasks, g_list_model_get_item (G_LIST_MODEL (list), i));
+
+  match_lines (self, old_tasks, old_matched, lines);
+
+  /* Figure out the parent of each task from the indentation */
+  parents = g_ptr_array_sized_new (lines->len);
+  previous_indent = 0;
   g_queue_init (&tasks_stack);
-  g_hash_table_iter_init (&iter, list_to_tasks);
 
-  while (g_hash_table_iter_next (&iter, (gpointer) &list, (gpointer) &tasks))
+  for (i = 0; i < lines->len; i++)
     {
-      gint64 previous_indent;
-      guint i;
+      ParsedLine *line = g_ptr_array_index (lines, i);
+      GtdTask *task = line->existing ? line->existing : line->task;
+      gint64 j;
 
-      previous_indent = 0;
+      /* If the indent changed, remove from the difference in level from stack */
+      for (j = 0; j <= (gint64) previous_indent - line->indent; j++)
+        g_queue_pop_head (&tasks_stack);
 
-      GTD_TRACE_MSG ("Setting up tasklist '%s'", gtd_task_list_get_name (list));
+      g_ptr_array_add (parents, g_queue_peek_head (&tasks_stack));
+      g_queue_push_head (&tasks_stack, task);
 
-      for (i = 0; tasks && i < tasks->len; i++)
-        {
-          GtdTask *parent_task;
-          GtdTask *task;
-          guint indent;
-          guint j;
+      previous_indent = line->indent;
+    }
+
+  g_queue_clear (&tasks_stack);
+
+  /* Detach the tasks that are kept from parents that change or go away */
+  for (i = 0; i < lines->len; i++)
+    {
+      ParsedLine *line = g_ptr_array_index (lines, i);
+      GtdTask *parent;
+
+      if (!line->existing)
+        continue;
 
-          task = g_ptr_array_index (tasks, i);
-          parent_task = NULL;
-          indent = GPOINTER_TO_INT (g_object_get_data (G_OBJECT (task), "indent"));
+      parent = gtd_task_get_parent (line->existing);
 
-          GTD_TRACE_MSG ("  Adding task '%s' (%s)",
-                         gtd_task_get_title (task),
-                         gtd_object_get_uid (GTD_OBJECT (task)));
+      if (parent && parent != g_ptr_array_index (parents, i))
+        gtd_task_remove_subtask (parent, line->existing);
+    }
 
-          /* If the indent changed, remove from the difference in level from stack */
-          for (j = 0; j <= previous_indent - indent; j++)
-            g_queue_pop_head (&tasks_stack);
+  /* Remove the tasks that are gone, subtasks first */
+  for (i = old_tasks->len; i > 0; i--)
+    {
+      if (old_matched[i - 1])
+        continue;
 
-          parent_task = g_queue_peek_head (&tasks_stack);
+      GTD_TRACE_MSG ("  Removing task '%s'", gtd_task_get_title (g_ptr_array_index (old_tasks, i - 1)));
 
-          if (parent_task)
-            gtd_task_add_subtask (parent_task, task);
+      remove_task (self, list, g_ptr_array_index (old_tasks, i - 1));
+    }
 
-          gtd_task_set_list (task, list);
-          gtd_task_list_add_task (list, task);
+  /* Update the tasks that are kept, sorting the list only once */
+  gtd_task_list_freeze (list);
 
-          g_queue_push_head (&tasks_stack, task);
+  for (i = 0; i < lines->len; i++)
+    {
+      ParsedLine *line = g_ptr_array_index (lines, i);
+      GtdTask *parent;
 
-          previous_indent = indent;
+      if (!line->existing)
+        continue;
+
+      if (line->edited)
+        {
+          GTD_TRACE_MSG ("  Updating task '%s'", gtd_task_get_title (line->existing));
+
+          update_task_from_line (line->existing, line->task);
         }
 
-      /* Clear the queue since we're changing projects */
-      g_queue_clear (&tasks_stack);
+      /* Subtasks of new tasks are only moved after these are added, below */
+      parent = g_ptr_array_index (parents, i);
+
+      if (parent && gtd_task_get_parent (line->existing) != parent && gtd_task_list_contains (list, parent))
+        gtd_task_add_subtask (parent, line->existing);
+
+      gtd_task_set_position (line->existing, i);
+    }
+
+  gtd_task_list_thaw (list);
+
+  /* And finally add the new tasks */
+  new_tasks = g_ptr_array_new ();
+
+  for (i = 0; i < lines->len; i++)
+    {
+      ParsedLine *line = g_ptr_array_index (lines, i);
+      GtdTask *parent;
+
+      if (line->existing)
+        continue;
+
+      GTD_TRACE_MSG ("  Adding task '%s'", gtd_task_get_title (line->task));
+
+      parent = g_ptr_array_index (parents, i);
+
+      if (parent)
+        gtd_task_add_subtask (parent, line->task);
+
+      gtd_task_set_list (line->task, list);
+      gtd_task_set_position (line->task, i);
+
+      g_hash_table_insert (self->tasks, (gpointer) gtd_object_get_uid (GTD_OBJECT (line->task)), line->task);
+      g_ptr_array_add (new_tasks, line->task);
+    }
+
+  gtd_task_list_add_tasks (list, new_tasks);
+
+  for (i = 0; i < lines->len; i++)
+    {
+      ParsedLine *line = g_ptr_array_index (lines, i);
+      GtdTask *parent = g_ptr_array_index (parents, i);
+
+      if (line->existing && parent && gtd_task_get_parent (line->existing) != parent)
+        gtd_task_add_subtask (parent, line->existing);
+    }
+
+  /* Remember where each task is in the file */
+  for (i = 0; i < lines->len; i++)
+    {
+      ParsedLine *line = g_ptr_array_index (lines, i);
+      GtdTask *task = line->existing ? line->existing : line->task;
+      LineSpan *span;
+
+      if (!line->terminated)
+        continue;
+
+      span = g_new0 (LineSpan, 1);
+      span->offset = line->line - contents;
+      span->length = line->length_with_newline;
+
+      g_hash_table_insert (line_spans, g_strdup (gtd_object_get_uid (GTD_OBJECT (task))), span);
     }
+
+  GTD_EXIT;
+}
+
+static void
+remove_list (GtdProviderTodoTxt *self,
+             GtdTaskList        *list)
+{
+  GTD_TRACE_MSG ("Removing tasklist '%s'", gtd_task_list_get_name (list));
+
+  g_hash_table_remove (self->lists, gtd_task_list_get_name (list));
+  g_ptr_array_remove (self->cache, list);
+  self->task_lists = g_list_remove (self->task_lists, list);
+
+  g_signal_emit_by_name (self, "list-removed", list);
 }
 
+/*
+ * Loads the file and applies it to the current lists and tasks. On the
+ * first load, everything is added; afterwards, only the tasks and lists
+ * that changed are touched, so that the UI keeps its state.
+ */
 static void
 reload_tasks (GtdProviderTodoTxt *self)
 {
-  g_autoptr (GHashTable) list_to_tasks = NULL;
+  g_autoptr (GHashTable) list_to_lines = NULL;
+  g_autoptr (GHashTable) line_spans = NULL;
+  g_autoptr (GHashTable) seen_lists = NULL;
+  g_autoptr (GBytes) new_contents = NULL;
+  g_autoptr (GMappedFile) mapped_file = NULL;
+  g_autoptr (GPtrArray) old_lists = NULL;
+  g_autoptr (GString) list_name = NULL;
   g_autofree gchar *input_path = NULL;
-  g_autofree gchar *file_contents = NULL;
-  g_autoptr (GPtrArray) valid_lines = NULL;
   g_autoptr (GError) error = NULL;
-  g_auto (GStrv) lines = NULL;
-  guint vtable_len;
-  guint n_lines;
+  GtdTaskList *current_list;
+  const gchar *contents;
+  const gchar *line;
+  const gchar *end;
+  gsize length;
+  guint line_number;
   guint i;
 
   GTD_ENTRY;
@@ -446,114 +1075,148 @@ reload_tasks (GtdProviderTodoTxt *self)
 
   g_debug ("Reading the contents of %s", input_path);
 
-  g_file_get_contents (input_path, &file_contents, NULL, &error);
+  mapped_file = g_mapped_file_new (input_path, FALSE, &error);
 
   if (error)
     {
       g_warning ("Error reading Todo.txt file: %s", error->message);
-      return;
+      GTD_RETURN ();
     }
 
-  self->task_counter = 0;
+  contents = g_mapped_file_get_contents (mapped_file);
+  length = g_mapped_file_get_length (mapped_file);
 
-  if (g_str_equal (file_contents, ""))
-    return;
-
-  lines = g_strsplit (file_contents, "\n", -1);
-  valid_lines = remove_empty_lines (lines);
-  n_lines = valid_lines->len;
-  vtable_len = G_N_ELEMENTS (custom_lines_vtable);
-
-  /* First parse the custom lines at the end of the Todo.txt file, if possible */
-  for (i = 0; n_lines >= vtable_len && i < vtable_len; i++)
+  /* Nothing to do if the file is what we have, e.g. when it's our own write */
+  if (self->contents &&
+      g_bytes_get_size (self->contents) == length &&
+      (length == 0 || memcmp (g_bytes_get_data (self->contents, NULL), contents, length) == 0))
     {
-      g_autoptr (GError) line_error = NULL;
-      GtdTodoTxtLineType line_type;
-      gchar *line;
-      guint line_number;
-
-      line_number = n_lines - vtable_len + i;
-      line = g_ptr_array_index (valid_lines, line_number);
-
-      /* Since leading whitespace doesn't matter here, remove them */
-      line = g_strstrip (line);
+      GTD_TRACE_MSG ("Contents didn't change, ignoring");
+      GTD_RETURN ();
+    }
 
-      line_type = gtd_todo_txt_parser_get_line_type (line, &line_error);
+  /*
+   * Keep a copy of the contents for the spans. The mapping itself is not
+   * kept around, since other programs may truncate the file under it.
+   */
+  new_contents = g_bytes_new (contents, length);
+  contents = g_bytes_get_data (new_contents, NULL);
+  g_clear_pointer (&mapped_file, g_mapped_file_unref);
 
-      if (line_error)
-        {
-          g_warning ("Error parsing custom line %d: %s", line_number, line_error->message);
-          continue;
-        }
+  old_lists = g_ptr_array_new ();
+  for (i = 0; i < self->cache->len; i++)
+    g_ptr_array_add (old_lists, g_ptr_array_index (self->cache, i));
 
-      if (custom_lines_vtable[i].type == line_type)
-        custom_lines_vtable[i].parse (self, line, &line_error);
+  seen_lists = g_hash_table_new (g_direct_hash, g_direct_equal);
 
-      if (line_error)
-        {
-          g_warning ("Error parsing custom line %d: %s", line_number, line_error->message);
-          continue;
-        }
-    }
+  parse_custom_lines (self, contents, length, seen_lists);
 
-  /* First, create all the tasks and store them temporarily in a GPtrArray */
-  list_to_tasks = g_hash_table_new_full (g_direct_hash,
+  /* Parse the task lines straight from the mapped file, grouped by list */
+  list_to_lines = g_hash_table_new_full (g_direct_hash,
                                          g_direct_equal,
                                          NULL,
                                          (GDestroyNotify) g_ptr_array_unref);
 
-  /* Then regular task lines */
-  for (i = 0; i < n_lines - vtable_len; i++)
+  list_name = g_string_new ("");
+  current_list = NULL;
+  line_number = 0;
+  line = contents;
+  end = contents + length;
+
+  while (line < end)
     {
       g_autoptr (GError) line_error = NULL;
-      GtdTodoTxtLineType line_type;
-      gchar *line;
+      ParsedLine *parsed_line;
+      const gchar *line_end;
+      gsize line_length;
+      GPtrArray *lines;
 
-      line = g_ptr_array_index (valid_lines, i);
+      line_end = memchr (line, '\n', end - line);
+      if (!line_end)
+        line_end = end;
 
-      /* Last element of the array is NULL */
-      if (!line || line[0] == '\0')
-        break;
+      line_number++;
+      line_length = strip_line (line, line_end - line);
 
-      GTD_TRACE_MSG ("Parsing line %d: %s", i, line);
+      /* The custom lines are skipped here, since they're hidden */
+      parsed_line = NULL;
+      if (line_length > 0)
+        {
+          GTD_TRACE_MSG ("Parsing line %u: %.*s", line_number, (gint) line_length, line);
 
-      line_type = gtd_todo_txt_parser_get_line_type (line, &line_error);
+          parsed_line = parse_line (self, line, line_length, list_name, &current_list, &line_error);
+        }
 
       if (line_error)
+        g_warning ("Error parsing line %u: %s", line_number, line_error->message);
+
+      if (parsed_line)
         {
-          g_warning ("Error parsing line %d: %s", i + 1, line_error->message);
-          continue;
+          parsed_line->line = line;
+          parsed_line->length = line_length;
+          parsed_line->length_with_newline = line_end + 1 - line;
+          parsed_line->terminated = line_end < end;
+
+          lines = g_hash_table_lookup (list_to_lines, parsed_line->list);
+
+          if (!lines)
+            {
+              lines = g_ptr_array_new_with_free_func ((GDestroyNotify) parsed_line_free);
+              g_hash_table_insert (list_to_lines, parsed_line->list, lines);
+            }
+
+          g_ptr_array_add (lines, parsed_line);
+          g_hash_table_add (seen_lists, parsed_line->list);
         }
 
-      switch (line_type)
-        {
-        case GTD_TODO_TXT_LINE_TYPE_TASKLIST:
-          break;
+      line = line_end + 1;
+    }
 
-        case GTD_TODO_TXT_LINE_TYPE_TASK:
-          parse_task (self, line, list_to_tasks, &line_error);
-          break;
+  /* The spans of the old contents are still needed to match the lines */
+  line_spans = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+  self->task_counter = 0;
 
-        case GTD_TODO_TXT_LINE_TYPE_LIST_COLORS:
-          break;
+  for (i = 0; i < self->cache->len; i++)
+    {
+      g_autoptr (GPtrArray) empty_lines = NULL;
+      GtdTaskList *list;
+      GPtrArray *lines;
 
-        case GTD_TODO_TXT_LINE_TYPE_UNKNOWN:
-          break;
+      list = g_ptr_array_index (self->cache, i);
+      lines = g_hash_table_lookup (list_to_lines, list);
 
-        default:
-          break;
-        }
+      if (!lines)
+        lines = empty_lines = g_ptr_array_new ();
 
-      if (line_error)
-        g_warning ("Error parsing line %d: %s", i + 1, line_error->message);
+      reconcile_list (self, list, lines, contents, line_spans);
+
+      self->task_counter += lines->len;
     }
 
-  /*
-   * Now that all the tasks are created and properly stored in a GPtrArray,
-   * we have to go through each GPtrArray, sort it, and figure out the parent
-   * and children relationship between the tasks.
-   */
-  resolve_subtasks (self, list_to_tasks);
+  g_clear_pointer (&self->line_spans, g_hash_table_destroy);
+  self->line_spans = g_steal_pointer (&line_spans);
+
+  g_clear_pointer (&self->contents, g_bytes_unref);
+  self->contents = g_steal_pointer (&new_contents);
+
+  /* Lists that are not in the file anymore */
+  for (i = 0; i < old_lists->len; i++)
+    {
+      GtdTaskList *list = g_ptr_array_index (old_lists, i);
+
+      /* Its tasks were removed while reconciling it above */
+      if (!g_hash_table_contains (seen_lists, list))
+        remove_list (self, list);
+    }
+
+  /* And lists that are new */
+  for (i = 0; i < self->cache->len; i++)
+    {
+      GtdTaskList *list = g_ptr_array_index (self->cache, i);
+
+      if (!g_ptr_array_find (old_lists, list, NULL))
+        g_signal_emit_by_name (self, "list-added", list);
+    }
 
   GTD_EXIT;
 }
@@ -587,43 +1250,56 @@ setup_file_monitor (GtdProviderTodoTxt *self)
  */
 
 static void
-on_file_monitor_changed_cb (GFileMonitor       *monitor,
-                            GFile              *first,
-                            GFile              *second,
-                            GFileMonitorEvent   event,
-                            GtdProviderTodoTxt *self)
+on_source_saved_cb (GObject      *source_object,
+                    GAsyncResult *result,
+                    gpointer      user_data)
 {
-  GList *l = NULL;
-  guint i;
-
-  if (!self->should_reload)
-    {
-      self->should_reload = TRUE;
-      return;
-    }
+  g_autoptr (GError) error = NULL;
+  GtdProviderTodoTxt *self;
 
-  g_clear_pointer (&self->lists, g_hash_table_destroy);
-  g_clear_pointer (&self->tasks, g_hash_table_destroy);
-  g_ptr_array_free (self->cache, TRUE);
+  self = GTD_PROVIDER_TODO_TXT (source_object);
+  self->saving = FALSE;
 
-  for (l = self->task_lists; l != NULL; l = l->next)
-    g_signal_emit_by_name (self, "list-removed", l->data);
+  if (!g_task_propagate_boolean (G_TASK (result), &error))
+    g_warning ("Error saving Todo.txt file: %s", error->message);
 
-  g_list_free (self->task_lists);
+  if (self->save_pending)
+    update_source (self);
+}
 
-  self->task_lists = NULL;
-  self->lists = g_hash_table_new ((GHashFunc) g_str_hash, (GEqualFunc) g_str_equal);
-  self->tasks = g_hash_table_new ((GHashFunc) g_str_hash, (GEqualFunc) g_str_equal);
-  self->cache = g_ptr_array_new ();
+static gboolean
+reload_timeout_cb (gpointer user_data)
+{
+  GtdProviderTodoTxt *self = GTD_PROVIDER_TODO_TXT (user_data);
 
-  reload_tasks (self);
+  self->reload_timeout_id = 0;
 
-  for (i = 0; i < self->cache->len; i++)
+  /*
+   * Local changes that are still being saved would overwrite the file
+   * anyway. Our own writes are ignored by reload_tasks(), since the
+   * contents are the same.
+   */
+  if (self->saving || self->save_pending || self->save_timeout_id > 0)
     {
-      GtdTaskList *list;
-      list = g_ptr_array_index (self->cache, i);
-      g_signal_emit_by_name (self, "list-added", list);
+      GTD_TRACE_MSG ("Local changes pending, not reloading");
+      return G_SOURCE_REMOVE;
     }
+
+  reload_tasks (self);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+on_file_monitor_changed_cb (GFileMonitor       *monitor,
+                            GFile              *first,
+                            GFile              *second,
+                            GFileMonitorEvent   event,
+                            GtdProviderTodoTxt *self)
+{
+  /* Editors usually emit a burst of events per save, so only reload once they settle */
+  g_clear_handle_id (&self->reload_timeout_id, g_source_remove);
+  self->reload_timeout_id = g_timeout_add (RELOAD_TIMEOUT_MS, reload_timeout_cb, self);
 }
 
 
@@ -670,49 +1346,157 @@ gtd_provider_todo_txt_get_icon (GtdProvider *provider)
 }
 
 static void
-gtd_provider_todo_txt_create_task (GtdProvider *provider,
-                                   GtdTaskList *list,
-                                   const gchar *title,
-                                   GDateTime   *due_date)
+gtd_provider_todo_txt_create_task (GtdProvider         *provider,
+                                   GtdTaskList         *list,
+                                   const gchar         *title,
+                                   GDateTime           *due_date,
+                                   GCancellable        *cancellable,
+                                   GAsyncReadyCallback  callback,
+                                   gpointer             user_data)
 {
-  GtdProviderTodoTxt *self;
+  g_autoptr (GDateTime) creation_date = NULL;
   g_autoptr (GtdTask) new_task = NULL;
+  g_autoptr (GTask) task = NULL;
+  GtdProviderTodoTxt *self;
 
   self = GTD_PROVIDER_TODO_TXT (provider);
+  creation_date = g_date_time_new_now_local ();
 
   /* Create the new task */
   new_task = GTD_TASK (gtd_provider_todo_txt_generate_task (self));
   gtd_task_set_due_date (new_task, due_date);
   gtd_task_set_list (new_task, list);
   gtd_task_set_title (new_task, title);
-  gtd_task_set_creation_date (new_task, g_date_time_new_now_local ());
+  gtd_task_set_creation_date (new_task, creation_date);
 
   gtd_task_list_add_task (list, new_task);
 
-  update_source (GTD_PROVIDER_TODO_TXT (provider));
+  schedule_update_source (self);
+
+  task = g_task_new (provider, cancellable, callback, user_data);
+  g_task_set_source_tag (task, gtd_provider_todo_txt_create_task);
+  g_task_return_pointer (task, g_object_ref (new_task), g_object_unref);
+}
+
+static GtdTask*
+gtd_provider_todo_txt_create_task_finish (GtdProvider   *provider,
+                                          GAsyncResult  *result,
+                                          GError       **error)
+{
+  g_autoptr (GtdTask) new_task = NULL;
+
+  /* The list holds the reference to the new task */
+  new_task = g_task_propagate_pointer (G_TASK (result), error);
+
+  return new_task;
 }
 
 static void
-gtd_provider_todo_txt_update_task (GtdProvider *provider,
-                                   GtdTask     *task)
+gtd_provider_todo_txt_update_task (GtdProvider         *provider,
+                                   GtdTask             *task,
+                                   GCancellable        *cancellable,
+                                   GAsyncReadyCallback  callback,
+                                   gpointer             user_data)
 {
-  update_source (GTD_PROVIDER_TODO_TXT (provider));
+  GtdProviderTodoTxt *self;
+  g_autoptr (GTask) gtask = NULL;
+
+  self = GTD_PROVIDER_TODO_TXT (provider);
+
+  invalidate_task_line (self, task);
+  schedule_update_source (self);
+
+  gtd_task_list_update_task (gtd_task_get_list (task), task);
+
+  gtask = g_task_new (provider, cancellable, callback, user_data);
+  g_task_set_source_tag (gtask, gtd_provider_todo_txt_update_task);
+  g_task_return_boolean (gtask, TRUE);
+}
+
+static gboolean
+gtd_provider_todo_txt_update_task_finish (GtdProvider   *provider,
+                                          GAsyncResult  *result,
+                                          GError       **error)
+{
+  return g_task_propagate_boolean (G_TASK (result), error);
+}
+
+static void
+gtd_provider_todo_txt_update_tasks (GtdProvider         *provider,
+                                    GPtrArray           *tasks,
+                                    GCancellable        *cancellable,
+                                    GAsyncReadyCallback  callback,
+                                    gpointer             user_data)
+{
+  GtdProviderTodoTxt *self;
+  g_autoptr (GTask) gtask = NULL;
+  guint i;
+
+  self = GTD_PROVIDER_TODO_TXT (provider);
+
+  for (i = 0; i < tasks->len; i++)
+    {
+      GtdTask *task = g_ptr_array_index (tasks, i);
+
+      invalidate_task_line (self, task);
+      gtd_task_list_update_task (gtd_task_get_list (task), task);
+    }
+
+  /* Writes are coalesced, so all tasks end up in a single write */
+  schedule_update_source (self);
+
+  gtask = g_task_new (provider, cancellable, callback, user_data);
+  g_task_set_source_tag (gtask, gtd_provider_todo_txt_update_tasks);
+  g_task_return_boolean (gtask, TRUE);
+}
+
+static gboolean
+gtd_provider_todo_txt_update_tasks_finish (GtdProvider   *provider,
+                                           GAsyncResult  *result,
+                                           GError       **error)
+{
+  return g_task_propagate_boolean (G_TASK (result), error);
 }
 
 static void
-gtd_provider_todo_txt_remove_task (GtdProvider *provider,
-                                   GtdTask     *task)
+gtd_provider_todo_txt_remove_task (GtdProvider         *provider,
+                                   GtdTask             *task,
+                                   GCancellable        *cancellable,
+                                   GAsyncReadyCallback  callback,
+                                   gpointer             user_data)
 {
+  GtdProviderTodoTxt *self;
+  g_autoptr (GTask) gtask = NULL;
+
+  self = GTD_PROVIDER_TODO_TXT (provider);
+
+  invalidate_task_line (self, task);
   gtd_task_list_remove_task (gtd_task_get_list (task), task);
 
-  update_source (GTD_PROVIDER_TODO_TXT (provider));
+  schedule_update_source (self);
+
+  gtask = g_task_new (provider, cancellable, callback, user_data);
+  g_task_set_source_tag (gtask, gtd_provider_todo_txt_remove_task);
+  g_task_return_boolean (gtask, TRUE);
+}
+
+static gboolean
+gtd_provider_todo_txt_remove_task_finish (GtdProvider   *provider,
+                                          GAsyncResult  *result,
+                                          GError       **error)
+{
+  return g_task_propagate_boolean (G_TASK (result), error);
 }
 
 static void
-gtd_provider_todo_txt_create_task_list (GtdProvider *provider,
-                                        const gchar *name)
+gtd_provider_todo_txt_create_task_list (GtdProvider         *provider,
+                                        const gchar         *name,
+                                        GCancellable        *cancellable,
+                                        GAsyncReadyCallback  callback,
+                                        gpointer             user_data)
 {
   GtdProviderTodoTxt *self;
+  g_autoptr (GTask) task = NULL;
   GtdTaskList *new_list;
 
   self = GTD_PROVIDER_TODO_TXT (provider);
@@ -725,38 +1509,86 @@ gtd_provider_todo_txt_create_task_list (GtdProvider *provider,
   g_ptr_array_add (self->cache, new_list);
   g_hash_table_insert (self->lists, g_strdup (name), new_list);
 
-  update_source (self);
+  schedule_update_source (self);
 
   g_signal_emit_by_name (provider, "list-added", new_list);
+
+  task = g_task_new (provider, cancellable, callback, user_data);
+  g_task_set_source_tag (task, gtd_provider_todo_txt_create_task_list);
+  g_task_return_boolean (task, TRUE);
+}
+
+static gboolean
+gtd_provider_todo_txt_create_task_list_finish (GtdProvider   *provider,
+                                               GAsyncResult  *result,
+                                               GError       **error)
+{
+  return g_task_propagate_boolean (G_TASK (result), error);
 }
 
 static void
-gtd_provider_todo_txt_update_task_list (GtdProvider *provider,
-                                        GtdTaskList *list)
+gtd_provider_todo_txt_update_task_list (GtdProvider         *provider,
+                                        GtdTaskList         *list,
+                                        GCancellable        *cancellable,
+                                        GAsyncReadyCallback  callback,
+                                        gpointer             user_data)
 {
   GtdProviderTodoTxt *self;
+  g_autoptr (GTask) task = NULL;
 
   self = GTD_PROVIDER_TODO_TXT (provider);
 
   g_return_if_fail (GTD_IS_TASK_LIST (list));
 
-  update_source (self);
+  /* Each task line contains the name of its list */
+  invalidate_task_list_lines (self, list);
+  schedule_update_source (self);
 
   g_signal_emit_by_name (provider, "list-changed", list);
+
+  task = g_task_new (provider, cancellable, callback, user_data);
+  g_task_set_source_tag (task, gtd_provider_todo_txt_update_task_list);
+  g_task_return_boolean (task, TRUE);
+}
+
+static gboolean
+gtd_provider_todo_txt_update_task_list_finish (GtdProvider   *provider,
+                                               GAsyncResult  *result,
+                                               GError       **error)
+{
+  return g_task_propagate_boolean (G_TASK (result), error);
 }
 
 static void
-gtd_provider_todo_txt_remove_task_list (GtdProvider *provider,
-                                        GtdTaskList *list)
+gtd_provider_todo_txt_remove_task_list (GtdProvider         *provider,
+                                        GtdTaskList         *list,
+                                        GCancellable        *cancellable,
+                                        GAsyncReadyCallback  callback,
+                                        gpointer             user_data)
 {
-  GtdProviderTodoTxt *self = GTD_PROVIDER_TODO_TXT (provider);
+  GtdProviderTodoTxt *self;
+  g_autoptr (GTask) task = NULL;
+
+  self = GTD_PROVIDER_TODO_TXT (provider);
 
   g_ptr_array_remove (self->cache, list);
   self->task_lists = g_list_remove (self->task_lists, list);
 
-  update_source (self);
+  schedule_update_source (self);
 
   g_signal_emit_by_name (provider, "list-removed", list);
+
+  task = g_task_new (provider, cancellable, callback, user_data);
+  g_task_set_source_tag (task, gtd_provider_todo_txt_remove_task_list);
+  g_task_return_boolean (task, TRUE);
+}
+
+static gboolean
+gtd_provider_todo_txt_remove_task_list_finish (GtdProvider   *provider,
+                                               GAsyncResult  *result,
+                                               GError       **error)
+{
+  return g_task_propagate_boolean (G_TASK (result), error);
 }
 
 static GList*
@@ -768,18 +1600,12 @@ gtd_provider_todo_txt_get_task_lists (GtdProvider *provider)
 }
 
 static GtdTaskList*
-gtd_provider_todo_txt_get_default_task_list (GtdProvider *provider)
+gtd_provider_todo_txt_get_inbox (GtdProvider *provider)
 {
+  /* Todo.txt files have no notion of an inbox */
   return NULL;
 }
 
-static void
-gtd_provider_todo_txt_set_default_task_list (GtdProvider *provider,
-                                             GtdTaskList *list)
-{
-  /* FIXME: implement me */
-}
-
 static void
 gtd_provider_iface_init (GtdProviderInterface *iface)
 {
@@ -790,17 +1616,23 @@ gtd_provider_iface_init (GtdProviderInterface *iface)
   iface->get_enabled = gtd_provider_todo_txt_get_enabled;
   iface->get_icon = gtd_provider_todo_txt_get_icon;
   iface->create_task = gtd_provider_todo_txt_create_task;
+  iface->create_task_finish = gtd_provider_todo_txt_create_task_finish;
   iface->update_task = gtd_provider_todo_txt_update_task;
+  iface->update_task_finish = gtd_provider_todo_txt_update_task_finish;
+  iface->update_tasks = gtd_provider_todo_txt_update_tasks;
+  iface->update_tasks_finish = gtd_provider_todo_txt_update_tasks_finish;
   iface->remove_task = gtd_provider_todo_txt_remove_task;
+  iface->remove_task_finish = gtd_provider_todo_txt_remove_task_finish;
   iface->create_task_list = gtd_provider_todo_txt_create_task_list;
+  iface->create_task_list_finish = gtd_provider_todo_txt_create_task_list_finish;
   iface->update_task_list = gtd_provider_todo_txt_update_task_list;
+  iface->update_task_list_finish = gtd_provider_todo_txt_update_task_list_finish;
   iface->remove_task_list = gtd_provider_todo_txt_remove_task_list;
+  iface->remove_task_list_finish = gtd_provider_todo_txt_remove_task_list_finish;
   iface->get_task_lists = gtd_provider_todo_txt_get_task_lists;
-  iface->get_default_task_list = gtd_provider_todo_txt_get_default_task_list;
-  iface->set_default_task_list = gtd_provider_todo_txt_set_default_task_list;
+  iface->get_inbox = gtd_provider_todo_txt_get_inbox;
 }
 
-
 /*
  * GObject overrides
  */
@@ -810,6 +1642,21 @@ gtd_provider_todo_txt_finalize (GObject *object)
 {
   GtdProviderTodoTxt *self = (GtdProviderTodoTxt *)object;
 
+  g_clear_handle_id (&self->reload_timeout_id, g_source_remove);
+
+  if (self->monitor)
+    {
+      g_signal_handlers_disconnect_by_func (self->monitor, on_file_monitor_changed_cb, self);
+      g_file_monitor_cancel (self->monitor);
+    }
+
+  g_clear_object (&self->monitor);
+
+  /* Write out edits that are still waiting for the save timeout */
+  flush_update_source (self);
+
+  g_clear_pointer (&self->contents, g_bytes_unref);
+  g_clear_pointer (&self->line_spans, g_hash_table_destroy);
   g_clear_pointer (&self->lists, g_hash_table_destroy);
   g_clear_pointer (&self->tasks, g_hash_table_destroy);
   g_ptr_array_free (self->cache, TRUE);
@@ -900,7 +1747,6 @@ gtd_provider_todo_txt_class_init (GtdProviderTodoTxtClass *klass)
                                                         G_TYPE_FILE,
                                                         G_PARAM_READWRITE | G_PARAM_CONSTRUCT_ONLY));
 
-  g_object_class_override_property (object_class, PROP_DEFAULT_TASKLIST, "default-task-list");
   g_object_class_override_property (object_class, PROP_DESCRIPTION, "description");
   g_object_class_override_property (object_class, PROP_ENABLED, "enabled");
   g_object_class_override_property (object_class, PROP_ICON, "icon");
@@ -915,7 +1761,7 @@ gtd_provider_todo_txt_init (GtdProviderTodoTxt *self)
   self->lists = g_hash_table_new (g_str_hash, g_str_equal);
   self->tasks = g_hash_table_new (g_str_hash, g_str_equal);
   self->cache = g_ptr_array_new ();
-  self->should_reload = TRUE;
+  self->line_spans = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
   self->icon = G_ICON (g_themed_icon_new_with_default_fallbacks ("computer-symbolic"));
 }
 
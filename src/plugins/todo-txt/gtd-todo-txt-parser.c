@@ -23,6 +23,7 @@
 #include "gtd-provider-todo-txt.h"
 
 #include <glib/gi18n.h>
+#include <string.h>
 
 
 G_DEFINE_QUARK (GtdTodoTxtParserError, gtd_todo_txt_parser_error)
@@ -49,6 +50,15 @@ typedef struct
   gboolean            in_description;
 } GtdTodoTxtParserState;
 
+/* A token, or any other region, of a line, without copying it */
+typedef struct
+{
+  const gchar        *start;
+  gsize               length;
+} Span;
+
+#define SPAN_END(span) ((span)->start + (span)->length)
+
 
 static GDateTime*
 parse_date (const gchar *token)
@@ -200,6 +210,178 @@ tokenize_line (const gchar *line,
   return tokens;
 }
 
+static inline gboolean
+span_equal (const Span  *span,
+            const gchar *str,
+            gsize        str_length)
+{
+  return span->length == str_length && memcmp (span->start, str, str_length) == 0;
+}
+
+static inline gboolean
+span_has_prefix (const Span  *span,
+                 const gchar *prefix,
+                 gsize        prefix_length)
+{
+  return span->length >= prefix_length && memcmp (span->start, prefix, prefix_length) == 0;
+}
+
+static inline gboolean
+span_has_suffix_char (const Span *span,
+                      gchar       c)
+{
+  return span->length > 0 && span->start[span->length - 1] == c;
+}
+
+static inline gboolean
+next_token (const gchar **cursor,
+            const gchar  *end,
+            Span         *token)
+{
+  const gchar *p = *cursor;
+
+  while (p < end && (*p == ' ' || *p == '\t'))
+    p++;
+
+  if (p == end)
+    return FALSE;
+
+  token->start = p;
+
+  while (p < end && *p != ' ' && *p != '\t')
+    p++;
+
+  token->length = p - token->start;
+  *cursor = p;
+
+  return TRUE;
+}
+
+static inline gint
+parse_digits (const gchar *str,
+              guint        n_digits)
+{
+  gint value = 0;
+  guint i;
+
+  for (i = 0; i < n_digits; i++)
+    {
+      if (!g_ascii_isdigit (str[i]))
+        return -1;
+
+      value = value * 10 + (str[i] - '0');
+    }
+
+  return value;
+}
+
+/*
+ * Parses a date without copying it. GNOME To Do always writes dates as
+ * YYYY-MM-DD, so that is parsed directly; anything else goes through
+ * g_date_set_parse(), like parse_date() does.
+ */
+static gboolean
+parse_date_span (const Span *span,
+                 GDate      *out_date)
+{
+  gchar buffer[64];
+
+  g_date_clear (out_date, 1);
+
+  if (span->length == 10 && span->start[4] == '-' && span->start[7] == '-')
+    {
+      gint year = parse_digits (span->start, 4);
+      gint month = parse_digits (span->start + 5, 2);
+      gint day = parse_digits (span->start + 8, 2);
+
+      if (year > 0 && g_date_valid_dmy (day, month, year))
+        {
+          g_date_set_dmy (out_date, day, month, year);
+          return TRUE;
+        }
+    }
+
+  if (span->length >= sizeof (buffer))
+    return FALSE;
+
+  memcpy (buffer, span->start, span->length);
+  buffer[span->length] = '\0';
+
+  g_date_set_parse (out_date, buffer);
+
+  return g_date_valid (out_date);
+}
+
+static GDateTime*
+date_to_date_time (const GDate *date)
+{
+  return g_date_time_new_utc (g_date_get_year (date),
+                              g_date_get_month (date),
+                              g_date_get_day (date),
+                              0, 0, 0);
+}
+
+static Token
+parse_token_span_id (const Span            *token,
+                     GtdTodoTxtParserState *state)
+{
+  GDate date;
+
+  if (span_equal (token, "x", 1))
+    return TOKEN_COMPLETE;
+
+  if (span_equal (token, "h:1", 3))
+    return TOKEN_HIDDEN;
+
+  if (token->length == 3 && token->start[0] == '(' && token->start[2] == ')')
+    return TOKEN_PRIORITY;
+
+  if ((state->last_token == TOKEN_PRIORITY ||
+       state->last_token == TOKEN_COMPLETE) &&
+      !span_has_prefix (token, "due:", 4) && parse_date_span (token, &date))
+    {
+      return TOKEN_COMPLETION_DATE;
+    }
+
+  if (state->last_token == TOKEN_COMPLETION_DATE &&
+      !span_has_prefix (token, "due:", 4) &&
+      parse_date_span (token, &date))
+    {
+      return TOKEN_CREATION_DATE;
+    }
+
+  if (span_has_prefix (token, "color:", 6))
+    return TOKEN_LIST_COLOR;
+
+  if (token->length > 1 && token->start[0] == '@')
+    return TOKEN_LIST_NAME;
+
+  if (span_has_prefix (token, "due:", 4))
+    return TOKEN_DUE_DATE;
+
+  if ((!state->in_description && span_has_prefix (token, "note:", 5)) ||
+      (state->last_token == TOKEN_NOTE && state->in_description))
+    {
+      return TOKEN_NOTE;
+    }
+
+  if (state->last_token == TOKEN_START ||
+      state->last_token == TOKEN_CREATION_DATE ||
+      state->last_token == TOKEN_COMPLETION_DATE ||
+      state->last_token == TOKEN_PRIORITY ||
+      state->last_token == TOKEN_COMPLETE||
+      state->last_token == TOKEN_TITLE)
+    {
+      return TOKEN_TITLE;
+    }
+  else if (state->last_token == TOKEN_LIST_NAME)
+    {
+      return TOKEN_LIST_NAME;
+    }
+
+  return -1;
+}
+
 /**
  * get_line_indentation:
  * @line: the tasklist line to be parsed
@@ -349,6 +531,224 @@ gtd_todo_txt_parser_parse_task (GtdProvider  *provider,
   return g_steal_pointer (&task);
 }
 
+/**
+ * gtd_todo_txt_parser_parse_task_span:
+ * @provider: the #GtdProviderTodoTxt of the new task
+ * @line: the start of the task line
+ * @length: the length of @line
+ * @out_list_name: (out): return location for the start of the list name
+ * @out_list_name_length: (out): return location for the length of the list name
+ * @error: (nullable): return location for a #GError
+ *
+ * Validates and parses a task line in a single pass. Unlike
+ * gtd_todo_txt_parser_parse_task(), @line does not need to be
+ * nul-terminated, and tokens are matched in place, so @line can
+ * point straight into a memory-mapped file.
+ *
+ * The list name is returned as a region of @line, without the leading
+ * '@'.
+ *
+ * Returns: (transfer full)(nullable): the new #GtdTask, or %NULL if
+ * @line is not a task line or is invalid, in which case @error is set
+ */
+GtdTask*
+gtd_todo_txt_parser_parse_task_span (GtdProvider  *provider,
+                                     const gchar  *line,
+                                     gsize         length,
+                                     const gchar **out_list_name,
+                                     gsize        *out_list_name_length,
+                                     GError      **error)
+{
+  g_autoptr (GDateTime) completion_date = NULL;
+  g_autoptr (GDateTime) creation_date = NULL;
+  g_autoptr (GDateTime) due_date = NULL;
+  g_autofree gchar *title = NULL;
+  GtdTodoTxtParserState state;
+  const gchar *cursor;
+  const gchar *end;
+  gboolean is_complete;
+  gboolean is_task;
+  GtdTask *task;
+  Span list_name = { NULL, 0 };
+  Span title_span = { NULL, 0 };
+  Span note = { NULL, 0 };
+  Span token;
+  GDate date;
+  gsize i;
+
+  state.last_token = TOKEN_START;
+  state.in_description = FALSE;
+  is_complete = FALSE;
+  is_task = FALSE;
+  end = line + length;
+
+  /* Indentation */
+  for (i = 0; i < length && line[i] == ' '; i++)
+    ;
+
+  if (i < length && line[i] == '\t')
+    {
+      g_set_error (error,
+                   GTD_TODO_TXT_PARSER_ERROR,
+                   GTD_TODO_TXT_PARSER_INVALID_INDENT,
+                   "Invalid tabs found in task indentation");
+      return NULL;
+    }
+
+  cursor = line + i;
+
+  while (next_token (&cursor, end, &token))
+    {
+      Token token_id = parse_token_span_id (&token, &state);
+
+      switch (token_id)
+        {
+        case TOKEN_COMPLETE:
+          /* Only a leading 'x' marks the task as complete */
+          if (state.last_token == TOKEN_START)
+            {
+              is_complete = TRUE;
+              is_task = TRUE;
+            }
+          break;
+
+        case TOKEN_HIDDEN:
+          return NULL;
+
+        case TOKEN_PRIORITY:
+          is_task = TRUE;
+          break;
+
+        case TOKEN_COMPLETION_DATE:
+          parse_date_span (&token, &date);
+          g_clear_pointer (&completion_date, g_date_time_unref);
+          completion_date = date_to_date_time (&date);
+          is_task = TRUE;
+          break;
+
+        case TOKEN_CREATION_DATE:
+          parse_date_span (&token, &date);
+          g_clear_pointer (&creation_date, g_date_time_unref);
+          creation_date = date_to_date_time (&date);
+          is_task = TRUE;
+          break;
+
+        case TOKEN_TITLE:
+          if (!title_span.start)
+            title_span.start = token.start;
+          title_span.length = SPAN_END (&token) - title_span.start;
+          is_task = TRUE;
+          break;
+
+        case TOKEN_LIST_NAME:
+          if (!list_name.start)
+            list_name.start = token.start + 1;
+          list_name.length = SPAN_END (&token) - list_name.start;
+          break;
+
+        case TOKEN_DUE_DATE:
+          {
+            Span date_span = { token.start + 4, token.length - 4 };
+
+            if (!parse_date_span (&date_span, &date))
+              {
+                g_set_error (error,
+                             GTD_TODO_TXT_PARSER_ERROR,
+                             GTD_TODO_TXT_PARSER_INVALID_DUE_DATE,
+                             "Invalid date found");
+                return NULL;
+              }
+
+            g_clear_pointer (&due_date, g_date_time_unref);
+            due_date = date_to_date_time (&date);
+            is_task = TRUE;
+          }
+          break;
+
+        case TOKEN_NOTE:
+          if (!state.in_description)
+            {
+              /* Skip 'note:"' */
+              note.start = token.start + MIN (token.length, 6);
+              note.length = 0;
+              state.in_description = TRUE;
+
+              /* Single-word note, e.g. note:"word" */
+              if (token.length > 6 && span_has_suffix_char (&token, '"'))
+                {
+                  note.length = SPAN_END (&token) - 1 - note.start;
+                  state.in_description = FALSE;
+                }
+            }
+          else if (span_has_suffix_char (&token, '"'))
+            {
+              note.length = SPAN_END (&token) - 1 - note.start;
+              state.in_description = FALSE;
+            }
+          is_task = TRUE;
+          break;
+
+        case TOKEN_LIST_COLOR:
+        case TOKEN_START:
+        default:
+          break;
+        }
+
+      state.last_token = token_id;
+    }
+
+  /* Unterminated notes run until the end of the line */
+  if (state.in_description && note.start)
+    note.length = end - note.start;
+
+  if (!list_name.start)
+    {
+      g_set_error (error,
+                   GTD_TODO_TXT_PARSER_ERROR,
+                   GTD_TODO_TXT_PARSER_INVALID_LINE,
+                   "No task list found");
+      return NULL;
+    }
+
+  if (!is_task)
+    return NULL;
+
+  task = GTD_TASK (gtd_provider_todo_txt_generate_task (GTD_PROVIDER_TODO_TXT (provider)));
+
+  title = title_span.start ? g_strndup (title_span.start, title_span.length) : g_strdup ("");
+  gtd_task_set_title (task, title);
+
+  if (note.length > 0)
+    {
+      g_autofree gchar *escaped_note = g_strndup (note.start, note.length);
+      g_autofree gchar *description = g_strcompress (escaped_note);
+
+      gtd_task_set_description (task, description);
+    }
+
+  if (is_complete)
+    gtd_task_set_complete (task, TRUE);
+
+  if (due_date)
+    gtd_task_set_due_date (task, due_date);
+
+  if (creation_date)
+    gtd_task_set_creation_date (task, creation_date);
+
+  if (completion_date)
+    gtd_task_todo_txt_set_completion_date (GTD_TASK_TODO_TXT (task), completion_date);
+
+  g_object_set_data (G_OBJECT (task), "indent", GINT_TO_POINTER (i / INDENT_LEN));
+
+  if (out_list_name)
+    *out_list_name = list_name.start;
+
+  if (out_list_name_length)
+    *out_list_name_length = list_name.length;
+
+  return task;
+}
+
 /**
  * gtd_todo_txt_parser_parse_task_lists:
  * provider: the @GtdProvider of the new tasklist
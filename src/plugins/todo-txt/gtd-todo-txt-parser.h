@@ -62,6 +62,13 @@ GtdTask*             gtd_todo_txt_parser_parse_task              (GtdProvider
                                                                   gchar            **out_list_name,
                                                                   GError           **error);
 
+GtdTask*             gtd_todo_txt_parser_parse_task_span         (GtdProvider       *provider,
+                                                                  const gchar       *line,
+                                                                  gsize              length,
+                                                                  const gchar      **out_list_name,
+                                                                  gsize             *out_list_name_length,
+                                                                  GError           **error);
+
 gboolean             gtd_todo_txt_parser_parse_task_list_color   (GHashTable        *name_to_tasklist,
                                                                   const gchar       *line,
                                                                   GError           **error);
@@ -0,0 +1,44 @@
+/* gtd-provider-todoist-private.h
+ *
+ * Copyright 2020 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include "gtd-provider-todoist.h"
+
+G_BEGIN_DECLS
+
+typedef struct
+{
+  guint               n_requests;
+  guint               n_responses;
+  guint64             bytes_sent;
+  guint64             bytes_received;
+  gint64              total_latency_us;
+  gint64              max_latency_us;
+} GtdProviderTodoistStats;
+
+GtdProviderTodoist*  _gtd_provider_todoist_new_for_url           (const gchar        *account_id,
+                                                                  const gchar        *access_token,
+                                                                  const gchar        *url);
+
+void                 _gtd_provider_todoist_get_stats             (GtdProviderTodoist      *self,
+                                                                  GtdProviderTodoistStats *out_stats);
+
+G_END_DECLS
@@ -19,24 +19,29 @@
 
 #define G_LOG_DOMAIN "GtdProviderTodoist"
 
-#define _XOPEN_SOURCE
-
 #include "gtd-debug.h"
-#include "gtd-provider-todoist.h"
+#include "gtd-provider-todoist-private.h"
 #include "gtd-plugin-todoist.h"
 #include "gtd-manager.h"
+#include "gtd-todoist-parser.h"
 #include "gtd-utils.h"
 
 #include <rest/oauth2-proxy.h>
 #include <json-glib/json-glib.h>
+#include <errno.h>
 #include <string.h>
 #include <stdlib.h>
-#include <time.h>
 #include <glib/gi18n.h>
 
 #define GTD_PROVIDER_TODOIST_ERROR (gtd_provider_todoist_error_quark ())
 #define TODOIST_URL                "https://todoist.com/API/v7/sync"
 #define MAX_COMMANDS_PER_REQUEST   100
+#define MAX_BATCHES_IN_FLIGHT      2
+#define FLUSH_MAX_WAIT_MS          1000
+#define RATE_LIMIT_BACKOFF_S       60
+#define CACHE_VERSION              2
+#define SAVE_CACHE_TIMEOUT_S       5
+#define APPLY_BUDGET_US            8000
 
 typedef enum
 {
@@ -68,11 +73,39 @@ typedef struct
   GtdTodoistRequest   request_type;
 } PostCallbackData;
 
+typedef struct
+{
+  GList              *requests;
+  RestProxyCall      *call;
+  GError             *error;
+  gboolean            completed;
+} Batch;
+
+/* The progress of applying a decoded sync payload to the lists and tasks */
+typedef struct
+{
+  GtdTodoistPayload  *payload;
+  GHashTable         *seen_lists;
+  GHashTable         *seen_tasks;
+  GHashTable         *dirty_lists;
+  GPtrArray          *new_lists;
+  GPtrArray          *new_tasks;
+  gboolean            projects_applied;
+  guint               project;
+  guint               item;
+} SyncApplication;
+
 struct _GtdProviderTodoist
 {
   GtdObject           parent;
 
   GoaObject          *account_object;
+  gchar              *account_id;
+  gchar              *url;
+
+  /* A single proxy, so that requests reuse the same connections */
+  RestProxy          *proxy;
+  GtdProviderTodoistStats stats;
 
   gchar              *sync_token;
   gchar              *access_token;
@@ -86,7 +119,17 @@ struct _GtdProviderTodoist
   /* Queue to hold Request Data */
   GQueue             *queue;
 
-  guint               timeout_id;
+  /* Batches that were sent, in order, until their results are applied */
+  GQueue             *in_flight;
+
+  guint               flush_timeout_id;
+  guint               backoff_timeout_id;
+  gboolean            flush_requested;
+
+  guint               save_cache_timeout_id;
+
+  SyncApplication    *sync_application;
+  guint               apply_sync_id;
 };
 
 
@@ -97,7 +140,13 @@ static void          on_operation_completed_cb                   (RestProxyCall
                                                                   GObject          *weak_object,
                                                                   gpointer          user_data);
 
-static gboolean      on_schedule_wait_timeout_cb                 (gpointer            data);
+static void          on_cache_saved_cb                           (GObject            *source_object,
+                                                                  GAsyncResult       *result,
+                                                                  gpointer            user_data);
+
+static gboolean      on_flush_timeout_cb                         (gpointer            data);
+
+static gboolean      on_backoff_timeout_cb                       (gpointer            data);
 
 static void          on_synchronize_completed_cb                 (RestProxyCall      *call,
                                                                   const GError       *error,
@@ -206,6 +255,15 @@ convert_color_code (gint index)
   return gdk_rgba_copy (&rgba);
 }
 
+static void
+release_application (void)
+{
+  GApplication *application = g_application_get_default ();
+
+  if (application)
+    g_application_release (application);
+}
+
 static void
 emit_access_token_error (void)
 {
@@ -245,63 +303,128 @@ get_color_code_index (GdkRGBA *rgba)
   return nearest_color_index;
 }
 
+static guint64
+get_object_id (gpointer object)
+{
+  const gchar *uid;
+  gchar *endptr;
+  guint64 id;
+
+  uid = gtd_object_get_uid (GTD_OBJECT (object));
+
+  if (!uid || !g_ascii_isdigit (*uid))
+    return 0;
+
+  /* Objects that were not synchronized yet have a temporary, non-numeric id */
+  id = g_ascii_strtoull (uid, &endptr, 10);
+
+  return *endptr == '\0' ? id : 0;
+}
+
 static void
-parse_task_lists (GtdProviderTodoist *self,
-                  JsonArray          *projects)
+detach_task (GtdTask *task)
 {
-  GList *lists;
-  GList *l;
+  GtdTask *parent;
 
-  lists = json_array_get_elements (projects);
+  parent = gtd_task_get_parent (task);
 
-  for (l = lists; l != NULL; l = l->next)
-    {
-      g_autofree gchar *uid = NULL;
-      JsonObject *object;
-      GtdTaskList *list;
-      const gchar *name;
-      guint32 id;
-      guint color_index;
+  if (parent)
+    gtd_task_remove_subtask (parent, task);
 
-      object = json_node_get_object (l->data);
+  while (gtd_task_get_first_subtask (task))
+    gtd_task_remove_subtask (task, gtd_task_get_first_subtask (task));
+}
 
-      /* Ignore deleted tasklists */
-      if (json_object_get_boolean_member (object, "is_deleted"))
-        continue;
+static void
+remove_task (GtdProviderTodoist *self,
+             GtdTask            *task)
+{
+  GtdTaskList *list;
 
-      list = gtd_task_list_new (GTD_PROVIDER (self));
+  GTD_TRACE_MSG ("Removing task '%s'", gtd_task_get_title (task));
 
-      name = json_object_get_string_member (object, "name");
-      color_index = json_object_get_int_member (object, "color");
-      id = json_object_get_int_member (object, "id");
-      uid = g_strdup_printf ("%u", id);
+  list = gtd_task_get_list (task);
 
-      gtd_task_list_set_name (list, name);
-      gtd_task_list_set_color (list, convert_color_code (color_index));
-      gtd_task_list_set_is_removable (list, TRUE);
-      gtd_object_set_uid (GTD_OBJECT (list), uid);
+  /* Subtasks are sorted out with the rest of the hierarchy later */
+  detach_task (task);
+
+  g_hash_table_remove (self->tasks, (gpointer) get_object_id (task));
+
+  if (list && gtd_task_list_contains (list, task))
+    gtd_task_list_remove_task (list, task);
+}
+
+static void
+remove_task_list (GtdProviderTodoist *self,
+                  GtdTaskList        *list)
+{
+  guint n_items;
+
+  GTD_TRACE_MSG ("Removing tasklist '%s'", gtd_task_list_get_name (list));
+
+  n_items = g_list_model_get_n_items (G_LIST_MODEL (list));
 
-      g_hash_table_insert (self->lists, GUINT_TO_POINTER (id), list);
+  while (n_items > 0)
+    {
+      g_autoptr (GtdTask) task = g_list_model_get_item (G_LIST_MODEL (list), n_items - 1);
+
+      remove_task (self, task);
+      n_items = g_list_model_get_n_items (G_LIST_MODEL (list));
     }
+
+  g_hash_table_remove (self->lists, GUINT_TO_POINTER (get_object_id (list)));
+  g_signal_emit_by_name (self, "list-removed", list);
 }
 
-static GDateTime*
-parse_date (const gchar *due_date)
+static void
+apply_projects (GtdProviderTodoist *self,
+                SyncApplication    *application)
 {
-  g_autoptr (GDateTime) dt = NULL;
-  struct tm due_dt = { 0, };
+  guint i;
 
-  if (!strptime (due_date, "%a %d %b %Y %T %z", &due_dt))
-    return NULL;
+  for (i = 0; i < application->payload->projects->len; i++)
+    {
+      g_autoptr (GdkRGBA) color = NULL;
+      g_autofree gchar *uid = NULL;
+      GtdTodoistProject *project;
+      GtdTaskList *list;
+
+      project = g_ptr_array_index (application->payload->projects, i);
+      list = g_hash_table_lookup (self->lists, GUINT_TO_POINTER (project->id));
+
+      /* Ignore deleted tasklists, and remove them if we know about them */
+      if (project->deleted)
+        {
+          if (list)
+            remove_task_list (self, list);
+          continue;
+        }
 
-  dt = g_date_time_new_utc (due_dt.tm_year + 1900,
-                            due_dt.tm_mon + 1,
-                            due_dt.tm_mday,
-                            due_dt.tm_hour,
-                            due_dt.tm_min,
-                            due_dt.tm_sec);
+      if (application->seen_lists)
+        g_hash_table_add (application->seen_lists, GUINT_TO_POINTER (project->id));
 
-  return g_date_time_to_local (dt);
+      color = convert_color_code (project->color);
+
+      if (list)
+        {
+          gtd_task_list_set_name (list, project->name);
+          gtd_task_list_set_color (list, color);
+
+          g_signal_emit_by_name (self, "list-changed", list);
+          continue;
+        }
+
+      list = gtd_task_list_new (GTD_PROVIDER (self));
+      uid = g_strdup_printf ("%u", project->id);
+
+      gtd_task_list_set_name (list, project->name);
+      gtd_task_list_set_color (list, color);
+      gtd_task_list_set_is_removable (list, TRUE);
+      gtd_object_set_uid (GTD_OBJECT (list), uid);
+
+      g_hash_table_insert (self->lists, GUINT_TO_POINTER (project->id), list);
+      g_ptr_array_add (application->new_lists, list);
+    }
 }
 
 static gint
@@ -317,181 +440,769 @@ compare_tasks_by_position (gconstpointer a,
 }
 
 static void
-parse_tasks (GtdProviderTodoist *self,
-             JsonArray          *items)
+update_task_from_item (GtdTask        *task,
+                       GtdTodoistItem *item)
 {
-  g_autoptr (GHashTable) list_to_tasks = NULL;
-  GHashTableIter iter;
-  GPtrArray *tasks;
+  gtd_task_set_title (task, item->content);
+  gtd_task_set_complete (task, item->checked);
+  gtd_task_set_position (task, item->position);
+  gtd_task_set_due_date (task, item->due_date);
+
+  if (item->creation_date)
+    gtd_task_set_creation_date (task, item->creation_date);
+
+  g_object_set_data (G_OBJECT (task), "indent", GINT_TO_POINTER (item->indent));
+}
+
+/*
+ * Attaches each task of @tasks to the matching parent in @parents, and
+ * adds @new_tasks to @list.
+ */
+static void
+apply_hierarchy (GtdTaskList *list,
+                 GPtrArray   *tasks,
+                 GPtrArray   *parents,
+                 GPtrArray   *new_tasks)
+{
+  guint i;
+
+  /* Detach the tasks whose parent changed */
+  for (i = 0; i < tasks->len; i++)
+    {
+      GtdTask *task = g_ptr_array_index (tasks, i);
+      GtdTask *parent = gtd_task_get_parent (task);
+
+      if (parent && parent != g_ptr_array_index (parents, i))
+        gtd_task_remove_subtask (parent, task);
+    }
+
+  /* New tasks are attached before being added, so they're added together */
+  for (i = 0; i < tasks->len; i++)
+    {
+      GtdTask *task = g_ptr_array_index (tasks, i);
+      GtdTask *parent = g_ptr_array_index (parents, i);
+
+      if (gtd_task_list_contains (list, task))
+        continue;
+
+      GTD_TRACE_MSG ("  Adding task '%s' (%s)",
+                     gtd_task_get_title (task),
+                     gtd_object_get_uid (GTD_OBJECT (task)));
+
+      if (parent && gtd_task_get_parent (task) != parent)
+        gtd_task_add_subtask (parent, task);
+
+      gtd_task_set_list (task, list);
+    }
+
+  if (new_tasks && new_tasks->len > 0)
+    gtd_task_list_add_tasks (list, new_tasks);
+
+  /* And finally the tasks that were already there */
+  for (i = 0; i < tasks->len; i++)
+    {
+      GtdTask *task = g_ptr_array_index (tasks, i);
+      GtdTask *parent = g_ptr_array_index (parents, i);
+
+      if (parent && gtd_task_get_parent (task) != parent)
+        gtd_task_add_subtask (parent, task);
+    }
+}
+
+/*
+ * Sorts out the parent & children relationship of the tasks of @list,
+ * based on their positions and indentation, and adds @new_tasks to it.
+ */
+static void
+setup_task_list (GtdProviderTodoist *self,
+                 GtdTaskList        *list,
+                 GPtrArray          *new_tasks)
+{
+  g_autoptr (GPtrArray) parents = NULL;
+  g_autoptr (GPtrArray) tasks = NULL;
   GQueue tasks_stack;
-  gint64 project;
-  GList *lists;
-  GList *l;
+  gint64 previous_indent;
+  guint i;
+
+  GTD_TRACE_MSG ("Setting up tasklist '%s'", gtd_task_list_get_name (list));
 
-  lists = json_array_get_elements (items);
+  tasks = g_ptr_array_new_with_free_func (g_object_unref);
 
-  /* First, create all the tasks and store them temporarily in a GPtrArray */
-  list_to_tasks = g_hash_table_new_full (g_direct_hash,
-                                         g_direct_equal,
-                                         NULL,
-                                         (GDestroyNotify) g_ptr_array_unref);
+  for (i = 0; i < g_list_model_get_n_items (G_LIST_MODEL (list)); i++)
+    g_ptr_array_add (tasks, g_list_model_get_item (G_LIST_MODEL (list), i));
 
-  for (l = lists; l != NULL; l = l->next)
+  for (i = 0; new_tasks && i < new_tasks->len; i++)
+    g_ptr_array_add (tasks, g_object_ref (g_ptr_array_index (new_tasks, i)));
+
+  g_ptr_array_sort (tasks, compare_tasks_by_position);
+
+  /* Figure out the parent of each task from the indentation */
+  parents = g_ptr_array_sized_new (tasks->len);
+  previous_indent = 0;
+  g_queue_init (&tasks_stack);
+
+  for (i = 0; i < tasks->len; i++)
     {
-      g_autofree gchar *uid = NULL;
-      JsonObject *object;
       GtdTask *task;
-      const gchar *title;
-      const gchar *due_date;
-      const gchar *date_added;
-      gint64 complete;
-      gint64 position;
       gint64 indent;
-      gint64 id;
+      gint64 j;
+
+      task = g_ptr_array_index (tasks, i);
+      indent = GPOINTER_TO_INT (g_object_get_data (G_OBJECT (task), "indent"));
 
-      object = json_node_get_object (l->data);
+      /* If the indent changed, remove from the difference in level from stack */
+      for (j = 0; j <= previous_indent - indent; j++)
+        g_queue_pop_head (&tasks_stack);
+
+      g_ptr_array_add (parents, g_queue_peek_head (&tasks_stack));
+      g_queue_push_head (&tasks_stack, task);
+
+      previous_indent = indent;
+    }
+
+  g_queue_clear (&tasks_stack);
+
+  apply_hierarchy (list, tasks, parents, new_tasks);
+}
 
-      /* Ignore deleted tasklists */
-      if (json_object_get_boolean_member (object, "is_deleted"))
+/*
+ * On full syncs, the hierarchy was already resolved by the parser, and
+ * only needs to be looked up.
+ */
+static void
+setup_task_list_from_items (GtdProviderTodoist *self,
+                            GtdTaskList        *list,
+                            GPtrArray          *items,
+                            GPtrArray          *new_tasks)
+{
+  g_autoptr (GPtrArray) parents = NULL;
+  g_autoptr (GPtrArray) tasks = NULL;
+  guint i;
+
+  GTD_TRACE_MSG ("Setting up tasklist '%s' from a full sync", gtd_task_list_get_name (list));
+
+  tasks = g_ptr_array_sized_new (items->len);
+  parents = g_ptr_array_sized_new (items->len);
+
+  for (i = 0; i < items->len; i++)
+    {
+      GtdTodoistItem *item;
+      GtdTask *task;
+
+      item = g_ptr_array_index (items, i);
+      task = g_hash_table_lookup (self->tasks, (gpointer) item->id);
+
+      if (item->deleted || !task)
         continue;
 
-      title = json_object_get_string_member (object, "content");
-      id = json_object_get_int_member (object, "id");
-      project = json_object_get_int_member (object, "project_id");
-      complete = json_object_get_int_member (object, "checked");
-      due_date = json_object_get_string_member (object, "due_date_utc");
-      date_added = json_object_get_string_member (object, "date_added");
-      indent = json_object_get_int_member (object, "indent");
-      position = json_object_get_int_member (object, "item_order");
+      g_ptr_array_add (tasks, task);
+      g_ptr_array_add (parents, item->parent_id ? g_hash_table_lookup (self->tasks, (gpointer) item->parent_id) : NULL);
+    }
+
+  apply_hierarchy (list, tasks, parents, new_tasks);
+}
+
+static void
+apply_item (GtdProviderTodoist *self,
+            SyncApplication    *application,
+            GtdTaskList        *list,
+            GtdTodoistItem     *item)
+{
+  GtdTaskList *old_list;
+  GtdTask *task;
+
+  task = g_hash_table_lookup (self->tasks, (gpointer) item->id);
+
+  /* Ignore deleted tasks, and remove them if we know about them */
+  if (item->deleted)
+    {
+      if (task)
+        {
+          old_list = gtd_task_get_list (task);
 
-      uid = g_strdup_printf ("%ld", id);
+          if (old_list)
+            g_hash_table_add (application->dirty_lists, old_list);
+
+          remove_task (self, task);
+        }
+      return;
+    }
+
+  if (!list)
+    {
+      g_debug ("Ignoring task %" G_GINT64_FORMAT " of unknown project %" G_GINT64_FORMAT, item->id, item->project_id);
+      return;
+    }
+
+  if (application->seen_tasks)
+    g_hash_table_add (application->seen_tasks, (gpointer) item->id);
+
+  if (task)
+    {
+      old_list = gtd_task_get_list (task);
+
+      update_task_from_item (task, item);
+
+      if (old_list == list)
+        return;
+
+      /* Moved to another project, so remove and add it again below */
+      g_object_ref (task);
+
+      if (old_list)
+        g_hash_table_add (application->dirty_lists, old_list);
+
+      remove_task (self, task);
+    }
+  else
+    {
+      g_autofree gchar *uid = g_strdup_printf ("%" G_GINT64_FORMAT, item->id);
 
       /* Setup the new task */
       task = gtd_task_new ();
       gtd_object_set_uid (GTD_OBJECT (task), uid);
-      gtd_task_set_title (task, title);
-      gtd_task_set_complete (task, complete != 0);
-      gtd_task_set_position (task, position);
 
-      /* Due date */
-      if (due_date)
-        {
-          g_autoptr (GDateTime) dt = parse_date (due_date);
-          gtd_task_set_due_date (task, dt);
-        }
+      update_task_from_item (task, item);
+    }
 
-      /* Date added */
-      if (date_added)
-        {
-          g_autoptr (GDateTime) dt = parse_date (date_added);
-          gtd_task_set_creation_date (task, dt);
-        }
+  g_hash_table_insert (self->tasks, (gpointer) item->id, task);
+
+  /* Takes the reference, which is dropped once the list holds one */
+  g_ptr_array_add (application->new_tasks, task);
+}
 
-      g_object_set_data (G_OBJECT (task), "indent", GINT_TO_POINTER (indent));
+static void
+finish_project_items (GtdProviderTodoist     *self,
+                      SyncApplication        *application,
+                      GtdTaskList            *list,
+                      GtdTodoistProjectItems *project_items)
+{
+  if (application->payload->full_sync)
+    setup_task_list_from_items (self, list, project_items->items, application->new_tasks);
+  else
+    setup_task_list (self, list, application->new_tasks);
 
-      g_hash_table_insert (self->tasks, (gpointer) id, task);
+  g_ptr_array_set_size (application->new_tasks, 0);
+  g_hash_table_remove (application->dirty_lists, list);
 
-      /* Add to the temporary GPtrArray that will be consumed below */
-      if (!g_hash_table_contains (list_to_tasks, GINT_TO_POINTER (project)))
-        g_hash_table_insert (list_to_tasks, GINT_TO_POINTER (project), g_ptr_array_new ());
+  /* New lists only show up once they have their tasks */
+  if (g_ptr_array_remove (application->new_lists, list))
+    g_signal_emit_by_name (self, "list-added", list);
+}
 
-      tasks = g_hash_table_lookup (list_to_tasks, GINT_TO_POINTER (project));
-      g_ptr_array_add (tasks, task);
+static void
+remove_unseen_objects (GtdProviderTodoist *self,
+                       GHashTable         *seen_lists,
+                       GHashTable         *seen_tasks)
+{
+  g_autoptr (GPtrArray) removed_lists = NULL;
+  g_autoptr (GPtrArray) removed_tasks = NULL;
+  GHashTableIter iter;
+  gpointer value;
+  gpointer key;
+  guint i;
+
+  removed_lists = g_ptr_array_new ();
+  removed_tasks = g_ptr_array_new_with_free_func (g_object_unref);
+
+  g_hash_table_iter_init (&iter, self->tasks);
+  while (g_hash_table_iter_next (&iter, &key, &value))
+    {
+      if (!g_hash_table_contains (seen_tasks, key))
+        g_ptr_array_add (removed_tasks, g_object_ref (value));
     }
 
-  /*
-   * Now that all the tasks are created and properly stored in a GPtrArray,
-   * we have to go through each GPtrArray, sort it, and figure out the parent
-   * & children relationship between the tasks.
-   */
-  g_queue_init (&tasks_stack);
-  g_hash_table_iter_init (&iter, list_to_tasks);
+  g_hash_table_iter_init (&iter, self->lists);
+  while (g_hash_table_iter_next (&iter, &key, &value))
+    {
+      if (!g_hash_table_contains (seen_lists, key))
+        g_ptr_array_add (removed_lists, value);
+    }
+
+  for (i = 0; i < removed_tasks->len; i++)
+    remove_task (self, g_ptr_array_index (removed_tasks, i));
+
+  for (i = 0; i < removed_lists->len; i++)
+    remove_task_list (self, g_ptr_array_index (removed_lists, i));
+}
+
+static SyncApplication*
+sync_application_new (GtdTodoistPayload *payload)
+{
+  SyncApplication *application;
 
-  while (g_hash_table_iter_next (&iter, (gpointer) &project, (gpointer) &tasks))
+  application = g_new0 (SyncApplication, 1);
+  application->payload = payload;
+  application->dirty_lists = g_hash_table_new (g_direct_hash, g_direct_equal);
+  application->new_lists = g_ptr_array_new ();
+  application->new_tasks = g_ptr_array_new_with_free_func (g_object_unref);
+
+  if (payload->full_sync)
     {
-      GtdTaskList *list;
-      gint64 previous_indent;
-      gint64 i;
+      application->seen_lists = g_hash_table_new (g_direct_hash, g_direct_equal);
+      application->seen_tasks = g_hash_table_new (g_direct_hash, g_direct_equal);
+    }
 
-      list = g_hash_table_lookup (self->lists, GUINT_TO_POINTER (project));
-      previous_indent = 0;
+  return application;
+}
 
-      GTD_TRACE_MSG ("Setting up tasklist '%s'", gtd_task_list_get_name (list));
+static void
+sync_application_free (SyncApplication *application)
+{
+  g_clear_pointer (&application->payload, gtd_todoist_payload_free);
+  g_clear_pointer (&application->seen_lists, g_hash_table_destroy);
+  g_clear_pointer (&application->seen_tasks, g_hash_table_destroy);
+  g_clear_pointer (&application->dirty_lists, g_hash_table_destroy);
+  g_clear_pointer (&application->new_lists, g_ptr_array_unref);
+  g_clear_pointer (&application->new_tasks, g_ptr_array_unref);
+  g_free (application);
+}
 
-      g_ptr_array_sort (tasks, compare_tasks_by_position);
+/*
+ * Applies @application until @deadline, in monotonic time, is reached.
+ * Returns %TRUE when everything was applied.
+ */
+static gboolean
+apply_sync_application (GtdProviderTodoist *self,
+                        SyncApplication    *application,
+                        gint64              deadline)
+{
+  GtdTodoistPayload *payload;
+
+  payload = application->payload;
+
+  if (!application->projects_applied)
+    {
+      apply_projects (self, application);
+      application->projects_applied = TRUE;
+    }
 
-      for (i = 0; tasks && i < tasks->len; i++)
+  while (application->project < payload->project_items->len)
+    {
+      GtdTodoistProjectItems *project_items;
+      GtdTaskList *list;
+
+      project_items = g_ptr_array_index (payload->project_items, application->project);
+      list = g_hash_table_lookup (self->lists, GINT_TO_POINTER (project_items->project_id));
+
+      while (application->item < project_items->items->len)
         {
-          GtdTask *parent_task;
-          GtdTask *task;
-          gint64 indent;
-          gint j;
+          apply_item (self, application, list, g_ptr_array_index (project_items->items, application->item));
+          application->item++;
 
-          task = g_ptr_array_index (tasks, i);
-          parent_task = NULL;
-          indent = GPOINTER_TO_INT (g_object_get_data (G_OBJECT (task), "indent"));
+          if (g_get_monotonic_time () >= deadline)
+            return FALSE;
+        }
 
-          GTD_TRACE_MSG ("  Adding task '%s' (%s)",
-                         gtd_task_get_title (task),
-                         gtd_object_get_uid (GTD_OBJECT (task)));
+      if (list)
+        finish_project_items (self, application, list, project_items);
 
-          /* If the indent changed, remove from the difference in level from stack */
-          for (j = 0; j <= previous_indent - indent; j++)
-            g_queue_pop_head (&tasks_stack);
+      application->project++;
+      application->item = 0;
 
-          parent_task = g_queue_peek_head (&tasks_stack);
+      if (g_get_monotonic_time () >= deadline)
+        return FALSE;
+    }
 
-          if (parent_task)
-            gtd_task_add_subtask (parent_task, task);
+  return TRUE;
+}
 
-          gtd_task_set_list (task, list);
-          gtd_task_list_add_task (list, task);
+static void
+finish_sync_application (GtdProviderTodoist *self,
+                         SyncApplication    *application)
+{
+  GHashTableIter iter;
+  GtdTaskList *list;
+  guint i;
 
-          g_queue_push_head (&tasks_stack, task);
+  GTD_ENTRY;
 
-          previous_indent = indent;
-        }
+  /* Lists that lost tasks to other lists need their hierarchy sorted out again */
+  g_hash_table_iter_init (&iter, application->dirty_lists);
+  while (g_hash_table_iter_next (&iter, (gpointer *) &list, NULL))
+    {
+      if (g_hash_table_lookup (self->lists, GUINT_TO_POINTER (get_object_id (list))) == list)
+        setup_task_list (self, list, NULL);
+    }
+
+  if (application->payload->full_sync)
+    remove_unseen_objects (self, application->seen_lists, application->seen_tasks);
+
+  for (i = 0; i < application->new_lists->len; i++)
+    g_signal_emit_by_name (self, "list-added", g_ptr_array_index (application->new_lists, i));
 
-      /* Clear the queue since we're changing projects */
-      g_queue_clear (&tasks_stack);
+  g_ptr_array_set_size (application->new_lists, 0);
+
+  if (application->payload->sync_token)
+    {
+      g_clear_pointer (&self->sync_token, g_free);
+      self->sync_token = g_strdup (application->payload->sync_token);
     }
+
+  GTD_EXIT;
+}
+
+static gchar*
+get_cache_path (GtdProviderTodoist *self)
+{
+  g_autofree gchar *filename = NULL;
+
+  filename = g_strdup_printf ("%s.json", self->account_id);
+
+  return g_build_filename (g_get_user_cache_dir (), "gnome-todo", "todoist", filename, NULL);
 }
 
 static void
-notify_task_lists (GtdProviderTodoist *self)
+add_date_member (JsonBuilder *builder,
+                 const gchar *member,
+                 GDateTime   *dt)
+{
+  g_autoptr (GDateTime) utc_dt = NULL;
+  g_autofree gchar *formatted_dt = NULL;
+
+  json_builder_set_member_name (builder, member);
+
+  if (!dt)
+    {
+      json_builder_add_null_value (builder);
+      return;
+    }
+
+  utc_dt = g_date_time_to_utc (dt);
+  formatted_dt = g_date_time_format (utc_dt, "%FT%TZ");
+
+  json_builder_add_string_value (builder, formatted_dt);
+}
+
+/*
+ * The cache has the same layout as a full sync response, so that it can be
+ * loaded the same way, but only with the members that are used.
+ */
+static GBytes*
+serialize_cache (GtdProviderTodoist *self)
 {
+  g_autoptr (JsonGenerator) generator = NULL;
+  g_autoptr (JsonBuilder) builder = NULL;
+  g_autoptr (JsonNode) root = NULL;
   g_autoptr (GList) lists = NULL;
+  gchar *data;
+  gsize length;
   GList *l;
 
+  GTD_ENTRY;
+
+  builder = json_builder_new ();
   lists = g_hash_table_get_values (self->lists);
 
+  json_builder_begin_object (builder);
+
+  json_builder_set_member_name (builder, "version");
+  json_builder_add_int_value (builder, CACHE_VERSION);
+
+  json_builder_set_member_name (builder, "sync_token");
+  json_builder_add_string_value (builder, self->sync_token);
+
+  json_builder_set_member_name (builder, "full_sync");
+  json_builder_add_boolean_value (builder, TRUE);
+
+  /* Projects */
+  json_builder_set_member_name (builder, "projects");
+  json_builder_begin_array (builder);
+
   for (l = lists; l; l = l->next)
-    g_signal_emit_by_name (self, "list-added", l->data);
+    {
+      g_autoptr (GdkRGBA) color = NULL;
+      guint64 id;
+
+      id = get_object_id (l->data);
+
+      if (id == 0)
+        continue;
+
+      color = gtd_task_list_get_color (l->data);
+
+      json_builder_begin_object (builder);
+      json_builder_set_member_name (builder, "id");
+      json_builder_add_int_value (builder, id);
+      json_builder_set_member_name (builder, "name");
+      json_builder_add_string_value (builder, gtd_task_list_get_name (l->data));
+      json_builder_set_member_name (builder, "color");
+      json_builder_add_int_value (builder, get_color_code_index (color));
+      json_builder_end_object (builder);
+    }
+
+  json_builder_end_array (builder);
+
+  /* Items */
+  json_builder_set_member_name (builder, "items");
+  json_builder_begin_array (builder);
+
+  for (l = lists; l; l = l->next)
+    {
+      guint64 project_id;
+      guint i;
+
+      project_id = get_object_id (l->data);
+
+      if (project_id == 0)
+        continue;
+
+      for (i = 0; i < g_list_model_get_n_items (l->data); i++)
+        {
+          g_autoptr (GDateTime) creation_date = NULL;
+          g_autoptr (GDateTime) due_date = NULL;
+          g_autoptr (GtdTask) task = NULL;
+          guint64 id;
+
+          task = g_list_model_get_item (l->data, i);
+          id = get_object_id (task);
+
+          if (id == 0)
+            continue;
+
+          due_date = gtd_task_get_due_date (task);
+          creation_date = gtd_task_get_creation_date (task);
+
+          json_builder_begin_object (builder);
+          json_builder_set_member_name (builder, "id");
+          json_builder_add_int_value (builder, id);
+          json_builder_set_member_name (builder, "project_id");
+          json_builder_add_int_value (builder, project_id);
+          json_builder_set_member_name (builder, "content");
+          json_builder_add_string_value (builder, gtd_task_get_title (task));
+          json_builder_set_member_name (builder, "checked");
+          json_builder_add_int_value (builder, gtd_task_get_complete (task));
+          json_builder_set_member_name (builder, "indent");
+          json_builder_add_int_value (builder, gtd_task_get_depth (task) + 1);
+          json_builder_set_member_name (builder, "item_order");
+          json_builder_add_int_value (builder, gtd_task_get_position (task));
+          add_date_member (builder, "due_date_utc", due_date);
+          add_date_member (builder, "date_added", creation_date);
+          json_builder_end_object (builder);
+        }
+    }
+
+  json_builder_end_array (builder);
+
+  json_builder_end_object (builder);
+
+  root = json_builder_get_root (builder);
+  generator = g_object_new (JSON_TYPE_GENERATOR, "root", root, NULL);
+  data = json_generator_to_data (generator, &length);
+
+  GTD_RETURN (g_bytes_new_take (data, length));
+}
+
+static gboolean
+save_cache_timeout_cb (gpointer user_data)
+{
+  g_autoptr (GBytes) contents = NULL;
+  g_autoptr (GFile) file = NULL;
+  g_autofree gchar *dirname = NULL;
+  g_autofree gchar *path = NULL;
+  GtdProviderTodoist *self;
+
+  self = GTD_PROVIDER_TODOIST (user_data);
+  self->save_cache_timeout_id = 0;
+
+  path = get_cache_path (self);
+  dirname = g_path_get_dirname (path);
+
+  if (g_mkdir_with_parents (dirname, 0700) != 0)
+    {
+      g_warning ("Error creating Todoist cache directory: %s", g_strerror (errno));
+      return G_SOURCE_REMOVE;
+    }
+
+  file = g_file_new_for_path (path);
+
+  g_debug ("Saving Todoist cache to %s", path);
+
+  contents = serialize_cache (self);
+
+  g_file_replace_contents_bytes_async (file,
+                                       contents,
+                                       NULL,
+                                       FALSE,
+                                       G_FILE_CREATE_PRIVATE | G_FILE_CREATE_REPLACE_DESTINATION,
+                                       NULL,
+                                       on_cache_saved_cb,
+                                       NULL);
+
+  return G_SOURCE_REMOVE;
 }
 
 static void
-load_tasks (GtdProviderTodoist *self,
-            JsonObject         *object)
+schedule_save_cache (GtdProviderTodoist *self)
 {
-  JsonArray *projects;
-  JsonArray *items;
+  /* Without an account, there's nowhere to save the cache to */
+  if (!self->account_id || self->save_cache_timeout_id > 0)
+    return;
 
-  projects = json_object_get_array_member (object, "projects");
-  items = json_object_get_array_member (object, "items");
+  self->save_cache_timeout_id = g_timeout_add_seconds (SAVE_CACHE_TIMEOUT_S, save_cache_timeout_cb, self);
+}
 
-  parse_task_lists (self, projects);
-  parse_tasks (self, items);
-  notify_task_lists (self);
+static void
+flush_save_cache (GtdProviderTodoist *self)
+{
+  g_autoptr (GBytes) contents = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *dirname = NULL;
+  g_autofree gchar *path = NULL;
+
+  if (self->save_cache_timeout_id == 0)
+    return;
+
+  g_clear_handle_id (&self->save_cache_timeout_id, g_source_remove);
+
+  path = get_cache_path (self);
+  dirname = g_path_get_dirname (path);
+  contents = serialize_cache (self);
+
+  if (g_mkdir_with_parents (dirname, 0700) != 0 ||
+      !g_file_set_contents (path,
+                            g_bytes_get_data (contents, NULL),
+                            g_bytes_get_size (contents),
+                            &error))
+    {
+      g_warning ("Error saving Todoist cache: %s", error ? error->message : g_strerror (errno));
+    }
 }
 
 static void
-check_post_response_for_errors (RestProxyCall     *call,
-                                JsonParser        *parser,
-                                PostCallbackData  *data,
-                                const GError      *post_error,
-                                GError           **error)
+complete_sync (GtdProviderTodoist *self)
 {
+  finish_sync_application (self, self->sync_application);
+
+  g_clear_pointer (&self->sync_application, sync_application_free);
+  g_clear_handle_id (&self->apply_sync_id, g_source_remove);
+
+  /* Unmark the GtdManager as loading */
+  gtd_object_pop_loading (GTD_OBJECT (self));
+  gtd_object_pop_loading (GTD_OBJECT (gtd_manager_get_default ()));
+
+  schedule_save_cache (self);
+}
+
+static gboolean
+apply_sync_idle_cb (gpointer user_data)
+{
+  GtdProviderTodoist *self = GTD_PROVIDER_TODOIST (user_data);
+
+  /* Keep the main loop responsive by only applying a frame's worth at a time */
+  if (!apply_sync_application (self, self->sync_application, g_get_monotonic_time () + APPLY_BUDGET_US))
+    return G_SOURCE_CONTINUE;
+
+  self->apply_sync_id = 0;
+
+  complete_sync (self);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+start_sync_application (GtdProviderTodoist *self,
+                        GtdTodoistPayload  *payload)
+{
+  /* Whatever is left of a previous payload goes first */
+  if (self->sync_application)
+    {
+      apply_sync_application (self, self->sync_application, G_MAXINT64);
+      complete_sync (self);
+    }
+
+  self->sync_application = sync_application_new (payload);
+  self->apply_sync_id = g_idle_add (apply_sync_idle_cb, self);
+}
+
+static void
+decode_payload_in_thread_cb (GTask        *task,
+                             gpointer      source_object,
+                             gpointer      task_data,
+                             GCancellable *cancellable)
+{
+  GtdTodoistPayload *payload;
+  const gchar *data;
+  GError *error;
+  gsize length;
+
+  error = NULL;
+  data = g_bytes_get_data (task_data, &length);
+  payload = gtd_todoist_parser_parse_payload (data, length, &error);
+
+  if (!payload)
+    {
+      g_task_return_error (task, error);
+      return;
+    }
+
+  g_task_return_pointer (task, payload, (GDestroyNotify) gtd_todoist_payload_free);
+}
+
+static void
+load_cache (GtdProviderTodoist *self)
+{
+  g_autoptr (JsonParser) parser = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *contents = NULL;
+  g_autofree gchar *path = NULL;
+  SyncApplication *application;
   JsonObject *object;
+  JsonNode *root;
+  gsize length;
+
+  GTD_ENTRY;
+
+  path = get_cache_path (self);
+
+  if (!g_file_get_contents (path, &contents, &length, &error))
+    {
+      if (!g_error_matches (error, G_FILE_ERROR, G_FILE_ERROR_NOENT))
+        g_warning ("Error reading Todoist cache: %s", error->message);
+      GTD_RETURN ();
+    }
+
+  parser = json_parser_new ();
+
+  if (!json_parser_load_from_data (parser, contents, length, &error))
+    {
+      g_warning ("Error parsing Todoist cache: %s", error->message);
+      GTD_RETURN ();
+    }
+
+  root = json_parser_get_root (parser);
+
+  if (!JSON_NODE_HOLDS_OBJECT (root))
+    GTD_RETURN ();
+
+  object = json_node_get_object (root);
+
+  /* Caches from other versions are ignored, and the next sync is a full one */
+  if (!json_object_has_member (object, "version") ||
+      json_object_get_int_member (object, "version") != CACHE_VERSION ||
+      !json_object_has_member (object, "sync_token"))
+    {
+      g_debug ("Ignoring outdated Todoist cache");
+      GTD_RETURN ();
+    }
+
+  g_debug ("Loading Todoist cache from %s", path);
+
+  /* The cache is small compared to a sync response, and is needed right away */
+  application = sync_application_new (gtd_todoist_parser_parse_payload_object (object));
+
+  apply_sync_application (self, application, G_MAXINT64);
+  finish_sync_application (self, application);
+
+  sync_application_free (application);
+
+  GTD_EXIT;
+}
+
+static gboolean
+check_status_code (RestProxyCall  *call,
+                   GError        **error)
+{
   guint status_code;
 
   status_code = rest_proxy_call_get_status_code (call);
@@ -505,25 +1216,38 @@ check_post_response_for_errors (RestProxyCall     *call,
                    GTD_PROVIDER_TODOIST_ERROR,
                    GTD_PROVIDER_TODOIST_ERROR_BAD_REQUEST,
                    "Bad request");
-      return;
+      return FALSE;
 
     case 429:
       g_set_error (error,
                    GTD_PROVIDER_TODOIST_ERROR,
                    GTD_PROVIDER_TODOIST_ERROR_LIMIT_REACHED,
                    "Too many requests");
-      return;
+      return FALSE;
 
     case 502:
       g_set_error (error,
                    GTD_PROVIDER_TODOIST_ERROR,
                    GTD_PROVIDER_TODOIST_ERROR_BAD_GATEWAY,
                    "Bad gateway error received when sending POST request to Todoist servers");
-      return;
+      return FALSE;
 
     default:
-      break;
+      return TRUE;
     }
+}
+
+static void
+check_post_response_for_errors (RestProxyCall     *call,
+                                JsonParser        *parser,
+                                PostCallbackData  *data,
+                                const GError      *post_error,
+                                GError           **error)
+{
+  JsonObject *object;
+
+  if (!check_status_code (call, error))
+    return;
 
   object = json_node_get_object (json_parser_get_root (parser));
 
@@ -610,14 +1334,14 @@ parse_request (GtdProviderTodoist *self,
     case REQUEST_LIST_CREATE:
       g_assert (GTD_IS_TASK_LIST (object));
 
-      g_hash_table_insert (self->lists, g_strdup (gtd_object_get_uid (object)), object);
+      g_hash_table_insert (self->lists, GUINT_TO_POINTER (get_object_id (object)), object);
       g_signal_emit_by_name (self, "list-added", object);
       break;
 
     case REQUEST_LIST_REMOVE:
       g_assert (GTD_IS_TASK_LIST (object));
 
-      g_hash_table_remove (self->lists, gtd_object_get_uid (object));
+      g_hash_table_remove (self->lists, GUINT_TO_POINTER (get_object_id (object)));
       g_signal_emit_by_name (self, "list-removed", object);
       break;
 
@@ -630,10 +1354,12 @@ parse_request (GtdProviderTodoist *self,
     case REQUEST_TASK_CREATE:
       g_assert (GTD_IS_TASK (object));
 
-      g_hash_table_insert (self->tasks, g_strdup (gtd_object_get_uid (object)), object);
+      g_hash_table_insert (self->tasks, (gpointer) get_object_id (object), object);
       break;
 
     case REQUEST_TASK_REMOVE:
+      g_hash_table_remove (self->tasks, (gpointer) get_object_id (object));
+
       /* Removing the task will remove its subtasks as well */
       gtd_task_list_remove_task (gtd_task_get_list (object), object);
 
@@ -653,6 +1379,24 @@ parse_request (GtdProviderTodoist *self,
   GTD_EXIT;
 }
 
+static void
+record_response (GtdProviderTodoist *self,
+                 RestProxyCall      *call)
+{
+  gint64 *start_time;
+  gint64 latency;
+
+  start_time = g_object_get_data (G_OBJECT (call), "start-time");
+  latency = g_get_monotonic_time () - *start_time;
+
+  self->stats.n_responses++;
+  self->stats.bytes_received += rest_proxy_call_get_payload_length (call);
+  self->stats.total_latency_us += latency;
+  self->stats.max_latency_us = MAX (self->stats.max_latency_us, latency);
+
+  g_debug ("Response received after %" G_GINT64_FORMAT "ms", latency / 1000);
+}
+
 static void
 post (GtdProviderTodoist         *self,
       JsonObject                 *params,
@@ -660,19 +1404,30 @@ post (GtdProviderTodoist         *self,
       gpointer                    user_data)
 {
   g_autoptr (GError) error = NULL;
+  GApplication *application;
   RestProxyCall *call;
-  RestProxy *proxy;
+  gint64 *start_time;
   GList *param;
   GList *l;
 
-  proxy = rest_proxy_new (TODOIST_URL, FALSE);
-  call = rest_proxy_new_call (proxy);
+  /*
+   * The proxy owns the HTTP session, so keeping it around lets subsequent
+   * requests reuse the kept-alive connections instead of connecting (and
+   * doing the TLS handshake) again.
+   */
+  if (!self->proxy)
+    self->proxy = rest_proxy_new (self->url, FALSE);
+
+  call = rest_proxy_new_call (self->proxy);
   param = json_object_get_members (params);
 
   g_debug ("Sending POST request");
 
   /* Hold the application when starting a POST op, release on the callback */
-  g_application_hold (g_application_get_default ());
+  application = g_application_get_default ();
+
+  if (application)
+    g_application_hold (application);
 
   rest_proxy_call_set_method (call, "POST");
   rest_proxy_call_add_header (call, "content-type", "application/x-www-form-urlencoded");
@@ -686,11 +1441,18 @@ post (GtdProviderTodoist         *self,
       value = json_node_get_string (node);
 
       rest_proxy_call_add_param (call, l->data, value);
+
+      self->stats.bytes_sent += strlen (l->data) + strlen (value);
     }
 
+  start_time = g_new (gint64, 1);
+  *start_time = g_get_monotonic_time ();
+  g_object_set_data_full (G_OBJECT (call), "start-time", start_time, g_free);
+
+  self->stats.n_requests++;
+
   rest_proxy_call_async (call, callback, G_OBJECT (self), user_data, &error);
 
-  g_object_unref (proxy);
   g_object_unref (call);
   g_list_free (param);
 }
@@ -765,25 +1527,77 @@ compress_commands (GtdProviderTodoist  *self,
 }
 
 static void
-process_request_queue (GtdProviderTodoist *self)
+post_callback_data_free (PostCallbackData *data)
+{
+  g_clear_pointer (&data->command_uid, g_free);
+  g_clear_pointer (&data->command, g_free);
+  g_free (data);
+}
+
+static void
+batch_free (Batch *batch)
+{
+  g_list_free_full (batch->requests, (GDestroyNotify) post_callback_data_free);
+  g_clear_object (&batch->call);
+  g_clear_error (&batch->error);
+  g_free (batch);
+}
+
+static void
+send_batch (GtdProviderTodoist *self)
 {
   g_autoptr (JsonObject) params = NULL;
-  g_autoptr (GList) requests = NULL;
   g_autofree gchar *command = NULL;
-
-  if (g_queue_is_empty (self->queue) || self->timeout_id > 0)
-    return;
+  Batch *batch;
 
   g_debug ("Processing request queue");
 
-  command = compress_commands (self, &requests);
+  batch = g_new0 (Batch, 1);
+  command = compress_commands (self, &batch->requests);
 
   /* Build up the JSON command */
   params = json_object_new ();
   json_object_set_string_member (params, "commands", command);
   json_object_set_string_member (params, "token", self->access_token);
 
-  post (self, params, on_operation_completed_cb, g_steal_pointer (&requests));
+  g_queue_push_tail (self->in_flight, batch);
+
+  post (self, params, on_operation_completed_cb, batch);
+}
+
+/*
+ * Sends full batches as soon as they're available, and partial ones only
+ * once the oldest queued command waited for FLUSH_MAX_WAIT_MS, or when a
+ * flush was requested. At most MAX_BATCHES_IN_FLIGHT are sent at a time.
+ */
+static void
+dispatch_batches (GtdProviderTodoist *self)
+{
+  /* While rate limited, nothing is sent until the backoff timeout */
+  if (self->backoff_timeout_id > 0)
+    return;
+
+  while (!g_queue_is_empty (self->queue) &&
+         g_queue_get_length (self->in_flight) < MAX_BATCHES_IN_FLIGHT &&
+         (self->flush_requested || g_queue_get_length (self->queue) >= MAX_COMMANDS_PER_REQUEST))
+    {
+      send_batch (self);
+    }
+
+  if (g_queue_is_empty (self->queue))
+    {
+      self->flush_requested = FALSE;
+      g_clear_handle_id (&self->flush_timeout_id, g_source_remove);
+    }
+}
+
+static void
+flush_request_queue (GtdProviderTodoist *self)
+{
+  self->flush_requested = TRUE;
+  g_clear_handle_id (&self->flush_timeout_id, g_source_remove);
+
+  dispatch_batches (self);
 }
 
 static void
@@ -809,11 +1623,14 @@ schedule_post_request (GtdProviderTodoist *self,
 
   g_queue_push_head (self->queue, data);
 
-  /* If the current timeout is set, cancel it */
-  if (self->timeout_id > 0)
-    g_source_remove (self->timeout_id);
+  /*
+   * The deadline starts with the oldest command waiting, and is not pushed
+   * back by the commands that are queued after it.
+   */
+  if (self->flush_timeout_id == 0 && !self->flush_requested)
+    self->flush_timeout_id = g_timeout_add (FLUSH_MAX_WAIT_MS, on_flush_timeout_cb, self);
 
-  self->timeout_id = g_timeout_add_seconds (1, on_schedule_wait_timeout_cb, self);
+  dispatch_batches (self);
 }
 
 static void
@@ -871,6 +1688,48 @@ parse_json_from_response (JsonParser    *parser,
 #endif
 }
 
+static gchar*
+build_item_update_command (GtdTask  *task,
+                           gchar   **out_command_uid)
+{
+  g_autoptr (GDateTime) local_due_date = NULL;
+  g_autoptr (GDateTime) due_date = NULL;
+  g_autofree gchar *escaped_title = NULL;
+  g_autofree gchar *command_uid = NULL;
+  g_autofree gchar *due_dt = NULL;
+  gchar *command;
+
+  escaped_title = escape_string_for_post (gtd_task_get_title (task));
+  local_due_date = gtd_task_get_due_date (task);
+  due_date = local_due_date ? g_date_time_to_utc (local_due_date) : NULL;
+  due_dt = due_date ? g_date_time_format (due_date, "\"%FT%R\"") : g_strdup ("null");
+
+  command_uid = g_uuid_string_random ();
+  command = g_strdup_printf ("{                                \n"
+                             "    \"type\": \"item_update\",   \n"
+                             "    \"uuid\": \"%s\",            \n"
+                             "    \"args\": {                  \n"
+                             "        \"checked\": %d,         \n"
+                             "        \"content\": \"%s\",     \n"
+                             "        \"due_date_utc\": %s,    \n"
+                             "        \"id\": %s,              \n"
+                             "        \"indent\": %d,          \n"
+                             "        \"item_order\": %ld      \n"
+                             "    }                            \n"
+                             "}",
+                             command_uid,
+                             gtd_task_get_complete (task),
+                             escaped_title,
+                             due_dt,
+                             gtd_object_get_uid (GTD_OBJECT (task)),
+                             gtd_task_get_depth (task) + 1,
+                             gtd_task_get_position (task));
+
+  *out_command_uid = g_steal_pointer (&command_uid);
+
+  return command;
+}
+
 static void
 update_task_position (GtdProviderTodoist *self,
                       GtdTask            *task,
@@ -923,44 +1782,97 @@ update_task_position (GtdProviderTodoist *self,
  * Callbacks
  */
 
+static void
+on_cache_saved_cb (GObject      *source_object,
+                   GAsyncResult *result,
+                   gpointer      user_data)
+{
+  g_autoptr (GError) error = NULL;
+
+  if (!g_file_replace_contents_finish (G_FILE (source_object), result, NULL, &error))
+    g_warning ("Error saving Todoist cache: %s", error->message);
+}
+
+static gboolean
+on_flush_timeout_cb (gpointer data)
+{
+  GtdProviderTodoist *self = (GtdProviderTodoist *) data;
+
+  self->flush_timeout_id = 0;
+
+  flush_request_queue (self);
+
+  return G_SOURCE_REMOVE;
+}
+
 static gboolean
-on_schedule_wait_timeout_cb (gpointer data)
+on_backoff_timeout_cb (gpointer data)
 {
   GtdProviderTodoist *self = (GtdProviderTodoist *) data;
 
-  self->timeout_id = 0;
+  self->backoff_timeout_id = 0;
 
-  process_request_queue (self);
+  flush_request_queue (self);
 
   return G_SOURCE_REMOVE;
 }
 
+static void
+on_payload_decoded_cb (GObject      *source_object,
+                       GAsyncResult *result,
+                       gpointer      user_data)
+{
+  g_autoptr (GError) error = NULL;
+  GtdProviderTodoist *self;
+  GtdTodoistPayload *payload;
+
+  self = GTD_PROVIDER_TODOIST (source_object);
+  payload = g_task_propagate_pointer (G_TASK (result), &error);
+
+  if (!payload)
+    {
+      /* Unmark the GtdManager as loading */
+      gtd_object_pop_loading (GTD_OBJECT (self));
+      gtd_object_pop_loading (GTD_OBJECT (gtd_manager_get_default ()));
+
+      gtd_manager_emit_error_message (gtd_manager_get_default (),
+                                      _("An error occurred while retrieving Todoist data"),
+                                      error->message,
+                                      NULL,
+                                      NULL);
+
+      g_warning ("Error parsing Todoist data: %s", error->message);
+      return;
+    }
+
+  /* The provider stays loading until the payload is fully applied */
+  start_sync_application (self, payload);
+}
+
 static void
 on_synchronize_completed_cb (RestProxyCall *call,
                              const GError  *post_error,
                              GObject       *weak_object,
                              gpointer       user_data)
 {
-  g_autoptr (JsonParser) parser = NULL;
-  g_autoptr (JsonObject) object = NULL;
   g_autoptr (GError) error = NULL;
+  g_autoptr (GTask) task = NULL;
   GtdProviderTodoist *self;
+  GBytes *payload;
 
   self = GTD_PROVIDER_TODOIST (weak_object);
-  parser = json_parser_new ();
-
-  /* Unmark the GtdManager as loading */
-  gtd_object_pop_loading (GTD_OBJECT (self));
-  gtd_object_pop_loading (GTD_OBJECT (gtd_manager_get_default ()));
 
   /* Release the application */
-	g_application_release (g_application_get_default ());
+  release_application ();
 
-  parse_json_from_response (parser, call);
-  check_post_response_for_errors (call, parser, NULL, post_error, &error);
+  record_response (self, call);
 
-  if (error)
+  if (!check_status_code (call, &error))
     {
+      /* Unmark the GtdManager as loading */
+      gtd_object_pop_loading (GTD_OBJECT (self));
+      gtd_object_pop_loading (GTD_OBJECT (gtd_manager_get_default ()));
+
       gtd_manager_emit_error_message (gtd_manager_get_default (),
                                       _("An error occurred while retrieving Todoist data"),
                                       error->message,
@@ -971,43 +1883,30 @@ on_synchronize_completed_cb (RestProxyCall *call,
       return;
     }
 
-  object = json_node_dup_object (json_parser_get_root (parser));
+  /* The response of large accounts takes long to decode, so it's done in a thread */
+  payload = g_bytes_new (rest_proxy_call_get_payload (call), rest_proxy_call_get_payload_length (call));
 
-  if (json_object_has_member (object, "sync_token"))
-    {
-      g_clear_pointer (&self->sync_token, g_free);
-      self->sync_token = g_strdup (json_object_get_string_member (object, "sync_token"));
-    }
-
-  load_tasks (self, object);
+  task = g_task_new (self, NULL, on_payload_decoded_cb, NULL);
+  g_task_set_source_tag (task, on_synchronize_completed_cb);
+  g_task_set_task_data (task, payload, (GDestroyNotify) g_bytes_unref);
+  g_task_run_in_thread (task, decode_payload_in_thread_cb);
 }
 
 static void
-on_operation_completed_cb (RestProxyCall *call,
-                           const GError  *post_error,
-                           GObject       *weak_object,
-                           gpointer       user_data)
+apply_batch (GtdProviderTodoist *self,
+             Batch              *batch)
 {
   g_autoptr (JsonParser) parser = NULL;
-  g_autoptr (GList) requests = NULL;
-  g_autoptr (GList) l = NULL;
-  GtdProviderTodoist *self;
+  GList *retry_requests = NULL;
+  GList *l;
   JsonObject *object;
 
-  self = GTD_PROVIDER_TODOIST (weak_object);
-  requests = (GList *) user_data;
-
-  g_debug ("Received response for POST request");
-
-  /* Release the hold since queue is empty */
-  g_application_release (g_application_get_default ());
-
   /* Parse the response */
   parser = json_parser_new ();
 
-  parse_json_from_response (parser, call);
+  parse_json_from_response (parser, batch->call);
 
-  for (l = requests; l; l = l->next)
+  for (l = batch->requests; l; l = l->next)
     {
       g_autoptr (GError) error = NULL;
       PostCallbackData *data;
@@ -1016,23 +1915,25 @@ on_operation_completed_cb (RestProxyCall *call,
 
       g_debug ("Parsing command %s", data->command_uid);
 
-      check_post_response_for_errors (call, parser, data, post_error, &error);
+      check_post_response_for_errors (batch->call, parser, data, batch->error, &error);
 
       if (error)
         {
           if (g_error_matches (error, GTD_PROVIDER_TODOIST_ERROR, GTD_PROVIDER_TODOIST_ERROR_BAD_GATEWAY))
             {
               g_debug ("Bad gateway received, trying again immediately");
-              g_queue_push_tail (self->queue, data);
+
+              retry_requests = g_list_prepend (retry_requests, data);
+              self->flush_requested = TRUE;
             }
           else if (g_error_matches (error, GTD_PROVIDER_TODOIST_ERROR, GTD_PROVIDER_TODOIST_ERROR_LIMIT_REACHED))
             {
-              g_debug ("Rescheduling dispatch timeout to 60 seconds");
+              g_debug ("Rescheduling dispatch timeout to %d seconds", RATE_LIMIT_BACKOFF_S);
 
-              g_queue_push_tail (self->queue, data);
+              retry_requests = g_list_prepend (retry_requests, data);
 
-              if (self->timeout_id == 0)
-                self->timeout_id = g_timeout_add_seconds (60, on_schedule_wait_timeout_cb, self);
+              if (self->backoff_timeout_id == 0)
+                self->backoff_timeout_id = g_timeout_add_seconds (RATE_LIMIT_BACKOFF_S, on_backoff_timeout_cb, self);
             }
           else
             {
@@ -1046,10 +1947,7 @@ on_operation_completed_cb (RestProxyCall *call,
 
               /* Not too much we can do here... */
               gtd_object_pop_loading (data->object);
-
-              g_clear_pointer (&data->command_uid, g_free);
-              g_clear_pointer (&data->command, g_free);
-              g_clear_pointer (&data, g_free);
+              post_callback_data_free (data);
             }
 
           continue;
@@ -1074,13 +1972,71 @@ on_operation_completed_cb (RestProxyCall *call,
       /* Apply the request operation */
       parse_request (self, data->object, data->request_type);
 
-      g_clear_pointer (&data->command_uid, g_free);
-      g_clear_pointer (&data->command, g_free);
-      g_clear_pointer (&data, g_free);
+      schedule_save_cache (self);
+
+      post_callback_data_free (data);
+    }
+
+  /* All commands were either applied, dropped or are retried now */
+  g_clear_pointer (&batch->requests, g_list_free);
+
+  /*
+   * Failed commands go back to the front of the queue in their original
+   * order. They were already marked as loading when first sent.
+   */
+  for (l = retry_requests; l; l = l->next)
+    {
+      PostCallbackData *data = l->data;
+
+      gtd_object_pop_loading (data->object);
+      g_queue_push_tail (self->queue, data);
+    }
+
+  g_list_free (retry_requests);
+}
+
+static void
+on_operation_completed_cb (RestProxyCall *call,
+                           const GError  *post_error,
+                           GObject       *weak_object,
+                           gpointer       user_data)
+{
+  GtdProviderTodoist *self;
+  Batch *batch;
+
+  self = GTD_PROVIDER_TODOIST (weak_object);
+  batch = (Batch *) user_data;
+
+  g_debug ("Received response for POST request");
+
+  /* Release the hold since queue is empty */
+  release_application ();
+
+  record_response (self, call);
+
+  batch->call = g_object_ref (call);
+  batch->error = post_error ? g_error_copy (post_error) : NULL;
+  batch->completed = TRUE;
+
+  /*
+   * Batches may complete out of order, but their results are applied in the
+   * order they were sent, so that e.g. the last sync_token wins.
+   */
+  while (!g_queue_is_empty (self->in_flight))
+    {
+      Batch *head = g_queue_peek_head (self->in_flight);
+
+      if (!head->completed)
+        break;
+
+      g_queue_pop_head (self->in_flight);
+
+      apply_batch (self, head);
+      batch_free (head);
     }
 
   /* Dispatch next batch of queued requests */
-  process_request_queue (self);
+  dispatch_batches (self);
 }
 
 
@@ -1202,45 +2158,15 @@ static void
 gtd_provider_todoist_update_task (GtdProvider *provider,
                                   GtdTask     *task)
 {
-  g_autoptr (GDateTime) local_due_date = NULL;
-  g_autoptr (GDateTime) due_date = NULL;
   GtdProviderTodoist *self;
-  g_autofree gchar *escaped_title = NULL;
   g_autofree gchar *command_uid = NULL;
   g_autofree gchar *command = NULL;
-  g_autofree gchar *due_dt = NULL;
 
   self = GTD_PROVIDER_TODOIST (provider);
-  due_dt = command = command_uid = NULL;
-  escaped_title = NULL;
 
   CHECK_ACCESS_TOKEN (self);
 
-  escaped_title = escape_string_for_post (gtd_task_get_title (task));
-  local_due_date = gtd_task_get_due_date (task);
-  due_date = local_due_date ? g_date_time_to_utc (local_due_date) : NULL;
-  due_dt = due_date ? g_date_time_format (due_date, "\"%FT%R\"") : g_strdup ("null");
-
-  command_uid = g_uuid_string_random ();
-  command = g_strdup_printf ("{                                \n"
-                             "    \"type\": \"item_update\",   \n"
-                             "    \"uuid\": \"%s\",            \n"
-                             "    \"args\": {                  \n"
-                             "        \"checked\": %d,         \n"
-                             "        \"content\": \"%s\",     \n"
-                             "        \"due_date_utc\": %s,    \n"
-                             "        \"id\": %s,              \n"
-                             "        \"indent\": %d,          \n"
-                             "        \"item_order\": %ld,     \n"
-                             "    }                            \n"
-                             "}",
-                             command_uid,
-                             gtd_task_get_complete (task),
-                             escaped_title,
-                             due_dt,
-                             gtd_object_get_uid (GTD_OBJECT (task)),
-                             gtd_task_get_depth (task) + 1,
-                             gtd_task_get_position (task));
+  command = build_item_update_command (task, &command_uid);
 
   schedule_post_request (self, task, REQUEST_TASK_UPDATE, command_uid, command);
 
@@ -1251,6 +2177,59 @@ gtd_provider_todoist_update_task (GtdProvider *provider,
   update_task_position (self, task, TRUE);
 }
 
+static void
+gtd_provider_todoist_update_tasks (GtdProvider         *provider,
+                                   GPtrArray           *tasks,
+                                   GCancellable        *cancellable,
+                                   GAsyncReadyCallback  callback,
+                                   gpointer             user_data)
+{
+  g_autoptr (GTask) gtask = NULL;
+  GtdProviderTodoist *self;
+  guint i;
+
+  self = GTD_PROVIDER_TODOIST (provider);
+  gtask = g_task_new (provider, cancellable, callback, user_data);
+  g_task_set_source_tag (gtask, gtd_provider_todoist_update_tasks);
+
+  if (!self->access_token)
+    {
+      emit_access_token_error ();
+      g_task_return_new_error (gtask,
+                               GTD_PROVIDER_TODOIST_ERROR,
+                               GTD_PROVIDER_TODOIST_ERROR_NOT_ALLOWED,
+                               "No access token");
+      return;
+    }
+
+  /*
+   * The tasks already have their final positions, so there's no need to
+   * recalculate them like gtd_provider_todoist_update_task() does.
+   */
+  for (i = 0; i < tasks->len; i++)
+    {
+      g_autofree gchar *command_uid = NULL;
+      g_autofree gchar *command = NULL;
+      GtdTask *task;
+
+      task = g_ptr_array_index (tasks, i);
+      command = build_item_update_command (task, &command_uid);
+
+      schedule_post_request (self, task, REQUEST_TASK_UPDATE, command_uid, command);
+    }
+
+  /* Full batches are already on their way, and the rest is sent within FLUSH_MAX_WAIT_MS */
+  g_task_return_boolean (gtask, TRUE);
+}
+
+static gboolean
+gtd_provider_todoist_update_tasks_finish (GtdProvider   *provider,
+                                          GAsyncResult  *result,
+                                          GError       **error)
+{
+  return g_task_propagate_boolean (G_TASK (result), error);
+}
+
 static void
 gtd_provider_todoist_remove_task (GtdProvider *provider,
                                   GtdTask     *task)
@@ -1409,6 +2388,7 @@ update_description (GtdProviderTodoist *self)
   account = goa_object_get_account (self->account_object);
   identity = goa_account_get_identity (account);
   self->description = g_strdup_printf (_("Todoist: %s"), identity);
+  self->account_id = g_strdup (goa_account_get_id (account));
 
   g_object_unref (account);
 }
@@ -1424,6 +2404,8 @@ gtd_provider_iface_init (GtdProviderInterface *iface)
   iface->get_icon = gtd_provider_todoist_get_icon;
   iface->create_task = gtd_provider_todoist_create_task;
   iface->update_task = gtd_provider_todoist_update_task;
+  iface->update_tasks = gtd_provider_todoist_update_tasks;
+  iface->update_tasks_finish = gtd_provider_todoist_update_tasks_finish;
   iface->remove_task = gtd_provider_todoist_remove_task;
   iface->create_task_list = gtd_provider_todoist_create_task_list;
   iface->update_task_list = gtd_provider_todoist_update_task_list;
@@ -1438,11 +2420,27 @@ gtd_provider_todoist_finalize (GObject *object)
 {
   GtdProviderTodoist *self = (GtdProviderTodoist *)object;
 
+  flush_save_cache (self);
+
+  g_clear_handle_id (&self->flush_timeout_id, g_source_remove);
+  g_clear_handle_id (&self->backoff_timeout_id, g_source_remove);
+  g_clear_handle_id (&self->apply_sync_id, g_source_remove);
+
+  /* A sync that wasn't fully applied still holds the GtdManager loading */
+  if (self->sync_application)
+    gtd_object_pop_loading (GTD_OBJECT (gtd_manager_get_default ()));
+
+  g_clear_pointer (&self->sync_application, sync_application_free);
   g_clear_pointer (&self->lists, g_hash_table_destroy);
   g_clear_pointer (&self->tasks, g_hash_table_destroy);
   g_clear_object (&self->icon);
   g_clear_pointer (&self->sync_token, g_free);
   g_clear_pointer (&self->description, g_free);
+  g_clear_pointer (&self->access_token, g_free);
+  g_clear_pointer (&self->account_id, g_free);
+  g_clear_pointer (&self->url, g_free);
+  g_clear_object (&self->proxy);
+  g_queue_free_full (self->in_flight, (GDestroyNotify) batch_free);
   g_queue_free (self->queue);
 
   G_OBJECT_CLASS (gtd_provider_todoist_parent_class)->finalize (object);
@@ -1503,12 +2501,20 @@ gtd_provider_todoist_set_property (GObject      *object,
     case PROP_GOA_OBJECT:
       self->account_object = GOA_OBJECT (g_value_dup_object (value));
 
+      /* Tests create the provider without an account */
+      if (!self->account_object)
+        break;
+
       update_description (self);
       store_access_token (self);
 
       /* Only synchronize if we have an access token */
       if (self->access_token)
-        synchronize (self);
+        {
+          /* Show the last known state right away, and then fetch what changed since */
+          load_cache (self);
+          synchronize (self);
+        }
 
       break;
 
@@ -1547,7 +2553,9 @@ static void
 gtd_provider_todoist_init (GtdProviderTodoist *self)
 {
   self->sync_token = g_strdup ("*");
+  self->url = g_strdup (TODOIST_URL);
   self->queue = g_queue_new ();
+  self->in_flight = g_queue_new ();
   self->icon = G_ICON (g_themed_icon_new_with_default_fallbacks ("goa-account-todoist"));
 
   /* Project id → GtdTaskList */
@@ -1566,6 +2574,40 @@ gtd_provider_todoist_new (GoaObject *account_object)
                        NULL);
 }
 
+GtdProviderTodoist*
+_gtd_provider_todoist_new_for_url (const gchar *account_id,
+                                   const gchar *access_token,
+                                   const gchar *url)
+{
+  GtdProviderTodoist *self;
+
+  g_return_val_if_fail (account_id != NULL, NULL);
+  g_return_val_if_fail (access_token != NULL, NULL);
+  g_return_val_if_fail (url != NULL, NULL);
+
+  self = g_object_new (GTD_TYPE_PROVIDER_TODOIST, NULL);
+  self->account_id = g_strdup (account_id);
+  self->access_token = g_strdup (access_token);
+
+  g_clear_pointer (&self->url, g_free);
+  self->url = g_strdup (url);
+
+  load_cache (self);
+  synchronize (self);
+
+  return self;
+}
+
+void
+_gtd_provider_todoist_get_stats (GtdProviderTodoist      *self,
+                                 GtdProviderTodoistStats *out_stats)
+{
+  g_return_if_fail (GTD_IS_PROVIDER_TODOIST (self));
+  g_return_if_fail (out_stats != NULL);
+
+  *out_stats = self->stats;
+}
+
 GoaObject*
 gtd_provider_todoist_get_goa_object (GtdProviderTodoist  *self)
 {
@@ -0,0 +1,345 @@
+/* gtd-todoist-parser.c
+ *
+ * Copyright 2020 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#define G_LOG_DOMAIN "GtdTodoistParser"
+
+#define _XOPEN_SOURCE
+
+#include "gtd-todoist-parser.h"
+
+#include <time.h>
+
+
+/*
+ * Auxiliary methods
+ */
+
+static void
+project_free (GtdTodoistProject *project)
+{
+  g_clear_pointer (&project->name, g_free);
+  g_free (project);
+}
+
+static void
+item_free (GtdTodoistItem *item)
+{
+  g_clear_pointer (&item->content, g_free);
+  g_clear_pointer (&item->due_date, g_date_time_unref);
+  g_clear_pointer (&item->creation_date, g_date_time_unref);
+  g_free (item);
+}
+
+static void
+project_items_free (GtdTodoistProjectItems *project_items)
+{
+  g_clear_pointer (&project_items->items, g_ptr_array_unref);
+  g_free (project_items);
+}
+
+static gboolean
+get_deleted (JsonObject *object)
+{
+  return json_object_has_member (object, "is_deleted") &&
+         json_object_get_boolean_member (object, "is_deleted");
+}
+
+static GDateTime*
+get_date (JsonObject  *object,
+          const gchar *member)
+{
+  const gchar *date;
+
+  date = json_object_get_string_member (object, member);
+
+  return date ? gtd_todoist_parser_parse_date (date) : NULL;
+}
+
+static gint
+compare_items_by_position (gconstpointer a,
+                           gconstpointer b)
+{
+  GtdTodoistItem *item_a = *((GtdTodoistItem **) a);
+  GtdTodoistItem *item_b = *((GtdTodoistItem **) b);
+
+  if (item_a->position != item_b->position)
+    return item_a->position < item_b->position ? -1 : 1;
+
+  return item_a->id < item_b->id ? -1 : item_a->id > item_b->id;
+}
+
+static GPtrArray*
+parse_projects (JsonArray *array)
+{
+  GPtrArray *projects;
+  guint i;
+
+  projects = g_ptr_array_new_full (json_array_get_length (array), (GDestroyNotify) project_free);
+
+  for (i = 0; i < json_array_get_length (array); i++)
+    {
+      GtdTodoistProject *project;
+      JsonObject *object;
+
+      object = json_array_get_object_element (array, i);
+
+      project = g_new0 (GtdTodoistProject, 1);
+      project->id = json_object_get_int_member (object, "id");
+      project->deleted = get_deleted (object);
+
+      if (!project->deleted)
+        {
+          project->name = g_strdup (json_object_get_string_member (object, "name"));
+          project->color = json_object_get_int_member (object, "color");
+        }
+
+      g_ptr_array_add (projects, project);
+    }
+
+  return projects;
+}
+
+/*
+ * Figures out the parent of each item from the indentation, the same way
+ * Todoist does. This is only meaningful when all the items of the project
+ * are known, i.e. on full syncs.
+ */
+static void
+resolve_hierarchy (GPtrArray *items)
+{
+  GQueue stack = G_QUEUE_INIT;
+  gint previous_indent;
+  guint i;
+
+  previous_indent = 0;
+
+  for (i = 0; i < items->len; i++)
+    {
+      GtdTodoistItem *item;
+      GtdTodoistItem *parent;
+      gint j;
+
+      item = g_ptr_array_index (items, i);
+
+      if (item->deleted)
+        continue;
+
+      /* If the indent changed, remove from the difference in level from stack */
+      for (j = 0; j <= previous_indent - item->indent; j++)
+        g_queue_pop_head (&stack);
+
+      parent = g_queue_peek_head (&stack);
+      item->parent_id = parent ? parent->id : 0;
+
+      g_queue_push_head (&stack, item);
+
+      previous_indent = item->indent;
+    }
+
+  g_queue_clear (&stack);
+}
+
+static GPtrArray*
+parse_items (JsonArray *array,
+             gboolean   full_sync)
+{
+  g_autoptr (GHashTable) project_to_items = NULL;
+  GPtrArray *project_items;
+  guint i;
+
+  project_to_items = g_hash_table_new (g_int64_hash, g_int64_equal);
+  project_items = g_ptr_array_new_with_free_func ((GDestroyNotify) project_items_free);
+
+  for (i = 0; i < json_array_get_length (array); i++)
+    {
+      GtdTodoistProjectItems *items;
+      GtdTodoistItem *item;
+      JsonObject *object;
+
+      object = json_array_get_object_element (array, i);
+
+      item = g_new0 (GtdTodoistItem, 1);
+      item->id = json_object_get_int_member (object, "id");
+      item->project_id = json_object_get_int_member (object, "project_id");
+      item->deleted = get_deleted (object);
+
+      if (!item->deleted)
+        {
+          item->content = g_strdup (json_object_get_string_member (object, "content"));
+          item->checked = json_object_get_int_member (object, "checked") != 0;
+          item->position = json_object_get_int_member (object, "item_order");
+          item->indent = json_object_get_int_member (object, "indent");
+          item->due_date = get_date (object, "due_date_utc");
+          item->creation_date = get_date (object, "date_added");
+        }
+
+      /* Group the items by project, in the order the projects first appear */
+      items = g_hash_table_lookup (project_to_items, &item->project_id);
+
+      if (!items)
+        {
+          items = g_new0 (GtdTodoistProjectItems, 1);
+          items->project_id = item->project_id;
+          items->items = g_ptr_array_new_with_free_func ((GDestroyNotify) item_free);
+
+          g_hash_table_insert (project_to_items, &items->project_id, items);
+          g_ptr_array_add (project_items, items);
+        }
+
+      g_ptr_array_add (items->items, item);
+    }
+
+  for (i = 0; i < project_items->len; i++)
+    {
+      GtdTodoistProjectItems *items = g_ptr_array_index (project_items, i);
+
+      g_ptr_array_sort (items->items, compare_items_by_position);
+
+      if (full_sync)
+        resolve_hierarchy (items->items);
+    }
+
+  return project_items;
+}
+
+
+/*
+ * Public API
+ */
+
+/**
+ * gtd_todoist_parser_parse_payload:
+ * @data: the JSON response of a sync request
+ * @length: the length of @data, or -1 if it is nul-terminated
+ * @error: return location for a #GError
+ *
+ * Decodes a sync response into plain records. This function is
+ * thread-safe.
+ *
+ * Returns: (transfer full)(nullable): the decoded payload, or %NULL
+ */
+GtdTodoistPayload*
+gtd_todoist_parser_parse_payload (const gchar  *data,
+                                  gssize        length,
+                                  GError      **error)
+{
+  g_autoptr (JsonParser) parser = NULL;
+  JsonNode *root;
+
+  parser = json_parser_new_immutable ();
+
+  if (!json_parser_load_from_data (parser, data, length, error))
+    return NULL;
+
+  root = json_parser_get_root (parser);
+
+  if (!JSON_NODE_HOLDS_OBJECT (root))
+    {
+      g_set_error_literal (error,
+                           JSON_PARSER_ERROR,
+                           JSON_PARSER_ERROR_INVALID_DATA,
+                           "The sync response is not an object");
+      return NULL;
+    }
+
+  return gtd_todoist_parser_parse_payload_object (json_node_get_object (root));
+}
+
+/**
+ * gtd_todoist_parser_parse_payload_object:
+ * @object: the root object of a sync response
+ *
+ * Same as gtd_todoist_parser_parse_payload(), for an already parsed
+ * response.
+ *
+ * Returns: (transfer full): the decoded payload
+ */
+GtdTodoistPayload*
+gtd_todoist_parser_parse_payload_object (JsonObject *object)
+{
+  GtdTodoistPayload *payload;
+
+  payload = g_new0 (GtdTodoistPayload, 1);
+
+  /*
+   * A full sync, which happens when the local state is too old, has every
+   * object; anything else is a delta with only what changed since the last
+   * sync_token.
+   */
+  payload->full_sync = json_object_has_member (object, "full_sync") &&
+                       json_object_get_boolean_member (object, "full_sync");
+
+  if (json_object_has_member (object, "sync_token"))
+    payload->sync_token = g_strdup (json_object_get_string_member (object, "sync_token"));
+
+  if (json_object_has_member (object, "projects"))
+    payload->projects = parse_projects (json_object_get_array_member (object, "projects"));
+  else
+    payload->projects = g_ptr_array_new ();
+
+  if (json_object_has_member (object, "items"))
+    payload->project_items = parse_items (json_object_get_array_member (object, "items"), payload->full_sync);
+  else
+    payload->project_items = g_ptr_array_new ();
+
+  return payload;
+}
+
+void
+gtd_todoist_payload_free (GtdTodoistPayload *payload)
+{
+  g_clear_pointer (&payload->sync_token, g_free);
+  g_clear_pointer (&payload->projects, g_ptr_array_unref);
+  g_clear_pointer (&payload->project_items, g_ptr_array_unref);
+  g_free (payload);
+}
+
+/**
+ * gtd_todoist_parser_parse_date:
+ * @date: a date, either in ISO 8601 or in Todoist's format
+ *
+ * Parses @date to a local #GDateTime.
+ *
+ * Returns: (transfer full)(nullable): a #GDateTime, or %NULL
+ */
+GDateTime*
+gtd_todoist_parser_parse_date (const gchar *date)
+{
+  g_autoptr (GDateTime) dt = NULL;
+  struct tm due_dt = { 0, };
+
+  /* The local cache stores dates in ISO 8601 */
+  dt = g_date_time_new_from_iso8601 (date, NULL);
+
+  if (dt)
+    return g_date_time_to_local (dt);
+
+  if (!strptime (date, "%a %d %b %Y %T %z", &due_dt))
+    return NULL;
+
+  dt = g_date_time_new_utc (due_dt.tm_year + 1900,
+                            due_dt.tm_mon + 1,
+                            due_dt.tm_mday,
+                            due_dt.tm_hour,
+                            due_dt.tm_min,
+                            due_dt.tm_sec);
+
+  return g_date_time_to_local (dt);
+}
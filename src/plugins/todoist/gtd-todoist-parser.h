@@ -0,0 +1,82 @@
+/* gtd-todoist-parser.h
+ *
+ * Copyright 2020 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#pragma once
+
+#include <glib.h>
+#include <json-glib/json-glib.h>
+
+G_BEGIN_DECLS
+
+/*
+ * Plain records decoded from a sync response. They don't touch any
+ * GObject, so they can be built in a worker thread, and then turned into
+ * lists and tasks in the main thread.
+ */
+typedef struct
+{
+  guint32             id;
+  gchar              *name;
+  gint                color;
+  gboolean            deleted;
+} GtdTodoistProject;
+
+typedef struct
+{
+  gint64              id;
+  gint64              project_id;
+  gint64              parent_id;
+  gchar              *content;
+  GDateTime          *due_date;
+  GDateTime          *creation_date;
+  gint64              position;
+  gint                indent;
+  gboolean            checked;
+  gboolean            deleted;
+} GtdTodoistItem;
+
+/* The items of a project, sorted by position */
+typedef struct
+{
+  gint64              project_id;
+  GPtrArray          *items;
+} GtdTodoistProjectItems;
+
+typedef struct
+{
+  gchar              *sync_token;
+  gboolean            full_sync;
+  GPtrArray          *projects;
+  GPtrArray          *project_items;
+} GtdTodoistPayload;
+
+GtdTodoistPayload*   gtd_todoist_parser_parse_payload            (const gchar        *data,
+                                                                  gssize              length,
+                                                                  GError            **error);
+
+GtdTodoistPayload*   gtd_todoist_parser_parse_payload_object     (JsonObject         *object);
+
+void                 gtd_todoist_payload_free                    (GtdTodoistPayload  *payload);
+
+GDateTime*           gtd_todoist_parser_parse_date               (const gchar        *date);
+
+G_DEFINE_AUTOPTR_CLEANUP_FUNC (GtdTodoistPayload, gtd_todoist_payload_free)
+
+G_END_DECLS
@@ -0,0 +1,231 @@
+/* benchmark-easing.c
+ *
+ * Copyright 2020 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "gnome-todo.h"
+
+#include "animation/gtd-interval-private.h"
+#include "core/gtd-log.h"
+
+typedef gdouble (*EasingFunc) (GtdEaseMode mode,
+                               gdouble     t,
+                               gdouble     d);
+
+static gint iterations = 1000000;
+static gchar *output = NULL;
+
+/* Keeps the compiler from optimizing the evaluations away */
+static volatile gdouble sink = 0.0;
+
+static GOptionEntry entries[] = {
+  { "iterations", 'i', 0, G_OPTION_ARG_INT, &iterations, "Number of evaluations per easing mode", "1000000" },
+  { "output", 'o', 0, G_OPTION_ARG_FILENAME, &output, "Write the JSON results to this file instead of stdout", "FILE" },
+  { NULL }
+};
+
+
+/*
+ * Auxiliary methods
+ */
+
+static gdouble
+usec_to_nsec_per_iteration (gint64 usec)
+{
+  return usec * 1000.0 / iterations;
+}
+
+
+/*
+ * Benchmarks
+ */
+
+static gint64
+benchmark_easing (EasingFunc  func,
+                  GtdEaseMode mode)
+{
+  gdouble sum = 0.0;
+  gint64 start;
+  gint i;
+
+  start = g_get_monotonic_time ();
+
+  for (i = 0; i < iterations; i++)
+    sum += func (mode, i, iterations);
+
+  sink = sum;
+
+  return g_get_monotonic_time () - start;
+}
+
+static gint64
+benchmark_interval_boxed (GtdInterval *interval)
+{
+  GValue value = G_VALUE_INIT;
+  gdouble sum = 0.0;
+  gint64 start;
+  gint i;
+
+  start = g_get_monotonic_time ();
+
+  /* What GtdPropertyTransition did on every frame */
+  for (i = 0; i < iterations; i++)
+    {
+      g_value_init (&value, G_TYPE_FLOAT);
+      gtd_interval_compute_value (interval, (gdouble) i / iterations, &value);
+      sum += g_value_get_float (&value);
+      g_value_unset (&value);
+    }
+
+  sink = sum;
+
+  return g_get_monotonic_time () - start;
+}
+
+static gint64
+benchmark_interval_unboxed (GtdInterval *interval)
+{
+  gdouble sum = 0.0;
+  gint64 start;
+  gint i;
+
+  start = g_get_monotonic_time ();
+
+  for (i = 0; i < iterations; i++)
+    {
+      gdouble value;
+
+      gtd_interval_compute_double (interval, (gdouble) i / iterations, &value);
+      sum += value;
+    }
+
+  sink = sum;
+
+  return g_get_monotonic_time () - start;
+}
+
+static void
+run_easing_benchmarks (GString *json)
+{
+  GtdEaseMode mode;
+
+  g_string_append (json, "  \"easing\": [\n");
+
+  for (mode = GTD_EASE_LINEAR; mode < GTD_EASE_LAST; mode++)
+    {
+      gint64 analytic_usec;
+      gint64 table_usec;
+
+      /* Build the table before timing the lookups */
+      gtd_easing_for_mode_table (mode, 0.0, 1.0);
+
+      analytic_usec = benchmark_easing (gtd_easing_for_mode, mode);
+      table_usec = benchmark_easing (gtd_easing_for_mode_table, mode);
+
+      g_string_append_printf (json,
+                              "    {\n"
+                              "      \"mode\": \"%s\",\n"
+                              "      \"analytic-nsec\": %.2f,\n"
+                              "      \"table-nsec\": %.2f,\n"
+                              "      \"max-error\": %.3e\n"
+                              "    }%s\n",
+                              gtd_get_easing_name_for_mode (mode),
+                              usec_to_nsec_per_iteration (analytic_usec),
+                              usec_to_nsec_per_iteration (table_usec),
+                              gtd_easing_get_table_error (mode),
+                              mode == GTD_EASE_LAST - 1 ? "" : ",");
+    }
+
+  g_string_append (json, "  ],\n");
+}
+
+static void
+run_interval_benchmarks (GString *json)
+{
+  g_autoptr (GtdInterval) interval = NULL;
+  gint64 boxed_usec;
+  gint64 unboxed_usec;
+
+  interval = g_object_ref_sink (gtd_interval_new (G_TYPE_FLOAT, 0.0f, 100.0f));
+
+  boxed_usec = benchmark_interval_boxed (interval);
+  unboxed_usec = benchmark_interval_unboxed (interval);
+
+  g_string_append_printf (json,
+                          "  \"interval\": {\n"
+                          "    \"boxed-nsec\": %.2f,\n"
+                          "    \"unboxed-nsec\": %.2f\n"
+                          "  }\n",
+                          usec_to_nsec_per_iteration (boxed_usec),
+                          usec_to_nsec_per_iteration (unboxed_usec));
+}
+
+gint
+main (gint   argc,
+      gchar *argv[])
+{
+  g_autoptr (GOptionContext) context = NULL;
+  g_autoptr (GString) json = NULL;
+  g_autoptr (GError) error = NULL;
+
+  context = g_option_context_new ("- benchmark the GNOME To Do easing functions");
+  g_option_context_add_main_entries (context, entries, NULL);
+
+  if (!g_option_context_parse (context, &argc, &argv, &error))
+    {
+      g_printerr ("%s\n", error->message);
+      return EXIT_FAILURE;
+    }
+
+  if (iterations <= 0)
+    {
+      g_printerr ("Invalid benchmark parameters\n");
+      return EXIT_FAILURE;
+    }
+
+  if (g_getenv ("G_MESSAGES_DEBUG"))
+    gtd_log_init ();
+
+  json = g_string_new ("{\n");
+
+  g_string_append_printf (json,
+                          "  \"parameters\": {\n"
+                          "    \"iterations\": %d\n"
+                          "  },\n",
+                          iterations);
+
+  run_easing_benchmarks (json);
+  run_interval_benchmarks (json);
+
+  g_string_append (json, "}\n");
+
+  if (output)
+    {
+      if (!g_file_set_contents (output, json->str, json->len, &error))
+        {
+          g_printerr ("Error writing results to %s: %s\n", output, error->message);
+          return EXIT_FAILURE;
+        }
+    }
+  else
+    {
+      g_print ("%s", json->str);
+    }
+
+  return EXIT_SUCCESS;
+}
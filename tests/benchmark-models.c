@@ -0,0 +1,416 @@
+/* benchmark-models.c
+ *
+ * Copyright 2020 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "gnome-todo.h"
+
+#include "core/gtd-log.h"
+#include "models/gtd-due-date-index.h"
+#include "models/gtd-due-date-index-private.h"
+#include "models/gtd-list-model-filter.h"
+#include "models/gtd-task-model.h"
+#include "models/gtd-task-model-private.h"
+#include "gtd-manager-protected.h"
+#include "dummy-provider.h"
+
+#define N_SORTED_INSERTS 1000
+#define N_REORDERS       100
+#define N_INVALIDATIONS  10
+#define N_ROLLOVERS      10
+
+typedef struct
+{
+  const gchar        *name;
+  guint               iterations;
+  gint64              total_usec;
+  gint64              min_usec;
+  gint64              max_usec;
+} Measurement;
+
+static gchar *sizes = NULL;
+static gint n_lists = 10;
+static gint subtask_depth = 2;
+static gint due_date_spread = 30;
+static gchar *output = NULL;
+
+static GOptionEntry entries[] = {
+  { "sizes", 's', 0, G_OPTION_ARG_STRING, &sizes, "Comma-separated numbers of tasks to benchmark", "1000,10000,100000" },
+  { "lists", 'l', 0, G_OPTION_ARG_INT, &n_lists, "Number of task lists the tasks are spread across", "10" },
+  { "subtask-depth", 'd', 0, G_OPTION_ARG_INT, &subtask_depth, "How deep subtasks are nested", "2" },
+  { "due-date-spread", 'u', 0, G_OPTION_ARG_INT, &due_date_spread, "Days around today in which due dates are spread, 0 for no due dates", "30" },
+  { "output", 'o', 0, G_OPTION_ARG_FILENAME, &output, "Write the JSON results to this file instead of stdout", "FILE" },
+  { NULL }
+};
+
+
+/*
+ * Auxiliary methods
+ */
+
+static void
+measurement_init (Measurement *measurement,
+                  const gchar *name)
+{
+  measurement->name = name;
+  measurement->iterations = 0;
+  measurement->total_usec = 0;
+  measurement->min_usec = G_MAXINT64;
+  measurement->max_usec = 0;
+}
+
+static void
+measurement_add (Measurement *measurement,
+                 gint64       usec)
+{
+  measurement->iterations++;
+  measurement->total_usec += usec;
+  measurement->min_usec = MIN (measurement->min_usec, usec);
+  measurement->max_usec = MAX (measurement->max_usec, usec);
+}
+
+static void
+measurement_to_json (Measurement *measurement,
+                     GString     *json,
+                     gboolean     last)
+{
+  g_string_append_printf (json,
+                          "        \"%s\": {\n"
+                          "          \"iterations\": %u,\n"
+                          "          \"total-usec\": %" G_GINT64_FORMAT ",\n"
+                          "          \"mean-usec\": %" G_GINT64_FORMAT ",\n"
+                          "          \"min-usec\": %" G_GINT64_FORMAT ",\n"
+                          "          \"max-usec\": %" G_GINT64_FORMAT "\n"
+                          "        }%s\n",
+                          measurement->name,
+                          measurement->iterations,
+                          measurement->total_usec,
+                          measurement->iterations > 0 ? measurement->total_usec / measurement->iterations : 0,
+                          measurement->iterations > 0 ? measurement->min_usec : 0,
+                          measurement->max_usec,
+                          last ? "" : ",");
+}
+
+static gboolean
+filter_incomplete_func (GObject  *item,
+                        gpointer  user_data)
+{
+  return !gtd_task_get_complete (GTD_TASK (item));
+}
+
+static GtdTaskList*
+get_largest_list (DummyProvider *provider)
+{
+  g_autoptr (GList) lists = NULL;
+  GtdTaskList *largest;
+  GList *l;
+
+  lists = gtd_provider_get_task_lists (GTD_PROVIDER (provider));
+  largest = NULL;
+
+  for (l = lists; l; l = l->next)
+    {
+      if (!largest ||
+          g_list_model_get_n_items (G_LIST_MODEL (l->data)) > g_list_model_get_n_items (G_LIST_MODEL (largest)))
+        {
+          largest = l->data;
+        }
+    }
+
+  return largest;
+}
+
+
+/*
+ * Benchmarks
+ */
+
+static void
+benchmark_initial_load (DummyProvider *provider,
+                        guint          n_tasks,
+                        Measurement   *measurement)
+{
+  gint64 start;
+
+  start = g_get_monotonic_time ();
+
+  dummy_provider_generate_tasks (provider, n_lists, n_tasks, subtask_depth, due_date_spread);
+  gtd_manager_add_provider (gtd_manager_get_default (), GTD_PROVIDER (provider));
+
+  measurement_add (measurement, g_get_monotonic_time () - start);
+}
+
+static void
+benchmark_sorted_insert (DummyProvider *provider,
+                         Measurement   *measurement)
+{
+  GtdTaskList *list;
+  guint n_items;
+  guint i;
+
+  list = get_largest_list (provider);
+  n_items = g_list_model_get_n_items (G_LIST_MODEL (list));
+
+  for (i = 0; i < N_SORTED_INSERTS; i++)
+    {
+      g_autoptr (GtdTask) task = NULL;
+      g_autofree gchar *uuid = NULL;
+      gint64 start;
+
+      uuid = g_uuid_string_random ();
+
+      task = gtd_task_new ();
+      gtd_task_set_list (task, list);
+      gtd_task_set_title (task, "Inserted task");
+      gtd_object_set_uid (GTD_OBJECT (task), uuid);
+      gtd_task_set_position (task, g_random_int_range (0, n_items + i + 1));
+
+      start = g_get_monotonic_time ();
+      gtd_task_list_add_task (list, task);
+      measurement_add (measurement, g_get_monotonic_time () - start);
+    }
+}
+
+static void
+benchmark_reorder (DummyProvider *provider,
+                   Measurement   *measurement)
+{
+  GtdTaskList *list;
+  guint n_items;
+  guint i;
+
+  list = get_largest_list (provider);
+  n_items = g_list_model_get_n_items (G_LIST_MODEL (list));
+
+  if (n_items < 2)
+    return;
+
+  for (i = 0; i < N_REORDERS; i++)
+    {
+      g_autoptr (GtdTask) task = NULL;
+      guint block_start;
+      guint block_length;
+      guint new_position;
+      gint64 start;
+
+      /* Only root tasks can be moved around */
+      task = g_list_model_get_item (G_LIST_MODEL (list), g_random_int_range (0, n_items));
+      while (gtd_task_get_parent (task))
+        g_set_object (&task, gtd_task_get_parent (task));
+
+      /* A task can't be moved into its own block of subtasks */
+      block_start = gtd_task_get_position (task);
+      block_length = gtd_task_get_n_total_subtasks (task) + 1;
+
+      if (block_length >= n_items)
+        continue;
+
+      new_position = g_random_int_range (0, n_items - block_length);
+      if (new_position >= block_start)
+        new_position += block_length;
+
+      start = g_get_monotonic_time ();
+      gtd_task_list_move_task_to_position (list, task, new_position);
+      measurement_add (measurement, g_get_monotonic_time () - start);
+    }
+}
+
+static void
+benchmark_filter_invalidation (Measurement *measurement)
+{
+  g_autoptr (GtdListModelFilter) filter = NULL;
+  guint i;
+
+  filter = gtd_list_model_filter_new (gtd_manager_get_tasks_model (gtd_manager_get_default ()));
+  gtd_list_model_filter_set_filter_func (filter, filter_incomplete_func, NULL, NULL);
+
+  for (i = 0; i < N_INVALIDATIONS; i++)
+    {
+      gint64 start;
+
+      start = g_get_monotonic_time ();
+      gtd_list_model_filter_invalidate (filter);
+      g_list_model_get_n_items (G_LIST_MODEL (filter));
+      measurement_add (measurement, g_get_monotonic_time () - start);
+    }
+}
+
+static void
+benchmark_flatten (Measurement *measurement)
+{
+  g_autoptr (GtdTaskModel) model = NULL;
+  gint64 start;
+  guint n_items;
+  guint i;
+
+  start = g_get_monotonic_time ();
+
+  model = _gtd_task_model_new (gtd_manager_get_default ());
+  n_items = g_list_model_get_n_items (G_LIST_MODEL (model));
+
+  for (i = 0; i < n_items; i++)
+    {
+      g_autoptr (GtdTask) task = g_list_model_get_item (G_LIST_MODEL (model), i);
+    }
+
+  measurement_add (measurement, g_get_monotonic_time () - start);
+}
+
+static void
+benchmark_day_rollover (Measurement *measurement)
+{
+  g_autoptr (GDateTime) now = NULL;
+  GtdDueDateIndex *index;
+  guint i;
+
+  now = g_date_time_new_now_local ();
+  index = gtd_manager_get_due_date_index (gtd_manager_get_default ());
+
+  for (i = 0; i < N_ROLLOVERS; i++)
+    {
+      g_autoptr (GDateTime) day = NULL;
+      GtdDueDateRange range;
+      gint64 start;
+
+      /* Move to the next day for real, so tasks actually change ranges */
+      day = g_date_time_add_days (now, i + 1);
+
+      start = g_get_monotonic_time ();
+
+      _gtd_due_date_index_set_today (index, day);
+
+      for (range = GTD_DUE_DATE_RANGE_OVERDUE; range < GTD_DUE_DATE_RANGE_LAST; range++)
+        g_list_model_get_n_items (gtd_due_date_index_get_model (index, range, FALSE));
+
+      measurement_add (measurement, g_get_monotonic_time () - start);
+    }
+
+  _gtd_due_date_index_set_today (index, now);
+}
+
+static void
+run_benchmarks (guint    n_tasks,
+                GString *json,
+                gboolean last)
+{
+  g_autoptr (DummyProvider) provider = NULL;
+  Measurement measurements[6];
+  guint i;
+
+  measurement_init (&measurements[0], "initial-load");
+  measurement_init (&measurements[1], "sorted-insert");
+  measurement_init (&measurements[2], "reorder");
+  measurement_init (&measurements[3], "filter-invalidation");
+  measurement_init (&measurements[4], "flatten");
+  measurement_init (&measurements[5], "day-rollover");
+
+  provider = dummy_provider_new ();
+
+  benchmark_initial_load (provider, n_tasks, &measurements[0]);
+  benchmark_sorted_insert (provider, &measurements[1]);
+  benchmark_reorder (provider, &measurements[2]);
+  benchmark_filter_invalidation (&measurements[3]);
+  benchmark_flatten (&measurements[4]);
+  benchmark_day_rollover (&measurements[5]);
+
+  gtd_manager_remove_provider (gtd_manager_get_default (), GTD_PROVIDER (provider));
+
+  g_string_append_printf (json,
+                          "    {\n"
+                          "      \"n-tasks\": %u,\n"
+                          "      \"results\": {\n",
+                          n_tasks);
+
+  for (i = 0; i < G_N_ELEMENTS (measurements); i++)
+    measurement_to_json (&measurements[i], json, i == G_N_ELEMENTS (measurements) - 1);
+
+  g_string_append_printf (json, "      }\n    }%s\n", last ? "" : ",");
+}
+
+gint
+main (gint   argc,
+      gchar *argv[])
+{
+  g_autoptr (GOptionContext) context = NULL;
+  g_autoptr (GString) json = NULL;
+  g_autoptr (GError) error = NULL;
+  g_auto (GStrv) split_sizes = NULL;
+  guint i;
+
+  context = g_option_context_new ("- benchmark the GNOME To Do models");
+  g_option_context_add_main_entries (context, entries, NULL);
+
+  if (!g_option_context_parse (context, &argc, &argv, &error))
+    {
+      g_printerr ("%s\n", error->message);
+      return EXIT_FAILURE;
+    }
+
+  if (n_lists <= 0 || subtask_depth < 0 || due_date_spread < 0)
+    {
+      g_printerr ("Invalid benchmark parameters\n");
+      return EXIT_FAILURE;
+    }
+
+  if (g_getenv ("G_MESSAGES_DEBUG"))
+    gtd_log_init ();
+
+  split_sizes = g_strsplit (sizes ? sizes : "1000,10000,100000", ",", -1);
+  json = g_string_new ("{\n");
+
+  g_string_append_printf (json,
+                          "  \"parameters\": {\n"
+                          "    \"lists\": %d,\n"
+                          "    \"subtask-depth\": %d,\n"
+                          "    \"due-date-spread\": %d\n"
+                          "  },\n"
+                          "  \"runs\": [\n",
+                          n_lists,
+                          subtask_depth,
+                          due_date_spread);
+
+  for (i = 0; split_sizes[i]; i++)
+    {
+      guint64 n_tasks;
+
+      if (!g_ascii_string_to_unsigned (split_sizes[i], 10, 1, G_MAXUINT, &n_tasks, &error))
+        {
+          g_printerr ("Invalid size '%s': %s\n", split_sizes[i], error->message);
+          return EXIT_FAILURE;
+        }
+
+      run_benchmarks (n_tasks, json, split_sizes[i + 1] == NULL);
+    }
+
+  g_string_append (json, "  ]\n}\n");
+
+  if (output)
+    {
+      if (!g_file_set_contents (output, json->str, json->len, &error))
+        {
+          g_printerr ("Error writing results to %s: %s\n", output, error->message);
+          return EXIT_FAILURE;
+        }
+    }
+  else
+    {
+      g_print ("%s", json->str);
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,355 @@
+/* benchmark-todo-txt-parser.c
+ *
+ * Copyright 2020 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "gnome-todo.h"
+
+#include "core/gtd-log.h"
+#include "gtd-provider-todo-txt.h"
+#include "gtd-todo-txt-parser.h"
+
+#include <glib/gstdio.h>
+#include <string.h>
+
+#define N_ITERATIONS 5
+
+typedef struct
+{
+  const gchar        *name;
+  gint64              best_usec;
+  guint               n_tasks;
+} Measurement;
+
+static gint n_lines = 100000;
+static gchar *output = NULL;
+
+static GOptionEntry entries[] = {
+  { "lines", 'n', 0, G_OPTION_ARG_INT, &n_lines, "Number of task lines in the generated file", "100000" },
+  { "output", 'o', 0, G_OPTION_ARG_FILENAME, &output, "Write the JSON results to this file instead of stdout", "FILE" },
+  { NULL }
+};
+
+
+/*
+ * Auxiliary methods
+ */
+
+static GString*
+generate_contents (guint n_tasks)
+{
+  GString *contents;
+  guint i;
+
+  contents = g_string_new ("");
+
+  for (i = 0; i < n_tasks; i++)
+    {
+      /* A mix of root tasks and subtasks, complete tasks, due dates and notes */
+      if (i % 4 != 0)
+        g_string_append (contents, "    ");
+
+      if (i % 3 == 0)
+        g_string_append (contents, "x 2020-03-01 2020-02-14 ");
+
+      g_string_append_printf (contents, "Task number %u with a reasonably long title @List%u", i, i / 1000);
+
+      if (i % 2 == 0)
+        g_string_append_printf (contents, " due:2020-%02u-%02u", i % 12 + 1, i % 28 + 1);
+
+      if (i % 5 == 0)
+        g_string_append (contents, " note:\"A note with \\\"escaped\\\" characters\\nand lines\"");
+
+      g_string_append_c (contents, '\n');
+    }
+
+  g_string_append (contents, "h:1 Lists");
+  for (i = 0; i <= n_tasks / 1000; i++)
+    g_string_append_printf (contents, " @List%u", i);
+  g_string_append_c (contents, '\n');
+
+  g_string_append (contents, "h:1 Colors");
+  for (i = 0; i <= n_tasks / 1000; i++)
+    g_string_append_printf (contents, " List%u:#3584e4", i);
+  g_string_append_c (contents, '\n');
+
+  return contents;
+}
+
+static guint
+parse_legacy (GtdProvider *provider,
+              const gchar *path)
+{
+  g_autofree gchar *contents = NULL;
+  g_auto (GStrv) lines = NULL;
+  guint n_tasks;
+  guint i;
+
+  g_file_get_contents (path, &contents, NULL, NULL);
+  lines = g_strsplit (contents, "\n", -1);
+  n_tasks = 0;
+
+  for (i = 0; lines[i]; i++)
+    {
+      g_autofree gchar *list_name = NULL;
+      g_autoptr (GError) error = NULL;
+      g_autoptr (GtdTask) task = NULL;
+      gchar *line;
+
+      line = g_strchomp (lines[i]);
+
+      if (line[0] == '\0')
+        continue;
+
+      if (gtd_todo_txt_parser_get_line_type (line, &error) != GTD_TODO_TXT_LINE_TYPE_TASK)
+        continue;
+
+      task = gtd_todo_txt_parser_parse_task (provider, line, &list_name, &error);
+
+      if (task)
+        n_tasks++;
+    }
+
+  return n_tasks;
+}
+
+static guint
+parse_spans (GtdProvider *provider,
+             const gchar *path)
+{
+  g_autoptr (GMappedFile) mapped_file = NULL;
+  const gchar *contents;
+  const gchar *line;
+  const gchar *end;
+  guint n_tasks;
+
+  mapped_file = g_mapped_file_new (path, FALSE, NULL);
+  contents = g_mapped_file_get_contents (mapped_file);
+  end = contents + g_mapped_file_get_length (mapped_file);
+  n_tasks = 0;
+
+  for (line = contents; line < end;)
+    {
+      g_autoptr (GError) error = NULL;
+      g_autoptr (GtdTask) task = NULL;
+      const gchar *line_end;
+      const gchar *list_name;
+      gsize list_name_length;
+
+      line_end = memchr (line, '\n', end - line);
+      if (!line_end)
+        line_end = end;
+
+      task = gtd_todo_txt_parser_parse_task_span (provider,
+                                                  line,
+                                                  line_end - line,
+                                                  &list_name,
+                                                  &list_name_length,
+                                                  &error);
+
+      if (task)
+        n_tasks++;
+
+      line = line_end + 1;
+    }
+
+  return n_tasks;
+}
+
+static guint
+load_provider (const gchar *path)
+{
+  g_autoptr (GtdProviderTodoTxt) provider = NULL;
+  g_autoptr (GFile) file = NULL;
+  g_autoptr (GList) lists = NULL;
+  guint n_tasks;
+  GList *l;
+
+  file = g_file_new_for_path (path);
+  provider = gtd_provider_todo_txt_new (file);
+  lists = gtd_provider_get_task_lists (GTD_PROVIDER (provider));
+  n_tasks = 0;
+
+  for (l = lists; l; l = l->next)
+    n_tasks += g_list_model_get_n_items (l->data);
+
+  return n_tasks;
+}
+
+static void
+measurement_to_json (Measurement *measurement,
+                     gsize        file_size,
+                     GString     *json,
+                     gboolean     last)
+{
+  gdouble seconds = MAX (measurement->best_usec, 1) / (gdouble) G_USEC_PER_SEC;
+
+  g_string_append_printf (json,
+                          "    \"%s\": {\n"
+                          "      \"tasks\": %u,\n"
+                          "      \"best-usec\": %" G_GINT64_FORMAT ",\n"
+                          "      \"lines-per-second\": %.0f,\n"
+                          "      \"mb-per-second\": %.2f\n"
+                          "    }%s\n",
+                          measurement->name,
+                          measurement->n_tasks,
+                          measurement->best_usec,
+                          measurement->n_tasks / seconds,
+                          file_size / seconds / (1024.0 * 1024.0),
+                          last ? "" : ",");
+}
+
+gint
+main (gint   argc,
+      gchar *argv[])
+{
+  g_autoptr (GtdProviderTodoTxt) provider = NULL;
+  g_autoptr (GOptionContext) context = NULL;
+  g_autoptr (GString) contents = NULL;
+  g_autoptr (GString) json = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autoptr (GFile) empty_file = NULL;
+  g_autofree gchar *empty_path = NULL;
+  g_autofree gchar *path = NULL;
+  g_autofree gchar *dir = NULL;
+  Measurement measurements[3];
+  guint i;
+  guint j;
+
+  context = g_option_context_new ("- benchmark the Todo.txt parser");
+  g_option_context_add_main_entries (context, entries, NULL);
+
+  if (!g_option_context_parse (context, &argc, &argv, &error))
+    {
+      g_printerr ("%s\n", error->message);
+      return EXIT_FAILURE;
+    }
+
+  if (n_lines <= 0)
+    {
+      g_printerr ("Invalid number of lines\n");
+      return EXIT_FAILURE;
+    }
+
+  if (g_getenv ("G_MESSAGES_DEBUG"))
+    gtd_log_init ();
+
+  dir = g_dir_make_tmp ("gnome-todo-benchmark-XXXXXX", &error);
+
+  if (!dir)
+    {
+      g_printerr ("Error creating temporary directory: %s\n", error->message);
+      return EXIT_FAILURE;
+    }
+
+  path = g_build_filename (dir, "todo.txt", NULL);
+  empty_path = g_build_filename (dir, "empty.txt", NULL);
+  contents = generate_contents (n_lines);
+
+  if (!g_file_set_contents (path, contents->str, contents->len, &error) ||
+      !g_file_set_contents (empty_path, "", 0, &error))
+    {
+      g_printerr ("Error writing benchmark file: %s\n", error->message);
+      return EXIT_FAILURE;
+    }
+
+  /* The parsers need a provider to create tasks */
+  empty_file = g_file_new_for_path (empty_path);
+  provider = gtd_provider_todo_txt_new (empty_file);
+
+  measurements[0] = (Measurement) { "legacy-parser", G_MAXINT64, 0 };
+  measurements[1] = (Measurement) { "span-parser", G_MAXINT64, 0 };
+  measurements[2] = (Measurement) { "provider-load", G_MAXINT64, 0 };
+
+  for (i = 0; i < N_ITERATIONS; i++)
+    {
+      for (j = 0; j < G_N_ELEMENTS (measurements); j++)
+        {
+          gint64 start;
+          guint n_tasks;
+
+          start = g_get_monotonic_time ();
+
+          switch (j)
+            {
+            case 0:
+              n_tasks = parse_legacy (GTD_PROVIDER (provider), path);
+              break;
+
+            case 1:
+              n_tasks = parse_spans (GTD_PROVIDER (provider), path);
+              break;
+
+            case 2:
+              n_tasks = load_provider (path);
+              break;
+
+            default:
+              g_assert_not_reached ();
+            }
+
+          measurements[j].best_usec = MIN (measurements[j].best_usec, g_get_monotonic_time () - start);
+          measurements[j].n_tasks = n_tasks;
+        }
+    }
+
+  /* Every generated line is a task; timings of a parser that dropped any are meaningless */
+  for (j = 0; j < G_N_ELEMENTS (measurements); j++)
+    {
+      if (measurements[j].n_tasks != (guint) n_lines)
+        {
+          g_printerr ("%s read %u tasks, expected %d\n",
+                      measurements[j].name,
+                      measurements[j].n_tasks,
+                      n_lines);
+          return EXIT_FAILURE;
+        }
+    }
+
+  json = g_string_new ("{\n");
+  g_string_append_printf (json,
+                          "  \"lines\": %d,\n"
+                          "  \"file-size\": %" G_GSIZE_FORMAT ",\n"
+                          "  \"results\": {\n",
+                          n_lines,
+                          contents->len);
+
+  for (j = 0; j < G_N_ELEMENTS (measurements); j++)
+    measurement_to_json (&measurements[j], contents->len, json, j == G_N_ELEMENTS (measurements) - 1);
+
+  g_string_append (json, "  }\n}\n");
+
+  g_unlink (path);
+  g_unlink (empty_path);
+  g_rmdir (dir);
+
+  if (output)
+    {
+      if (!g_file_set_contents (output, json->str, json->len, &error))
+        {
+          g_printerr ("Error writing results to %s: %s\n", output, error->message);
+          return EXIT_FAILURE;
+        }
+    }
+  else
+    {
+      g_print ("%s", json->str);
+    }
+
+  return EXIT_SUCCESS;
+}
@@ -165,13 +165,16 @@ dummy_provider_create_task_list (GtdProvider         *provider,
                                  GAsyncReadyCallback  callback,
                                  gpointer             user_data)
 {
+  g_autofree gchar *uuid = NULL;
   GSequenceIter *iter;
   DummyProvider *self;
   GtdTaskList* list;
 
   self = DUMMY_PROVIDER (provider);
+  uuid = g_uuid_string_random ();
 
   list = gtd_task_list_new (provider);
+  gtd_object_set_uid (GTD_OBJECT (list), uuid);
   gtd_task_list_set_name (list, name);
 
   iter = g_sequence_append (self->lists, list);
@@ -458,6 +461,123 @@ dummy_provider_generate_task_lists (DummyProvider *self)
   return self->number_of_tasks;
 }
 
+/**
+ * dummy_provider_generate_tasks:
+ * @self: a #DummyProvider
+ * @n_lists: the number of task lists to create
+ * @n_tasks: the total number of tasks to create
+ * @subtask_depth: how deep subtasks are nested
+ * @due_date_spread: the number of days around today in which due dates
+ *   are spread, or 0 to not set due dates
+ *
+ * Generates @n_tasks tasks evenly distributed across @n_lists new task
+ * lists. Tasks are created in chains of a root task followed by
+ * @subtask_depth nested subtasks. When @due_date_spread is not 0, about
+ * three quarters of the tasks have a random due date within
+ * @due_date_spread days before or after today.
+ *
+ * Tasks are added with gtd_task_list_add_tasks(), the same way providers
+ * load them.
+ *
+ * Returns: the number of tasks in @self
+ */
+guint
+dummy_provider_generate_tasks (DummyProvider *self,
+                               guint          n_lists,
+                               guint          n_tasks,
+                               guint          subtask_depth,
+                               guint          due_date_spread)
+{
+  static guint32 list_id = 0;
+  g_autoptr (GDateTime) today = NULL;
+  g_autoptr (GDateTime) now = NULL;
+  guint generated_tasks;
+  guint i;
+
+  g_return_val_if_fail (DUMMY_IS_PROVIDER (self), 0);
+  g_return_val_if_fail (n_lists > 0, 0);
+
+  now = g_date_time_new_now_local ();
+  today = g_date_time_new_local (g_date_time_get_year (now),
+                                 g_date_time_get_month (now),
+                                 g_date_time_get_day_of_month (now),
+                                 0, 0, 0);
+
+  generated_tasks = 0;
+
+  for (i = 0; i < n_lists; i++)
+    {
+      g_autoptr (GPtrArray) root_tasks = NULL;
+      g_autoptr (GPtrArray) tasks = NULL;
+      g_autofree gchar *list_name = NULL;
+      GSequenceIter *iter;
+      GtdTaskList *new_list;
+      GtdTask *parent;
+      guint n_list_tasks;
+      guint j;
+
+      list_name = g_strdup_printf ("Generated List %u", ++list_id);
+      gtd_provider_create_task_list (GTD_PROVIDER (self), list_name, NULL, NULL, NULL);
+
+      /* The new list is the last one */
+      iter = g_sequence_iter_prev (g_sequence_get_end_iter (self->lists));
+      new_list = g_sequence_get (iter);
+
+      /* The last list gets the remainder */
+      n_list_tasks = n_tasks / n_lists;
+      if (i == n_lists - 1)
+        n_list_tasks = n_tasks - generated_tasks;
+
+      /* Subtasks are not owned by their parents, so keep them alive until added */
+      tasks = g_ptr_array_new_with_free_func (g_object_unref);
+      root_tasks = g_ptr_array_new ();
+      parent = NULL;
+
+      for (j = 0; j < n_list_tasks; j++)
+        {
+          g_autofree gchar *title = NULL;
+          g_autofree gchar *uuid = NULL;
+          GtdTask *task;
+
+          task = gtd_task_new ();
+          gtd_task_set_list (task, new_list);
+          gtd_task_set_position (task, j);
+          g_ptr_array_add (tasks, task);
+
+          title = g_strdup_printf ("Task %u", j + 1);
+          gtd_task_set_title (task, title);
+
+          uuid = g_uuid_string_random ();
+          gtd_object_set_uid (GTD_OBJECT (task), uuid);
+
+          if (due_date_spread > 0 && g_random_int_range (0, 4) != 0)
+            {
+              g_autoptr (GDateTime) due_date = NULL;
+
+              due_date = g_date_time_add_days (today,
+                                               g_random_int_range (-(gint) due_date_spread,
+                                                                   (gint) due_date_spread + 1));
+              gtd_task_set_due_date (task, due_date);
+            }
+
+          if (j % (subtask_depth + 1) == 0)
+            g_ptr_array_add (root_tasks, task);
+          else
+            gtd_task_add_subtask (parent, task);
+
+          parent = task;
+        }
+
+      gtd_task_list_add_tasks (new_list, root_tasks);
+
+      generated_tasks += n_list_tasks;
+    }
+
+  self->number_of_tasks += generated_tasks;
+
+  return self->number_of_tasks;
+}
+
 void
 dummy_provider_schedule_remove_task (DummyProvider *self)
 {
@@ -34,6 +34,12 @@ guint                dummy_provider_generate_task_list           (DummyProvider
 
 guint                dummy_provider_generate_task_lists          (DummyProvider      *self);
 
+guint                dummy_provider_generate_tasks               (DummyProvider      *self,
+                                                                  guint               n_lists,
+                                                                  guint               n_tasks,
+                                                                  guint               subtask_depth,
+                                                                  guint               due_date_spread);
+
 void                 dummy_provider_schedule_remove_task         (DummyProvider      *self);
 
 guint                dummy_provider_randomly_remove_task         (DummyProvider      *self);
@@ -19,6 +19,7 @@
  */
 
 #include "gtd-keyframe-transition.h"
+#include "gtd-timeline-private.h"
 #include "gtd-widget.h"
 
 static const char *css =
@@ -38,6 +39,10 @@ static const char *css =
 "  background-image: none;"
 "  background-color: pink;"
 "}\n"
+"stressed {"
+"  background-image: none;"
+"  background-color: orange;"
+"}\n"
 ;
 
 static const char *ui =
@@ -48,7 +53,7 @@ static const char *ui =
 "    <child>"
 "      <object class='GtkBox'>"
 "        <child>"
-"          <object class='GtdWidget'>"
+"          <object class='GtdWidget' id='stage'>"
 "            <property name='hexpand'>true</property>"
 "            <child>"
 "              <object class='GtdWidget'>"
@@ -109,13 +114,24 @@ static const char *ui =
 "          </object>"
 "        </child>"
 "        <child>"
-"          <object class='GtkButton' id='button'>"
-"            <property name='label'>Move</property>"
+"          <object class='GtkBox'>"
+"            <property name='orientation'>vertical</property>"
+"            <property name='spacing'>6</property>"
 "            <property name='valign'>start</property>"
 "            <property name='margin-top'>12</property>"
 "            <property name='margin-start'>12</property>"
 "            <property name='margin-end'>12</property>"
 "            <property name='margin-bottom'>12</property>"
+"            <child>"
+"              <object class='GtkButton' id='button'>"
+"                <property name='label'>Move</property>"
+"              </object>"
+"            </child>"
+"            <child>"
+"              <object class='GtkButton' id='stress_button'>"
+"                <property name='label'>Stress</property>"
+"              </object>"
+"            </child>"
 "          </object>"
 "        </child>"
 "      </object>"
@@ -123,6 +139,8 @@ static const char *ui =
 "  </object>"
 "</interface>";
 
+#define N_STRESSED_WIDGETS 500
+
 static gboolean pink_moved = FALSE;
 
 static void
@@ -229,12 +247,108 @@ move_pink_cb (GtkButton *button,
   pink_moved = !pink_moved;
 }
 
+static gboolean
+print_frame_stats_cb (gpointer user_data)
+{
+  GtdTimelineFrameStats stats;
+  GdkFrameClock *frame_clock;
+
+  frame_clock = gtk_widget_get_frame_clock (GTK_WIDGET (user_data));
+
+  if (!frame_clock)
+    return G_SOURCE_CONTINUE;
+
+  gtd_timeline_get_frame_stats (frame_clock, &stats);
+
+  if (stats.n_frames > 0)
+    {
+      g_message ("%u timelines: last frame %.2lfms, average %.2lfms, worst %.2lfms",
+                 stats.n_timelines,
+                 stats.last_frame_us / 1000.0,
+                 stats.total_frame_us / 1000.0 / stats.n_frames,
+                 stats.max_frame_us / 1000.0);
+    }
+
+  return G_SOURCE_CONTINUE;
+}
+
+static gboolean
+unparent_stressed_widget_cb (gpointer user_data)
+{
+  gtk_widget_unparent (GTK_WIDGET (user_data));
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+on_stressed_transition_stopped_cb (GtdWidget   *widget,
+                                   const gchar *name,
+                                   gboolean     is_finished,
+                                   gpointer     user_data)
+{
+  /* The widget still uses its transitions after this signal, so
+   * only unparent it once the frame is over, so that every Stress
+   * click measures the same number of widgets
+   */
+  g_idle_add_full (G_PRIORITY_DEFAULT_IDLE,
+                   unparent_stressed_widget_cb,
+                   g_object_ref (widget),
+                   g_object_unref);
+}
+
+static void
+on_window_destroy_cb (GtkWidget *window,
+                      gpointer   user_data)
+{
+  g_source_remove (GPOINTER_TO_UINT (user_data));
+}
+
+static void
+stress_cb (GtkButton *button,
+           GtdWidget *stage)
+{
+  guint i;
+
+  /* Like bulk actions on task rows, with hundreds of concurrent transitions */
+  for (i = 0; i < N_STRESSED_WIDGETS; i++)
+    {
+      GtdTransition *transition;
+      GtkWidget *widget;
+
+      widget = g_object_new (GTD_TYPE_WIDGET,
+                             "css-name", "stressed",
+                             "halign", GTK_ALIGN_START,
+                             "valign", GTK_ALIGN_START,
+                             "width-request", 6,
+                             "height-request", 6,
+                             NULL);
+      gtk_widget_set_parent (widget, GTK_WIDGET (stage));
+
+      transition = gtd_property_transition_new ("translation-x");
+      gtd_transition_set_from (transition, G_TYPE_FLOAT, 0.f);
+      gtd_transition_set_to (transition, G_TYPE_FLOAT, (gfloat) g_random_double_range (50.0, 400.0));
+      gtd_timeline_set_duration (GTD_TIMELINE (transition), 2000);
+      gtd_timeline_set_repeat_count (GTD_TIMELINE (transition), 1);
+      gtd_timeline_set_auto_reverse (GTD_TIMELINE (transition), TRUE);
+
+      gtd_widget_set_translation (GTD_WIDGET (widget), 0.f, (gfloat) g_random_double_range (0.0, 300.0), 0.f);
+      g_signal_connect (widget,
+                        "transition-stopped::stress",
+                        G_CALLBACK (on_stressed_transition_stopped_cb),
+                        NULL);
+
+      gtd_widget_add_transition (GTD_WIDGET (widget), "stress", transition);
+      g_object_unref (transition);
+    }
+}
+
 static GtkWidget *
 create_ui (void)
 {
   g_autoptr (GtkBuilder) builder = NULL;
   g_autoptr (GError) error = NULL;
   GtkWidget *win;
+  guint stats_id;
 
   g_type_ensure (GTD_TYPE_WIDGET);
 
@@ -257,6 +371,14 @@ create_ui (void)
                     G_CALLBACK (move_pink_cb),
                     gtk_builder_get_object (builder, "mover"));
 
+  g_signal_connect (gtk_builder_get_object (builder, "stress_button"),
+                    "clicked",
+                    G_CALLBACK (stress_cb),
+                    gtk_builder_get_object (builder, "stage"));
+
+  stats_id = g_timeout_add_seconds (1, print_frame_stats_cb, win);
+  g_signal_connect (win, "destroy", G_CALLBACK (on_window_destroy_cb), GUINT_TO_POINTER (stats_id));
+
   return win;
 }
 
@@ -0,0 +1,93 @@
+/* test-clock.c
+ *
+ * Copyright 2020 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "gnome-todo.h"
+
+#include "core/gtd-log.h"
+
+static void
+test_date_labels (void)
+{
+  g_autoptr (GDateTime) last_year = NULL;
+  g_autoptr (GDateTime) yesterday = NULL;
+  g_autoptr (GDateTime) tomorrow = NULL;
+  g_autoptr (GDateTime) today = NULL;
+  g_autoptr (GDateTime) later = NULL;
+  g_autoptr (GtdClock) clock = NULL;
+  g_autofree gchar *expected = NULL;
+  const gchar *label;
+
+  today = g_date_time_new_now_local ();
+  yesterday = g_date_time_add_days (today, -1);
+  tomorrow = g_date_time_add_days (today, 1);
+  last_year = g_date_time_add_years (today, -1);
+
+  /* Same day, different time */
+  later = g_date_time_new_local (g_date_time_get_year (today),
+                                 g_date_time_get_month (today),
+                                 g_date_time_get_day_of_month (today),
+                                 12, 0, 0);
+
+  clock = gtd_clock_new ();
+
+  /* The clock must sample the same day as the reference dates */
+  if (gtd_clock_get_days_from_today (clock, later) != 0)
+    {
+      g_test_skip ("Crossed midnight while setting up the test");
+      return;
+    }
+
+  g_assert_cmpint (gtd_clock_get_days_from_today (clock, today), ==, 0);
+  g_assert_cmpint (gtd_clock_get_days_from_today (clock, yesterday), ==, -1);
+  g_assert_cmpint (gtd_clock_get_days_from_today (clock, tomorrow), ==, 1);
+  g_assert_cmpint (gtd_clock_get_days_from_today (clock, last_year), <, -364);
+
+  g_assert_cmpstr (gtd_clock_get_relative_date_label (clock, today), ==, "Today");
+  g_assert_cmpstr (gtd_clock_get_relative_date_label (clock, yesterday), ==, "Yesterday");
+  g_assert_cmpstr (gtd_clock_get_relative_date_label (clock, tomorrow), ==, "Tomorrow");
+  g_assert_cmpstr (gtd_clock_get_due_date_label (clock, today), ==, "Today");
+  g_assert_cmpstr (gtd_clock_get_due_date_label (clock, yesterday), ==, "Yesterday");
+  g_assert_cmpstr (gtd_clock_get_due_date_label (clock, tomorrow), ==, "Tomorrow");
+
+  /* Labels are shared by all times of the same day */
+  label = gtd_clock_get_due_date_label (clock, today);
+  g_assert_true (gtd_clock_get_due_date_label (clock, later) == label);
+
+  /* Past days are counted back, whatever the year */
+  expected = g_strdup_printf ("%d days ago", -gtd_clock_get_days_from_today (clock, last_year));
+  label = gtd_clock_get_relative_date_label (clock, last_year);
+
+  g_assert_cmpstr (label, ==, expected);
+  g_assert_true (label == g_intern_string (expected));
+}
+
+gint
+main (gint   argc,
+      gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  if (g_getenv ("G_MESSAGES_DEBUG"))
+    gtd_log_init ();
+
+  g_test_add_func ("/clock/date-labels", test_date_labels);
+
+  return g_test_run ();
+}
@@ -0,0 +1,231 @@
+/* test-due-date-index.c
+ *
+ * Copyright 2020 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "gnome-todo.h"
+
+#include "core/gtd-log.h"
+#include "models/gtd-due-date-index.h"
+#include "gtd-manager-protected.h"
+#include "dummy-provider.h"
+
+static GPtrArray*
+copy_model (GListModel *model)
+{
+  GPtrArray *tasks;
+  guint i;
+
+  tasks = g_ptr_array_new_with_free_func (g_object_unref);
+
+  for (i = 0; i < g_list_model_get_n_items (model); i++)
+    g_ptr_array_add (tasks, g_list_model_get_item (model, i));
+
+  return tasks;
+}
+
+static void
+assert_sorted_by_due_date (GListModel *model)
+{
+  g_autoptr (GDateTime) previous_dt = NULL;
+  gboolean seen_undated = FALSE;
+  guint i;
+
+  for (i = 0; i < g_list_model_get_n_items (model); i++)
+    {
+      g_autoptr (GtdTask) task = g_list_model_get_item (model, i);
+      g_autoptr (GDateTime) dt = gtd_task_get_due_date (task);
+
+      /* Undated tasks are always at the end */
+      if (!dt)
+        {
+          seen_undated = TRUE;
+          continue;
+        }
+
+      g_assert_false (seen_undated);
+
+      if (previous_dt)
+        g_assert_cmpint (g_date_time_compare (previous_dt, dt), <=, 0);
+
+      g_clear_pointer (&previous_dt, g_date_time_unref);
+      previous_dt = g_steal_pointer (&dt);
+    }
+}
+
+static void
+test_basic (void)
+{
+  g_autoptr (DummyProvider) dummy_provider = NULL;
+  g_autoptr (GPtrArray) tasks = NULL;
+  g_autoptr (GDateTime) yesterday = NULL;
+  g_autoptr (GDateTime) today = NULL;
+  g_autoptr (GDateTime) now = NULL;
+  GtdDueDateIndex *index;
+  GListModel *incomplete_all;
+  GListModel *overdue;
+  GListModel *today_model;
+  GListModel *scheduled;
+  GListModel *all;
+  guint n_tasks;
+  guint i;
+
+  index = gtd_manager_get_due_date_index (gtd_manager_get_default ());
+  all = gtd_due_date_index_get_model (index, GTD_DUE_DATE_RANGE_ALL, TRUE);
+  incomplete_all = gtd_due_date_index_get_model (index, GTD_DUE_DATE_RANGE_ALL, FALSE);
+  scheduled = gtd_due_date_index_get_model (index, GTD_DUE_DATE_RANGE_SCHEDULED, TRUE);
+  overdue = gtd_due_date_index_get_model (index, GTD_DUE_DATE_RANGE_OVERDUE, TRUE);
+  today_model = gtd_due_date_index_get_model (index, GTD_DUE_DATE_RANGE_TODAY, TRUE);
+
+  /* Create a DumbProvider and pre-populate it */
+  dummy_provider = dummy_provider_new ();
+  n_tasks = dummy_provider_generate_task_lists (dummy_provider);
+  gtd_manager_add_provider (gtd_manager_get_default (), GTD_PROVIDER (dummy_provider));
+
+  g_assert_cmpuint (g_list_model_get_n_items (all), ==, n_tasks);
+  g_assert_cmpuint (g_list_model_get_n_items (incomplete_all), ==, n_tasks);
+  g_assert_cmpuint (g_list_model_get_n_items (scheduled), ==, 0);
+
+  /* Generate more */
+  n_tasks = dummy_provider_generate_task_lists (dummy_provider);
+  g_assert_cmpuint (g_list_model_get_n_items (all), ==, n_tasks);
+
+  /* Schedule every other task to today, and every third task to yesterday */
+  now = g_date_time_new_now_local ();
+  today = g_date_time_new_local (g_date_time_get_year (now),
+                                 g_date_time_get_month (now),
+                                 g_date_time_get_day_of_month (now),
+                                 0, 0, 0);
+  yesterday = g_date_time_add_days (today, -1);
+
+  tasks = copy_model (all);
+
+  for (i = 0; i < tasks->len; i++)
+    {
+      if (i % 3 == 0)
+        gtd_task_set_due_date (g_ptr_array_index (tasks, i), yesterday);
+      else if (i % 2 == 0)
+        gtd_task_set_due_date (g_ptr_array_index (tasks, i), today);
+    }
+
+  g_assert_cmpuint (g_list_model_get_n_items (all), ==, n_tasks);
+  g_assert_cmpuint (g_list_model_get_n_items (overdue), ==, (n_tasks + 2) / 3);
+  g_assert_cmpuint (g_list_model_get_n_items (scheduled),
+                    ==,
+                    g_list_model_get_n_items (overdue) + g_list_model_get_n_items (today_model));
+  assert_sorted_by_due_date (all);
+
+  /* Completing tasks only removes them from the incomplete models */
+  gtd_task_set_complete (g_ptr_array_index (tasks, 0), TRUE);
+  g_assert_cmpuint (g_list_model_get_n_items (all), ==, n_tasks);
+  g_assert_cmpuint (g_list_model_get_n_items (incomplete_all), ==, n_tasks - 1);
+
+  gtd_task_set_complete (g_ptr_array_index (tasks, 0), FALSE);
+  g_assert_cmpuint (g_list_model_get_n_items (incomplete_all), ==, n_tasks);
+
+  g_clear_pointer (&tasks, g_ptr_array_unref);
+
+  while (n_tasks > 0)
+    {
+      n_tasks = dummy_provider_randomly_remove_task (dummy_provider);
+      g_assert_cmpuint (g_list_model_get_n_items (all), ==, n_tasks);
+      assert_sorted_by_due_date (all);
+    }
+}
+
+static void
+assert_sorted (GListModel *model)
+{
+  g_autoptr (GtdTask) previous = NULL;
+  guint i;
+
+  for (i = 0; i < g_list_model_get_n_items (model); i++)
+    {
+      g_autoptr (GtdTask) task = g_list_model_get_item (model, i);
+
+      if (previous)
+        g_assert_cmpint (gtd_task_compare (previous, task), <=, 0);
+
+      g_clear_object (&previous);
+      previous = g_steal_pointer (&task);
+    }
+}
+
+static void
+test_subtasks (void)
+{
+  g_autoptr (DummyProvider) dummy_provider = NULL;
+  g_autoptr (GPtrArray) tasks = NULL;
+  GtdDueDateIndex *index;
+  GListModel *all;
+  guint n_tasks;
+  guint i;
+
+  index = gtd_manager_get_due_date_index (gtd_manager_get_default ());
+  all = gtd_due_date_index_get_model (index, GTD_DUE_DATE_RANGE_ALL, TRUE);
+
+  /* Chains of a root task with two nested subtasks, all undated */
+  dummy_provider = dummy_provider_new ();
+  n_tasks = dummy_provider_generate_tasks (dummy_provider, 1, 30, 2, 0);
+  gtd_manager_add_provider (gtd_manager_get_default (), GTD_PROVIDER (dummy_provider));
+
+  g_assert_cmpuint (g_list_model_get_n_items (all), ==, n_tasks);
+
+  /* Without custom positions, subtasks are sorted relative to their ancestors */
+  tasks = copy_model (all);
+
+  for (i = 0; i < tasks->len; i++)
+    gtd_task_set_position (g_ptr_array_index (tasks, i), -1);
+
+  assert_sorted (all);
+
+  /* Renaming the root tasks reverses their order, and their subtasks must follow */
+  for (i = 0; i < tasks->len; i++)
+    {
+      g_autofree gchar *title = NULL;
+      GtdTask *task = g_ptr_array_index (tasks, i);
+
+      if (gtd_task_get_parent (task))
+        continue;
+
+      title = g_strdup_printf ("Root %03u", tasks->len - i);
+      gtd_task_set_title (task, title);
+
+      assert_sorted (all);
+    }
+
+  g_clear_pointer (&tasks, g_ptr_array_unref);
+
+  while (n_tasks > 0)
+    n_tasks = dummy_provider_randomly_remove_task (dummy_provider);
+}
+
+gint
+main (gint argc,
+      gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  if (g_getenv ("G_MESSAGES_DEBUG"))
+    gtd_log_init ();
+
+  g_test_add_func ("/models/due-date-index/basic", test_basic);
+  g_test_add_func ("/models/due-date-index/subtasks", test_subtasks);
+
+  return g_test_run ();
+}
@@ -0,0 +1,96 @@
+/* test-easing.c
+ *
+ * Copyright 2020 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "gnome-todo.h"
+
+#include "core/gtd-log.h"
+
+#include <float.h>
+
+/* The bounds documented in gtd_easing_for_mode_table() */
+#define TABLE_ERROR_BOUND       1e-3
+#define CIRC_TABLE_ERROR_BOUND  1e-2
+
+static gdouble
+get_table_error_bound (GtdEaseMode mode)
+{
+  switch (mode)
+    {
+    case GTD_EASE_IN_CIRC:
+    case GTD_EASE_OUT_CIRC:
+    case GTD_EASE_IN_OUT_CIRC:
+      return CIRC_TABLE_ERROR_BOUND;
+
+    default:
+      return TABLE_ERROR_BOUND;
+    }
+}
+
+
+/*
+ * Tests
+ */
+
+static void
+test_table_error (void)
+{
+  GtdEaseMode mode;
+
+  for (mode = GTD_EASE_LINEAR; mode < GTD_EASE_LAST; mode++)
+    {
+      gdouble error = gtd_easing_get_table_error (mode);
+
+      g_test_message ("%s: %.3e", gtd_get_easing_name_for_mode (mode), error);
+
+      g_assert_cmpfloat (error, <, get_table_error_bound (mode));
+    }
+}
+
+static void
+test_table_boundaries (void)
+{
+  GtdEaseMode mode;
+
+  /* The table holds floats, so exact means up to their precision */
+  for (mode = GTD_EASE_LINEAR; mode < GTD_EASE_LAST; mode++)
+    {
+      g_assert_cmpfloat_with_epsilon (gtd_easing_for_mode_table (mode, 0.0, 250.0),
+                                      gtd_easing_for_mode (mode, 0.0, 250.0),
+                                      FLT_EPSILON);
+      g_assert_cmpfloat_with_epsilon (gtd_easing_for_mode_table (mode, 250.0, 250.0),
+                                      gtd_easing_for_mode (mode, 250.0, 250.0),
+                                      FLT_EPSILON);
+    }
+}
+
+gint
+main (gint   argc,
+      gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  if (g_getenv ("G_MESSAGES_DEBUG"))
+    gtd_log_init ();
+
+  g_test_add_func ("/easing/table-error", test_table_error);
+  g_test_add_func ("/easing/table-boundaries", test_table_boundaries);
+
+  return g_test_run ();
+}
@@ -0,0 +1,491 @@
+/* test-eds-writer.c
+ *
+ * Copyright 2020 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "gnome-todo.h"
+
+#include "core/gtd-log.h"
+#include "gtd-eds-writer.h"
+
+/*
+ * A local stand-in for a calendar. It keeps the summary of each object
+ * by uid, and records each call it receives. Calls can be held until the
+ * test releases them, removals can be made to fail, and so can any call
+ * that modifies a given object.
+ */
+typedef struct
+{
+  GMutex              mutex;
+  GCond               cond;
+  gboolean            blocked;
+  gboolean            fail_removals;
+  gchar              *failing_uid;
+
+  GHashTable         *objects;
+  GPtrArray          *calls;
+  guint               n_created;
+} FakeCalendar;
+
+typedef struct
+{
+  guint               n_pending;
+  guint               n_failed;
+} Results;
+
+static void
+record_call (FakeCalendar *fake,
+             const gchar  *type,
+             guint         n_objects)
+{
+  g_mutex_lock (&fake->mutex);
+
+  g_ptr_array_add (fake->calls, g_strdup_printf ("%s:%u", type, n_objects));
+  g_cond_broadcast (&fake->cond);
+
+  while (fake->blocked)
+    g_cond_wait (&fake->cond, &fake->mutex);
+
+  g_mutex_unlock (&fake->mutex);
+}
+
+static gboolean
+fake_create_objects (gpointer       backend,
+                     GSList        *icalcomps,
+                     GSList       **out_uids,
+                     GCancellable  *cancellable,
+                     GError       **error)
+{
+  FakeCalendar *fake = backend;
+  GSList *l;
+
+  record_call (fake, "create", g_slist_length (icalcomps));
+
+  g_mutex_lock (&fake->mutex);
+
+  for (l = icalcomps; l; l = l->next)
+    {
+      gchar *uid = g_strdup_printf ("created-%u", fake->n_created++);
+
+      g_hash_table_insert (fake->objects, g_strdup (uid), g_strdup (i_cal_component_get_summary (l->data)));
+      *out_uids = g_slist_append (*out_uids, uid);
+    }
+
+  g_mutex_unlock (&fake->mutex);
+
+  return TRUE;
+}
+
+static gboolean
+fake_modify_objects (gpointer       backend,
+                     GSList        *icalcomps,
+                     GCancellable  *cancellable,
+                     GError       **error)
+{
+  FakeCalendar *fake = backend;
+  GSList *l;
+
+  record_call (fake, "modify", g_slist_length (icalcomps));
+
+  g_mutex_lock (&fake->mutex);
+
+  /* Like a real calendar, nothing is written when one object is bad */
+  for (l = icalcomps; l; l = l->next)
+    {
+      if (g_strcmp0 (i_cal_component_get_uid (l->data), fake->failing_uid) == 0)
+        {
+          g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_INVALID_DATA, "Invalid object");
+          g_mutex_unlock (&fake->mutex);
+          return FALSE;
+        }
+    }
+
+  for (l = icalcomps; l; l = l->next)
+    {
+      g_hash_table_insert (fake->objects,
+                           g_strdup (i_cal_component_get_uid (l->data)),
+                           g_strdup (i_cal_component_get_summary (l->data)));
+    }
+
+  g_mutex_unlock (&fake->mutex);
+
+  return TRUE;
+}
+
+static gboolean
+fake_remove_objects (gpointer       backend,
+                     GSList        *ids,
+                     GCancellable  *cancellable,
+                     GError       **error)
+{
+  FakeCalendar *fake = backend;
+  gboolean success;
+  GSList *l;
+
+  record_call (fake, "remove", g_slist_length (ids));
+
+  g_mutex_lock (&fake->mutex);
+
+  success = !fake->fail_removals;
+
+  if (success)
+    {
+      for (l = ids; l; l = l->next)
+        g_hash_table_remove (fake->objects, e_cal_component_id_get_uid (l->data));
+    }
+  else
+    {
+      g_set_error_literal (error, G_IO_ERROR, G_IO_ERROR_PERMISSION_DENIED, "Read-only calendar");
+    }
+
+  g_mutex_unlock (&fake->mutex);
+
+  return success;
+}
+
+static const GtdEdsWriterBackend fake_backend = {
+  .create_objects = fake_create_objects,
+  .modify_objects = fake_modify_objects,
+  .remove_objects = fake_remove_objects,
+};
+
+static FakeCalendar*
+fake_calendar_new (void)
+{
+  FakeCalendar *fake;
+
+  fake = g_new0 (FakeCalendar, 1);
+  fake->objects = g_hash_table_new_full (g_str_hash, g_str_equal, g_free, g_free);
+  fake->calls = g_ptr_array_new_with_free_func (g_free);
+
+  g_mutex_init (&fake->mutex);
+  g_cond_init (&fake->cond);
+
+  return fake;
+}
+
+static void
+fake_calendar_free (FakeCalendar *fake)
+{
+  g_clear_pointer (&fake->objects, g_hash_table_destroy);
+  g_clear_pointer (&fake->calls, g_ptr_array_unref);
+  g_clear_pointer (&fake->failing_uid, g_free);
+  g_mutex_clear (&fake->mutex);
+  g_cond_clear (&fake->cond);
+  g_free (fake);
+}
+
+static void
+fake_calendar_set_blocked (FakeCalendar *fake,
+                           gboolean      blocked)
+{
+  g_mutex_lock (&fake->mutex);
+  fake->blocked = blocked;
+  g_cond_broadcast (&fake->cond);
+  g_mutex_unlock (&fake->mutex);
+}
+
+static void
+fake_calendar_wait_for_calls (FakeCalendar *fake,
+                              guint         n_calls)
+{
+  g_mutex_lock (&fake->mutex);
+
+  while (fake->calls->len < n_calls)
+    g_cond_wait (&fake->cond, &fake->mutex);
+
+  g_mutex_unlock (&fake->mutex);
+}
+
+static const gchar*
+get_call (FakeCalendar *fake,
+          guint         i)
+{
+  g_assert_cmpuint (i, <, fake->calls->len);
+
+  return g_ptr_array_index (fake->calls, i);
+}
+
+static ICalComponent*
+create_component (const gchar *uid,
+                  const gchar *summary)
+{
+  ICalComponent *icalcomp;
+
+  icalcomp = i_cal_component_new_vtodo ();
+
+  if (uid)
+    i_cal_component_set_uid (icalcomp, uid);
+
+  i_cal_component_set_summary (icalcomp, summary);
+
+  return icalcomp;
+}
+
+static void
+on_operation_finished_cb (GObject      *source_object,
+                          GAsyncResult *result,
+                          gpointer      user_data)
+{
+  Results *results = user_data;
+
+  if (g_task_had_error (G_TASK (result)))
+    results->n_failed++;
+
+  results->n_pending--;
+}
+
+static void
+modify (GtdEdsWriter *writer,
+        const gchar  *uid,
+        const gchar  *summary,
+        Results      *results)
+{
+  ICalComponent *icalcomp = create_component (uid, summary);
+
+  results->n_pending++;
+  gtd_eds_writer_modify (writer, icalcomp, NULL, on_operation_finished_cb, results);
+
+  g_object_unref (icalcomp);
+}
+
+static void
+remove_object (GtdEdsWriter *writer,
+               const gchar  *uid,
+               Results      *results)
+{
+  results->n_pending++;
+  gtd_eds_writer_remove (writer, uid, NULL, NULL, on_operation_finished_cb, results);
+}
+
+static void
+wait_for_results (Results *results)
+{
+  while (results->n_pending > 0)
+    g_main_context_iteration (NULL, TRUE);
+}
+
+
+/*
+ * Tests
+ */
+
+static void
+test_coalesce (void)
+{
+  g_autoptr (GtdEdsWriter) writer = NULL;
+  ICalComponent *new_component;
+  GtdEdsWriterStats stats;
+  FakeCalendar *fake;
+  Results results = { 0, };
+
+  fake = fake_calendar_new ();
+  writer = gtd_eds_writer_new_for_backend (&fake_backend, fake, (GDestroyNotify) fake_calendar_free);
+
+  g_hash_table_insert (fake->objects, g_strdup ("c"), g_strdup ("C"));
+
+  /* Writes issued at once are sent together, and updates of 'a' collapse */
+  modify (writer, "a", "A1", &results);
+  modify (writer, "a", "A2", &results);
+  modify (writer, "b", "B", &results);
+  modify (writer, "a", "A3", &results);
+  remove_object (writer, "c", &results);
+
+  new_component = create_component (NULL, "New");
+  results.n_pending++;
+  gtd_eds_writer_create (writer, new_component, NULL, on_operation_finished_cb, &results);
+  g_object_unref (new_component);
+
+  g_assert_cmpuint (gtd_eds_writer_get_queue_depth (writer), ==, 4);
+
+  wait_for_results (&results);
+
+  g_assert_cmpuint (results.n_failed, ==, 0);
+  g_assert_cmpuint (fake->calls->len, ==, 3);
+  g_assert_cmpstr (get_call (fake, 0), ==, "create:1");
+  g_assert_cmpstr (get_call (fake, 1), ==, "modify:2");
+  g_assert_cmpstr (get_call (fake, 2), ==, "remove:1");
+
+  g_assert_cmpstr (g_hash_table_lookup (fake->objects, "a"), ==, "A3");
+  g_assert_cmpstr (g_hash_table_lookup (fake->objects, "b"), ==, "B");
+  g_assert_cmpstr (g_hash_table_lookup (fake->objects, "created-0"), ==, "New");
+  g_assert_false (g_hash_table_contains (fake->objects, "c"));
+
+  gtd_eds_writer_get_stats (writer, &stats);
+
+  g_assert_cmpuint (stats.n_requests, ==, 6);
+  g_assert_cmpuint (stats.n_coalesced, ==, 2);
+  g_assert_cmpuint (stats.n_batches, ==, 1);
+  g_assert_cmpuint (stats.queue_depth, ==, 0);
+  g_assert_cmpuint (stats.max_queue_depth, ==, 4);
+  g_assert_cmpint (stats.max_latency_us, >, 0);
+  g_assert_cmpint (stats.total_latency_us, >=, stats.max_latency_us);
+}
+
+static void
+test_remove_after_modify (void)
+{
+  g_autoptr (GtdEdsWriter) writer = NULL;
+  GtdEdsWriterStats stats;
+  FakeCalendar *fake;
+  Results results = { 0, };
+
+  fake = fake_calendar_new ();
+  writer = gtd_eds_writer_new_for_backend (&fake_backend, fake, (GDestroyNotify) fake_calendar_free);
+
+  /* The modification is never written, but both operations finish */
+  modify (writer, "a", "A", &results);
+  remove_object (writer, "a", &results);
+
+  /* Modifying an object with a pending removal must wait for it */
+  modify (writer, "a", "A again", &results);
+
+  wait_for_results (&results);
+
+  g_assert_cmpuint (results.n_failed, ==, 0);
+  g_assert_cmpuint (fake->calls->len, ==, 2);
+  g_assert_cmpstr (get_call (fake, 0), ==, "remove:1");
+  g_assert_cmpstr (get_call (fake, 1), ==, "modify:1");
+  g_assert_cmpstr (g_hash_table_lookup (fake->objects, "a"), ==, "A again");
+
+  gtd_eds_writer_get_stats (writer, &stats);
+
+  g_assert_cmpuint (stats.n_coalesced, ==, 1);
+  g_assert_cmpuint (stats.n_batches, ==, 2);
+}
+
+static void
+test_in_flight (void)
+{
+  g_autoptr (GtdEdsWriter) writer = NULL;
+  GtdEdsWriterStats stats;
+  FakeCalendar *fake;
+  Results results = { 0, };
+  guint i;
+
+  fake = fake_calendar_new ();
+  writer = gtd_eds_writer_new_for_backend (&fake_backend, fake, (GDestroyNotify) fake_calendar_free);
+
+  /* Hold the first batch in the calendar */
+  fake_calendar_set_blocked (fake, TRUE);
+
+  modify (writer, "first", "First", &results);
+
+  while (gtd_eds_writer_get_queue_depth (writer) > 0)
+    g_main_context_iteration (NULL, TRUE);
+
+  fake_calendar_wait_for_calls (fake, 1);
+
+  /* Everything queued meanwhile goes in the next batch */
+  for (i = 0; i < 10; i++)
+    {
+      g_autofree gchar *uid = g_strdup_printf ("task-%u", i);
+
+      modify (writer, uid, "Task", &results);
+      modify (writer, "first", "First again", &results);
+    }
+
+  g_assert_cmpuint (gtd_eds_writer_get_queue_depth (writer), ==, 11);
+
+  fake_calendar_set_blocked (fake, FALSE);
+
+  wait_for_results (&results);
+
+  g_assert_cmpuint (results.n_failed, ==, 0);
+  g_assert_cmpuint (fake->calls->len, ==, 2);
+  g_assert_cmpstr (get_call (fake, 0), ==, "modify:1");
+  g_assert_cmpstr (get_call (fake, 1), ==, "modify:11");
+  g_assert_cmpstr (g_hash_table_lookup (fake->objects, "first"), ==, "First again");
+
+  gtd_eds_writer_get_stats (writer, &stats);
+
+  g_assert_cmpuint (stats.n_requests, ==, 21);
+  g_assert_cmpuint (stats.n_coalesced, ==, 9);
+  g_assert_cmpuint (stats.n_batches, ==, 2);
+  g_assert_cmpuint (stats.max_queue_depth, ==, 11);
+}
+
+static void
+test_errors (void)
+{
+  g_autoptr (GtdEdsWriter) writer = NULL;
+  FakeCalendar *fake;
+  Results results = { 0, };
+
+  fake = fake_calendar_new ();
+  fake->fail_removals = TRUE;
+  writer = gtd_eds_writer_new_for_backend (&fake_backend, fake, (GDestroyNotify) fake_calendar_free);
+
+  /* A failed removal doesn't fail the modifications in the same batch */
+  modify (writer, "a", "A", &results);
+  remove_object (writer, "b", &results);
+  remove_object (writer, "c", &results);
+
+  wait_for_results (&results);
+
+  g_assert_cmpuint (results.n_failed, ==, 2);
+  g_assert_cmpstr (g_hash_table_lookup (fake->objects, "a"), ==, "A");
+}
+
+static void
+test_retry (void)
+{
+  g_autoptr (GtdEdsWriter) writer = NULL;
+  FakeCalendar *fake;
+  Results results = { 0, };
+
+  fake = fake_calendar_new ();
+  fake->failing_uid = g_strdup ("bad");
+  writer = gtd_eds_writer_new_for_backend (&fake_backend, fake, (GDestroyNotify) fake_calendar_free);
+
+  /* A bad object only fails its own operation, not the whole batch */
+  modify (writer, "a", "A", &results);
+  modify (writer, "bad", "Bad", &results);
+  modify (writer, "b", "B", &results);
+
+  wait_for_results (&results);
+
+  g_assert_cmpuint (results.n_failed, ==, 1);
+  g_assert_cmpuint (fake->calls->len, ==, 4);
+  g_assert_cmpstr (get_call (fake, 0), ==, "modify:3");
+  g_assert_cmpstr (get_call (fake, 1), ==, "modify:1");
+  g_assert_cmpstr (get_call (fake, 2), ==, "modify:1");
+  g_assert_cmpstr (get_call (fake, 3), ==, "modify:1");
+
+  g_assert_cmpstr (g_hash_table_lookup (fake->objects, "a"), ==, "A");
+  g_assert_cmpstr (g_hash_table_lookup (fake->objects, "b"), ==, "B");
+  g_assert_false (g_hash_table_contains (fake->objects, "bad"));
+}
+
+gint
+main (gint   argc,
+      gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  if (g_getenv ("G_MESSAGES_DEBUG"))
+    gtd_log_init ();
+
+  g_test_add_func ("/eds-writer/coalesce", test_coalesce);
+  g_test_add_func ("/eds-writer/remove-after-modify", test_remove_after_modify);
+  g_test_add_func ("/eds-writer/in-flight", test_in_flight);
+  g_test_add_func ("/eds-writer/errors", test_errors);
+  g_test_add_func ("/eds-writer/retry", test_retry);
+
+  return g_test_run ();
+}
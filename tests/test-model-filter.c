@@ -13,9 +13,60 @@ struct _TestItem
 G_DECLARE_FINAL_TYPE (TestItem, test_item, TEST, ITEM, GObject)
 G_DEFINE_TYPE (TestItem, test_item, G_TYPE_OBJECT)
 
+enum
+{
+  PROP_0,
+  PROP_N,
+  N_PROPS
+};
+
+static void
+test_item_get_property (GObject    *object,
+                        guint       prop_id,
+                        GValue     *value,
+                        GParamSpec *pspec)
+{
+  switch (prop_id)
+    {
+    case PROP_N:
+      g_value_set_uint (value, TEST_ITEM (object)->n);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+    }
+}
+
+static void
+test_item_set_property (GObject      *object,
+                        guint         prop_id,
+                        const GValue *value,
+                        GParamSpec   *pspec)
+{
+  switch (prop_id)
+    {
+    case PROP_N:
+      TEST_ITEM (object)->n = g_value_get_uint (value);
+      break;
+
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+    }
+}
+
 static void
 test_item_class_init (TestItemClass *klass)
 {
+  GObjectClass *object_class = G_OBJECT_CLASS (klass);
+
+  object_class->get_property = test_item_get_property;
+  object_class->set_property = test_item_set_property;
+
+  g_object_class_install_property (object_class,
+                                   PROP_N,
+                                   g_param_spec_uint ("n", "n", "n",
+                                                      0, G_MAXUINT, 0,
+                                                      G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 }
 
 static void
@@ -197,6 +248,94 @@ test_items_changed (void)
   g_clear_object (&filter);
 }
 
+static guint n_emissions = 0;
+
+static void
+count_items_changed_cb (GtdListModelFilter *filter,
+                        guint               position,
+                        guint               n_removed,
+                        guint               n_added,
+                        gpointer            user_data)
+{
+  last_n_added = n_added;
+  last_n_removed = n_removed;
+  last_changed_position = position;
+  n_emissions++;
+}
+
+static void
+test_refilter_item (void)
+{
+  GtdListModelFilter *filter;
+  GListStore *model;
+  TestItem *item;
+  guint i;
+
+  model = g_list_store_new (TEST_TYPE_ITEM);
+
+  for (i = 0; i < 100; i++)
+    {
+      g_autoptr (TestItem) val = test_item_new (i);
+      g_list_store_append (model, val);
+    }
+
+  filter = gtd_list_model_filter_new (G_LIST_MODEL (model));
+  gtd_list_model_filter_set_filter_func (filter, filter_func1, NULL, NULL);
+  g_assert_cmpint (50, ==, g_list_model_get_n_items (G_LIST_MODEL (filter)));
+
+  g_signal_connect (filter, "items-changed", G_CALLBACK (count_items_changed_cb), NULL);
+
+  /* Hide item 10, which is at position 5 of the filter */
+  item = g_list_model_get_item (G_LIST_MODEL (model), 10);
+  item->n = 11;
+  gtd_list_model_filter_refilter_item (filter, item);
+
+  g_assert_cmpint (49, ==, g_list_model_get_n_items (G_LIST_MODEL (filter)));
+  g_assert_cmpint (n_emissions, ==, 1);
+  g_assert_cmpint (last_changed_position, ==, 5);
+  g_assert_cmpint (last_n_removed, ==, 1);
+  g_assert_cmpint (last_n_added, ==, 0);
+
+  /* Refiltering without changes doesn't emit anything */
+  gtd_list_model_filter_refilter_item (filter, item);
+  g_assert_cmpint (n_emissions, ==, 1);
+
+  /* Show it again, at the same position */
+  item->n = 10;
+  gtd_list_model_filter_refilter_range (filter, 0, 100);
+
+  g_assert_cmpint (50, ==, g_list_model_get_n_items (G_LIST_MODEL (filter)));
+  g_assert_cmpint (n_emissions, ==, 2);
+  g_assert_cmpint (last_changed_position, ==, 5);
+  g_assert_cmpint (last_n_removed, ==, 0);
+  g_assert_cmpint (last_n_added, ==, 1);
+
+  g_clear_object (&item);
+
+  /* Watched items are refiltered when they change */
+  gtd_list_model_filter_set_watch_items (filter, TRUE);
+
+  item = g_list_model_get_item (G_LIST_MODEL (model), 99);
+  g_object_set (item, "n", 98, NULL);
+
+  g_assert_cmpint (51, ==, g_list_model_get_n_items (G_LIST_MODEL (filter)));
+  g_assert_cmpint (n_emissions, ==, 3);
+  g_assert_cmpint (last_changed_position, ==, 50);
+
+  {
+    g_autoptr (TestItem) last = g_list_model_get_item (G_LIST_MODEL (filter), 50);
+    g_assert_true (last == item);
+  }
+
+  gtd_list_model_filter_set_watch_items (filter, FALSE);
+  g_object_set (item, "n", 99, NULL);
+  g_assert_cmpint (n_emissions, ==, 3);
+
+  g_clear_object (&item);
+  g_clear_object (&model);
+  g_clear_object (&filter);
+}
+
 gint
 main (gint argc,
       gchar *argv[])
@@ -204,5 +343,6 @@ main (gint argc,
   g_test_init (&argc, &argv, NULL);
   g_test_add_func ("/models/model-filter/basic", test_basic);
   g_test_add_func ("/models/model-filter/items-changed", test_items_changed);
+  g_test_add_func ("/models/model-filter/refilter-item", test_refilter_item);
   return g_test_run ();
 }
@@ -0,0 +1,332 @@
+/* test-snapshot.c
+ *
+ * Copyright 2020 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "gnome-todo.h"
+
+#include "core/gtd-log.h"
+#include "core/gtd-snapshot-private.h"
+#include "gtd-manager-protected.h"
+#include "dummy-provider.h"
+
+#include <glib/gstdio.h>
+
+static gchar*
+create_snapshot_path (void)
+{
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *dir = NULL;
+
+  dir = g_dir_make_tmp ("gnome-todo-snapshot-XXXXXX", &error);
+  g_assert_no_error (error);
+
+  return g_build_filename (dir, "snapshot.gvariant", NULL);
+}
+
+static void
+remove_snapshot_path (const gchar *path)
+{
+  g_autofree gchar *dir = g_path_get_dirname (path);
+
+  g_unlink (path);
+  g_rmdir (dir);
+}
+
+static void
+assert_same_day (GDateTime *a,
+                 GDateTime *b)
+{
+  g_assert_true ((a == NULL) == (b == NULL));
+
+  if (a)
+    {
+      g_assert_true (g_date_time_equal (a, b));
+      g_assert_cmpint (g_date_time_get_year (a), ==, g_date_time_get_year (b));
+      g_assert_cmpint (g_date_time_get_day_of_year (a), ==, g_date_time_get_day_of_year (b));
+    }
+
+  g_clear_pointer (&a, g_date_time_unref);
+  g_clear_pointer (&b, g_date_time_unref);
+}
+
+static void
+test_round_trip (void)
+{
+  g_autoptr (DummyProvider) dummy_provider = NULL;
+  g_autoptr (GListStore) lists_store = NULL;
+  g_autoptr (GPtrArray) providers = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autoptr (GDateTime) due_date = NULL;
+  g_autoptr (GList) lists = NULL;
+  g_autofree gchar *path = NULL;
+  GtdSnapshotProvider *snapshot_provider;
+  GtdTask *task;
+  GList *l;
+
+  dummy_provider = dummy_provider_new ();
+  dummy_provider_generate_task_list (dummy_provider);
+  dummy_provider_generate_task_lists (dummy_provider);
+
+  lists = gtd_provider_get_task_lists (GTD_PROVIDER (dummy_provider));
+  lists_store = g_list_store_new (GTD_TYPE_TASK_LIST);
+
+  for (l = lists; l; l = l->next)
+    g_list_store_append (lists_store, l->data);
+
+  /* Some state that must survive the round trip */
+  gtd_task_list_set_archived (lists->data, TRUE);
+  task = g_list_model_get_item (lists->data, 0);
+  gtd_task_set_complete (task, TRUE);
+  g_object_unref (task);
+
+  /* Date-only due dates are UTC midnight, like EDS creates them */
+  due_date = g_date_time_new_utc (2020, 3, 31, 0, 0, 0);
+  task = g_list_model_get_item (lists->data, 1);
+  gtd_task_set_due_date (task, due_date);
+  g_object_unref (task);
+
+  path = create_snapshot_path ();
+  _gtd_snapshot_save (G_LIST_MODEL (lists_store), path, &error);
+  g_assert_no_error (error);
+
+  providers = _gtd_snapshot_load (path, &error);
+  g_assert_no_error (error);
+  g_assert_nonnull (providers);
+  g_assert_cmpuint (providers->len, ==, 1);
+
+  snapshot_provider = g_ptr_array_index (providers, 0);
+  g_assert_cmpstr (gtd_provider_get_id (GTD_PROVIDER (snapshot_provider)), ==, "dummy-provider");
+
+  for (l = lists; l; l = l->next)
+    {
+      GtdTaskList *placeholder;
+      GtdTaskList *list;
+      guint i;
+
+      list = l->data;
+      placeholder = _gtd_snapshot_provider_lookup_list (snapshot_provider, gtd_object_get_uid (GTD_OBJECT (list)));
+
+      g_assert_nonnull (placeholder);
+      g_assert_cmpstr (gtd_task_list_get_name (placeholder), ==, gtd_task_list_get_name (list));
+      g_assert_cmpint (gtd_task_list_get_archived (placeholder), ==, gtd_task_list_get_archived (list));
+      g_assert_cmpuint (gtd_task_list_get_n_tasks (placeholder), ==, gtd_task_list_get_n_tasks (list));
+      g_assert_cmpuint (gtd_task_list_get_n_completed (placeholder), ==, gtd_task_list_get_n_completed (list));
+
+      for (i = 0; i < g_list_model_get_n_items (G_LIST_MODEL (list)); i++)
+        {
+          g_autoptr (GtdTask) original = g_list_model_get_item (G_LIST_MODEL (list), i);
+          GtdTask *copy;
+
+          copy = gtd_task_list_get_task_by_id (placeholder, gtd_object_get_uid (GTD_OBJECT (original)));
+
+          g_assert_nonnull (copy);
+          g_assert_cmpstr (gtd_task_get_title (copy), ==, gtd_task_get_title (original));
+          g_assert_cmpint (gtd_task_get_depth (copy), ==, gtd_task_get_depth (original));
+          assert_same_day (gtd_task_get_due_date (copy), gtd_task_get_due_date (original));
+          g_assert_true (gtd_object_get_loading (GTD_OBJECT (copy)));
+        }
+    }
+
+  remove_snapshot_path (path);
+}
+
+static void
+test_reconcile (void)
+{
+  g_autoptr (DummyProvider) dummy_provider = NULL;
+  g_autoptr (GListStore) lists_store = NULL;
+  g_autoptr (GtdManager) manager = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autoptr (GList) lists = NULL;
+  g_autofree gchar *path = NULL;
+  GtdStartupStats stats;
+  GListModel *lists_model;
+  GListModel *tasks_model;
+  guint n_tasks;
+  guint i;
+  GList *l;
+
+  /* Save a snapshot of a previous run */
+  dummy_provider = dummy_provider_new ();
+  n_tasks = dummy_provider_generate_task_lists (dummy_provider);
+
+  lists = gtd_provider_get_task_lists (GTD_PROVIDER (dummy_provider));
+  lists_store = g_list_store_new (GTD_TYPE_TASK_LIST);
+
+  for (l = lists; l; l = l->next)
+    g_list_store_append (lists_store, l->data);
+
+  path = create_snapshot_path ();
+  _gtd_snapshot_save (G_LIST_MODEL (lists_store), path, &error);
+  g_assert_no_error (error);
+
+  /* Tasks are available right after loading the snapshot */
+  manager = gtd_manager_new ();
+  lists_model = gtd_manager_get_task_lists_model (manager);
+  tasks_model = gtd_manager_get_tasks_model (manager);
+
+  gtd_manager_load_snapshot (manager, path, &error);
+  g_assert_no_error (error);
+
+  gtd_manager_get_startup_stats (manager, &stats);
+  g_assert_cmpint (stats.mode, ==, GTD_STARTUP_MODE_SNAPSHOT);
+  g_assert_cmpint (stats.first_data_us, >, 0);
+  g_assert_cmpint (stats.reconciled_us, ==, 0);
+
+  g_assert_cmpuint (g_list_model_get_n_items (lists_model), ==, g_list_length (lists));
+  g_assert_cmpuint (g_list_model_get_n_items (tasks_model), ==, n_tasks);
+
+  for (i = 0; i < g_list_model_get_n_items (lists_model); i++)
+    {
+      g_autoptr (GtdTaskList) list = g_list_model_get_item (lists_model, i);
+
+      g_assert_true (GTD_IS_SNAPSHOT_PROVIDER (gtd_task_list_get_provider (list)));
+    }
+
+  /* The real lists replace the placeholders in place */
+  gtd_manager_add_provider (manager, GTD_PROVIDER (dummy_provider));
+
+  gtd_manager_get_startup_stats (manager, &stats);
+  g_assert_cmpint (stats.reconciled_us, >=, stats.first_data_us);
+
+  g_assert_cmpuint (g_list_model_get_n_items (lists_model), ==, g_list_length (lists));
+  g_assert_cmpuint (g_list_model_get_n_items (tasks_model), ==, n_tasks);
+
+  for (i = 0; i < g_list_model_get_n_items (lists_model); i++)
+    {
+      g_autoptr (GtdTaskList) list = g_list_model_get_item (lists_model, i);
+
+      g_assert_true (gtd_task_list_get_provider (list) == GTD_PROVIDER (dummy_provider));
+    }
+
+  gtd_manager_remove_provider (manager, GTD_PROVIDER (dummy_provider));
+
+  remove_snapshot_path (path);
+}
+
+static void
+on_lists_items_changed_cb (GListModel *model,
+                           guint       position,
+                           guint       removed,
+                           guint       added,
+                           guint      *n_swaps)
+{
+  /* Placeholders must only ever be swapped in place */
+  g_assert_cmpuint (removed, ==, 1);
+  g_assert_cmpuint (added, ==, 1);
+
+  (*n_swaps)++;
+}
+
+static void
+test_reconcile_loading (void)
+{
+  g_autoptr (DummyProvider) loading_provider = NULL;
+  g_autoptr (DummyProvider) dummy_provider = NULL;
+  g_autoptr (GListStore) lists_store = NULL;
+  g_autoptr (GtdManager) manager = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autoptr (GList) lists = NULL;
+  g_autofree gchar *path = NULL;
+  GtdStartupStats stats;
+  GListModel *lists_model;
+  guint n_swaps;
+  guint i;
+  GList *l;
+
+  dummy_provider = dummy_provider_new ();
+  dummy_provider_generate_task_lists (dummy_provider);
+
+  lists = gtd_provider_get_task_lists (GTD_PROVIDER (dummy_provider));
+  lists_store = g_list_store_new (GTD_TYPE_TASK_LIST);
+
+  for (l = lists; l; l = l->next)
+    g_list_store_append (lists_store, l->data);
+
+  path = create_snapshot_path ();
+  _gtd_snapshot_save (G_LIST_MODEL (lists_store), path, &error);
+  g_assert_no_error (error);
+
+  manager = gtd_manager_new ();
+  lists_model = gtd_manager_get_task_lists_model (manager);
+
+  gtd_manager_load_snapshot (manager, path, &error);
+  g_assert_no_error (error);
+
+  /* A provider with the same id that is still loading, and has no lists yet */
+  loading_provider = dummy_provider_new ();
+  gtd_object_push_loading (GTD_OBJECT (loading_provider));
+
+  gtd_manager_add_provider (manager, GTD_PROVIDER (loading_provider));
+
+  g_assert_cmpuint (g_list_model_get_n_items (lists_model), ==, g_list_length (lists));
+
+  n_swaps = 0;
+  g_signal_connect (lists_model, "items-changed", G_CALLBACK (on_lists_items_changed_cb), &n_swaps);
+
+  /* Like EDS, it stops loading right before announcing its last list */
+  for (l = lists; l; l = l->next)
+    {
+      if (!l->next)
+        gtd_object_pop_loading (GTD_OBJECT (loading_provider));
+
+      g_signal_emit_by_name (loading_provider, "list-added", l->data);
+    }
+
+  while (g_main_context_iteration (NULL, FALSE))
+    ;
+
+  g_signal_handlers_disconnect_by_func (lists_model, on_lists_items_changed_cb, &n_swaps);
+
+  g_assert_cmpuint (n_swaps, ==, g_list_length (lists));
+  g_assert_cmpuint (g_list_model_get_n_items (lists_model), ==, g_list_length (lists));
+
+  for (i = 0; i < g_list_model_get_n_items (lists_model); i++)
+    {
+      g_autoptr (GtdTaskList) list = g_list_model_get_item (lists_model, i);
+
+      g_assert_false (GTD_IS_SNAPSHOT_PROVIDER (gtd_task_list_get_provider (list)));
+    }
+
+  gtd_manager_get_startup_stats (manager, &stats);
+  g_assert_cmpint (stats.reconciled_us, >, 0);
+
+  for (l = lists; l; l = l->next)
+    g_signal_emit_by_name (loading_provider, "list-removed", l->data);
+
+  gtd_manager_remove_provider (manager, GTD_PROVIDER (loading_provider));
+
+  remove_snapshot_path (path);
+}
+
+gint
+main (gint   argc,
+      gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  if (g_getenv ("G_MESSAGES_DEBUG"))
+    gtd_log_init ();
+
+  g_test_add_func ("/snapshot/round-trip", test_round_trip);
+  g_test_add_func ("/snapshot/reconcile", test_reconcile);
+  g_test_add_func ("/snapshot/reconcile-loading", test_reconcile_loading);
+
+  return g_test_run ();
+}
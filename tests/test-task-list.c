@@ -86,6 +86,385 @@ test_move (void)
   g_assert_true (g_list_model_get_item (model, 6) == last_root_task);
 }
 
+static void
+on_items_changed_cb (GListModel *model,
+                     guint       position,
+                     guint       removed,
+                     guint       added,
+                     guint      *n_emissions)
+{
+  (*n_emissions)++;
+}
+
+static void
+on_items_changed_count_cb (GListModel *model,
+                           guint       position,
+                           guint       removed,
+                           guint       added,
+                           guint      *n_announced)
+{
+  *n_announced = *n_announced - removed + added;
+}
+
+static void
+on_task_added_cb (GtdTaskList *list,
+                  GtdTask     *task,
+                  guint       *n_announced)
+{
+  /* Handlers must only see tasks that were announced with items-changed */
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (list)), ==, *n_announced);
+}
+
+static GtdTask*
+create_task (GtdTaskList *list,
+             gint64       position)
+{
+  g_autofree gchar *title = NULL;
+  g_autofree gchar *uuid = NULL;
+  GtdTask *task;
+
+  uuid = g_uuid_string_random ();
+  title = g_strdup_printf ("%" G_GINT64_FORMAT, position);
+
+  task = gtd_task_new ();
+  gtd_task_set_list (task, list);
+  gtd_object_set_uid (GTD_OBJECT (task), uuid);
+  gtd_task_set_title (task, title);
+  gtd_task_set_position (task, position);
+
+  return task;
+}
+
+static void
+test_add_tasks (void)
+{
+  g_autoptr (DummyProvider) dummy_provider = NULL;
+  g_autoptr (GtdTaskList) list = NULL;
+  g_autoptr (GPtrArray) tasks = NULL;
+  g_autoptr (GtdTask) extra_task = NULL;
+  GListModel *model;
+  guint n_announced;
+  guint n_emissions;
+  guint i;
+
+  dummy_provider = dummy_provider_new ();
+  list = g_object_new (GTD_TYPE_TASK_LIST,
+                       "provider", dummy_provider,
+                       "name", "Bulk",
+                       NULL);
+  model = G_LIST_MODEL (list);
+
+  n_emissions = 0;
+  g_signal_connect (list, "items-changed", G_CALLBACK (on_items_changed_cb), &n_emissions);
+
+  n_announced = 0;
+  g_signal_connect (list, "items-changed", G_CALLBACK (on_items_changed_count_cb), &n_announced);
+  g_signal_connect (list, "task-added", G_CALLBACK (on_task_added_cb), &n_announced);
+
+  /* Root tasks are added in reverse order, and the last one has 2 subtasks */
+  tasks = g_ptr_array_new_with_free_func (g_object_unref);
+
+  for (i = 0; i < 5; i++)
+    g_ptr_array_add (tasks, create_task (list, 4 - i));
+
+  /* Parents don't own their subtasks, so keep them in the array too */
+  for (i = 0; i < 2; i++)
+    {
+      GtdTask *subtask = create_task (list, 5 + i);
+
+      gtd_task_add_subtask (g_ptr_array_index (tasks, 0), subtask);
+      g_ptr_array_add (tasks, subtask);
+    }
+
+  gtd_task_list_add_tasks (list, tasks);
+
+  g_assert_cmpuint (n_emissions, ==, 1);
+  g_assert_cmpuint (g_list_model_get_n_items (model), ==, 7);
+
+  for (i = 0; i < g_list_model_get_n_items (model); i++)
+    {
+      g_autoptr (GtdTask) task = g_list_model_get_item (model, i);
+
+      g_assert_true (gtd_task_list_contains (list, task));
+      g_assert_cmpint (gtd_task_get_position (task), ==, i);
+    }
+
+  /* Adding to a non-empty list also emits items-changed once */
+  extra_task = create_task (list, 7);
+  g_ptr_array_set_size (tasks, 0);
+  g_ptr_array_add (tasks, g_object_ref (extra_task));
+  g_ptr_array_add (tasks, g_object_ref (extra_task));
+
+  gtd_task_list_add_tasks (list, tasks);
+
+  g_assert_cmpuint (n_emissions, ==, 2);
+  g_assert_cmpuint (g_list_model_get_n_items (model), ==, 8);
+  g_assert_true (gtd_task_list_get_task_by_id (list, gtd_object_get_uid (GTD_OBJECT (extra_task))) == extra_task);
+}
+
+typedef struct
+{
+  guint               n_emissions;
+  guint               position;
+  guint               removed;
+  guint               added;
+} ItemsChanged;
+
+static void
+on_items_changed_record_cb (GListModel   *model,
+                            guint         position,
+                            guint         removed,
+                            guint         added,
+                            ItemsChanged *items_changed)
+{
+  items_changed->n_emissions++;
+  items_changed->position = position;
+  items_changed->removed = removed;
+  items_changed->added = added;
+}
+
+static void
+on_items_changed_mirror_cb (GListModel *model,
+                            guint       position,
+                            guint       removed,
+                            guint       added,
+                            GPtrArray  *mirror)
+{
+  guint i;
+
+  g_ptr_array_remove_range (mirror, position, removed);
+
+  for (i = 0; i < added; i++)
+    g_ptr_array_insert (mirror, position + i, g_list_model_get_item (model, position + i));
+}
+
+static void
+test_freeze (void)
+{
+  g_autoptr (DummyProvider) dummy_provider = NULL;
+  g_autoptr (GtdTaskList) list = NULL;
+  g_autoptr (GtdTask) frozen_task = NULL;
+  g_autoptr (GPtrArray) mirror = NULL;
+  g_autoptr (GPtrArray) tasks = NULL;
+  g_autoptr (GtdTask) added_task = NULL;
+  ItemsChanged items_changed = { 0, };
+  GListModel *model;
+  guint i;
+
+  dummy_provider = dummy_provider_new ();
+  list = g_object_new (GTD_TYPE_TASK_LIST,
+                       "provider", dummy_provider,
+                       "name", "Frozen",
+                       NULL);
+  model = G_LIST_MODEL (list);
+
+  tasks = g_ptr_array_new_with_free_func (g_object_unref);
+
+  for (i = 0; i < 10; i++)
+    g_ptr_array_add (tasks, create_task (list, i));
+
+  gtd_task_list_add_tasks (list, tasks);
+
+  g_signal_connect (list, "items-changed", G_CALLBACK (on_items_changed_record_cb), &items_changed);
+
+  /* Reverse tasks 3 to 6, nesting the freezes */
+  gtd_task_list_freeze (list);
+  gtd_task_list_freeze (list);
+
+  for (i = 3; i <= 6; i++)
+    gtd_task_set_position (g_ptr_array_index (tasks, i), 9 - i);
+
+  gtd_task_list_thaw (list);
+
+  g_assert_cmpuint (items_changed.n_emissions, ==, 0);
+
+  /* Still frozen, so the old order is kept */
+  frozen_task = g_list_model_get_item (model, 3);
+  g_assert_true (frozen_task == g_ptr_array_index (tasks, 3));
+
+  gtd_task_list_thaw (list);
+
+  /* Only the range that moved is reported, once */
+  g_assert_cmpuint (items_changed.n_emissions, ==, 1);
+  g_assert_cmpuint (items_changed.position, ==, 3);
+  g_assert_cmpuint (items_changed.removed, ==, 4);
+  g_assert_cmpuint (items_changed.added, ==, 4);
+
+  for (i = 0; i < g_list_model_get_n_items (model); i++)
+    {
+      g_autoptr (GtdTask) task = g_list_model_get_item (model, i);
+      guint expected = i >= 3 && i <= 6 ? 9 - i : i;
+
+      g_assert_true (task == g_ptr_array_index (tasks, expected));
+    }
+
+  /* Thawing without changes emits nothing */
+  gtd_task_list_freeze (list);
+  gtd_task_list_thaw (list);
+
+  g_assert_cmpuint (items_changed.n_emissions, ==, 1);
+
+  /* Updated tasks are reported when thawing, even if they didn't move */
+  gtd_task_list_freeze (list);
+  gtd_task_list_update_task (list, g_ptr_array_index (tasks, 1));
+  gtd_task_list_update_task (list, g_ptr_array_index (tasks, 8));
+
+  g_assert_cmpuint (items_changed.n_emissions, ==, 1);
+
+  gtd_task_list_thaw (list);
+
+  g_assert_cmpuint (items_changed.n_emissions, ==, 2);
+  g_assert_cmpuint (items_changed.position, ==, 1);
+  g_assert_cmpuint (items_changed.removed, ==, 8);
+  g_assert_cmpuint (items_changed.added, ==, 8);
+
+  /* Adding and removing tasks while frozen keeps the signals consistent */
+  mirror = g_ptr_array_new_with_free_func (g_object_unref);
+  on_items_changed_mirror_cb (model, 0, 0, g_list_model_get_n_items (model), mirror);
+  g_signal_connect (list, "items-changed", G_CALLBACK (on_items_changed_mirror_cb), mirror);
+
+  gtd_task_list_freeze (list);
+
+  gtd_task_set_position (g_ptr_array_index (tasks, 0), 20);
+
+  added_task = create_task (list, 10);
+  gtd_task_list_add_task (list, added_task);
+  gtd_task_list_remove_task (list, g_ptr_array_index (tasks, 9));
+
+  gtd_task_list_thaw (list);
+
+  g_assert_cmpuint (g_list_model_get_n_items (model), ==, 10);
+  g_assert_cmpuint (mirror->len, ==, 10);
+
+  for (i = 0; i < mirror->len; i++)
+    {
+      g_autoptr (GtdTask) task = g_list_model_get_item (model, i);
+
+      g_assert_true (task == g_ptr_array_index (mirror, i));
+    }
+
+  g_assert_true (g_ptr_array_index (mirror, 9) == g_ptr_array_index (tasks, 0));
+}
+
+static void
+test_remove_tasks (void)
+{
+  g_autoptr (DummyProvider) dummy_provider = NULL;
+  g_autoptr (GtdTaskList) list = NULL;
+  g_autoptr (GPtrArray) removed_tasks = NULL;
+  g_autoptr (GPtrArray) tasks = NULL;
+  ItemsChanged items_changed = { 0, };
+  GListModel *model;
+  guint i;
+
+  dummy_provider = dummy_provider_new ();
+  list = g_object_new (GTD_TYPE_TASK_LIST,
+                       "provider", dummy_provider,
+                       "name", "Removal",
+                       NULL);
+  model = G_LIST_MODEL (list);
+
+  tasks = g_ptr_array_new_with_free_func (g_object_unref);
+
+  for (i = 0; i < 10; i++)
+    g_ptr_array_add (tasks, create_task (list, i));
+
+  /* Task 3 is the parent of task 4 */
+  gtd_task_add_subtask (g_ptr_array_index (tasks, 3), g_ptr_array_index (tasks, 4));
+
+  gtd_task_list_add_tasks (list, tasks);
+
+  g_signal_connect (list, "items-changed", G_CALLBACK (on_items_changed_record_cb), &items_changed);
+
+  /* Subtasks and duplicates are removed only once */
+  removed_tasks = g_ptr_array_new ();
+  g_ptr_array_add (removed_tasks, g_ptr_array_index (tasks, 6));
+  g_ptr_array_add (removed_tasks, g_ptr_array_index (tasks, 3));
+  g_ptr_array_add (removed_tasks, g_ptr_array_index (tasks, 4));
+  g_ptr_array_add (removed_tasks, g_ptr_array_index (tasks, 6));
+
+  gtd_task_list_remove_tasks (list, removed_tasks);
+
+  g_assert_cmpuint (items_changed.n_emissions, ==, 1);
+  g_assert_cmpuint (items_changed.position, ==, 3);
+  g_assert_cmpuint (items_changed.removed, ==, 4);
+  g_assert_cmpuint (items_changed.added, ==, 1);
+  g_assert_cmpuint (g_list_model_get_n_items (model), ==, 7);
+
+  g_assert_false (gtd_task_list_contains (list, g_ptr_array_index (tasks, 3)));
+  g_assert_false (gtd_task_list_contains (list, g_ptr_array_index (tasks, 4)));
+  g_assert_false (gtd_task_list_contains (list, g_ptr_array_index (tasks, 6)));
+
+  /* Removing tasks that are not in the list emits nothing */
+  gtd_task_list_remove_tasks (list, removed_tasks);
+
+  g_assert_cmpuint (items_changed.n_emissions, ==, 1);
+}
+
+static void
+test_counters (void)
+{
+  g_autoptr (DummyProvider) dummy_provider = NULL;
+  g_autoptr (GDateTime) yesterday = NULL;
+  g_autoptr (GtdTaskList) list = NULL;
+  g_autoptr (GPtrArray) removed_tasks = NULL;
+  g_autoptr (GPtrArray) tasks = NULL;
+  g_autoptr (GDateTime) today = NULL;
+  guint i;
+
+  dummy_provider = dummy_provider_new ();
+  list = g_object_new (GTD_TYPE_TASK_LIST,
+                       "provider", dummy_provider,
+                       "name", "Counters",
+                       NULL);
+
+  today = g_date_time_new_now_local ();
+  yesterday = g_date_time_add_days (today, -1);
+
+  tasks = g_ptr_array_new_with_free_func (g_object_unref);
+
+  for (i = 0; i < 6; i++)
+    g_ptr_array_add (tasks, create_task (list, i));
+
+  /* Tasks 0 and 1 are due today, task 2 is overdue, and task 3 is complete */
+  gtd_task_set_due_date (g_ptr_array_index (tasks, 0), today);
+  gtd_task_set_due_date (g_ptr_array_index (tasks, 1), today);
+  gtd_task_set_due_date (g_ptr_array_index (tasks, 2), yesterday);
+  gtd_task_set_complete (g_ptr_array_index (tasks, 3), TRUE);
+
+  gtd_task_list_add_tasks (list, tasks);
+
+  g_assert_cmpuint (gtd_task_list_get_n_tasks (list), ==, 6);
+  g_assert_cmpuint (gtd_task_list_get_n_completed (list), ==, 1);
+  g_assert_cmpuint (gtd_task_list_get_n_due_today (list), ==, 2);
+  g_assert_cmpuint (gtd_task_list_get_n_overdue (list), ==, 1);
+
+  /* Completed tasks are neither due today nor overdue */
+  gtd_task_set_complete (g_ptr_array_index (tasks, 0), TRUE);
+  gtd_task_set_complete (g_ptr_array_index (tasks, 2), TRUE);
+
+  g_assert_cmpuint (gtd_task_list_get_n_completed (list), ==, 3);
+  g_assert_cmpuint (gtd_task_list_get_n_due_today (list), ==, 1);
+  g_assert_cmpuint (gtd_task_list_get_n_overdue (list), ==, 0);
+
+  gtd_task_set_complete (g_ptr_array_index (tasks, 2), FALSE);
+  gtd_task_set_due_date (g_ptr_array_index (tasks, 1), NULL);
+
+  g_assert_cmpuint (gtd_task_list_get_n_completed (list), ==, 2);
+  g_assert_cmpuint (gtd_task_list_get_n_due_today (list), ==, 0);
+  g_assert_cmpuint (gtd_task_list_get_n_overdue (list), ==, 1);
+
+  removed_tasks = g_ptr_array_new ();
+  g_ptr_array_add (removed_tasks, g_ptr_array_index (tasks, 2));
+  g_ptr_array_add (removed_tasks, g_ptr_array_index (tasks, 3));
+
+  gtd_task_list_remove_tasks (list, removed_tasks);
+
+  g_assert_cmpuint (gtd_task_list_get_n_tasks (list), ==, 4);
+  g_assert_cmpuint (gtd_task_list_get_n_completed (list), ==, 1);
+  g_assert_cmpuint (gtd_task_list_get_n_overdue (list), ==, 0);
+}
+
 gint
 main (gint argc,
       gchar *argv[])
@@ -96,6 +475,10 @@ main (gint argc,
     gtd_log_init ();
 
   g_test_add_func ("/task-list/move", test_move);
+  g_test_add_func ("/task-list/add-tasks", test_add_tasks);
+  g_test_add_func ("/task-list/freeze", test_freeze);
+  g_test_add_func ("/task-list/remove-tasks", test_remove_tasks);
+  g_test_add_func ("/task-list/counters", test_counters);
 
   return g_test_run ();
 }
@@ -52,6 +52,60 @@ test_basic (void)
     }
 }
 
+static void
+on_items_changed_cb (GListModel *model,
+                     guint       position,
+                     guint       removed,
+                     guint       added,
+                     guint      *n_emissions)
+{
+  (*n_emissions)++;
+}
+
+static void
+test_archived (void)
+{
+  g_autoptr (DummyProvider) dummy_provider = NULL;
+  g_autoptr (GList) lists = NULL;
+  GdkRGBA color = { 1.0, 0.0, 0.0, 1.0 };
+  GtdTaskList *list;
+  GListModel *model;
+  guint n_emissions;
+  guint n_tasks;
+
+  dummy_provider = dummy_provider_new ();
+  dummy_provider_generate_task_lists (dummy_provider);
+  gtd_manager_add_provider (gtd_manager_get_default (), GTD_PROVIDER (dummy_provider));
+
+  lists = gtd_provider_get_task_lists (GTD_PROVIDER (dummy_provider));
+  list = lists->data;
+
+  model = gtd_manager_get_tasks_model (gtd_manager_get_default ());
+  n_tasks = g_list_model_get_n_items (model);
+
+  n_emissions = 0;
+  g_signal_connect (model, "items-changed", G_CALLBACK (on_items_changed_cb), &n_emissions);
+
+  /* Archiving removes the tasks of the list in a single range */
+  gtd_task_list_set_archived (list, TRUE);
+
+  g_assert_cmpuint (n_emissions, ==, 1);
+  g_assert_cmpuint (g_list_model_get_n_items (model), ==, n_tasks - gtd_task_list_get_n_tasks (list));
+
+  gtd_task_list_set_archived (list, FALSE);
+
+  g_assert_cmpuint (n_emissions, ==, 2);
+  g_assert_cmpuint (g_list_model_get_n_items (model), ==, n_tasks);
+
+  /* Other changes to the list don't touch the tasks */
+  gtd_task_list_set_color (list, &color);
+  g_signal_emit_by_name (dummy_provider, "list-changed", list);
+
+  g_assert_cmpuint (n_emissions, ==, 2);
+
+  g_signal_handlers_disconnect_by_func (model, on_items_changed_cb, &n_emissions);
+}
+
 gint
 main (gint argc,
       gchar *argv[])
@@ -62,6 +116,7 @@ main (gint argc,
     gtd_log_init ();
 
   g_test_add_func ("/models/task-model/basic", test_basic);
+  g_test_add_func ("/models/task-model/archived", test_archived);
 
   return g_test_run ();
 }
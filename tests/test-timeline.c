@@ -0,0 +1,134 @@
+/* test-timeline.c
+ *
+ * Copyright 2020 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "gnome-todo.h"
+
+#include "animation/gtd-timeline-private.h"
+#include "core/gtd-log.h"
+
+/* Like bulk actions on task rows, with hundreds of concurrent transitions */
+#define N_TIMELINES  500
+#define DURATION_MS  300
+#define TIMEOUT_SEC  10
+
+static gboolean has_display = FALSE;
+
+static void
+on_timeline_stopped_cb (GtdTimeline *timeline,
+                        gboolean     is_finished,
+                        guint       *n_stopped)
+{
+  (*n_stopped)++;
+}
+
+static gboolean
+on_timeout_cb (gpointer user_data)
+{
+  gboolean *timed_out = user_data;
+
+  *timed_out = TRUE;
+
+  return G_SOURCE_REMOVE;
+}
+
+
+/*
+ * Tests
+ */
+
+static void
+test_frame_budget (void)
+{
+  g_autoptr (GPtrArray) timelines = NULL;
+  GtdTimelineFrameStats stats;
+  GdkFrameClock *frame_clock;
+  GtkWidget *window;
+  gboolean timed_out;
+  guint timeout_id;
+  guint n_stopped;
+  guint i;
+
+  if (!has_display)
+    {
+      g_test_skip ("No display to drive a frame clock");
+      return;
+    }
+
+  window = gtk_window_new ();
+  gtk_window_present (GTK_WINDOW (window));
+
+  frame_clock = gtk_widget_get_frame_clock (window);
+  g_assert_nonnull (frame_clock);
+
+  timelines = g_ptr_array_new_with_free_func (g_object_unref);
+  n_stopped = 0;
+
+  for (i = 0; i < N_TIMELINES; i++)
+    {
+      GtdTimeline *timeline = gtd_timeline_new_for_frame_clock (frame_clock, DURATION_MS);
+
+      g_signal_connect (timeline, "stopped", G_CALLBACK (on_timeline_stopped_cb), &n_stopped);
+      g_ptr_array_add (timelines, timeline);
+
+      gtd_timeline_start (timeline);
+    }
+
+  timed_out = FALSE;
+  timeout_id = g_timeout_add_seconds (TIMEOUT_SEC, on_timeout_cb, &timed_out);
+
+  while (n_stopped < N_TIMELINES && !timed_out)
+    g_main_context_iteration (NULL, TRUE);
+
+  g_assert_false (timed_out);
+  g_clear_handle_id (&timeout_id, g_source_remove);
+
+  gtd_timeline_get_frame_stats (frame_clock, &stats);
+
+  g_test_message ("%u frames, average %.2lfms, worst %.2lfms",
+                  stats.n_frames,
+                  stats.total_frame_us / 1000.0 / MAX (stats.n_frames, 1),
+                  stats.max_frame_us / 1000.0);
+
+  /*
+   * Only the average is asserted, since a single frame can always be
+   * delayed by the machine running the tests.
+   */
+  g_assert_cmpuint (stats.n_frames, >, 0);
+  g_assert_cmpint (stats.total_frame_us / stats.n_frames, <, GTD_TIMELINE_FRAME_BUDGET_US);
+
+  gtk_window_destroy (GTK_WINDOW (window));
+}
+
+gint
+main (gint   argc,
+      gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  if (g_getenv ("G_MESSAGES_DEBUG"))
+    gtd_log_init ();
+
+  /* Run under a headless display server, such as xvfb-run, to not skip */
+  has_display = gtk_init_check ();
+
+  g_test_add_func ("/timeline/frame-budget", test_frame_budget);
+
+  return g_test_run ();
+}
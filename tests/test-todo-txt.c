@@ -0,0 +1,270 @@
+/* test-todo-txt.c
+ *
+ * Copyright 2020 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "gnome-todo.h"
+
+#include "core/gtd-log.h"
+#include "gtd-provider-todo-txt.h"
+
+#include <glib/gstdio.h>
+#include <string.h>
+
+#define WAIT_TIMEOUT_USEC (5 * G_USEC_PER_SEC)
+
+#define INITIAL_CONTENTS \
+  "Task A @Work\n" \
+  "    Subtask B @Work\n" \
+  "Task C @Work\n" \
+  "Task D @Home\n"
+
+typedef struct
+{
+  gchar              *dir;
+  gchar              *path;
+  GtdProviderTodoTxt *provider;
+} Fixture;
+
+typedef gboolean (*ConditionFunc) (gpointer user_data);
+
+
+/*
+ * Auxiliary methods
+ */
+
+static void
+fixture_setup (Fixture       *fixture,
+               gconstpointer  user_data)
+{
+  g_autoptr (GError) error = NULL;
+  g_autoptr (GFile) file = NULL;
+
+  fixture->dir = g_dir_make_tmp ("gnome-todo-test-XXXXXX", &error);
+  g_assert_no_error (error);
+
+  fixture->path = g_build_filename (fixture->dir, "todo.txt", NULL);
+
+  g_file_set_contents (fixture->path, INITIAL_CONTENTS, -1, &error);
+  g_assert_no_error (error);
+
+  file = g_file_new_for_path (fixture->path);
+  fixture->provider = gtd_provider_todo_txt_new (file);
+}
+
+static void
+fixture_teardown (Fixture       *fixture,
+                  gconstpointer  user_data)
+{
+  g_clear_object (&fixture->provider);
+
+  g_unlink (fixture->path);
+  g_rmdir (fixture->dir);
+
+  g_clear_pointer (&fixture->path, g_free);
+  g_clear_pointer (&fixture->dir, g_free);
+}
+
+/* The provider only sees external changes through its file monitor */
+static void
+wait_until (ConditionFunc condition,
+            gpointer      user_data)
+{
+  gint64 deadline = g_get_monotonic_time () + WAIT_TIMEOUT_USEC;
+
+  while (!condition (user_data))
+    {
+      g_assert_cmpint (g_get_monotonic_time (), <, deadline);
+
+      if (!g_main_context_iteration (NULL, FALSE))
+        g_usleep (10000);
+    }
+}
+
+static GtdTaskList*
+find_list (GtdProviderTodoTxt *provider,
+           const gchar        *name)
+{
+  g_autoptr (GList) lists = NULL;
+  GList *l;
+
+  lists = gtd_provider_get_task_lists (GTD_PROVIDER (provider));
+
+  for (l = lists; l; l = l->next)
+    {
+      if (g_strcmp0 (gtd_task_list_get_name (l->data), name) == 0)
+        return l->data;
+    }
+
+  return NULL;
+}
+
+static GtdTask*
+peek_task (GtdTaskList *list,
+           guint        position)
+{
+  g_autoptr (GtdTask) task = g_list_model_get_item (G_LIST_MODEL (list), position);
+
+  return task;
+}
+
+static void
+on_list_removed_cb (GtdProvider *provider,
+                    GtdTaskList *list,
+                    guint       *n_removed)
+{
+  (*n_removed)++;
+}
+
+static gboolean
+list_has_n_items (gpointer user_data)
+{
+  GtdTaskList *list = user_data;
+
+  return g_list_model_get_n_items (G_LIST_MODEL (list)) == 4;
+}
+
+static gboolean
+file_has_title (gpointer user_data)
+{
+  g_autofree gchar *contents = NULL;
+  Fixture *fixture = user_data;
+
+  if (!g_file_get_contents (fixture->path, &contents, NULL, NULL))
+    return FALSE;
+
+  return strstr (contents, "Task A renamed") != NULL;
+}
+
+
+/*
+ * Tests
+ */
+
+static void
+test_load (Fixture       *fixture,
+           gconstpointer  user_data)
+{
+  g_autoptr (GList) lists = NULL;
+  GtdTaskList *work;
+  GtdTaskList *home;
+
+  lists = gtd_provider_get_task_lists (GTD_PROVIDER (fixture->provider));
+  g_assert_cmpuint (g_list_length (lists), ==, 2);
+
+  work = find_list (fixture->provider, "Work");
+  home = find_list (fixture->provider, "Home");
+
+  g_assert_nonnull (work);
+  g_assert_nonnull (home);
+
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (work)), ==, 3);
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (home)), ==, 1);
+
+  g_assert_cmpstr (gtd_task_get_title (peek_task (work, 0)), ==, "Task A");
+  g_assert_cmpstr (gtd_task_get_title (peek_task (work, 1)), ==, "Subtask B");
+  g_assert_cmpstr (gtd_task_get_title (peek_task (work, 2)), ==, "Task C");
+
+  g_assert_true (gtd_task_get_parent (peek_task (work, 1)) == peek_task (work, 0));
+}
+
+static void
+test_reconcile (Fixture       *fixture,
+                gconstpointer  user_data)
+{
+  g_autoptr (GError) error = NULL;
+  GtdTaskList *work;
+  GtdTask *task_a;
+  GtdTask *task_b;
+  GtdTask *task_c;
+  guint n_removed;
+
+  work = find_list (fixture->provider, "Work");
+  task_a = peek_task (work, 0);
+  task_b = peek_task (work, 1);
+  task_c = peek_task (work, 2);
+
+  n_removed = 0;
+  g_signal_connect (fixture->provider, "list-removed", G_CALLBACK (on_list_removed_cb), &n_removed);
+
+  /* Edit a task, add another one, and drop the only task of Home */
+  g_file_set_contents (fixture->path,
+                       "Task A @Work\n"
+                       "    Subtask B @Work\n"
+                       "Task C edited @Work\n"
+                       "Task E @Work\n",
+                       -1,
+                       &error);
+  g_assert_no_error (error);
+
+  wait_until (list_has_n_items, work);
+
+  /* The tasks that are still there are the same objects */
+  g_assert_true (peek_task (work, 0) == task_a);
+  g_assert_true (peek_task (work, 1) == task_b);
+  g_assert_true (peek_task (work, 2) == task_c);
+  g_assert_true (gtd_task_get_parent (task_b) == task_a);
+
+  g_assert_cmpstr (gtd_task_get_title (task_c), ==, "Task C edited");
+  g_assert_cmpstr (gtd_task_get_title (peek_task (work, 3)), ==, "Task E");
+
+  g_assert_null (find_list (fixture->provider, "Home"));
+  g_assert_cmpuint (n_removed, ==, 1);
+}
+
+static void
+test_save (Fixture       *fixture,
+           gconstpointer  user_data)
+{
+  g_autofree gchar *contents = NULL;
+  g_autoptr (GError) error = NULL;
+  GtdTaskList *work;
+  GtdTask *task_a;
+
+  work = find_list (fixture->provider, "Work");
+  task_a = peek_task (work, 0);
+
+  gtd_task_set_title (task_a, "Task A renamed");
+  gtd_provider_update_task (GTD_PROVIDER (fixture->provider), task_a, NULL, NULL, NULL);
+
+  wait_until (file_has_title, fixture);
+
+  /* Lines that didn't change are written back as they were */
+  g_file_get_contents (fixture->path, &contents, NULL, &error);
+  g_assert_no_error (error);
+
+  g_assert_nonnull (strstr (contents, "    Subtask B @Work\n"));
+  g_assert_nonnull (strstr (contents, "Task C @Work\n"));
+  g_assert_nonnull (strstr (contents, "Task D @Home\n"));
+}
+
+gint
+main (gint   argc,
+      gchar *argv[])
+{
+  g_test_init (&argc, &argv, NULL);
+
+  if (g_getenv ("G_MESSAGES_DEBUG"))
+    gtd_log_init ();
+
+  g_test_add ("/todo-txt/load", Fixture, NULL, fixture_setup, test_load, fixture_teardown);
+  g_test_add ("/todo-txt/reconcile", Fixture, NULL, fixture_setup, test_reconcile, fixture_teardown);
+  g_test_add ("/todo-txt/save", Fixture, NULL, fixture_setup, test_save, fixture_teardown);
+
+  return g_test_run ();
+}
@@ -0,0 +1,696 @@
+/* test-todoist-sync.c
+ *
+ * Copyright 2020 Georges Basile Stavracas Neto <georges.stavracas@gmail.com>
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ * SPDX-License-Identifier: GPL-3.0-or-later
+ */
+
+#include "gnome-todo.h"
+
+#include "core/gtd-log.h"
+#include "gtd-provider-todoist-private.h"
+
+#include <glib/gstdio.h>
+#include <json-glib/json-glib.h>
+#include <libsoup/soup.h>
+#include <string.h>
+
+#define EMPTY_DELTA "{ \"sync_token\": \"empty\", \"full_sync\": false, \"projects\": [], \"items\": [] }"
+
+/*
+ * A local stand-in for the Todoist sync endpoint. Sync requests are
+ * answered with the next recorded response, and the sync_token that was
+ * sent is recorded. Commands are acknowledged after an optional latency
+ * per batch. The connections that requests arrive on are counted.
+ */
+typedef struct
+{
+  SoupServer         *server;
+  gchar              *url;
+  const gchar       **responses;
+  GPtrArray          *sync_tokens;
+  GPtrArray          *sockets;
+
+  const guint        *latencies_ms;
+  guint               n_latencies;
+
+  GArray             *batch_sizes;
+  GArray             *batch_times;
+  guint               n_commands;
+  guint               n_in_flight;
+  guint               max_in_flight;
+} FakeTodoist;
+
+typedef struct
+{
+  FakeTodoist        *fake;
+  SoupMessage        *message;
+  gchar              *response;
+} DelayedResponse;
+
+static gboolean
+send_delayed_response_cb (gpointer user_data)
+{
+  DelayedResponse *delayed = user_data;
+  gsize length;
+
+  length = strlen (delayed->response);
+
+  soup_message_set_status (delayed->message, SOUP_STATUS_OK);
+  soup_message_set_response (delayed->message,
+                             "application/json",
+                             SOUP_MEMORY_TAKE,
+                             g_steal_pointer (&delayed->response),
+                             length);
+
+  soup_server_unpause_message (delayed->fake->server, delayed->message);
+
+  delayed->fake->n_in_flight--;
+
+  g_object_unref (delayed->message);
+  g_free (delayed);
+
+  return G_SOURCE_REMOVE;
+}
+
+static void
+handle_commands (FakeTodoist *fake,
+                 SoupMessage *message,
+                 const gchar *commands)
+{
+  g_autoptr (JsonBuilder) builder = NULL;
+  g_autoptr (JsonParser) parser = NULL;
+  g_autoptr (JsonNode) root = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *sync_token = NULL;
+  DelayedResponse *delayed;
+  JsonArray *array;
+  gint64 now;
+  guint n_commands;
+  guint batch;
+  guint i;
+
+  parser = json_parser_new ();
+  json_parser_load_from_data (parser, commands, -1, &error);
+  g_assert_no_error (error);
+
+  array = json_node_get_array (json_parser_get_root (parser));
+  n_commands = json_array_get_length (array);
+  batch = fake->batch_sizes->len;
+  now = g_get_monotonic_time ();
+
+  g_array_append_val (fake->batch_sizes, n_commands);
+  g_array_append_val (fake->batch_times, now);
+
+  fake->n_commands += n_commands;
+  fake->n_in_flight++;
+  fake->max_in_flight = MAX (fake->max_in_flight, fake->n_in_flight);
+
+  /* Acknowledge every command of the batch */
+  sync_token = g_strdup_printf ("commands-%u", batch + 1);
+
+  builder = json_builder_new ();
+  json_builder_begin_object (builder);
+
+  json_builder_set_member_name (builder, "sync_token");
+  json_builder_add_string_value (builder, sync_token);
+
+  json_builder_set_member_name (builder, "sync_status");
+  json_builder_begin_object (builder);
+
+  for (i = 0; i < n_commands; i++)
+    {
+      JsonObject *command = json_array_get_object_element (array, i);
+
+      json_builder_set_member_name (builder, json_object_get_string_member (command, "uuid"));
+      json_builder_add_string_value (builder, "ok");
+    }
+
+  json_builder_end_object (builder);
+
+  json_builder_set_member_name (builder, "temp_id_mapping");
+  json_builder_begin_object (builder);
+  json_builder_end_object (builder);
+
+  json_builder_end_object (builder);
+
+  root = json_builder_get_root (builder);
+
+  delayed = g_new0 (DelayedResponse, 1);
+  delayed->fake = fake;
+  delayed->message = g_object_ref (message);
+  delayed->response = json_to_string (root, FALSE);
+
+  soup_server_pause_message (fake->server, message);
+
+  g_timeout_add (batch < fake->n_latencies ? fake->latencies_ms[batch] : 0,
+                 send_delayed_response_cb,
+                 delayed);
+}
+
+static void
+server_callback (SoupServer        *server,
+                 SoupMessage       *message,
+                 const gchar       *path,
+                 GHashTable        *query,
+                 SoupClientContext *client,
+                 gpointer           user_data)
+{
+  g_autoptr (GHashTable) params = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *filename = NULL;
+  g_autofree gchar *contents = NULL;
+  FakeTodoist *fake;
+  const gchar *response;
+  GSocket *socket;
+  gsize length;
+
+  fake = user_data;
+  params = soup_form_decode (message->request_body->data);
+  socket = soup_client_context_get_gsocket (client);
+
+  if (!g_ptr_array_find (fake->sockets, socket, NULL))
+    g_ptr_array_add (fake->sockets, g_object_ref (socket));
+
+  if (g_hash_table_contains (params, "commands"))
+    {
+      handle_commands (fake, message, g_hash_table_lookup (params, "commands"));
+      return;
+    }
+
+  response = fake->responses[fake->sync_tokens->len];
+
+  g_ptr_array_add (fake->sync_tokens, g_strdup (g_hash_table_lookup (params, "sync_token")));
+
+  /* Once the recorded responses are over, nothing changes anymore */
+  if (!response)
+    {
+      soup_message_set_status (message, SOUP_STATUS_OK);
+      soup_message_set_response (message, "application/json", SOUP_MEMORY_STATIC, EMPTY_DELTA, strlen (EMPTY_DELTA));
+      return;
+    }
+
+  if (g_path_is_absolute (response))
+    filename = g_strdup (response);
+  else
+    filename = g_build_filename (TEST_DATA_DIR, "todoist", response, NULL);
+
+  g_file_get_contents (filename, &contents, &length, &error);
+  g_assert_no_error (error);
+
+  soup_message_set_status (message, SOUP_STATUS_OK);
+  soup_message_set_response (message, "application/json", SOUP_MEMORY_TAKE, g_steal_pointer (&contents), length);
+}
+
+static FakeTodoist*
+fake_todoist_new (const gchar **responses)
+{
+  g_autoptr (GError) error = NULL;
+  g_autoptr (GSList) uris = NULL;
+  FakeTodoist *fake;
+
+  fake = g_new0 (FakeTodoist, 1);
+  fake->responses = responses;
+  fake->sync_tokens = g_ptr_array_new_with_free_func (g_free);
+  fake->sockets = g_ptr_array_new_with_free_func (g_object_unref);
+  fake->batch_sizes = g_array_new (FALSE, FALSE, sizeof (guint));
+  fake->batch_times = g_array_new (FALSE, FALSE, sizeof (gint64));
+  fake->server = soup_server_new (NULL, NULL);
+
+  soup_server_add_handler (fake->server, NULL, server_callback, fake, NULL);
+  soup_server_listen_local (fake->server, 0, SOUP_SERVER_LISTEN_IPV4_ONLY, &error);
+  g_assert_no_error (error);
+
+  uris = soup_server_get_uris (fake->server);
+  fake->url = soup_uri_to_string (uris->data, FALSE);
+
+  g_slist_free_full (g_steal_pointer (&uris), (GDestroyNotify) soup_uri_free);
+
+  return fake;
+}
+
+static void
+fake_todoist_free (FakeTodoist *fake)
+{
+  soup_server_disconnect (fake->server);
+
+  g_clear_object (&fake->server);
+  g_clear_pointer (&fake->sync_tokens, g_ptr_array_unref);
+  g_clear_pointer (&fake->sockets, g_ptr_array_unref);
+  g_clear_pointer (&fake->batch_sizes, g_array_unref);
+  g_clear_pointer (&fake->batch_times, g_array_unref);
+  g_clear_pointer (&fake->url, g_free);
+  g_free (fake);
+}
+
+static void
+wait_for_sync (GtdProviderTodoist *provider)
+{
+  while (gtd_object_get_loading (GTD_OBJECT (provider)))
+    g_main_context_iteration (NULL, TRUE);
+}
+
+static GtdTaskList*
+find_list (GtdProviderTodoist *provider,
+           const gchar        *uid)
+{
+  g_autoptr (GList) lists = NULL;
+  GList *l;
+
+  lists = gtd_provider_get_task_lists (GTD_PROVIDER (provider));
+
+  for (l = lists; l; l = l->next)
+    {
+      if (g_strcmp0 (gtd_object_get_uid (l->data), uid) == 0)
+        return l->data;
+    }
+
+  return NULL;
+}
+
+static gchar*
+get_cache_path (const gchar *account_id)
+{
+  g_autofree gchar *filename = g_strdup_printf ("%s.json", account_id);
+
+  return g_build_filename (g_get_user_cache_dir (), "gnome-todo", "todoist", filename, NULL);
+}
+
+static void
+remove_cache (const gchar *account_id)
+{
+  g_autofree gchar *cache_parent_dir = NULL;
+  g_autofree gchar *cache_dir = NULL;
+  g_autofree gchar *cache_path = NULL;
+
+  cache_path = get_cache_path (account_id);
+  cache_dir = g_path_get_dirname (cache_path);
+  cache_parent_dir = g_path_get_dirname (cache_dir);
+
+  g_unlink (cache_path);
+  g_rmdir (cache_dir);
+  g_rmdir (cache_parent_dir);
+}
+
+static GPtrArray*
+queue_updates (GtdProviderTodoist *provider,
+               GtdTask            *task,
+               guint               n_updates)
+{
+  GPtrArray *tasks;
+  guint i;
+
+  tasks = g_ptr_array_new ();
+
+  for (i = 0; i < n_updates; i++)
+    g_ptr_array_add (tasks, task);
+
+  gtd_provider_update_tasks (GTD_PROVIDER (provider), tasks, NULL, NULL, NULL);
+
+  return tasks;
+}
+
+static void
+wait_for_commands (FakeTodoist *fake,
+                   GtdTask     *task,
+                   guint        n_commands)
+{
+  while (fake->n_commands < n_commands || gtd_object_get_loading (GTD_OBJECT (task)))
+    g_main_context_iteration (NULL, TRUE);
+}
+
+static gchar*
+generate_full_sync (guint n_projects,
+                    guint n_tasks_per_project)
+{
+  GString *json;
+  guint i;
+  guint p;
+
+  json = g_string_new ("{ \"sync_token\": \"large\", \"full_sync\": true, \"projects\": [");
+
+  for (p = 0; p < n_projects; p++)
+    {
+      g_string_append_printf (json,
+                              "%s{ \"id\": %u, \"name\": \"Project %u\", \"color\": 1, \"is_deleted\": 0 }",
+                              p > 0 ? ", " : "",
+                              p + 1,
+                              p + 1);
+    }
+
+  g_string_append (json, "], \"items\": [");
+
+  /* Interleave the projects, and nest every task up to 3 levels deep */
+  for (i = 0; i < n_tasks_per_project; i++)
+    {
+      for (p = 0; p < n_projects; p++)
+        {
+          g_string_append_printf (json,
+                                  "%s{ \"id\": %u, \"project_id\": %u, \"content\": \"Task %u\", "
+                                  "\"checked\": 0, \"due_date_utc\": null, "
+                                  "\"date_added\": \"Fri 07 Feb 2020 10:00:00 +0000\", "
+                                  "\"indent\": %u, \"item_order\": %u, \"is_deleted\": 0 }",
+                                  i + p > 0 ? ", " : "",
+                                  100 + p * n_tasks_per_project + i,
+                                  p + 1,
+                                  i,
+                                  i % 3 + 1,
+                                  i + 1);
+        }
+    }
+
+  g_string_append (json, "] }");
+
+  return g_string_free (json, FALSE);
+}
+
+static void
+test_cache (void)
+{
+  g_autoptr (GtdProviderTodoist) provider = NULL;
+  g_autofree gchar *cache_path = NULL;
+  g_autoptr (GList) lists = NULL;
+  const gchar *responses[] = { "sync-full.json", "sync-delta.json", NULL };
+  FakeTodoist *fake;
+  GtdTaskList *inbox;
+  GtdTaskList *work;
+  GtdTask *proofread;
+  GtdTask *bread;
+  GtdTask *eggs;
+
+  fake = fake_todoist_new (responses);
+  cache_path = get_cache_path ("account");
+
+  /* Without a cache, everything comes from a full sync */
+  provider = _gtd_provider_todoist_new_for_url ("account", "token", fake->url);
+
+  lists = gtd_provider_get_task_lists (GTD_PROVIDER (provider));
+  g_assert_null (lists);
+
+  wait_for_sync (provider);
+
+  g_assert_cmpuint (fake->sync_tokens->len, ==, 1);
+  g_assert_cmpstr (g_ptr_array_index (fake->sync_tokens, 0), ==, "*");
+
+  inbox = find_list (provider, "1");
+  work = find_list (provider, "2");
+  g_assert_nonnull (inbox);
+  g_assert_nonnull (work);
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (inbox)), ==, 2);
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (work)), ==, 2);
+
+  /* The cache is written, at the latest, when the provider goes away */
+  g_clear_object (&provider);
+  g_assert_true (g_file_test (cache_path, G_FILE_TEST_EXISTS));
+
+  /* Now the cached state is available right away, before syncing */
+  provider = _gtd_provider_todoist_new_for_url ("account", "token", fake->url);
+
+  inbox = find_list (provider, "1");
+  work = find_list (provider, "2");
+  g_assert_nonnull (inbox);
+  g_assert_nonnull (work);
+  g_assert_cmpstr (gtd_task_list_get_name (work), ==, "Work");
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (inbox)), ==, 2);
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (work)), ==, 2);
+
+  proofread = gtd_task_list_get_task_by_id (work, "14");
+  g_assert_nonnull (proofread);
+  g_assert_true (gtd_task_get_parent (proofread) == gtd_task_list_get_task_by_id (work, "12"));
+
+  /* And only the delta since the cached sync token is applied */
+  wait_for_sync (provider);
+
+  g_assert_cmpuint (fake->sync_tokens->len, ==, 2);
+  g_assert_cmpstr (g_ptr_array_index (fake->sync_tokens, 1), ==, "token-1");
+
+  g_assert_true (find_list (provider, "1") == inbox);
+  g_assert_true (find_list (provider, "2") == work);
+  g_assert_cmpstr (gtd_task_list_get_name (work), ==, "Office");
+
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (work)), ==, 1);
+  g_assert_null (gtd_task_list_get_task_by_id (work, "12"));
+  g_assert_true (gtd_task_list_get_task_by_id (work, "14") == proofread);
+  g_assert_null (gtd_task_get_parent (proofread));
+
+  g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (inbox)), ==, 3);
+
+  bread = gtd_task_list_get_task_by_id (inbox, "11");
+  eggs = gtd_task_list_get_task_by_id (inbox, "13");
+  g_assert_nonnull (bread);
+  g_assert_nonnull (eggs);
+  g_assert_true (gtd_task_get_complete (bread));
+  g_assert_true (gtd_task_get_parent (eggs) == bread);
+
+  g_clear_object (&provider);
+
+  remove_cache ("account");
+  fake_todoist_free (fake);
+}
+
+static void
+test_large_sync (void)
+{
+  g_autoptr (GtdProviderTodoist) provider = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *contents = NULL;
+  g_autofree gchar *path = NULL;
+  const gchar *responses[] = { NULL, NULL };
+  const guint n_projects = 4;
+  const guint n_tasks = 2500;
+  FakeTodoist *fake;
+  guint p;
+
+  path = g_build_filename (g_get_user_cache_dir (), "large-sync.json", NULL);
+  contents = generate_full_sync (n_projects, n_tasks);
+
+  g_file_set_contents (path, contents, -1, &error);
+  g_assert_no_error (error);
+
+  responses[0] = path;
+  fake = fake_todoist_new (responses);
+
+  /* The payload is decoded in a thread, and applied over several iterations */
+  provider = _gtd_provider_todoist_new_for_url ("large-sync", "token", fake->url);
+  wait_for_sync (provider);
+
+  for (p = 0; p < n_projects; p++)
+    {
+      g_autofree gchar *list_uid = g_strdup_printf ("%u", p + 1);
+      g_autofree gchar *root_uid = g_strdup_printf ("%u", 100 + p * n_tasks + 9);
+      g_autofree gchar *child_uid = g_strdup_printf ("%u", 100 + p * n_tasks + 10);
+      g_autofree gchar *grandchild_uid = g_strdup_printf ("%u", 100 + p * n_tasks + 11);
+      GtdTaskList *list;
+      GtdTask *root;
+      GtdTask *child;
+      GtdTask *grandchild;
+
+      list = find_list (provider, list_uid);
+      g_assert_nonnull (list);
+      g_assert_cmpuint (g_list_model_get_n_items (G_LIST_MODEL (list)), ==, n_tasks);
+
+      root = gtd_task_list_get_task_by_id (list, root_uid);
+      child = gtd_task_list_get_task_by_id (list, child_uid);
+      grandchild = gtd_task_list_get_task_by_id (list, grandchild_uid);
+
+      g_assert_nonnull (root);
+      g_assert_null (gtd_task_get_parent (root));
+      g_assert_true (gtd_task_get_parent (child) == root);
+      g_assert_true (gtd_task_get_parent (grandchild) == child);
+    }
+
+  g_clear_object (&provider);
+
+  g_unlink (path);
+  remove_cache ("large-sync");
+  fake_todoist_free (fake);
+}
+
+static void
+test_pipelining (void)
+{
+  g_autoptr (GtdProviderTodoist) provider = NULL;
+  g_autoptr (JsonParser) parser = NULL;
+  g_autoptr (GPtrArray) tasks = NULL;
+  g_autoptr (GError) error = NULL;
+  g_autofree gchar *cache_path = NULL;
+  const gchar *responses[] = { "sync-full.json", NULL };
+  const guint latencies_ms[] = { 100, 600, 50 };
+  FakeTodoist *fake;
+  JsonObject *cache;
+  GtdTask *task;
+  gint64 start;
+
+  fake = fake_todoist_new (responses);
+  fake->latencies_ms = latencies_ms;
+  fake->n_latencies = G_N_ELEMENTS (latencies_ms);
+
+  provider = _gtd_provider_todoist_new_for_url ("pipelining", "token", fake->url);
+  wait_for_sync (provider);
+
+  task = gtd_task_list_get_task_by_id (find_list (provider, "1"), "10");
+  g_assert_nonnull (task);
+
+  start = g_get_monotonic_time ();
+  tasks = queue_updates (provider, task, 3 * 100);
+
+  wait_for_commands (fake, task, 3 * 100);
+
+  /* Full batches are sent right away, without waiting for the deadline */
+  g_assert_cmpuint (fake->batch_sizes->len, ==, 3);
+  g_assert_cmpuint (g_array_index (fake->batch_sizes, guint, 0), ==, 100);
+  g_assert_cmpuint (g_array_index (fake->batch_sizes, guint, 1), ==, 100);
+  g_assert_cmpuint (g_array_index (fake->batch_sizes, guint, 2), ==, 100);
+  g_assert_cmpint (g_array_index (fake->batch_times, gint64, 2) - start, <, 1000 * 1000);
+
+  /* Two batches were on the wire at the same time, but never more */
+  g_assert_cmpuint (fake->max_in_flight, ==, 2);
+
+  /*
+   * The second batch is the slowest to answer, but the responses are still
+   * applied in order, so the sync token of the last batch is the one kept.
+   */
+  g_clear_object (&provider);
+
+  cache_path = get_cache_path ("pipelining");
+  parser = json_parser_new ();
+  json_parser_load_from_file (parser, cache_path, &error);
+  g_assert_no_error (error);
+
+  cache = json_node_get_object (json_parser_get_root (parser));
+  g_assert_cmpstr (json_object_get_string_member (cache, "sync_token"), ==, "commands-3");
+
+  remove_cache ("pipelining");
+  fake_todoist_free (fake);
+}
+
+static void
+test_max_wait (void)
+{
+  g_autoptr (GtdProviderTodoist) provider = NULL;
+  g_autoptr (GPtrArray) tasks = NULL;
+  const gchar *responses[] = { "sync-full.json", NULL };
+  FakeTodoist *fake;
+  GtdTask *task;
+  gint64 elapsed;
+  gint64 start;
+
+  fake = fake_todoist_new (responses);
+
+  provider = _gtd_provider_todoist_new_for_url ("max-wait", "token", fake->url);
+  wait_for_sync (provider);
+
+  task = gtd_task_list_get_task_by_id (find_list (provider, "1"), "10");
+  g_assert_nonnull (task);
+
+  start = g_get_monotonic_time ();
+  tasks = queue_updates (provider, task, 10);
+
+  wait_for_commands (fake, task, 10);
+
+  /* A partial batch is held back until the deadline, and sent as a whole */
+  elapsed = g_array_index (fake->batch_times, gint64, 0) - start;
+
+  g_assert_cmpuint (fake->batch_sizes->len, ==, 1);
+  g_assert_cmpuint (g_array_index (fake->batch_sizes, guint, 0), ==, 10);
+  g_assert_cmpint (elapsed, >=, 900 * 1000);
+  g_assert_cmpint (elapsed, <, 3000 * 1000);
+
+  g_clear_object (&provider);
+
+  remove_cache ("max-wait");
+  fake_todoist_free (fake);
+}
+
+static void
+test_connection_reuse (void)
+{
+  g_autoptr (GtdProviderTodoist) provider = NULL;
+  const gchar *responses[] = { "sync-full.json", NULL };
+  const guint latencies_ms[] = { 50, 50, 50 };
+  GtdProviderTodoistStats stats;
+  FakeTodoist *fake;
+  GtdTask *task;
+  guint i;
+
+  fake = fake_todoist_new (responses);
+  fake->latencies_ms = latencies_ms;
+  fake->n_latencies = G_N_ELEMENTS (latencies_ms);
+
+  provider = _gtd_provider_todoist_new_for_url ("reuse", "token", fake->url);
+  wait_for_sync (provider);
+
+  task = gtd_task_list_get_task_by_id (find_list (provider, "1"), "10");
+  g_assert_nonnull (task);
+
+  for (i = 0; i < G_N_ELEMENTS (latencies_ms); i++)
+    {
+      g_autoptr (GPtrArray) tasks = NULL;
+
+      tasks = queue_updates (provider, task, 100);
+      wait_for_commands (fake, task, (i + 1) * 100);
+
+      /* Let the connection go back to idle before the next request */
+      while (g_main_context_iteration (NULL, FALSE))
+        ;
+    }
+
+  /* The sync and all the batches went through the same kept-alive connection */
+  g_assert_cmpuint (fake->sockets->len, ==, 1);
+
+  _gtd_provider_todoist_get_stats (provider, &stats);
+
+  g_assert_cmpuint (stats.n_requests, ==, 4);
+  g_assert_cmpuint (stats.n_responses, ==, 4);
+  g_assert_cmpuint (stats.bytes_sent, >, 0);
+  g_assert_cmpuint (stats.bytes_received, >, 0);
+  g_assert_cmpint (stats.max_latency_us, >=, 50 * 1000);
+  g_assert_cmpint (stats.total_latency_us, >=, 3 * 50 * 1000);
+
+  g_clear_object (&provider);
+
+  remove_cache ("reuse");
+  fake_todoist_free (fake);
+}
+
+gint
+main (gint   argc,
+      gchar *argv[])
+{
+  g_autofree gchar *cache_dir = NULL;
+  gint result;
+
+  /* Keep the cache away from the user's */
+  cache_dir = g_dir_make_tmp ("gnome-todo-todoist-XXXXXX", NULL);
+  g_setenv ("XDG_CACHE_HOME", cache_dir, TRUE);
+
+  g_test_init (&argc, &argv, NULL);
+
+  if (g_getenv ("G_MESSAGES_DEBUG"))
+    gtd_log_init ();
+
+  g_test_add_func ("/todoist/sync/cache", test_cache);
+  g_test_add_func ("/todoist/sync/large", test_large_sync);
+  g_test_add_func ("/todoist/commands/pipelining", test_pipelining);
+  g_test_add_func ("/todoist/commands/max-wait", test_max_wait);
+  g_test_add_func ("/todoist/connection/reuse", test_connection_reuse);
+
+  result = g_test_run ();
+
+  g_rmdir (cache_dir);
+
+  return result;
+}